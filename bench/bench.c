@@ -0,0 +1,721 @@
+/**
+ * bench.c - throughput benchmarks for safeinput
+ *
+ * Runs each getter family over generated inputs fed from memory, a file,
+ * an mmap() of that file and a pipe, next to scanf() and fgets()+strto*
+ * baselines on the same bytes.
+ *
+ * usage - bench [-n values] [-f filter] [--json]
+ *
+ * 		-n		values per input ( default 1000000 )
+ * 		-f		only run benchmarks whose name contains this string
+ * 		--json	one JSON object per result instead of a table
+ *
+ * Allocations are counted by wrapping malloc/calloc/realloc at link time
+ * ( -Wl,--wrap ), which sees the library's calls but not libc's own.
+ */
+
+#define _GNU_SOURCE
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <limits.h>
+#include <stddef.h>
+#include <time.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <signal.h>
+#include <sys/wait.h>
+#include <safeinput/safeinput.h>
+
+// === Allocation counting ===
+static size_t allocs;
+
+void *__real_malloc ( size_t size );
+void *__real_calloc ( size_t n, size_t size );
+void *__real_realloc ( void *ptr, size_t size );
+
+void *__wrap_malloc ( size_t size ) { allocs++; return __real_malloc( size ); }
+void *__wrap_calloc ( size_t n, size_t size ) { allocs++; return __real_calloc( n, size ); }
+void *__wrap_realloc ( void *ptr, size_t size ) { allocs++; return __real_realloc( ptr, size ); }
+
+// === Inputs ===
+typedef struct input {
+	const char	*name;
+	char		*data;
+	size_t		len;
+	size_t		values;		// values ( lines, tokens or rows ) in data
+	char		path[64];	// the same bytes on disk
+} input;
+
+static uint64_t rng = 0x9E3779B97F4A7C15ull;
+
+static uint64_t next ( void ) {
+
+	// xorshift64*, deterministic across runs
+	rng ^= rng >> 12;
+	rng ^= rng << 25;
+	rng ^= rng >> 27;
+	return rng * 0x2545F4914F6CDD1Dull;
+}
+
+typedef int ( *genFn )( char *dst, size_t i );
+
+static int genIntSmall ( char *dst, size_t i ) { (void)i; return sprintf( dst, "%d\n", (int)( next() % 1000 )); }
+static int genIntWide ( char *dst, size_t i ) { (void)i; return sprintf( dst, "%d\n", (int)(uint32_t)next() ); }
+static int genLongWide ( char *dst, size_t i ) { (void)i; return sprintf( dst, "%lld\n", (long long)next() ); }
+
+static int genIntMix ( char *dst, size_t i ) {
+
+	(void)i;
+	switch ( next() % 10 ) {
+		case 0:		return sprintf( dst, "%dx\n", (int)( next() % 1000 ));	// trailing garbage
+		default:	return sprintf( dst, "%d\n", (int)(uint32_t)next() );
+	}
+}
+
+static int genDoubleShort ( char *dst, size_t i ) {
+
+	(void)i;
+	return sprintf( dst, "%.3f\n", (double)(int64_t)( next() % 20000000 ) / 1000.0 - 10000.0 );
+}
+
+static int genDoubleLong ( char *dst, size_t i ) {
+
+	(void)i;
+	double d;
+	do {
+		uint64_t bits = next();
+		memcpy( &d, &bits, sizeof(d) );
+	} while ( d != d || d - d != 0 );	// finite only
+	return sprintf( dst, "%.17g\n", d );
+}
+
+static int genString ( char *dst, size_t i, size_t len ) {
+
+	(void)i;
+	for ( size_t k = 0; k < len; k++ ) dst[k] = (char)( 'a' + next() % 26 );
+	dst[len] = '\n';
+	return (int)len + 1;
+}
+
+// ~100 bytes of mixed-script text: ASCII words with Latin-1, Cyrillic, CJK and emoji
+static int genUtf8 ( char *dst, size_t i ) {
+
+	static const char *pieces[] = { "word ", "caf\xC3\xA9 ", "\xD0\xBC\xD0\xB8\xD1\x80 ", "\xE6\x97\xA5\xE6\x9C\xAC ", "\xF0\x9F\x98\x80 ", "data, " };
+	size_t len = 0;
+
+	(void)i;
+	while ( len < 96 ) {
+		const char *p = pieces[ next() % 6 ];
+		size_t n = strlen( p );
+		memcpy( dst + len, p, n );
+		len += n;
+	}
+	dst[len] = '\n';
+	return (int)len + 1;
+}
+
+static int genStrShort ( char *dst, size_t i ) { return genString( dst, i, 16 ); }
+static int genStrLong ( char *dst, size_t i ) { return genString( dst, i, 100 ); }
+static int genStr4k ( char *dst, size_t i ) { return genString( dst, i, 4000 ); }
+static int genChar ( char *dst, size_t i ) { (void)i; return sprintf( dst, "%c\n", (char)( 'a' + next() % 4 )); }
+static int genBool ( char *dst, size_t i ) { (void)i; return sprintf( dst, "%c\n", next() & 1 ? 'y' : 'n' ); }
+
+// 16 integers per line, so values = tokens
+static int genRow ( char *dst, size_t i ) {
+
+	return sprintf( dst, "%d%c", (int)( next() % 100000 ), i % 16 == 15 ? '\n' : ',' );
+}
+
+static int genCsv ( char *dst, size_t i ) {
+
+	return sprintf( dst, "%zu,%d.%02d,\"item %d\",%d\n", i, (int)( next() % 1000 ), (int)( next() % 100 ),
+					(int)( next() % 10000 ), (int)( next() % 50 ));
+}
+
+static input makeInput ( const char *name, genFn gen, size_t n, size_t perValue ) {
+
+	input in = { .name = name, .values = n };
+	in.data = malloc( n * perValue + 1 );
+	if ( !in.data ) {
+		perror( "malloc" );
+		exit( EXIT_FAILURE );
+	}
+
+	for ( size_t i = 0; i < n; i++ ) in.len += (size_t)gen( in.data + in.len, i );
+
+	snprintf( in.path, sizeof(in.path), "/tmp/si_bench_%s_%d", name, (int)getpid() );
+	FILE *fp = fopen( in.path, "wb" );
+	if ( !fp || fwrite( in.data, 1, in.len, fp ) != in.len || fclose( fp )) {
+		perror( in.path );
+		exit( EXIT_FAILURE );
+	}
+
+	return in;
+}
+
+// === Sources ===
+typedef enum source { SRC_MEMORY, SRC_FILE, SRC_MAPPED, SRC_PIPE, SRC_COUNT } source;
+
+static const char *sourceName[SRC_COUNT] = { "memory", "file", "mmap", "pipe" };
+
+static pid_t writer;
+
+// fork a child that writes the input into a pipe, return the read end
+static int openPipe ( const input *in ) {
+
+	int fds[2];
+	if ( pipe( fds )) {
+		perror( "pipe" );
+		exit( EXIT_FAILURE );
+	}
+
+	writer = fork();
+	if ( writer == 0 ) {
+		close( fds[0] );
+		for ( size_t off = 0; off < in->len; ) {
+			ssize_t w = write( fds[1], in->data + off, in->len - off );
+			if ( w <= 0 ) _exit( 1 );
+			off += (size_t)w;
+		}
+		_exit( 0 );
+	}
+
+	close( fds[1] );
+	return fds[0];
+}
+
+static void closeSource ( int fd ) {
+
+	if ( fd >= 0 ) close( fd );
+	if ( writer > 0 ) {
+		kill( writer, SIGTERM );
+		waitpid( writer, NULL, 0 );
+		writer = 0;
+	}
+}
+
+static int openSource ( const input *in, source src ) {
+
+	if ( src == SRC_MEMORY ) return -1;
+	if ( src == SRC_PIPE ) return openPipe( in );
+
+	int fd = open( in->path, O_RDONLY );
+	if ( fd < 0 ) {
+		perror( in->path );
+		exit( EXIT_FAILURE );
+	}
+	return fd;
+}
+
+static si_reader *openReader ( const input *in, source src, int fd ) {
+
+	si_reader *r;
+
+	switch ( src ) {
+		case SRC_MEMORY:	r = si_reader_fromMemory( in->data, in->len ); break;
+		case SRC_MAPPED:	r = si_reader_fromMapped( fd ); break;
+		default:			r = si_reader_fromFd( fd ); break;
+	}
+
+	if ( !r ) exit( EXIT_FAILURE );
+	si_reader_setSilent( r, true );
+	si_reader_setLineLimit( r, 8192 );
+	return r;
+}
+
+static FILE *openStream ( const input *in, source src, int fd ) {
+
+	FILE *fp = ( src == SRC_MEMORY ) ? fmemopen( in->data, in->len, "r" ) : fdopen( dup( fd ), "r" );
+	if ( !fp ) exit( EXIT_FAILURE );
+	return fp;
+}
+
+// === Benchmarks ===
+static volatile uint64_t sink;
+
+typedef size_t ( *readerFn )( si_reader *r );
+typedef size_t ( *streamFn )( FILE *fp );
+
+#define GETTER( name, type, call, stop )								\
+	static size_t name ( si_reader *r ) {								\
+		size_t n = 0;													\
+		while ( 1 ) {													\
+			type v = call;												\
+			if ( stop ) break;											\
+			sink += (uint64_t)v;										\
+			n++;														\
+		}																\
+		return n;														\
+	}
+
+GETTER( benchGetInt, int, si_reader_getInt( r ), si_reader_eof( r ) && v == INT_MIN )
+GETTER( benchGetUInt, unsigned int, si_reader_getUInt( r ), si_reader_eof( r ) && v == UINT_MAX )
+GETTER( benchGetLong, long, si_reader_getLong( r ), si_reader_eof( r ) && v == LONG_MIN )
+GETTER( benchGetULong, unsigned long, si_reader_getULong( r ), si_reader_eof( r ) && v == ULONG_MAX )
+GETTER( benchGetLongLong, long long, si_reader_getLongLong( r ), si_reader_eof( r ) && v == LLONG_MIN )
+GETTER( benchGetULongLong, unsigned long long, si_reader_getULongLong( r ), si_reader_eof( r ) && v == ULLONG_MAX )
+GETTER( benchGetChar, int, si_reader_getChar( r ), v == EOF )
+GETTER( benchGetCharFiltered, int, si_reader_getCharFiltered( r, "abcd" ), v == EOF )
+
+static size_t benchGetDouble ( si_reader *r ) {
+
+	size_t n = 0;
+	while ( 1 ) {
+		double v = si_reader_getDouble( r );
+		if ( v != v && si_reader_eof( r )) break;
+		sink += (uint64_t)( v != 0 );
+		n++;
+	}
+	return n;
+}
+
+static size_t benchGetFloat ( si_reader *r ) {
+
+	size_t n = 0;
+	while ( 1 ) {
+		float v = si_reader_getFloat( r );
+		if ( v != v && si_reader_eof( r )) break;
+		sink += (uint64_t)( v != 0 );
+		n++;
+	}
+	return n;
+}
+
+static void onBoolError ( void *ctx, si_error kind, const char *msg ) {
+
+	(void)msg;
+	if ( kind == SI_ERR_EOF ) *(bool *)ctx = true;
+}
+
+// false is a valid answer, so EOF is only visible through the error handler
+static size_t benchGetBool ( si_reader *r ) {
+
+	bool done = false;
+	si_reader_setSilent( r, false );
+	si_reader_setErrorHandler( r, onBoolError, &done );
+
+	size_t n = 0;
+	while ( 1 ) {
+		bool v = si_reader_getBool( r );
+		if ( done ) break;
+		sink += v;
+		n++;
+	}
+	return n;
+}
+
+static size_t benchGetCharIn ( si_reader *r ) {
+
+	si_charset cs;
+	si_charset_compile( &cs, "a-d" );
+
+	size_t n = 0;
+	for ( int c; ( c = si_reader_getCharIn( r, &cs )) != EOF; n++ ) sink += (uint64_t)c;
+	return n;
+}
+
+static size_t benchTryGetInt ( si_reader *r ) {
+
+	size_t n = 0;
+	si_result s;
+	int v;
+
+	while (( s = si_reader_tryGetInt( r, &v )) != SI_EOF ) {
+		if ( s == SI_OK ) sink += (uint64_t)v;
+		n++;
+	}
+	return n;
+}
+
+static size_t benchTryGetDouble ( si_reader *r ) {
+
+	size_t n = 0;
+	si_result s;
+	double v;
+
+	while (( s = si_reader_tryGetDouble( r, &v )) != SI_EOF ) {
+		if ( s == SI_OK ) sink += (uint64_t)( v != 0 );
+		n++;
+	}
+	return n;
+}
+
+static size_t benchGetCString ( si_reader *r ) {
+
+	size_t n = 0;
+	for ( char *s; ( s = si_reader_getCString( r )); n++ ) {
+		sink += (uint64_t)s[0];
+		free( s );
+	}
+	return n;
+}
+
+static size_t benchGetString ( si_reader *r ) {
+
+	size_t n = 0;
+	for ( si_string s; ( s = si_reader_getStringMax( r, 8000 )).data; n++ ) {
+		sink += s.len;
+		free( s.data );
+	}
+	return n;
+}
+
+static size_t benchGetStringArena ( si_reader *r ) {
+
+	si_arena *a = si_arena_create( 0 );
+	si_allocator al = si_arena_allocator( a );
+	si_reader_setAllocator( r, &al );
+
+	size_t n = 0;
+	for ( si_string s; ( s = si_reader_getStringMax( r, 8000 )).data; n++ ) {
+		sink += s.len;
+		if ( n % 4096 == 4095 ) si_arena_reset( a );
+	}
+
+	si_reader_setAllocator( r, NULL );
+	si_arena_destroy( a );
+	return n;
+}
+
+static size_t benchGetStringView ( si_reader *r ) {
+
+	size_t n = 0;
+	for ( si_string s; ( s = si_reader_getStringViewMax( r, 8000 )).data; n++ ) sink += s.len;
+	return n;
+}
+
+static size_t benchGetStringViewUtf8 ( si_reader *r ) {
+
+	size_t n = 0;
+	for ( si_string s; ( s = si_reader_getStringViewUtf8( r )).data; n++ ) sink += s.len;
+	return n;
+}
+
+// the two-pass way: split the line, then validate it
+static size_t benchReadLineValidate ( si_reader *r ) {
+
+	size_t n = 0;
+	si_string s;
+	while ( si_reader_readLine( r, &s ) == SI_OK ) {
+		sink += si_utf8_valid( s.data, s.len );
+		n++;
+	}
+	return n;
+}
+
+static size_t benchReadLine ( si_reader *r ) {
+
+	size_t n = 0;
+	si_string s;
+	while ( si_reader_readLine( r, &s ) == SI_OK ) {
+		sink += s.len;
+		n++;
+	}
+	return n;
+}
+
+static bool onLine ( void *ctx, si_string line ) {
+
+	sink += line.len;
+	++*(size_t *)ctx;
+	return true;
+}
+
+static size_t benchForEachLine ( si_reader *r ) {
+
+	size_t n = 0;
+	si_reader_forEachLine( r, onLine, &n );
+	return n;
+}
+
+static bool onLong ( void *ctx, long v ) {
+
+	sink += (uint64_t)v;
+	++*(size_t *)ctx;
+	return true;
+}
+
+static size_t benchForEachLong ( si_reader *r ) {
+
+	size_t n = 0;
+	si_reader_forEachLong( r, onLong, &n );
+	return n;
+}
+
+static bool onDouble ( void *ctx, double v ) {
+
+	sink += (uint64_t)v;
+	++*(size_t *)ctx;
+	return true;
+}
+
+static size_t benchForEachDouble ( si_reader *r ) {
+
+	size_t n = 0;
+	si_reader_forEachDouble( r, onDouble, &n );
+	return n;
+}
+
+static size_t benchIntArray ( si_reader *r ) {
+
+	int buf[4096];
+	size_t n = 0, got;
+	si_position err;
+
+	while (( got = si_reader_getIntArray( r, buf, 4096, ',', &err ))) {
+		sink += (uint64_t)buf[0];
+		n += got;
+	}
+	return n;
+}
+
+static size_t benchParallelLongArray ( si_reader *r ) {
+
+	size_t n;
+	long *v = si_reader_parallelGetLongArray( r, ',', 0, &n, NULL );
+	if ( v && n ) sink += (uint64_t)v[0];
+	free( v );
+	return n;
+}
+
+static size_t benchRecord ( si_reader *r ) {
+
+	si_record rec;
+	size_t n = 0;
+	si_result s;
+
+	while (( s = si_reader_getRecord( r, ',', '"', &rec )) != SI_EOF ) {
+		int qty;
+		double price;
+		if ( s == SI_OK && !si_fieldDouble( &rec, 1, &price ) && !si_fieldInt( &rec, 3, &qty )) sink += (uint64_t)qty;
+		n++;
+	}
+	return n;
+}
+
+typedef struct row { long id; double price; si_string name; int qty; } row;
+
+static size_t benchStruct ( si_reader *r ) {
+
+	si_schema *schema = si_schema_fromSignature( "l,d,s,i", (size_t[]){ offsetof( row, id ), offsetof( row, price ),
+												 offsetof( row, name ), offsetof( row, qty ) }, ',', '"' );
+	row x;
+	size_t n = 0;
+	si_result s;
+
+	while (( s = si_reader_readStruct( r, schema, &x, NULL )) != SI_EOF ) {
+		if ( s == SI_OK ) sink += (uint64_t)x.qty;
+		n++;
+	}
+
+	si_schema_free( schema );
+	return n;
+}
+
+// baselines
+static size_t benchScanfInt ( FILE *fp ) {
+
+	size_t n = 0;
+	int v, got;
+	while (( got = fscanf( fp, "%d", &v )) != EOF ) {
+		if ( got == 1 ) sink += (uint64_t)v;
+		else if ( fscanf( fp, "%*s" ) == EOF ) break;
+		n++;
+	}
+	return n;
+}
+
+static size_t benchFgetsStrtol ( FILE *fp ) {
+
+	char line[INPUT_BUFFER_SIZE];
+	size_t n = 0;
+	while ( fgets( line, sizeof(line), fp )) {
+		char *end;
+		sink += (uint64_t)strtol( line, &end, 10 );
+		n++;
+	}
+	return n;
+}
+
+static size_t benchScanfDouble ( FILE *fp ) {
+
+	size_t n = 0;
+	double v;
+	int got;
+	while (( got = fscanf( fp, "%lf", &v )) != EOF ) {
+		if ( got == 1 ) sink += (uint64_t)( v != 0 );
+		else if ( fscanf( fp, "%*s" ) == EOF ) break;
+		n++;
+	}
+	return n;
+}
+
+static size_t benchFgetsStrtod ( FILE *fp ) {
+
+	char line[INPUT_BUFFER_SIZE];
+	size_t n = 0;
+	while ( fgets( line, sizeof(line), fp )) {
+		char *end;
+		sink += (uint64_t)( strtod( line, &end ) != 0 );
+		n++;
+	}
+	return n;
+}
+
+static size_t benchFgetsLine ( FILE *fp ) {
+
+	static char line[8192];
+	size_t n = 0;
+	while ( fgets( line, sizeof(line), fp )) {
+		sink += (uint64_t)line[0];
+		n++;
+	}
+	return n;
+}
+
+typedef struct bench {
+	const char	*name;
+	const char	*input;
+	readerFn	reader;		// exactly one of reader / stream is set
+	streamFn	stream;
+} bench;
+
+static const bench benches[] = {
+	{ "si_getInt",				"int-small",	benchGetInt,			NULL },
+	{ "si_getInt",				"int-wide",		benchGetInt,			NULL },
+	{ "si_getInt",				"int-mix10",	benchGetInt,			NULL },
+	{ "si_getUInt",				"int-small",	benchGetUInt,			NULL },
+	{ "si_getLong",				"long-wide",	benchGetLong,			NULL },
+	{ "si_getULong",			"int-small",	benchGetULong,			NULL },
+	{ "si_getLongLong",			"long-wide",	benchGetLongLong,		NULL },
+	{ "si_getULongLong",		"int-small",	benchGetULongLong,		NULL },
+	{ "si_getFloat",			"double-short",	benchGetFloat,			NULL },
+	{ "si_getDouble",			"double-short",	benchGetDouble,			NULL },
+	{ "si_getDouble",			"double-long",	benchGetDouble,			NULL },
+	{ "si_getChar",				"char",			benchGetChar,			NULL },
+	{ "si_getCharFiltered",		"char",			benchGetCharFiltered,	NULL },
+	{ "si_getCharIn",			"char",			benchGetCharIn,			NULL },
+	{ "si_getBool",				"bool",			benchGetBool,			NULL },
+	{ "si_tryGetInt",			"int-mix10",	benchTryGetInt,			NULL },
+	{ "si_tryGetDouble",		"double-long",	benchTryGetDouble,		NULL },
+	{ "si_getCString",			"str-short",	benchGetCString,		NULL },
+	{ "si_getStringMax",		"str-long",		benchGetString,			NULL },
+	{ "si_getStringMax",		"str-4k",		benchGetString,			NULL },
+	{ "si_getStringMax+arena",	"str-long",		benchGetStringArena,	NULL },
+	{ "si_getStringViewMax",	"str-long",		benchGetStringView,		NULL },
+	{ "si_getStringViewMax",	"str-4k",		benchGetStringView,		NULL },
+	{ "si_reader_readLine",		"str-long",		benchReadLine,			NULL },
+	{ "si_getStringViewUtf8",	"str-long",		benchGetStringViewUtf8,	NULL },
+	{ "si_getStringViewUtf8",	"utf8-long",	benchGetStringViewUtf8,	NULL },
+	{ "readLine+si_utf8_valid",	"utf8-long",	benchReadLineValidate,	NULL },
+	{ "si_reader_forEachLine",	"str-long",		benchForEachLine,		NULL },
+	{ "si_reader_forEachLong",	"long-wide",	benchForEachLong,		NULL },
+	{ "si_reader_forEachDouble","double-long",	benchForEachDouble,		NULL },
+	{ "si_getIntArray",			"int-rows",		benchIntArray,			NULL },
+	{ "si_parallelGetLongArray","int-rows",		benchParallelLongArray,	NULL },
+	{ "si_getRecord",			"csv",			benchRecord,			NULL },
+	{ "si_readStruct",			"csv",			benchStruct,			NULL },
+	{ "scanf %d",				"int-wide",		NULL,					benchScanfInt },
+	{ "fgets+strtol",			"int-wide",		NULL,					benchFgetsStrtol },
+	{ "scanf %d",				"int-mix10",	NULL,					benchScanfInt },
+	{ "scanf %lf",				"double-long",	NULL,					benchScanfDouble },
+	{ "fgets+strtod",			"double-long",	NULL,					benchFgetsStrtod },
+	{ "fgets",					"str-long",		NULL,					benchFgetsLine },
+};
+
+static double now ( void ) {
+
+	struct timespec ts;
+	clock_gettime( CLOCK_MONOTONIC, &ts );
+	return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+int main ( int argc, char **argv ) {
+
+	size_t n = 1000000;
+	const char *filter = NULL;
+	bool json = false;
+
+	for ( int i = 1; i < argc; i++ ) {
+		if ( !strcmp( argv[i], "-n" ) && i + 1 < argc ) n = strtoul( argv[++i], NULL, 10 );
+		else if ( !strcmp( argv[i], "-f" ) && i + 1 < argc ) filter = argv[++i];
+		else if ( !strcmp( argv[i], "--json" )) json = true;
+		else {
+			fprintf( stderr, "usage: %s [-n values] [-f filter] [--json]\n", argv[0] );
+			return EXIT_FAILURE;
+		}
+	}
+
+	signal( SIGPIPE, SIG_IGN );
+
+	input inputs[] = {
+		makeInput( "int-small",		genIntSmall,	n, 8 ),
+		makeInput( "int-wide",		genIntWide,		n, 16 ),
+		makeInput( "int-mix10",		genIntMix,		n, 16 ),
+		makeInput( "long-wide",		genLongWide,	n, 24 ),
+		makeInput( "double-short",	genDoubleShort,	n, 16 ),
+		makeInput( "double-long",	genDoubleLong,	n, 32 ),
+		makeInput( "char",			genChar,		n, 4 ),
+		makeInput( "bool",			genBool,		n, 4 ),
+		makeInput( "str-short",		genStrShort,	n, 20 ),
+		makeInput( "str-long",		genStrLong,		n, 104 ),
+		makeInput( "str-4k",		genStr4k,		n / 32 + 1, 4004 ),
+		makeInput( "utf8-long",		genUtf8,		n, 112 ),
+		makeInput( "int-rows",		genRow,			n, 8 ),
+		makeInput( "csv",			genCsv,			n, 48 ),
+	};
+	size_t nInputs = sizeof(inputs) / sizeof(inputs[0]);
+
+	if ( !json ) printf( "%-24s %-13s %-7s %10s %10s %9s %12s\n", "benchmark", "input", "source", "values", "ns/value", "MB/s", "allocs/value" );
+
+	for ( size_t b = 0; b < sizeof(benches) / sizeof(benches[0]); b++ ) {
+		const bench *bm = &benches[b];
+		if ( filter && !strstr( bm->name, filter ) && !strstr( bm->input, filter )) continue;
+
+		const input *in = NULL;
+		for ( size_t i = 0; i < nInputs; i++ )
+			if ( !strcmp( inputs[i].name, bm->input )) in = &inputs[i];
+
+		for ( source src = 0; src < SRC_COUNT; src++ ) {
+			if ( bm->stream && src == SRC_MAPPED ) continue;
+
+			int fd = openSource( in, src );
+			si_reader *r = bm->reader ? openReader( in, src, fd ) : NULL;
+			FILE *fp = bm->stream ? openStream( in, src, fd ) : NULL;
+
+			size_t before = allocs;
+			double t0 = now();
+			size_t values = bm->reader ? bm->reader( r ) : bm->stream( fp );
+			double t = now() - t0;
+			size_t count = allocs - before;
+
+			if ( r ) si_reader_free( r );
+			if ( fp ) fclose( fp );
+			closeSource( fd );
+
+			double ns = values ? t * 1e9 / (double)values : 0;
+			double mbs = t > 0 ? (double)in->len / t / 1e6 : 0;
+			double apv = values ? (double)count / (double)values : 0;
+
+			if ( json )
+				printf( "{\"benchmark\":\"%s\",\"input\":\"%s\",\"source\":\"%s\",\"values\":%zu,"
+						"\"ns_per_value\":%.2f,\"mb_per_s\":%.1f,\"allocs_per_value\":%.4f}\n",
+						bm->name, in->name, sourceName[src], values, ns, mbs, apv );
+			else
+				printf( "%-24s %-13s %-7s %10zu %10.2f %9.1f %12.4f\n", bm->name, in->name, sourceName[src], values, ns, mbs, apv );
+			fflush( stdout );
+		}
+	}
+
+	for ( size_t i = 0; i < nInputs; i++ ) {
+		unlink( inputs[i].path );
+		free( inputs[i].data );
+	}
+
+	return EXIT_SUCCESS;
+}
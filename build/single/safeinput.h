@@ -0,0 +1,7084 @@
+// safeinput.h - version 1.1.0
+
+#ifndef SAFEINPUT_H_
+#define SAFEINPUT_H_
+
+// the single-header build ( make single ) compiles the library into the
+// file that defines SAFEINPUT_IMPLEMENTATION, which needs these extensions
+#if defined(SAFEINPUT_IMPLEMENTATION) && !defined(_GNU_SOURCE)
+#define _GNU_SOURCE
+#endif
+
+// === Includes ===
+#include <stdbool.h>
+#include <stddef.h> // for size_t
+#include <stdint.h> // for uint32_t
+#include <stdio.h> // for FILE
+
+// === Exports ===
+// the shared library is built with -fvisibility=hidden, so only SI_API
+// declarations end up in its dynamic symbol table
+#ifndef SI_API
+#if defined(__GNUC__)
+#define SI_API	__attribute__(( visibility( "default" )))
+#else
+#define SI_API
+#endif
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// === STRUCTs ===
+typedef struct si_string {
+	char	*data;	// pointer to data
+	size_t	len;	// byte counter
+} si_string;
+
+// where a batch read stopped ( line == 0 if it didn't fail )
+typedef struct si_position {
+	size_t	line;	// 1-based input line
+	size_t	column;	// 1-based byte column
+} si_position;
+
+// opaque input source, see si_reader_from*()
+typedef struct si_reader si_reader;
+
+// memory source for the string getters ( free may be NULL for bulk release )
+typedef struct si_allocator {
+	void	*(*alloc)( void *ctx, size_t size );
+	void	(*free)( void *ctx, void *ptr );
+	void	*ctx;
+} si_allocator;
+
+// bump allocator, see si_arena_allocator()
+typedef struct si_arena si_arena;
+
+// result of the status-returning calls
+typedef enum si_result {
+	SI_OK = 0,
+	SI_EOF,			// end of input, read error, or bad arguments
+	SI_TOO_LONG,	// line exceeded the limit and was discarded
+	SI_WOULD_BLOCK,	// non-blocking source has no complete line yet
+	SI_INVALID,		// not a valid value of the requested type
+	SI_OVERFLOW,	// valid syntax, but out of the type's range
+} si_result;
+
+// what an error message is about
+typedef enum si_error {
+	SI_ERR_INVALID,		// rejected line
+	SI_ERR_OVERFLOW,	// number out of range
+	SI_ERR_TOO_LONG,	// line exceeded the buffer size
+	SI_ERR_EOF,			// end of input notice
+	SI_ERR_NOMEM,		// allocation failure
+	SI_ERR_USAGE,		// bad arguments
+} si_error;
+
+// receives every message a reader would print to stderr
+typedef void ( *si_errorHandler )( void *ctx, si_error kind, const char *msg );
+
+// callbacks for si_reader_forEach*(), return false to stop early
+typedef bool ( *si_lineFn )( void *ctx, si_string line );
+typedef bool ( *si_longFn )( void *ctx, long value );
+typedef bool ( *si_doubleFn )( void *ctx, double value );
+
+typedef struct si_errorStats {
+	size_t	invalid;	// rejected lines
+	size_t	overflow;	// numbers out of range
+	size_t	tooLong;	// lines over the buffer size
+	size_t	suppressed;	// messages dropped by the repeat limit
+} si_errorStats;
+
+// 256-bit byte class, build with si_charset_compile()
+typedef struct si_charset {
+	unsigned long long	bits[4];	// bit c is set if byte c is a member
+	unsigned char		nibble[32];	// the same set transposed for SIMD scans
+} si_charset;
+
+// one delimited line split into fields, see si_reader_getRecord()
+#define SI_RECORD_FIELDS				64
+
+typedef struct si_record {
+	size_t		line;	// 1-based input line the record came from
+	size_t		count;	// fields in use
+	si_string	field[SI_RECORD_FIELDS];	// views, valid until the next read
+} si_record;
+
+// field types for si_schema_compile()
+typedef enum si_fieldType {
+	SI_FIELD_SKIP = 0,		// field is checked for presence only
+	SI_FIELD_INT,
+	SI_FIELD_UINT,
+	SI_FIELD_LONG,
+	SI_FIELD_ULONG,
+	SI_FIELD_LONGLONG,
+	SI_FIELD_ULONGLONG,
+	SI_FIELD_FLOAT,
+	SI_FIELD_DOUBLE,
+	SI_FIELD_BOOL,			// "y" or "n"
+	SI_FIELD_CHAR,			// exactly one byte
+	SI_FIELD_STRING,		// si_string view, valid until the next read
+	SI_FIELD_STRING_COPY,	// si_string from the reader's allocator
+	SI_FIELD_TYPES			// number of field types
+} si_fieldType;
+
+typedef struct si_fieldDesc {
+	si_fieldType	type;
+	size_t			offset;	// offsetof() the destination member
+} si_fieldDesc;
+
+// one question of a form, see si_reader_promptMany()
+typedef struct si_promptField {
+	const char		*label;	// prompt shown when the answer is needed, NULL for none
+	si_fieldType	type;	// any but SI_FIELD_SKIP
+	void			*out;	// destination of the matching type, si_string for strings
+} si_promptField;
+
+// compiled record layout, see si_schema_compile()
+typedef struct si_schema si_schema;
+
+// why a line or value was turned down, indexes si_stats.rejected
+typedef enum si_reject {
+	SI_REJECT_USAGE,		// NULL buffer or a limit below 1
+	SI_REJECT_TOO_LONG,		// line or token over the limit, drained
+	SI_REJECT_SYNTAX,		// not a value of the type, or more than one character
+	SI_REJECT_RANGE,		// valid syntax, but out of the type's range
+	SI_REJECT_NEGATIVE,		// '-' in front of an unsigned value
+	SI_REJECT_CHOICE,		// character outside the allowed set, or not y/n
+	SI_REJECT_RECORD,		// bad quoting or wrong number of fields
+	SI_REJECTS				// number of reasons
+} si_reject;
+
+// hot-path counters of one reader, see si_reader_stats()
+typedef struct si_stats {
+	bool	enabled;					// false unless the library was built with SI_STATS
+	size_t	bytes;						// bytes taken from the source
+	size_t	refills;					// read() / fread() calls
+	size_t	blocked;					// refills that found no data ( EAGAIN )
+	size_t	lines;						// lines consumed
+	size_t	drained;					// bytes discarded by too-long lines and skipLine
+	size_t	parsed[SI_FIELD_TYPES];		// accepted values by si_fieldType
+	size_t	rejected[SI_REJECTS];		// rejects by si_reject
+	size_t	allocs;						// string getter allocations
+	size_t	allocBytes;
+} si_stats;
+
+// === INPUT BUFFER ===
+#define INPUT_BUFFER_SIZE				128
+#define CHAR_INPUT_BUFFER_SIZE			4
+#define SI_LINE_MAX						( 16u * 1024 * 1024 ) // hard cap for any line
+#define SI_UNBOUNDED					( (size_t)-1 ) // line limit of SI_LINE_MAX
+
+// === Input handling ===
+SI_API int si_getInt						( void );
+SI_API unsigned int si_getUInt				( void );
+
+SI_API float si_getFloat					( void );
+SI_API double si_getDouble					( void );
+
+SI_API long si_getLong						( void );
+SI_API unsigned long si_getULong			( void );
+SI_API long long si_getLongLong				( void );
+SI_API unsigned long long si_getULongLong	( void );
+
+SI_API int si_getChar						( void );
+SI_API int si_getCharFiltered				( const char *allowed );
+SI_API int si_getCharIn							( const si_charset *cs );
+
+SI_API char *si_getCString					( void );
+SI_API si_string si_getString				( void );
+SI_API si_string si_getStringView			( void ); // valid until the next read
+SI_API si_string si_retainString			( si_string view ); // malloc'd copy of a view
+
+SI_API char *si_getCStringMax				( size_t max ); // lines of up to max bytes
+SI_API si_string si_getStringMax			( size_t max );
+SI_API si_string si_getStringViewMax		( size_t max );
+SI_API bool si_setLineLimit					( size_t limit ); // INPUT_BUFFER_SIZE by default
+SI_API bool si_setErrorHandler					( si_errorHandler fn, void *ctx ); // NULL for stderr
+SI_API bool si_setLocking						( bool on ); // line-atomic getters on the shared stdin reader
+SI_API bool si_setSilent						( bool silent );
+SI_API bool si_setAllocator						( const si_allocator *a ); // NULL for malloc/free
+SI_API void si_release							( void *ptr ); // free a string through the allocator
+
+SI_API bool si_getBool						( void );
+
+// === Status input handling ( no sentinels, no retry loop ) ===
+SI_API si_result si_tryGetInt					( int *out );
+SI_API si_result si_tryGetUInt					( unsigned int *out );
+SI_API si_result si_tryGetFloat					( float *out );
+SI_API si_result si_tryGetDouble				( double *out );
+SI_API si_result si_tryGetLong					( long *out );
+SI_API si_result si_tryGetULong					( unsigned long *out );
+SI_API si_result si_tryGetLongLong				( long long *out );
+SI_API si_result si_tryGetULongLong				( unsigned long long *out );
+SI_API si_result si_tryGetChar					( char *out );
+SI_API si_result si_tryGetBool					( bool *out );
+SI_API si_result si_tryGetLineIn				( const si_charset *cs, si_string *line ); // whole-line validator
+SI_API size_t si_skipLine						( void ); // drop the rest of the line, returns bytes skipped
+
+// === Bounded input ( lo <= x <= hi, checked while parsing ) ===
+SI_API int si_getIntRange						( int lo, int hi );
+SI_API unsigned int si_getUIntRange				( unsigned int lo, unsigned int hi );
+SI_API long si_getLongRange						( long lo, long hi );
+SI_API unsigned long si_getULongRange			( unsigned long lo, unsigned long hi );
+SI_API long long si_getLongLongRange			( long long lo, long long hi );
+SI_API unsigned long long si_getULongLongRange	( unsigned long long lo, unsigned long long hi );
+SI_API float si_getFloatRange					( float lo, float hi );
+SI_API double si_getDoubleRange					( double lo, double hi );
+
+SI_API si_result si_tryGetIntRange					( int lo, int hi, int *out ); // SI_OVERFLOW outside [lo, hi]
+SI_API si_result si_tryGetUIntRange					( unsigned int lo, unsigned int hi, unsigned int *out );
+SI_API si_result si_tryGetLongRange					( long lo, long hi, long *out );
+SI_API si_result si_tryGetULongRange				( unsigned long lo, unsigned long hi, unsigned long *out );
+SI_API si_result si_tryGetLongLongRange				( long long lo, long long hi, long long *out );
+SI_API si_result si_tryGetULongLongRange			( unsigned long long lo, unsigned long long hi, unsigned long long *out );
+SI_API si_result si_tryGetFloatRange				( float lo, float hi, float *out );
+SI_API si_result si_tryGetDoubleRange				( double lo, double hi, double *out );
+
+// === Streaming ( one call for the whole input, see si_reader_forEachLine() ) ===
+SI_API si_result si_forEachLine					( si_lineFn fn, void *ctx );
+SI_API si_result si_forEachLong					( si_longFn fn, void *ctx );
+SI_API si_result si_forEachDouble				( si_doubleFn fn, void *ctx );
+
+// === Prompts ( prompt and retry messages in one write, type-ahead kept ) ===
+SI_API bool si_prompt							( const char *prompt ); // shown before each wait for a line, NULL for none
+SI_API si_result si_promptMany					( const si_promptField *fields, size_t n ); // a form, several answers per line
+
+// === UTF-8 ( validated in the pass that finds the newline ) ===
+SI_API int si_getCodepoint						( void ); // one character per line, like si_getChar()
+SI_API char *si_getCStringUtf8					( void );
+SI_API si_string si_getStringUtf8				( void );
+SI_API si_string si_getStringViewUtf8			( void ); // valid until the next read
+SI_API si_result si_tryGetCodepoint				( uint32_t *out );
+SI_API si_result si_tryGetLineUtf8				( si_string *line ); // SI_INVALID for a line that isn't UTF-8
+
+// === Readers ===
+SI_API si_reader *si_reader_fromFile		( FILE *fp );
+SI_API si_reader *si_reader_fromFd			( int fd );
+SI_API si_reader *si_reader_fromMemory		( const void *data, size_t len );
+SI_API si_reader *si_reader_fromMapped			( int fd ); // mmap regular files, else si_reader_fromFd
+SI_API bool si_mapStdin							( void ); // mmap a redirected stdin before the first read
+SI_API void si_reader_free					( si_reader *r );
+
+SI_API si_reader *si_stdin					( void ); // default reader behind si_get*()
+SI_API si_reader *si_useReader					( si_reader *r ); // per-thread default for si_get*(), NULL for stdin
+SI_API bool si_reader_setLocking				( si_reader *r, bool on ); // hold a lock per getter call
+SI_API bool si_reader_eof					( const si_reader *r );
+SI_API int si_reader_error					( const si_reader *r );
+SI_API bool si_reader_setLineLimit			( si_reader *r, size_t limit );
+SI_API bool si_reader_setAllocator				( si_reader *r, const si_allocator *a );
+SI_API void si_reader_release					( si_reader *r, void *ptr );
+SI_API si_string si_reader_retainString			( si_reader *r, si_string view );
+
+SI_API bool si_reader_setErrorHandler			( si_reader *r, si_errorHandler fn, void *ctx );
+SI_API bool si_reader_setSilent					( si_reader *r, bool silent ); // count errors, print nothing
+SI_API bool si_reader_setErrorRepeatLimit		( si_reader *r, unsigned limit ); // 0 for no limit
+SI_API bool si_reader_setPrompt					( si_reader *r, const char *prompt ); // terminals only, not copied
+SI_API si_errorStats si_reader_errorStats		( const si_reader *r );
+SI_API si_stats si_reader_stats					( const si_reader *r ); // zero unless built with SI_STATS
+SI_API bool si_reader_resetStats				( si_reader *r );
+
+SI_API bool si_reader_setNonBlocking			( si_reader *r, bool on ); // sets O_NONBLOCK on the fd
+SI_API int si_reader_fd							( const si_reader *r ); // for poll/epoll, -1 if none
+SI_API bool si_reader_wouldBlock				( const si_reader *r );
+SI_API si_result si_reader_readLine				( si_reader *r, si_string *line ); // view, never retries
+SI_API size_t si_reader_skipLine				( si_reader *r );
+SI_API si_result si_reader_forEachLine			( si_reader *r, si_lineFn fn, void *ctx ); // views, SI_EOF at the end, SI_OK if fn stopped
+SI_API si_result si_reader_forEachLong			( si_reader *r, si_longFn fn, void *ctx ); // lines that don't parse are skipped
+SI_API si_result si_reader_forEachDouble		( si_reader *r, si_doubleFn fn, void *ctx );
+
+// === Character sets ===
+SI_API bool si_charset_compile					( si_charset *cs, const char *spec ); // "A-Za-z0-9_", "^0-9", ...
+SI_API size_t si_charset_span					( const si_charset *cs, const char *p, size_t len ); // SIMD strspn
+SI_API bool si_utf8_valid						( const char *p, size_t len ); // SIMD, RFC 3629
+
+static inline bool si_charset_has		( const si_charset *cs, unsigned char c ) {
+	return ( cs->bits[ c >> 6 ] >> ( c & 63 )) & 1;
+}
+
+// === Arenas ===
+SI_API si_arena *si_arena_create				( size_t chunkSize ); // 0 for 64 KiB chunks
+SI_API void *si_arena_alloc						( si_arena *a, size_t size );
+SI_API void si_arena_reset						( si_arena *a ); // frees everything, keeps chunks
+SI_API void si_arena_destroy					( si_arena *a );
+SI_API si_allocator si_arena_allocator			( si_arena *a );
+
+// === Reader input handling ===
+SI_API int si_reader_getInt				( si_reader *r );
+SI_API unsigned int si_reader_getUInt		( si_reader *r );
+
+SI_API float si_reader_getFloat				( si_reader *r );
+SI_API double si_reader_getDouble			( si_reader *r );
+
+SI_API long si_reader_getLong				( si_reader *r );
+SI_API unsigned long si_reader_getULong		( si_reader *r );
+SI_API long long si_reader_getLongLong		( si_reader *r );
+SI_API unsigned long long si_reader_getULongLong	( si_reader *r );
+
+SI_API int si_reader_getChar				( si_reader *r );
+SI_API int si_reader_getCharFiltered		( si_reader *r, const char *allowed );
+SI_API int si_reader_getCharIn					( si_reader *r, const si_charset *cs );
+
+SI_API char *si_reader_getCString			( si_reader *r );
+SI_API si_string si_reader_getString		( si_reader *r );
+SI_API si_string si_reader_getStringView	( si_reader *r );
+SI_API char *si_reader_getCStringMax		( si_reader *r, size_t max );
+SI_API si_string si_reader_getStringMax		( si_reader *r, size_t max );
+SI_API si_string si_reader_getStringViewMax		( si_reader *r, size_t max );
+
+SI_API bool si_reader_getBool				( si_reader *r );
+
+SI_API si_result si_reader_tryGetInt			( si_reader *r, int *out );
+SI_API si_result si_reader_tryGetUInt			( si_reader *r, unsigned int *out );
+SI_API si_result si_reader_tryGetFloat			( si_reader *r, float *out );
+SI_API si_result si_reader_tryGetDouble			( si_reader *r, double *out );
+SI_API si_result si_reader_tryGetLong			( si_reader *r, long *out );
+SI_API si_result si_reader_tryGetULong			( si_reader *r, unsigned long *out );
+SI_API si_result si_reader_tryGetLongLong		( si_reader *r, long long *out );
+SI_API si_result si_reader_tryGetULongLong		( si_reader *r, unsigned long long *out );
+SI_API si_result si_reader_tryGetChar			( si_reader *r, char *out );
+SI_API si_result si_reader_tryGetBool			( si_reader *r, bool *out );
+SI_API si_result si_reader_tryGetLineIn			( si_reader *r, const si_charset *cs, si_string *line );
+
+SI_API int si_reader_getCodepoint				( si_reader *r );
+SI_API char *si_reader_getCStringUtf8			( si_reader *r );
+SI_API si_string si_reader_getStringUtf8		( si_reader *r );
+SI_API si_string si_reader_getStringViewUtf8	( si_reader *r );
+SI_API si_result si_reader_tryGetCodepoint		( si_reader *r, uint32_t *out );
+SI_API si_result si_reader_tryGetLineUtf8		( si_reader *r, si_string *line );
+
+SI_API int si_reader_getIntRange						( si_reader *r, int lo, int hi );
+SI_API unsigned int si_reader_getUIntRange				( si_reader *r, unsigned int lo, unsigned int hi );
+SI_API long si_reader_getLongRange						( si_reader *r, long lo, long hi );
+SI_API unsigned long si_reader_getULongRange			( si_reader *r, unsigned long lo, unsigned long hi );
+SI_API long long si_reader_getLongLongRange				( si_reader *r, long long lo, long long hi );
+SI_API unsigned long long si_reader_getULongLongRange	( si_reader *r, unsigned long long lo, unsigned long long hi );
+SI_API float si_reader_getFloatRange					( si_reader *r, float lo, float hi );
+SI_API double si_reader_getDoubleRange					( si_reader *r, double lo, double hi );
+
+SI_API si_result si_reader_tryGetIntRange				( si_reader *r, int lo, int hi, int *out );
+SI_API si_result si_reader_tryGetUIntRange				( si_reader *r, unsigned int lo, unsigned int hi, unsigned int *out );
+SI_API si_result si_reader_tryGetLongRange				( si_reader *r, long lo, long hi, long *out );
+SI_API si_result si_reader_tryGetULongRange				( si_reader *r, unsigned long lo, unsigned long hi, unsigned long *out );
+SI_API si_result si_reader_tryGetLongLongRange			( si_reader *r, long long lo, long long hi, long long *out );
+SI_API si_result si_reader_tryGetULongLongRange			( si_reader *r, unsigned long long lo, unsigned long long hi, unsigned long long *out );
+SI_API si_result si_reader_tryGetFloatRange				( si_reader *r, float lo, float hi, float *out );
+SI_API si_result si_reader_tryGetDoubleRange			( si_reader *r, double lo, double hi, double *out );
+
+// === Batch input ===
+SI_API size_t si_getIntArray					( int *out, size_t n, char delim, si_position *err );
+SI_API size_t si_getUIntArray					( unsigned int *out, size_t n, char delim, si_position *err );
+SI_API size_t si_getLongArray					( long *out, size_t n, char delim, si_position *err );
+SI_API size_t si_getULongArray					( unsigned long *out, size_t n, char delim, si_position *err );
+SI_API size_t si_getLongLongArray				( long long *out, size_t n, char delim, si_position *err );
+SI_API size_t si_getULongLongArray				( unsigned long long *out, size_t n, char delim, si_position *err );
+SI_API size_t si_getFloatArray					( float *out, size_t n, char delim, si_position *err );
+SI_API size_t si_getDoubleArray					( double *out, size_t n, char delim, si_position *err );
+
+SI_API size_t si_reader_getIntArray				( si_reader *r, int *out, size_t n, char delim, si_position *err );
+SI_API size_t si_reader_getUIntArray			( si_reader *r, unsigned int *out, size_t n, char delim, si_position *err );
+SI_API size_t si_reader_getLongArray			( si_reader *r, long *out, size_t n, char delim, si_position *err );
+SI_API size_t si_reader_getULongArray			( si_reader *r, unsigned long *out, size_t n, char delim, si_position *err );
+SI_API size_t si_reader_getLongLongArray		( si_reader *r, long long *out, size_t n, char delim, si_position *err );
+SI_API size_t si_reader_getULongLongArray		( si_reader *r, unsigned long long *out, size_t n, char delim, si_position *err );
+SI_API size_t si_reader_getFloatArray			( si_reader *r, float *out, size_t n, char delim, si_position *err );
+SI_API size_t si_reader_getDoubleArray			( si_reader *r, double *out, size_t n, char delim, si_position *err );
+
+// parse all remaining input of a ( mapped ) reader on several threads, free() the result
+SI_API int *si_reader_parallelGetIntArray	( si_reader *r, char delim, unsigned threads, size_t *count, si_position *err );
+SI_API unsigned int *si_reader_parallelGetUIntArray		( si_reader *r, char delim, unsigned threads, size_t *count, si_position *err );
+SI_API long *si_reader_parallelGetLongArray		( si_reader *r, char delim, unsigned threads, size_t *count, si_position *err );
+SI_API unsigned long *si_reader_parallelGetULongArray	( si_reader *r, char delim, unsigned threads, size_t *count, si_position *err );
+SI_API long long *si_reader_parallelGetLongLongArray	( si_reader *r, char delim, unsigned threads, size_t *count, si_position *err );
+SI_API unsigned long long *si_reader_parallelGetULongLongArray	( si_reader *r, char delim, unsigned threads, size_t *count, si_position *err );
+SI_API float *si_reader_parallelGetFloatArray	( si_reader *r, char delim, unsigned threads, size_t *count, si_position *err );
+SI_API double *si_reader_parallelGetDoubleArray		( si_reader *r, char delim, unsigned threads, size_t *count, si_position *err );
+
+// === Records ===
+SI_API si_result si_getRecord						( char delim, char quote, si_record *rec );
+SI_API si_result si_reader_getRecord				( si_reader *r, char delim, char quote, si_record *rec );
+
+SI_API si_string si_field							( const si_record *rec, size_t i ); // 0-based, { NULL, 0 } if missing
+SI_API si_result si_fieldInt						( const si_record *rec, size_t i, int *out );
+SI_API si_result si_fieldUInt						( const si_record *rec, size_t i, unsigned int *out );
+SI_API si_result si_fieldLong						( const si_record *rec, size_t i, long *out );
+SI_API si_result si_fieldULong						( const si_record *rec, size_t i, unsigned long *out );
+SI_API si_result si_fieldLongLong					( const si_record *rec, size_t i, long long *out );
+SI_API si_result si_fieldULongLong					( const si_record *rec, size_t i, unsigned long long *out );
+SI_API si_result si_fieldFloat						( const si_record *rec, size_t i, float *out );
+SI_API si_result si_fieldDouble						( const si_record *rec, size_t i, double *out );
+
+// === Schemas ===
+SI_API si_schema *si_schema_compile					( const si_fieldDesc *fields, size_t n, char delim, char quote );
+SI_API si_schema *si_schema_fromSignature			( const char *sig, const size_t *offsets, char delim, char quote ); // "i,u,d,s,b"
+SI_API void si_schema_free							( si_schema *schema );
+SI_API si_result si_readStruct						( const si_schema *schema, void *out, size_t *badField );
+SI_API si_result si_reader_readStruct				( si_reader *r, const si_schema *schema, void *out, size_t *badField );
+SI_API si_result si_reader_promptMany				( si_reader *r, const si_promptField *fields, size_t n );
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // SAFEINPUT_H_
+
+#if defined(SAFEINPUT_IMPLEMENTATION) && !defined(SAFEINPUT_IMPLEMENTED_)
+#define SAFEINPUT_IMPLEMENTED_
+
+/**
+ * safeinput.c - version 1.1.0
+ *
+ * Author:   https://github.com/bustyanimebabesdotcom
+ * License:  The Unlicense
+ *
+ * Safe(r) input handling for C.
+ *
+ * This library provides a standalone, portable alternative to `scanf`,
+ * focusing on input validation and buffer overflow prevention.
+ *
+ * It is designed for simplicity, robustness, and use in projects
+ * where `scanf` and `gets` would otherwise be used by people who
+ * unfortunately don't know any better.
+ *
+ * Main safety features:
+ *   - Input length enforcement
+ *   - Graceful EOF handling
+ *   - Error feedback to stderr
+ *   - Non-null-terminated byte-string support
+ *
+ * Phase 2 completed:
+ *   - Implemented si_string (byte-counted, no null terminator)
+ *   - Byte-for-byte `getchar()` loop with bounds checking
+ *
+ * Phase 3:
+ *   - Block-buffered reads from the fd with SIMD newline scanning
+ *   - Span-based SWAR integer parsing ( no strto*, no errno )
+ *   - Correctly rounded float parsing ( Clinger, Eisel-Lemire, big decimal )
+ *   - One per-type parse core shared by every getter family
+ *
+ * TODO:
+ *   - Profile and optimize where sensible
+ *
+ * Use this in any project, commercial or personal.
+ * Attribution is appreciated but not required.
+ *
+ * For more information, see LICENSE or visit <https://unlicense.org/>
+ */
+
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE
+#endif
+
+#define alwaysInline	__attribute__((always_inline)) inline
+#define cold			__attribute__((cold))
+#define unlikely(x)		__builtin_expect(!!(x), 0)
+
+// hot getters, offered to the caller's inliner by the single-header build
+#if !defined(SAFEINPUT_IMPLEMENTATION)
+#define hotApi
+#elif defined(SAFEINPUT_INLINE)
+#define hotApi			SAFEINPUT_INLINE
+#else
+#define hotApi			inline
+#endif
+
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+#include <limits.h>
+#include <errno.h>
+#include <math.h>
+#include <float.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/uio.h>
+#include <sys/ioctl.h>
+#include <pthread.h>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>	// every ISA level, for the target() kernels below
+#define SI_X86			1
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+
+/**
+ * si_reader - block-buffered line source
+ *
+ * Input is pulled from the fd in SI_READ_BLOCK sized chunks and lines are
+ * located with a vectorised newline scan instead of one getchar per byte.
+ * Unread bytes are compacted to the front of the block before a refill, so
+ * a line is always contiguous in memory.
+ *
+ * Memory readers point buf straight at the caller's bytes and start out
+ * at EOF, so they are never compacted or written to. Mapped readers are
+ * memory readers over an mmap() of a regular file, unmapped on free.
+ *
+ * A line longer than the block makes the buffer grow geometrically into
+ * a heap allocation owned by the reader, never past SI_LINE_MAX bytes.
+ *
+ * With locking enabled every public getter holds the reader's recursive
+ * mutex for the whole call ( si_guard ), so each line or batch is read
+ * and parsed atomically: one lock per call rather than one per byte.
+ *
+ * In non-blocking mode a read that would block sets `blocked` instead of
+ * `eof`. A partial line simply stays buffered until the rest arrives, and
+ * a too-long line that is only partly drained sets `skipping` so the next
+ * call carries on discarding it.
+ *
+ * NOTE:	the default reader owns fd 0 directly. Mixing these getters
+ * 			with stdio reads on stdin (fgets, scanf, ...) is not supported,
+ * 			as bytes read ahead by either side are invisible to the other.
+ */
+#define SI_READ_BLOCK	( 64 * 1024 )
+#define SI_PENDING_MAX	256		// retry messages held for the next prompt
+
+struct si_reader {
+	char	*buf;		// block buffer ( or caller memory )
+	size_t	cap;		// size of buf
+	size_t	pos;		// first unread byte
+	size_t	end;		// one past the last valid byte
+	int		fd;			// source file descriptor, -1 if none
+	FILE	*fp;		// stdio source for streams without an fd
+	int		err;		// errno of the last failed read, 0 if none
+	bool	eof;		// source is exhausted ( sticky, like stdio )
+	bool	flushOut;	// flush stdout before blocking ( reading a terminal's stdin )
+	bool	nonBlock;	// fd is O_NONBLOCK, getters return instead of waiting
+	bool	blocked;	// the last refill hit EAGAIN ( reset by every line fetch )
+	bool	skipping;	// still draining a too-long line
+	size_t	base;		// stream offset of buf[0]
+	size_t	lines;		// newlines consumed so far
+	size_t	lineStart;	// stream offset of the current line
+	size_t	lineLimit;	// string getter limit, same meaning as INPUT_BUFFER_SIZE
+	char	*heapBuf;	// grown buffer owned by the reader, NULL if none
+	void	*map;		// mmap()ed file behind buf, NULL if none
+	size_t	mapLen;
+	char	*fieldBuf;	// unescaped quoted fields of the current record
+	size_t	fieldCap;
+	si_allocator alloc;	// string getter allocator, all NULL for malloc/free
+	si_errorHandler onError;	// error sink, NULL for stderr
+	void	*errorCtx;
+	bool	silent;		// count errors but don't report them
+	const char *prompt;	// written before blocking at a line start, NULL for none
+	char	pending[SI_PENDING_MAX];	// messages waiting to go out with the prompt
+	size_t	pendingLen;
+	unsigned repeatLimit;	// consecutive same-kind messages shown, 0 for all
+	unsigned repeats;	// length of the current run of lastKind messages
+	si_error lastKind;
+	si_errorStats stats;
+	pthread_mutex_t *lock;	// held by the getters if set, NULL for lock-free use
+#ifdef SI_STATS
+	si_stats counters;	// hot-path counters, see si_count()
+#endif
+};
+
+static char si_stdinBlock[SI_READ_BLOCK];
+static pthread_mutex_t si_stdinLock = PTHREAD_RECURSIVE_MUTEX_INITIALIZER_NP;
+static si_reader si_stdinReader = {
+	.buf		= si_stdinBlock,
+	.cap		= SI_READ_BLOCK,
+	.fd			= STDIN_FILENO,
+	.flushOut	= true,
+	.lineLimit	= INPUT_BUFFER_SIZE,
+};
+
+
+
+/**
+ * si_guard - hold r's lock ( if it has one ) until the enclosing scope ends
+ *
+ * Uses the cleanup attribute, so every return path unlocks. The mutex is
+ * recursive because getters call each other ( getString -> getStringView ).
+ */
+static alwaysInline si_reader *si_lock ( si_reader *r ) {
+
+	if ( unlikely( r && r->lock )) pthread_mutex_lock( r->lock );
+	return r;
+}
+
+static alwaysInline void si_unlock ( si_reader **r ) {
+
+	if ( unlikely( *r && (*r)->lock )) pthread_mutex_unlock( (*r)->lock );
+}
+
+#define si_guard( r )	si_reader *si_held __attribute__(( cleanup( si_unlock ), unused )) = si_lock( r )
+
+// the default reader of the calling thread, see si_useReader(), initial-exec
+// so the shared library reads it off the thread pointer, not via __tls_get_addr
+static __thread si_reader *si_threadReader __attribute__(( tls_model( "initial-exec" )));
+
+static alwaysInline si_reader *si_current ( void ) {
+
+	return si_threadReader ? si_threadReader : &si_stdinReader;
+}
+
+
+
+/**
+ * si_writeAll - writev() all of iov to fd, carrying on after short writes
+ *
+ * Prompts and messages are best effort, so a failed write is dropped.
+ */
+static cold void si_writeAll ( int fd, struct iovec *iov, int count ) {
+
+	while ( count > 0 ) {
+
+		ssize_t n = writev( fd, iov, count );
+		if ( n < 0 ) {
+			if ( errno == EINTR ) continue;
+			return;
+		}
+
+		for ( ; count > 0 && (size_t)n >= iov->iov_len; iov++, count-- ) n -= (ssize_t)iov->iov_len;
+		if ( count > 0 ) {
+			iov->iov_base = (char *)iov->iov_base + n;
+			iov->iov_len -= (size_t)n;
+		}
+	}
+}
+
+
+
+/**
+ * si_showPending - write the held messages, then msg, in a single writev()
+ *
+ * @msg:		the prompt or a message that can't wait, NULL for none
+ */
+static cold void si_showPending ( si_reader *r, const char *msg ) {
+
+	struct iovec iov[2] = {
+		{ r->pending, r->pendingLen },
+		{ (char *)msg, msg ? strlen( msg ) : 0 },
+	};
+
+	r->pendingLen = 0;
+	if ( iov[0].iov_len || iov[1].iov_len ) si_writeAll( STDERR_FILENO, iov, 2 );
+}
+
+
+
+/**
+ * si_emit - hand a message to the reader's error handler, or to stderr
+ *
+ * While a prompt is set, a retry message is held back if the getter's next
+ * step is the blocking read that shows the prompt ( no further line is
+ * buffered ), so message and prompt cost one write. Anything else goes out
+ * at once, behind whatever is already held.
+ */
+static cold void si_emit ( si_reader *r, si_error kind, const char *msg ) {
+
+	if ( r && r->onError ) {
+		r->onError( r->errorCtx, kind, msg );
+		return;
+	}
+
+	if ( !r || !r->prompt ) {
+		fputs( msg, stderr );
+		return;
+	}
+
+	size_t len = strlen( msg );
+	bool retry = ( kind == SI_ERR_INVALID || kind == SI_ERR_OVERFLOW );
+
+	if ( retry && !r->eof && !r->nonBlock && r->pendingLen + len <= sizeof(r->pending)
+		 && !memchr( r->buf + r->pos, '\n', r->end - r->pos )) {
+		memcpy( r->pending + r->pendingLen, msg, len );
+		r->pendingLen += len;
+	}
+	else si_showPending( r, msg );
+}
+
+
+
+/**
+ * si_report - count an error against the reader and report it
+ *
+ * With a repeat limit set, a run of same-kind messages is cut off after
+ * repeatLimit of them and the rest are only counted. The run is summed up
+ * in one line as soon as a different kind of error shows up, so a flood
+ * of garbage costs one write instead of one per line.
+ *
+ * r may be NULL for errors that don't belong to a reader.
+ */
+static cold void si_report ( si_reader *r, si_error kind, const char *msg ) {
+
+	if ( !r ) {
+		si_emit( r, kind, msg );
+		return;
+	}
+
+	if ( kind == SI_ERR_INVALID ) r->stats.invalid++;
+	else if ( kind == SI_ERR_OVERFLOW ) r->stats.overflow++;
+	else if ( kind == SI_ERR_TOO_LONG ) r->stats.tooLong++;
+
+	if ( r->silent ) return;
+
+	if ( r->repeatLimit ) {
+		if ( r->repeats && kind == r->lastKind ) {
+			if ( r->repeats++ >= r->repeatLimit ) {
+				r->stats.suppressed++;
+				return;
+			}
+		}
+		else {
+			if ( r->repeats > r->repeatLimit ) {
+				char summary[64];
+				snprintf( summary, sizeof(summary), "Last message repeated %u more time%s.\n",
+						  r->repeats - r->repeatLimit, r->repeats - r->repeatLimit == 1 ? "" : "s" );
+				si_emit( r, r->lastKind, summary );
+			}
+			r->lastKind = kind;
+			r->repeats = 1;
+		}
+	}
+
+	si_emit( r, kind, msg );
+}
+
+
+
+/**
+ * Hot-path counters
+ *
+ * Built with -DSI_STATS ( make STATS=1 ), every reader counts bytes,
+ * refills, lines, values parsed, rejects and string allocations, so a slow
+ * consumer can tell a slow source from bad data or parser cost. Without
+ * it si_count() compiles to nothing and the reader carries no counters.
+ */
+#ifdef SI_STATS
+#define si_count( r, field, n )	(( r )->counters.field += ( n ))
+#else
+#define si_count( r, field, n )	((void)( r ))
+#endif
+
+#define si_countReject( r, result )	si_count( r, rejected[ si_rejectOf( result ) ], 1 )
+
+
+
+/**
+ * si_scanByte - find the first byte c in [p, end)
+ *
+ * Short lines and fields are the common case, so the first few
+ * blocks are checked inline with SSE2/NEON compares. Both are baseline
+ * on x86-64 and AArch64, so this needs no -march. Anything longer is
+ * handed to memchr(), which glibc already picks per CPU ( ifunc ) for wide scans.
+ *
+ * returns a pointer to the byte, or NULL if there is none
+ */
+static alwaysInline const char *si_scanByte ( const char *p, const char *end, char c ) {
+
+	const char *inlineEnd = ( end - p > 64 ) ? p + 64 : end;
+
+#if defined(__SSE2__)
+	const __m128i needle = _mm_set1_epi8( c );
+
+	for ( ; inlineEnd - p >= 16; p += 16 ) {
+		unsigned mask = (unsigned)_mm_movemask_epi8( _mm_cmpeq_epi8( _mm_loadu_si128( (const __m128i *)p ), needle ));
+		if ( mask ) return p + __builtin_ctz( mask );
+	}
+#elif defined(__ARM_NEON)
+	const uint8x16_t needle = vdupq_n_u8( (uint8_t)c );
+
+	for ( ; inlineEnd - p >= 16; p += 16 ) {
+		uint8x16_t eq = vceqq_u8( vld1q_u8( (const uint8_t *)p ), needle );
+		uint64_t mask = vget_lane_u64( vreinterpret_u64_u8( vshrn_n_u16( vreinterpretq_u16_u8( eq ), 4 )), 0 );
+		if ( mask ) return p + ( __builtin_ctzll( mask ) >> 2 );
+	}
+#endif
+
+	(void)inlineEnd;
+	if ( p >= end ) return NULL;
+	return memchr( p, c, (size_t)( end - p ));
+}
+
+
+
+static alwaysInline const char *si_scanNewline ( const char *p, const char *end ) {
+
+	return si_scanByte( p, end, '\n' );
+}
+
+
+
+/**
+ * si_growBuffer - double the reader's buffer, up to SI_LINE_MAX bytes
+ *
+ * Only called with the unread bytes already compacted to offset 0.
+ *
+ * returns false if the buffer is at the cap or allocation fails
+ */
+static cold bool si_growBuffer ( si_reader *r ) {
+
+	if ( r->cap >= SI_LINE_MAX ) return false;
+
+	size_t cap = r->cap > SI_LINE_MAX / 2 ? SI_LINE_MAX : r->cap * 2;
+	char *buf = realloc( r->heapBuf, cap );
+	if ( !buf ) return false;
+
+	if ( !r->heapBuf ) memcpy( buf, r->buf, r->end );
+
+	r->heapBuf = r->buf = buf;
+	r->cap = cap;
+	return true;
+}
+
+
+
+/**
+ * si_typedAhead - true if r's fd already holds input, so a read won't wait
+ *
+ * A terminal in canonical mode hands out one line per read(), so answers
+ * typed ahead arrive one refill at a time; without this check each of
+ * them would be prompted for after the fact.
+ */
+static cold bool si_typedAhead ( const si_reader *r ) {
+
+	int n = 0;
+	return r->fd >= 0 && ioctl( r->fd, FIONREAD, &n ) == 0 && n > 0;
+}
+
+
+
+/**
+ * si_refill - compact unread bytes to the front of the block and read more
+ *
+ * Flushes stdout first so prompts without a trailing newline are visible
+ * before we block, matching what stdio does for a line-buffered stdin.
+ * A reader with a prompt then writes it, together with any held error
+ * messages, in one writev() ( see si_reader_setPrompt ).
+ *
+ * returns the number of bytes added, 0 on EOF, read error, when the read
+ * would block ( r->blocked ), or when the buffer is full and can't grow
+ * ( r->eof stays false in the last two cases )
+ */
+static cold size_t si_refill ( si_reader *r ) {
+
+	if ( r->eof ) return 0;
+
+	if ( r->pos ) {
+		memmove( r->buf, r->buf + r->pos, r->end - r->pos );
+		r->base += r->pos;
+		r->end -= r->pos;
+		r->pos = 0;
+	}
+
+	if ( r->end == r->cap && !si_growBuffer( r )) return 0;
+
+	if ( !r->nonBlock ) {
+		if ( r->flushOut || r->prompt ) fflush( stdout );
+		// held messages always, the prompt only if this read starts a line and will wait
+		if ( unlikely( r->prompt || r->pendingLen ))
+			si_showPending( r, r->prompt && !r->end && !r->skipping && !si_typedAhead( r ) ? r->prompt : NULL );
+	}
+
+	ssize_t n;
+
+	if ( r->fp ) {
+		n = (ssize_t)fread_unlocked( r->buf + r->end, 1, r->cap - r->end, r->fp );
+		if ( n == 0 && ferror_unlocked( r->fp )) n = -1;
+	}
+	else {
+		do n = read( r->fd, r->buf + r->end, r->cap - r->end );
+		while ( n < 0 && errno == EINTR );
+	}
+
+	si_count( r, refills, 1 );
+
+	if ( n < 0 && ( errno == EAGAIN || errno == EWOULDBLOCK )) {
+		si_count( r, blocked, 1 );
+		r->blocked = true;
+		return 0;
+	}
+
+	if ( n <= 0 ) {
+		if ( n < 0 ) r->err = errno;
+		r->eof = true;
+		return 0;
+	}
+
+	si_count( r, bytes, (size_t)n );
+	r->end += (size_t)n;
+	return (size_t)n;
+}
+
+
+
+/**
+ * si_consumeLine - mark everything up to buffer offset next as read,
+ * 					where buf[next - 1] is a newline
+ */
+static alwaysInline void si_consumeLine ( si_reader *r, size_t next ) {
+
+	si_count( r, lines, 1 );
+	r->pos = next;
+	r->lines++;
+	r->lineStart = r->base + next;
+}
+
+
+
+/**
+ * si_drainStdin - Drains leftover input from stdin to prevent buffer overflows.
+ * Discards buffered blocks until newline or EOF is encountered
+ * 
+ * Each block is searched with si_scanNewline() and dropped whole, and as
+ * nothing is left unread the refill after it has nothing to compact.
+ *
+ * called by si_nextLine() and si_reader_skipLine(). If a non-blocking read
+ * runs dry first, r->skipping is left set and the next call resumes the drain.
+ *
+ * returns the number of bytes discarded, newline included
+ */
+static cold size_t si_drainStdin ( si_reader *r ) {
+
+	size_t skipped = 0;
+
+	r->skipping = false;
+
+	while ( 1 ) {
+		const char *nl = si_scanNewline( r->buf + r->pos, r->buf + r->end );
+		if ( nl ) {
+			size_t next = (size_t)( nl - r->buf ) + 1;
+			skipped += next - r->pos;
+			si_count( r, drained, next - r->pos );
+			si_consumeLine( r, next );
+			return skipped;
+		}
+
+		skipped += r->end - r->pos;
+		si_count( r, drained, r->end - r->pos );
+		r->pos = r->end;
+		if ( !si_refill( r )) {
+			r->skipping = r->blocked;
+			return skipped;
+		}
+	}
+}
+
+
+
+/**
+ * si_nextLineSlow - si_nextLine() for everything but a whole buffered line
+ *
+ * Refills, partial lines, drains and the final unterminated line, kept
+ * out of line so the fast path stays small enough to inline anywhere.
+ */
+static cold int si_nextLineSlow ( si_reader *r, size_t maxLen, const char **line, size_t *outLen ) {
+
+	size_t scanned = 0;
+
+	r->blocked = false;
+
+	if ( unlikely( r->skipping )) {
+		si_drainStdin( r );
+		if ( r->skipping ) return EOF;
+	}
+
+	while ( 1 ) {
+		const char *start = r->buf + r->pos;
+		const char *nl = si_scanNewline( start + scanned, r->buf + r->end );
+
+		if ( nl ) {
+			size_t len = (size_t)( nl - start );
+			si_consumeLine( r, r->pos + len + 1 );
+			if ( unlikely( len >= maxLen )) {
+				si_count( r, drained, len + 1 );
+				si_count( r, rejected[SI_REJECT_TOO_LONG], 1 );
+				return 1;
+			}
+			*line = start;
+			*outLen = len;
+			return 0;
+		}
+
+		scanned = r->end - r->pos;
+
+		if ( unlikely( scanned >= maxLen )) {
+			si_drainStdin( r );
+			si_count( r, rejected[SI_REJECT_TOO_LONG], 1 );
+			return 1;
+		}
+
+		if ( unlikely( !si_refill( r ))) {
+			// partial line, keep it buffered until the rest arrives
+			if ( r->blocked ) return EOF;
+			if ( unlikely( !r->eof )) {
+				// no room left to buffer the line
+				si_drainStdin( r );
+				si_count( r, rejected[SI_REJECT_TOO_LONG], 1 );
+				return 1;
+			}
+			if ( scanned == 0 ) return EOF;
+			// last line without a trailing newline
+			si_count( r, lines, 1 );
+			*line = r->buf + r->pos;
+			*outLen = scanned;
+			r->pos = r->end;
+			return 0;
+		}
+	}
+}
+
+
+
+/**
+ * si_nextLine - locate the next line in the reader without copying it
+ *
+ * @r:			reader to pull from
+ * @maxLen:		line length limit, lines of maxLen bytes or more are rejected
+ * @line:		receives a pointer to the first byte of the line
+ * @outLen:		receives the line length, excluding the newline
+ *
+ * The returned line stays valid until the next call on the same reader.
+ * The common case, a whole line of fewer than maxLen bytes already in the
+ * buffer, is one scan and a few stores; anything else is si_nextLineSlow().
+ *
+ * Returns:
+ * 		0 - on success
+ * 		1 - on a line that exceeds maxLen ( the rest of it is drained )
+ *	   -1 - on EOF, or with r->blocked set when no full line is buffered yet
+ */
+static alwaysInline int si_nextLine ( si_reader *r, size_t maxLen, const char **line, size_t *outLen ) {
+
+	const char *start = r->buf + r->pos;
+	const char *nl = si_scanNewline( start, r->buf + r->end );
+
+	if ( unlikely( !nl || r->skipping || (size_t)( nl - start ) >= maxLen ))
+		return si_nextLineSlow( r, maxLen, line, outLen );
+
+	size_t len = (size_t)( nl - start );
+	r->blocked = false;
+	si_consumeLine( r, r->pos + len + 1 );
+	*line = start;
+	*outLen = len;
+	return 0;
+}
+
+
+
+/**
+ * si_readLine - fetch the next line from a reader without copying it
+ *
+ * @r:			reader to pull from
+ * @maxLen:		line length limit, same meaning as for si_readByte()
+ * @line:		receives a pointer into the reader's buffer
+ * @outLen:		receives the line length
+ *
+ * The line is not null-terminated and stays valid until the next read.
+ *
+ * Returns:
+ * 		0 - on success
+ * 		1 - on error ( NULL r, line or outLen, maxLen < 1, or line too long )
+ *	   -1 - on EOF
+ */
+static alwaysInline int si_readLine ( si_reader *r, size_t maxLen, const char **line, size_t *outLen ) {
+
+	if ( unlikely( !r || !line || !outLen || maxLen < 1 )) {
+		if ( r ) si_count( r, rejected[SI_REJECT_USAGE], 1 );
+		return 1;
+	}
+
+	*outLen = 0;
+
+	int result = si_nextLine( r, maxLen, line, outLen );
+
+	if ( unlikely( result == 1 )) {
+		si_report( r, SI_ERR_TOO_LONG, "Input exceeding buffer size. Try again.\n" );
+		return 1;
+	}
+
+	return result;
+}
+
+
+
+/**
+ * si_tally - count a failed status getter in the reader's error stats
+ */
+static alwaysInline si_result si_tally ( si_reader *r, si_result status ) {
+
+	if ( status == SI_INVALID ) r->stats.invalid++;
+	else if ( status == SI_OVERFLOW ) r->stats.overflow++;
+	else if ( status == SI_TOO_LONG ) r->stats.tooLong++;
+	return status;
+}
+
+
+
+/**
+ * si_tryLine - si_nextLine() with the result mapped to an si_result
+ *
+ * Never prints, so the status getters can fail quietly.
+ */
+static alwaysInline si_result si_tryLine ( si_reader *r, size_t maxLen, const char **line, size_t *outLen ) {
+
+	*outLen = 0;
+
+	switch ( si_nextLine( r, maxLen, line, outLen )) {
+		case 0:		return SI_OK;
+		case 1:		return si_tally( r, SI_TOO_LONG );
+		default:	return r->blocked ? SI_WOULD_BLOCK : SI_EOF;
+	}
+}
+
+
+
+/**
+ * si_maxToLimit - convert a "longest accepted line" into a si_readLine() limit
+ */
+static alwaysInline size_t si_maxToLimit ( size_t max ) {
+
+	return max >= SI_LINE_MAX ? SI_LINE_MAX : max + 1;
+}
+
+
+
+/**
+ * si_readByte - read up to maxLen bytes from a reader into buffer, 
+ * 					stop at newline or EOF, drain excess input, and report length.
+ * 
+ * @r:			reader to pull from
+ * @buf:		buffer to fill with input characters
+ * @maxLen:		maximum number of bytes to read into buf
+ * @outLen:		pointer to size_t to receive the number of bytes read
+ * 
+ * Returns:
+ * 		0 - on success
+ * 		1 - on error ( NULL r, buf or outLen, or maxLen < 1 )
+ *	   -1 - on EOF ( caller should check and handle appropriately )
+ */
+static alwaysInline int si_readByte ( si_reader *r, char *buf, size_t maxLen, size_t *outLen ) {
+
+	if ( unlikely( !buf )) return 1;
+
+	const char *line;
+	int result = si_readLine( r, maxLen, &line, outLen );
+	if ( result ) return result;
+
+	memcpy( buf, line, *outLen );
+	return 0;
+}
+
+
+
+/**
+ * Integer parsing
+ *
+ * The integer getters parse the line in place as a (ptr, len) span. The
+ * accepted syntax is exactly what strtol()/strtoul() accept in base 10 with
+ * the "C" locale, followed by nothing but the end of the line:
+ *
+ * 		[whitespace] [+|-] digits
+ *
+ * Like the strto* calls, an embedded '\0' ends the number. Digits are
+ * converted eight at a time with SWAR arithmetic, without touching errno.
+ */
+enum {
+	SI_PARSE_OK = 0,
+	SI_PARSE_INVALID,	// no digits, or trailing garbage
+	SI_PARSE_RANGE,		// syntactically fine but out of range
+	SI_PARSE_NEGATIVE,	// '-' in front of an unsigned value
+};
+
+static alwaysInline si_error si_errorKind ( int result ) {
+
+	return result == SI_PARSE_RANGE ? SI_ERR_OVERFLOW : SI_ERR_INVALID;
+}
+
+static alwaysInline si_reject si_rejectOf ( int result ) {
+
+	return result == SI_PARSE_RANGE ? SI_REJECT_RANGE : result == SI_PARSE_NEGATIVE ? SI_REJECT_NEGATIVE : SI_REJECT_SYNTAX;
+}
+
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+#define si_load64le(p)	__builtin_bswap64( si_load64( p ))
+#else
+#define si_load64le(p)	si_load64( p )
+#endif
+
+static alwaysInline uint64_t si_load64 ( const char *p ) {
+
+	uint64_t v;
+	memcpy( &v, p, sizeof(v) );
+	return v;
+}
+
+
+
+/**
+ * si_isEightDigits - true if all eight bytes of a little-endian word are '0'..'9'
+ */
+static alwaysInline bool si_isEightDigits ( uint64_t v ) {
+
+	return ((( v & 0xF0F0F0F0F0F0F0F0ull ) | ((( v + 0x0606060606060606ull ) & 0xF0F0F0F0F0F0F0F0ull ) >> 4 ))
+			== 0x3333333333333333ull );
+}
+
+
+
+/**
+ * si_eightDigits - convert eight ASCII digits ( little-endian word ) to their value
+ */
+static alwaysInline uint32_t si_eightDigits ( uint64_t v ) {
+
+	v -= 0x3030303030303030ull;
+	v = ( v * 10 ) + ( v >> 8 );
+	v = ((( v & 0x000000FF000000FFull ) * ( 100 + ( 1000000ull << 32 ))) +
+		((( v >> 16 ) & 0x000000FF000000FFull ) * ( 1 + ( 10000ull << 32 )))) >> 32;
+	return (uint32_t)v;
+}
+
+
+
+/**
+ * si_isSpace - isspace() for the "C" locale, without the table lookup
+ */
+static alwaysInline bool si_isSpace ( unsigned char c ) {
+
+	return c == ' ' || ( c >= '\t' && c <= '\r' );
+}
+
+
+
+/**
+ * si_parseMagnitude - parse "[ws] [+|-] digits" from a span into an unsigned magnitude
+ *
+ * @p, @len:	the span, not null-terminated
+ * @neg:		receives true if a '-' sign was present
+ * @out:		receives the magnitude ( only meaningful on SI_PARSE_OK )
+ *
+ * returns SI_PARSE_OK, SI_PARSE_INVALID or SI_PARSE_RANGE ( above ULLONG_MAX )
+ */
+static alwaysInline int si_parseMagnitude ( const char *p, size_t len, bool *neg, unsigned long long *out ) {
+
+	const char *end = p + len;
+
+	while ( p < end && si_isSpace( (unsigned char)*p )) p++;
+
+	*neg = false;
+	if ( p < end && ( *p == '-' || *p == '+' )) *neg = ( *p++ == '-' );
+
+	const char *digits = p;
+	while ( p < end && *p == '0' ) p++;
+
+	// up to 19 significant digits always fit, 8 at a time first
+	const char *sig = p;
+	uint64_t value = 0;
+
+	while ( end - p >= 8 && p - sig <= 11 ) {
+		uint64_t word = si_load64le( p );
+		if ( !si_isEightDigits( word )) break;
+		value = value * 100000000ull + si_eightDigits( word );
+		p += 8;
+	}
+
+	bool range = false;
+
+	for ( ; p < end && (unsigned char)( *p - '0' ) < 10; p++ ) {
+		unsigned d = (unsigned)( *p - '0' );
+		if ( p - sig < 19 ) value = value * 10 + d;
+		else if ( unlikely( __builtin_mul_overflow( value, 10, &value ) ||
+							__builtin_add_overflow( value, d, &value ))) range = true;
+	}
+
+	if ( unlikely( p == digits )) return SI_PARSE_INVALID;
+	if ( unlikely( p != end && *p != '\0' )) return SI_PARSE_INVALID;
+	if ( unlikely( range )) return SI_PARSE_RANGE;
+
+	*out = value;
+	return SI_PARSE_OK;
+}
+
+
+
+/**
+ * si_parseSigned - strtoll()-style parse of a span, checked against [min, max]
+ *
+ * returns SI_PARSE_OK, SI_PARSE_INVALID or SI_PARSE_RANGE
+ */
+static alwaysInline int si_parseSigned ( const char *p, size_t len, long long min, long long max, long long *out ) {
+
+	bool neg;
+	unsigned long long mag;
+
+	int result = si_parseMagnitude( p, len, &neg, &mag );
+	if ( result ) return result;
+
+	if ( neg ) {
+		if ( mag > (unsigned long long)-( min + 1 ) + 1 ) return SI_PARSE_RANGE;
+		*out = mag ? -(long long)( mag - 1 ) - 1 : 0;
+	}
+	else {
+		if ( mag > (unsigned long long)max ) return SI_PARSE_RANGE;
+		*out = (long long)mag;
+	}
+
+	return SI_PARSE_OK;
+}
+
+
+
+/**
+ * si_parseUnsigned - strtoull()-style parse of a span, checked against max
+ *
+ * As with strtoul(), a leading '-' negates the magnitude in unsigned
+ * arithmetic rather than being rejected.
+ *
+ * returns SI_PARSE_OK, SI_PARSE_INVALID or SI_PARSE_RANGE
+ */
+static alwaysInline int si_parseUnsigned ( const char *p, size_t len, unsigned long long max, unsigned long long *out ) {
+
+	bool neg;
+	unsigned long long mag;
+
+	int result = si_parseMagnitude( p, len, &neg, &mag );
+	if ( result ) return result;
+
+	if ( mag > max ) return SI_PARSE_RANGE;
+
+	*out = neg ? ( 0 - mag ) & max : mag;
+	return SI_PARSE_OK;
+}
+
+
+
+/**
+ * Floating point parsing
+ *
+ * si_getFloat/si_getDouble parse the span themselves instead of calling
+ * strtof()/strtod(). The accepted syntax matches the strto* calls in the
+ * "C" locale ( decimal and hexadecimal forms ), and results are correctly
+ * rounded to nearest-even. There are three tiers:
+ *
+ * 		1. Clinger's fast path, when the digits and the power of ten are
+ * 		   both exactly representable and one multiply or divide is exact.
+ * 		2. Eisel-Lemire, a 128-bit multiply against a table of powers of
+ * 		   five, which settles nearly every remaining normal result.
+ * 		3. A big-decimal fallback that shifts the digits in base 10 until
+ * 		   64 exact bits and a sticky bit are known.
+ *
+ * Anything strtod() would report as non-finite or ERANGE is rejected with
+ * SI_PARSE_RANGE, including glibc's rule of flagging subnormal results
+ * only when they are inexact.
+ */
+/**
+ * safeinput_pow5.h - 128-bit approximations of 5^q, q in [-342, 308]
+ *
+ * Private to safeinput.c. Each entry is the top 128 bits of 5^q, normalised
+ * so the most significant bit is set ( rounded up for negative q ), as used
+ * by the Eisel-Lemire fast path in si_eiselLemire().
+ *
+ * Generated, do not edit. For q >= 0 the entry is 5^q shifted into
+ * [2^127, 2^128) and truncated. For q < 0 it is 2^b / 5^-q + 1, with b
+ * chosen so the result lands in the same range.
+ */
+
+#ifndef SAFEINPUT_POW5_H_
+#define SAFEINPUT_POW5_H_
+
+#define SI_POW5_MIN		( -342 )
+#define SI_POW5_MAX		308
+
+// { high, low } halves of each 128-bit entry
+static const uint64_t si_pow5[ SI_POW5_MAX - SI_POW5_MIN + 1 ][2] = {
+	{ 0xeef453d6923bd65aull, 0x113faa2906a13b3full },
+	{ 0x9558b4661b6565f8ull, 0x4ac7ca59a424c507ull },
+	{ 0xbaaee17fa23ebf76ull, 0x5d79bcf00d2df649ull },
+	{ 0xe95a99df8ace6f53ull, 0xf4d82c2c107973dcull },
+	{ 0x91d8a02bb6c10594ull, 0x79071b9b8a4be869ull },
+	{ 0xb64ec836a47146f9ull, 0x9748e2826cdee284ull },
+	{ 0xe3e27a444d8d98b7ull, 0xfd1b1b2308169b25ull },
+	{ 0x8e6d8c6ab0787f72ull, 0xfe30f0f5e50e20f7ull },
+	{ 0xb208ef855c969f4full, 0xbdbd2d335e51a935ull },
+	{ 0xde8b2b66b3bc4723ull, 0xad2c788035e61382ull },
+	{ 0x8b16fb203055ac76ull, 0x4c3bcb5021afcc31ull },
+	{ 0xaddcb9e83c6b1793ull, 0xdf4abe242a1bbf3dull },
+	{ 0xd953e8624b85dd78ull, 0xd71d6dad34a2af0dull },
+	{ 0x87d4713d6f33aa6bull, 0x8672648c40e5ad68ull },
+	{ 0xa9c98d8ccb009506ull, 0x680efdaf511f18c2ull },
+	{ 0xd43bf0effdc0ba48ull, 0x0212bd1b2566def2ull },
+	{ 0x84a57695fe98746dull, 0x014bb630f7604b57ull },
+	{ 0xa5ced43b7e3e9188ull, 0x419ea3bd35385e2dull },
+	{ 0xcf42894a5dce35eaull, 0x52064cac828675b9ull },
+	{ 0x818995ce7aa0e1b2ull, 0x7343efebd1940993ull },
+	{ 0xa1ebfb4219491a1full, 0x1014ebe6c5f90bf8ull },
+	{ 0xca66fa129f9b60a6ull, 0xd41a26e077774ef6ull },
+	{ 0xfd00b897478238d0ull, 0x8920b098955522b4ull },
+	{ 0x9e20735e8cb16382ull, 0x55b46e5f5d5535b0ull },
+	{ 0xc5a890362fddbc62ull, 0xeb2189f734aa831dull },
+	{ 0xf712b443bbd52b7bull, 0xa5e9ec7501d523e4ull },
+	{ 0x9a6bb0aa55653b2dull, 0x47b233c92125366eull },
+	{ 0xc1069cd4eabe89f8ull, 0x999ec0bb696e840aull },
+	{ 0xf148440a256e2c76ull, 0xc00670ea43ca250dull },
+	{ 0x96cd2a865764dbcaull, 0x380406926a5e5728ull },
+	{ 0xbc807527ed3e12bcull, 0xc605083704f5ecf2ull },
+	{ 0xeba09271e88d976bull, 0xf7864a44c633682eull },
+	{ 0x93445b8731587ea3ull, 0x7ab3ee6afbe0211dull },
+	{ 0xb8157268fdae9e4cull, 0x5960ea05bad82964ull },
+	{ 0xe61acf033d1a45dfull, 0x6fb92487298e33bdull },
+	{ 0x8fd0c16206306babull, 0xa5d3b6d479f8e056ull },
+	{ 0xb3c4f1ba87bc8696ull, 0x8f48a4899877186cull },
+	{ 0xe0b62e2929aba83cull, 0x331acdabfe94de87ull },
+	{ 0x8c71dcd9ba0b4925ull, 0x9ff0c08b7f1d0b14ull },
+	{ 0xaf8e5410288e1b6full, 0x07ecf0ae5ee44dd9ull },
+	{ 0xdb71e91432b1a24aull, 0xc9e82cd9f69d6150ull },
+	{ 0x892731ac9faf056eull, 0xbe311c083a225cd2ull },
+	{ 0xab70fe17c79ac6caull, 0x6dbd630a48aaf406ull },
+	{ 0xd64d3d9db981787dull, 0x092cbbccdad5b108ull },
+	{ 0x85f0468293f0eb4eull, 0x25bbf56008c58ea5ull },
+	{ 0xa76c582338ed2621ull, 0xaf2af2b80af6f24eull },
+	{ 0xd1476e2c07286faaull, 0x1af5af660db4aee1ull },
+	{ 0x82cca4db847945caull, 0x50d98d9fc890ed4dull },
+	{ 0xa37fce126597973cull, 0xe50ff107bab528a0ull },
+	{ 0xcc5fc196fefd7d0cull, 0x1e53ed49a96272c8ull },
+	{ 0xff77b1fcbebcdc4full, 0x25e8e89c13bb0f7aull },
+	{ 0x9faacf3df73609b1ull, 0x77b191618c54e9acull },
+	{ 0xc795830d75038c1dull, 0xd59df5b9ef6a2417ull },
+	{ 0xf97ae3d0d2446f25ull, 0x4b0573286b44ad1dull },
+	{ 0x9becce62836ac577ull, 0x4ee367f9430aec32ull },
+	{ 0xc2e801fb244576d5ull, 0x229c41f793cda73full },
+	{ 0xf3a20279ed56d48aull, 0x6b43527578c1110full },
+	{ 0x9845418c345644d6ull, 0x830a13896b78aaa9ull },
+	{ 0xbe5691ef416bd60cull, 0x23cc986bc656d553ull },
+	{ 0xedec366b11c6cb8full, 0x2cbfbe86b7ec8aa8ull },
+	{ 0x94b3a202eb1c3f39ull, 0x7bf7d71432f3d6a9ull },
+	{ 0xb9e08a83a5e34f07ull, 0xdaf5ccd93fb0cc53ull },
+	{ 0xe858ad248f5c22c9ull, 0xd1b3400f8f9cff68ull },
+	{ 0x91376c36d99995beull, 0x23100809b9c21fa1ull },
+	{ 0xb58547448ffffb2dull, 0xabd40a0c2832a78aull },
+	{ 0xe2e69915b3fff9f9ull, 0x16c90c8f323f516cull },
+	{ 0x8dd01fad907ffc3bull, 0xae3da7d97f6792e3ull },
+	{ 0xb1442798f49ffb4aull, 0x99cd11cfdf41779cull },
+	{ 0xdd95317f31c7fa1dull, 0x40405643d711d583ull },
+	{ 0x8a7d3eef7f1cfc52ull, 0x482835ea666b2572ull },
+	{ 0xad1c8eab5ee43b66ull, 0xda3243650005eecfull },
+	{ 0xd863b256369d4a40ull, 0x90bed43e40076a82ull },
+	{ 0x873e4f75e2224e68ull, 0x5a7744a6e804a291ull },
+	{ 0xa90de3535aaae202ull, 0x711515d0a205cb36ull },
+	{ 0xd3515c2831559a83ull, 0x0d5a5b44ca873e03ull },
+	{ 0x8412d9991ed58091ull, 0xe858790afe9486c2ull },
+	{ 0xa5178fff668ae0b6ull, 0x626e974dbe39a872ull },
+	{ 0xce5d73ff402d98e3ull, 0xfb0a3d212dc8128full },
+	{ 0x80fa687f881c7f8eull, 0x7ce66634bc9d0b99ull },
+	{ 0xa139029f6a239f72ull, 0x1c1fffc1ebc44e80ull },
+	{ 0xc987434744ac874eull, 0xa327ffb266b56220ull },
+	{ 0xfbe9141915d7a922ull, 0x4bf1ff9f0062baa8ull },
+	{ 0x9d71ac8fada6c9b5ull, 0x6f773fc3603db4a9ull },
+	{ 0xc4ce17b399107c22ull, 0xcb550fb4384d21d3ull },
+	{ 0xf6019da07f549b2bull, 0x7e2a53a146606a48ull },
+	{ 0x99c102844f94e0fbull, 0x2eda7444cbfc426dull },
+	{ 0xc0314325637a1939ull, 0xfa911155fefb5308ull },
+	{ 0xf03d93eebc589f88ull, 0x793555ab7eba27caull },
+	{ 0x96267c7535b763b5ull, 0x4bc1558b2f3458deull },
+	{ 0xbbb01b9283253ca2ull, 0x9eb1aaedfb016f16ull },
+	{ 0xea9c227723ee8bcbull, 0x465e15a979c1cadcull },
+	{ 0x92a1958a7675175full, 0x0bfacd89ec191ec9ull },
+	{ 0xb749faed14125d36ull, 0xcef980ec671f667bull },
+	{ 0xe51c79a85916f484ull, 0x82b7e12780e7401aull },
+	{ 0x8f31cc0937ae58d2ull, 0xd1b2ecb8b0908810ull },
+	{ 0xb2fe3f0b8599ef07ull, 0x861fa7e6dcb4aa15ull },
+	{ 0xdfbdcece67006ac9ull, 0x67a791e093e1d49aull },
+	{ 0x8bd6a141006042bdull, 0xe0c8bb2c5c6d24e0ull },
+	{ 0xaecc49914078536dull, 0x58fae9f773886e18ull },
+	{ 0xda7f5bf590966848ull, 0xaf39a475506a899eull },
+	{ 0x888f99797a5e012dull, 0x6d8406c952429603ull },
+	{ 0xaab37fd7d8f58178ull, 0xc8e5087ba6d33b83ull },
+	{ 0xd5605fcdcf32e1d6ull, 0xfb1e4a9a90880a64ull },
+	{ 0x855c3be0a17fcd26ull, 0x5cf2eea09a55067full },
+	{ 0xa6b34ad8c9dfc06full, 0xf42faa48c0ea481eull },
+	{ 0xd0601d8efc57b08bull, 0xf13b94daf124da26ull },
+	{ 0x823c12795db6ce57ull, 0x76c53d08d6b70858ull },
+	{ 0xa2cb1717b52481edull, 0x54768c4b0c64ca6eull },
+	{ 0xcb7ddcdda26da268ull, 0xa9942f5dcf7dfd09ull },
+	{ 0xfe5d54150b090b02ull, 0xd3f93b35435d7c4cull },
+	{ 0x9efa548d26e5a6e1ull, 0xc47bc5014a1a6dafull },
+	{ 0xc6b8e9b0709f109aull, 0x359ab6419ca1091bull },
+	{ 0xf867241c8cc6d4c0ull, 0xc30163d203c94b62ull },
+	{ 0x9b407691d7fc44f8ull, 0x79e0de63425dcf1dull },
+	{ 0xc21094364dfb5636ull, 0x985915fc12f542e4ull },
+	{ 0xf294b943e17a2bc4ull, 0x3e6f5b7b17b2939dull },
+	{ 0x979cf3ca6cec5b5aull, 0xa705992ceecf9c42ull },
+	{ 0xbd8430bd08277231ull, 0x50c6ff782a838353ull },
+	{ 0xece53cec4a314ebdull, 0xa4f8bf5635246428ull },
+	{ 0x940f4613ae5ed136ull, 0x871b7795e136be99ull },
+	{ 0xb913179899f68584ull, 0x28e2557b59846e3full },
+	{ 0xe757dd7ec07426e5ull, 0x331aeada2fe589cfull },
+	{ 0x9096ea6f3848984full, 0x3ff0d2c85def7621ull },
+	{ 0xb4bca50b065abe63ull, 0x0fed077a756b53a9ull },
+	{ 0xe1ebce4dc7f16dfbull, 0xd3e8495912c62894ull },
+	{ 0x8d3360f09cf6e4bdull, 0x64712dd7abbbd95cull },
+	{ 0xb080392cc4349decull, 0xbd8d794d96aacfb3ull },
+	{ 0xdca04777f541c567ull, 0xecf0d7a0fc5583a0ull },
+	{ 0x89e42caaf9491b60ull, 0xf41686c49db57244ull },
+	{ 0xac5d37d5b79b6239ull, 0x311c2875c522ced5ull },
+	{ 0xd77485cb25823ac7ull, 0x7d633293366b828bull },
+	{ 0x86a8d39ef77164bcull, 0xae5dff9c02033197ull },
+	{ 0xa8530886b54dbdebull, 0xd9f57f830283fdfcull },
+	{ 0xd267caa862a12d66ull, 0xd072df63c324fd7bull },
+	{ 0x8380dea93da4bc60ull, 0x4247cb9e59f71e6dull },
+	{ 0xa46116538d0deb78ull, 0x52d9be85f074e608ull },
+	{ 0xcd795be870516656ull, 0x67902e276c921f8bull },
+	{ 0x806bd9714632dff6ull, 0x00ba1cd8a3db53b6ull },
+	{ 0xa086cfcd97bf97f3ull, 0x80e8a40eccd228a4ull },
+	{ 0xc8a883c0fdaf7df0ull, 0x6122cd128006b2cdull },
+	{ 0xfad2a4b13d1b5d6cull, 0x796b805720085f81ull },
+	{ 0x9cc3a6eec6311a63ull, 0xcbe3303674053bb0ull },
+	{ 0xc3f490aa77bd60fcull, 0xbedbfc4411068a9cull },
+	{ 0xf4f1b4d515acb93bull, 0xee92fb5515482d44ull },
+	{ 0x991711052d8bf3c5ull, 0x751bdd152d4d1c4aull },
+	{ 0xbf5cd54678eef0b6ull, 0xd262d45a78a0635dull },
+	{ 0xef340a98172aace4ull, 0x86fb897116c87c34ull },
+	{ 0x9580869f0e7aac0eull, 0xd45d35e6ae3d4da0ull },
+	{ 0xbae0a846d2195712ull, 0x8974836059cca109ull },
+	{ 0xe998d258869facd7ull, 0x2bd1a438703fc94bull },
+	{ 0x91ff83775423cc06ull, 0x7b6306a34627ddcfull },
+	{ 0xb67f6455292cbf08ull, 0x1a3bc84c17b1d542ull },
+	{ 0xe41f3d6a7377eecaull, 0x20caba5f1d9e4a93ull },
+	{ 0x8e938662882af53eull, 0x547eb47b7282ee9cull },
+	{ 0xb23867fb2a35b28dull, 0xe99e619a4f23aa43ull },
+	{ 0xdec681f9f4c31f31ull, 0x6405fa00e2ec94d4ull },
+	{ 0x8b3c113c38f9f37eull, 0xde83bc408dd3dd04ull },
+	{ 0xae0b158b4738705eull, 0x9624ab50b148d445ull },
+	{ 0xd98ddaee19068c76ull, 0x3badd624dd9b0957ull },
+	{ 0x87f8a8d4cfa417c9ull, 0xe54ca5d70a80e5d6ull },
+	{ 0xa9f6d30a038d1dbcull, 0x5e9fcf4ccd211f4cull },
+	{ 0xd47487cc8470652bull, 0x7647c3200069671full },
+	{ 0x84c8d4dfd2c63f3bull, 0x29ecd9f40041e073ull },
+	{ 0xa5fb0a17c777cf09ull, 0xf468107100525890ull },
+	{ 0xcf79cc9db955c2ccull, 0x7182148d4066eeb4ull },
+	{ 0x81ac1fe293d599bfull, 0xc6f14cd848405530ull },
+	{ 0xa21727db38cb002full, 0xb8ada00e5a506a7cull },
+	{ 0xca9cf1d206fdc03bull, 0xa6d90811f0e4851cull },
+	{ 0xfd442e4688bd304aull, 0x908f4a166d1da663ull },
+	{ 0x9e4a9cec15763e2eull, 0x9a598e4e043287feull },
+	{ 0xc5dd44271ad3cdbaull, 0x40eff1e1853f29fdull },
+	{ 0xf7549530e188c128ull, 0xd12bee59e68ef47cull },
+	{ 0x9a94dd3e8cf578b9ull, 0x82bb74f8301958ceull },
+	{ 0xc13a148e3032d6e7ull, 0xe36a52363c1faf01ull },
+	{ 0xf18899b1bc3f8ca1ull, 0xdc44e6c3cb279ac1ull },
+	{ 0x96f5600f15a7b7e5ull, 0x29ab103a5ef8c0b9ull },
+	{ 0xbcb2b812db11a5deull, 0x7415d448f6b6f0e7ull },
+	{ 0xebdf661791d60f56ull, 0x111b495b3464ad21ull },
+	{ 0x936b9fcebb25c995ull, 0xcab10dd900beec34ull },
+	{ 0xb84687c269ef3bfbull, 0x3d5d514f40eea742ull },
+	{ 0xe65829b3046b0afaull, 0x0cb4a5a3112a5112ull },
+	{ 0x8ff71a0fe2c2e6dcull, 0x47f0e785eaba72abull },
+	{ 0xb3f4e093db73a093ull, 0x59ed216765690f56ull },
+	{ 0xe0f218b8d25088b8ull, 0x306869c13ec3532cull },
+	{ 0x8c974f7383725573ull, 0x1e414218c73a13fbull },
+	{ 0xafbd2350644eeacfull, 0xe5d1929ef90898faull },
+	{ 0xdbac6c247d62a583ull, 0xdf45f746b74abf39ull },
+	{ 0x894bc396ce5da772ull, 0x6b8bba8c328eb783ull },
+	{ 0xab9eb47c81f5114full, 0x066ea92f3f326564ull },
+	{ 0xd686619ba27255a2ull, 0xc80a537b0efefebdull },
+	{ 0x8613fd0145877585ull, 0xbd06742ce95f5f36ull },
+	{ 0xa798fc4196e952e7ull, 0x2c48113823b73704ull },
+	{ 0xd17f3b51fca3a7a0ull, 0xf75a15862ca504c5ull },
+	{ 0x82ef85133de648c4ull, 0x9a984d73dbe722fbull },
+	{ 0xa3ab66580d5fdaf5ull, 0xc13e60d0d2e0ebbaull },
+	{ 0xcc963fee10b7d1b3ull, 0x318df905079926a8ull },
+	{ 0xffbbcfe994e5c61full, 0xfdf17746497f7052ull },
+	{ 0x9fd561f1fd0f9bd3ull, 0xfeb6ea8bedefa633ull },
+	{ 0xc7caba6e7c5382c8ull, 0xfe64a52ee96b8fc0ull },
+	{ 0xf9bd690a1b68637bull, 0x3dfdce7aa3c673b0ull },
+	{ 0x9c1661a651213e2dull, 0x06bea10ca65c084eull },
+	{ 0xc31bfa0fe5698db8ull, 0x486e494fcff30a62ull },
+	{ 0xf3e2f893dec3f126ull, 0x5a89dba3c3efccfaull },
+	{ 0x986ddb5c6b3a76b7ull, 0xf89629465a75e01cull },
+	{ 0xbe89523386091465ull, 0xf6bbb397f1135823ull },
+	{ 0xee2ba6c0678b597full, 0x746aa07ded582e2cull },
+	{ 0x94db483840b717efull, 0xa8c2a44eb4571cdcull },
+	{ 0xba121a4650e4ddebull, 0x92f34d62616ce413ull },
+	{ 0xe896a0d7e51e1566ull, 0x77b020baf9c81d17ull },
+	{ 0x915e2486ef32cd60ull, 0x0ace1474dc1d122eull },
+	{ 0xb5b5ada8aaff80b8ull, 0x0d819992132456baull },
+	{ 0xe3231912d5bf60e6ull, 0x10e1fff697ed6c69ull },
+	{ 0x8df5efabc5979c8full, 0xca8d3ffa1ef463c1ull },
+	{ 0xb1736b96b6fd83b3ull, 0xbd308ff8a6b17cb2ull },
+	{ 0xddd0467c64bce4a0ull, 0xac7cb3f6d05ddbdeull },
+	{ 0x8aa22c0dbef60ee4ull, 0x6bcdf07a423aa96bull },
+	{ 0xad4ab7112eb3929dull, 0x86c16c98d2c953c6ull },
+	{ 0xd89d64d57a607744ull, 0xe871c7bf077ba8b7ull },
+	{ 0x87625f056c7c4a8bull, 0x11471cd764ad4972ull },
+	{ 0xa93af6c6c79b5d2dull, 0xd598e40d3dd89bcfull },
+	{ 0xd389b47879823479ull, 0x4aff1d108d4ec2c3ull },
+	{ 0x843610cb4bf160cbull, 0xcedf722a585139baull },
+	{ 0xa54394fe1eedb8feull, 0xc2974eb4ee658828ull },
+	{ 0xce947a3da6a9273eull, 0x733d226229feea32ull },
+	{ 0x811ccc668829b887ull, 0x0806357d5a3f525full },
+	{ 0xa163ff802a3426a8ull, 0xca07c2dcb0cf26f7ull },
+	{ 0xc9bcff6034c13052ull, 0xfc89b393dd02f0b5ull },
+	{ 0xfc2c3f3841f17c67ull, 0xbbac2078d443ace2ull },
+	{ 0x9d9ba7832936edc0ull, 0xd54b944b84aa4c0dull },
+	{ 0xc5029163f384a931ull, 0x0a9e795e65d4df11ull },
+	{ 0xf64335bcf065d37dull, 0x4d4617b5ff4a16d5ull },
+	{ 0x99ea0196163fa42eull, 0x504bced1bf8e4e45ull },
+	{ 0xc06481fb9bcf8d39ull, 0xe45ec2862f71e1d6ull },
+	{ 0xf07da27a82c37088ull, 0x5d767327bb4e5a4cull },
+	{ 0x964e858c91ba2655ull, 0x3a6a07f8d510f86full },
+	{ 0xbbe226efb628afeaull, 0x890489f70a55368bull },
+	{ 0xeadab0aba3b2dbe5ull, 0x2b45ac74ccea842eull },
+	{ 0x92c8ae6b464fc96full, 0x3b0b8bc90012929dull },
+	{ 0xb77ada0617e3bbcbull, 0x09ce6ebb40173744ull },
+	{ 0xe55990879ddcaabdull, 0xcc420a6a101d0515ull },
+	{ 0x8f57fa54c2a9eab6ull, 0x9fa946824a12232dull },
+	{ 0xb32df8e9f3546564ull, 0x47939822dc96abf9ull },
+	{ 0xdff9772470297ebdull, 0x59787e2b93bc56f7ull },
+	{ 0x8bfbea76c619ef36ull, 0x57eb4edb3c55b65aull },
+	{ 0xaefae51477a06b03ull, 0xede622920b6b23f1ull },
+	{ 0xdab99e59958885c4ull, 0xe95fab368e45ecedull },
+	{ 0x88b402f7fd75539bull, 0x11dbcb0218ebb414ull },
+	{ 0xaae103b5fcd2a881ull, 0xd652bdc29f26a119ull },
+	{ 0xd59944a37c0752a2ull, 0x4be76d3346f0495full },
+	{ 0x857fcae62d8493a5ull, 0x6f70a4400c562ddbull },
+	{ 0xa6dfbd9fb8e5b88eull, 0xcb4ccd500f6bb952ull },
+	{ 0xd097ad07a71f26b2ull, 0x7e2000a41346a7a7ull },
+	{ 0x825ecc24c873782full, 0x8ed400668c0c28c8ull },
+	{ 0xa2f67f2dfa90563bull, 0x728900802f0f32faull },
+	{ 0xcbb41ef979346bcaull, 0x4f2b40a03ad2ffb9ull },
+	{ 0xfea126b7d78186bcull, 0xe2f610c84987bfa8ull },
+	{ 0x9f24b832e6b0f436ull, 0x0dd9ca7d2df4d7c9ull },
+	{ 0xc6ede63fa05d3143ull, 0x91503d1c79720dbbull },
+	{ 0xf8a95fcf88747d94ull, 0x75a44c6397ce912aull },
+	{ 0x9b69dbe1b548ce7cull, 0xc986afbe3ee11abaull },
+	{ 0xc24452da229b021bull, 0xfbe85badce996168ull },
+	{ 0xf2d56790ab41c2a2ull, 0xfae27299423fb9c3ull },
+	{ 0x97c560ba6b0919a5ull, 0xdccd879fc967d41aull },
+	{ 0xbdb6b8e905cb600full, 0x5400e987bbc1c920ull },
+	{ 0xed246723473e3813ull, 0x290123e9aab23b68ull },
+	{ 0x9436c0760c86e30bull, 0xf9a0b6720aaf6521ull },
+	{ 0xb94470938fa89bceull, 0xf808e40e8d5b3e69ull },
+	{ 0xe7958cb87392c2c2ull, 0xb60b1d1230b20e04ull },
+	{ 0x90bd77f3483bb9b9ull, 0xb1c6f22b5e6f48c2ull },
+	{ 0xb4ecd5f01a4aa828ull, 0x1e38aeb6360b1af3ull },
+	{ 0xe2280b6c20dd5232ull, 0x25c6da63c38de1b0ull },
+	{ 0x8d590723948a535full, 0x579c487e5a38ad0eull },
+	{ 0xb0af48ec79ace837ull, 0x2d835a9df0c6d851ull },
+	{ 0xdcdb1b2798182244ull, 0xf8e431456cf88e65ull },
+	{ 0x8a08f0f8bf0f156bull, 0x1b8e9ecb641b58ffull },
+	{ 0xac8b2d36eed2dac5ull, 0xe272467e3d222f3full },
+	{ 0xd7adf884aa879177ull, 0x5b0ed81dcc6abb0full },
+	{ 0x86ccbb52ea94baeaull, 0x98e947129fc2b4e9ull },
+	{ 0xa87fea27a539e9a5ull, 0x3f2398d747b36224ull },
+	{ 0xd29fe4b18e88640eull, 0x8eec7f0d19a03aadull },
+	{ 0x83a3eeeef9153e89ull, 0x1953cf68300424acull },
+	{ 0xa48ceaaab75a8e2bull, 0x5fa8c3423c052dd7ull },
+	{ 0xcdb02555653131b6ull, 0x3792f412cb06794dull },
+	{ 0x808e17555f3ebf11ull, 0xe2bbd88bbee40bd0ull },
+	{ 0xa0b19d2ab70e6ed6ull, 0x5b6aceaeae9d0ec4ull },
+	{ 0xc8de047564d20a8bull, 0xf245825a5a445275ull },
+	{ 0xfb158592be068d2eull, 0xeed6e2f0f0d56712ull },
+	{ 0x9ced737bb6c4183dull, 0x55464dd69685606bull },
+	{ 0xc428d05aa4751e4cull, 0xaa97e14c3c26b886ull },
+	{ 0xf53304714d9265dfull, 0xd53dd99f4b3066a8ull },
+	{ 0x993fe2c6d07b7fabull, 0xe546a8038efe4029ull },
+	{ 0xbf8fdb78849a5f96ull, 0xde98520472bdd033ull },
+	{ 0xef73d256a5c0f77cull, 0x963e66858f6d4440ull },
+	{ 0x95a8637627989aadull, 0xdde7001379a44aa8ull },
+	{ 0xbb127c53b17ec159ull, 0x5560c018580d5d52ull },
+	{ 0xe9d71b689dde71afull, 0xaab8f01e6e10b4a6ull },
+	{ 0x9226712162ab070dull, 0xcab3961304ca70e8ull },
+	{ 0xb6b00d69bb55c8d1ull, 0x3d607b97c5fd0d22ull },
+	{ 0xe45c10c42a2b3b05ull, 0x8cb89a7db77c506aull },
+	{ 0x8eb98a7a9a5b04e3ull, 0x77f3608e92adb242ull },
+	{ 0xb267ed1940f1c61cull, 0x55f038b237591ed3ull },
+	{ 0xdf01e85f912e37a3ull, 0x6b6c46dec52f6688ull },
+	{ 0x8b61313bbabce2c6ull, 0x2323ac4b3b3da015ull },
+	{ 0xae397d8aa96c1b77ull, 0xabec975e0a0d081aull },
+	{ 0xd9c7dced53c72255ull, 0x96e7bd358c904a21ull },
+	{ 0x881cea14545c7575ull, 0x7e50d64177da2e54ull },
+	{ 0xaa242499697392d2ull, 0xdde50bd1d5d0b9e9ull },
+	{ 0xd4ad2dbfc3d07787ull, 0x955e4ec64b44e864ull },
+	{ 0x84ec3c97da624ab4ull, 0xbd5af13bef0b113eull },
+	{ 0xa6274bbdd0fadd61ull, 0xecb1ad8aeacdd58eull },
+	{ 0xcfb11ead453994baull, 0x67de18eda5814af2ull },
+	{ 0x81ceb32c4b43fcf4ull, 0x80eacf948770ced7ull },
+	{ 0xa2425ff75e14fc31ull, 0xa1258379a94d028dull },
+	{ 0xcad2f7f5359a3b3eull, 0x096ee45813a04330ull },
+	{ 0xfd87b5f28300ca0dull, 0x8bca9d6e188853fcull },
+	{ 0x9e74d1b791e07e48ull, 0x775ea264cf55347eull },
+	{ 0xc612062576589ddaull, 0x95364afe032a819eull },
+	{ 0xf79687aed3eec551ull, 0x3a83ddbd83f52205ull },
+	{ 0x9abe14cd44753b52ull, 0xc4926a9672793543ull },
+	{ 0xc16d9a0095928a27ull, 0x75b7053c0f178294ull },
+	{ 0xf1c90080baf72cb1ull, 0x5324c68b12dd6339ull },
+	{ 0x971da05074da7beeull, 0xd3f6fc16ebca5e04ull },
+	{ 0xbce5086492111aeaull, 0x88f4bb1ca6bcf585ull },
+	{ 0xec1e4a7db69561a5ull, 0x2b31e9e3d06c32e6ull },
+	{ 0x9392ee8e921d5d07ull, 0x3aff322e62439fd0ull },
+	{ 0xb877aa3236a4b449ull, 0x09befeb9fad487c3ull },
+	{ 0xe69594bec44de15bull, 0x4c2ebe687989a9b4ull },
+	{ 0x901d7cf73ab0acd9ull, 0x0f9d37014bf60a11ull },
+	{ 0xb424dc35095cd80full, 0x538484c19ef38c95ull },
+	{ 0xe12e13424bb40e13ull, 0x2865a5f206b06fbaull },
+	{ 0x8cbccc096f5088cbull, 0xf93f87b7442e45d4ull },
+	{ 0xafebff0bcb24aafeull, 0xf78f69a51539d749ull },
+	{ 0xdbe6fecebdedd5beull, 0xb573440e5a884d1cull },
+	{ 0x89705f4136b4a597ull, 0x31680a88f8953031ull },
+	{ 0xabcc77118461cefcull, 0xfdc20d2b36ba7c3eull },
+	{ 0xd6bf94d5e57a42bcull, 0x3d32907604691b4dull },
+	{ 0x8637bd05af6c69b5ull, 0xa63f9a49c2c1b110ull },
+	{ 0xa7c5ac471b478423ull, 0x0fcf80dc33721d54ull },
+	{ 0xd1b71758e219652bull, 0xd3c36113404ea4a9ull },
+	{ 0x83126e978d4fdf3bull, 0x645a1cac083126eaull },
+	{ 0xa3d70a3d70a3d70aull, 0x3d70a3d70a3d70a4ull },
+	{ 0xccccccccccccccccull, 0xcccccccccccccccdull },
+	{ 0x8000000000000000ull, 0x0000000000000000ull },
+	{ 0xa000000000000000ull, 0x0000000000000000ull },
+	{ 0xc800000000000000ull, 0x0000000000000000ull },
+	{ 0xfa00000000000000ull, 0x0000000000000000ull },
+	{ 0x9c40000000000000ull, 0x0000000000000000ull },
+	{ 0xc350000000000000ull, 0x0000000000000000ull },
+	{ 0xf424000000000000ull, 0x0000000000000000ull },
+	{ 0x9896800000000000ull, 0x0000000000000000ull },
+	{ 0xbebc200000000000ull, 0x0000000000000000ull },
+	{ 0xee6b280000000000ull, 0x0000000000000000ull },
+	{ 0x9502f90000000000ull, 0x0000000000000000ull },
+	{ 0xba43b74000000000ull, 0x0000000000000000ull },
+	{ 0xe8d4a51000000000ull, 0x0000000000000000ull },
+	{ 0x9184e72a00000000ull, 0x0000000000000000ull },
+	{ 0xb5e620f480000000ull, 0x0000000000000000ull },
+	{ 0xe35fa931a0000000ull, 0x0000000000000000ull },
+	{ 0x8e1bc9bf04000000ull, 0x0000000000000000ull },
+	{ 0xb1a2bc2ec5000000ull, 0x0000000000000000ull },
+	{ 0xde0b6b3a76400000ull, 0x0000000000000000ull },
+	{ 0x8ac7230489e80000ull, 0x0000000000000000ull },
+	{ 0xad78ebc5ac620000ull, 0x0000000000000000ull },
+	{ 0xd8d726b7177a8000ull, 0x0000000000000000ull },
+	{ 0x878678326eac9000ull, 0x0000000000000000ull },
+	{ 0xa968163f0a57b400ull, 0x0000000000000000ull },
+	{ 0xd3c21bcecceda100ull, 0x0000000000000000ull },
+	{ 0x84595161401484a0ull, 0x0000000000000000ull },
+	{ 0xa56fa5b99019a5c8ull, 0x0000000000000000ull },
+	{ 0xcecb8f27f4200f3aull, 0x0000000000000000ull },
+	{ 0x813f3978f8940984ull, 0x4000000000000000ull },
+	{ 0xa18f07d736b90be5ull, 0x5000000000000000ull },
+	{ 0xc9f2c9cd04674edeull, 0xa400000000000000ull },
+	{ 0xfc6f7c4045812296ull, 0x4d00000000000000ull },
+	{ 0x9dc5ada82b70b59dull, 0xf020000000000000ull },
+	{ 0xc5371912364ce305ull, 0x6c28000000000000ull },
+	{ 0xf684df56c3e01bc6ull, 0xc732000000000000ull },
+	{ 0x9a130b963a6c115cull, 0x3c7f400000000000ull },
+	{ 0xc097ce7bc90715b3ull, 0x4b9f100000000000ull },
+	{ 0xf0bdc21abb48db20ull, 0x1e86d40000000000ull },
+	{ 0x96769950b50d88f4ull, 0x1314448000000000ull },
+	{ 0xbc143fa4e250eb31ull, 0x17d955a000000000ull },
+	{ 0xeb194f8e1ae525fdull, 0x5dcfab0800000000ull },
+	{ 0x92efd1b8d0cf37beull, 0x5aa1cae500000000ull },
+	{ 0xb7abc627050305adull, 0xf14a3d9e40000000ull },
+	{ 0xe596b7b0c643c719ull, 0x6d9ccd05d0000000ull },
+	{ 0x8f7e32ce7bea5c6full, 0xe4820023a2000000ull },
+	{ 0xb35dbf821ae4f38bull, 0xdda2802c8a800000ull },
+	{ 0xe0352f62a19e306eull, 0xd50b2037ad200000ull },
+	{ 0x8c213d9da502de45ull, 0x4526f422cc340000ull },
+	{ 0xaf298d050e4395d6ull, 0x9670b12b7f410000ull },
+	{ 0xdaf3f04651d47b4cull, 0x3c0cdd765f114000ull },
+	{ 0x88d8762bf324cd0full, 0xa5880a69fb6ac800ull },
+	{ 0xab0e93b6efee0053ull, 0x8eea0d047a457a00ull },
+	{ 0xd5d238a4abe98068ull, 0x72a4904598d6d880ull },
+	{ 0x85a36366eb71f041ull, 0x47a6da2b7f864750ull },
+	{ 0xa70c3c40a64e6c51ull, 0x999090b65f67d924ull },
+	{ 0xd0cf4b50cfe20765ull, 0xfff4b4e3f741cf6dull },
+	{ 0x82818f1281ed449full, 0xbff8f10e7a8921a4ull },
+	{ 0xa321f2d7226895c7ull, 0xaff72d52192b6a0dull },
+	{ 0xcbea6f8ceb02bb39ull, 0x9bf4f8a69f764490ull },
+	{ 0xfee50b7025c36a08ull, 0x02f236d04753d5b4ull },
+	{ 0x9f4f2726179a2245ull, 0x01d762422c946590ull },
+	{ 0xc722f0ef9d80aad6ull, 0x424d3ad2b7b97ef5ull },
+	{ 0xf8ebad2b84e0d58bull, 0xd2e0898765a7deb2ull },
+	{ 0x9b934c3b330c8577ull, 0x63cc55f49f88eb2full },
+	{ 0xc2781f49ffcfa6d5ull, 0x3cbf6b71c76b25fbull },
+	{ 0xf316271c7fc3908aull, 0x8bef464e3945ef7aull },
+	{ 0x97edd871cfda3a56ull, 0x97758bf0e3cbb5acull },
+	{ 0xbde94e8e43d0c8ecull, 0x3d52eeed1cbea317ull },
+	{ 0xed63a231d4c4fb27ull, 0x4ca7aaa863ee4bddull },
+	{ 0x945e455f24fb1cf8ull, 0x8fe8caa93e74ef6aull },
+	{ 0xb975d6b6ee39e436ull, 0xb3e2fd538e122b44ull },
+	{ 0xe7d34c64a9c85d44ull, 0x60dbbca87196b616ull },
+	{ 0x90e40fbeea1d3a4aull, 0xbc8955e946fe31cdull },
+	{ 0xb51d13aea4a488ddull, 0x6babab6398bdbe41ull },
+	{ 0xe264589a4dcdab14ull, 0xc696963c7eed2dd1ull },
+	{ 0x8d7eb76070a08aecull, 0xfc1e1de5cf543ca2ull },
+	{ 0xb0de65388cc8ada8ull, 0x3b25a55f43294bcbull },
+	{ 0xdd15fe86affad912ull, 0x49ef0eb713f39ebeull },
+	{ 0x8a2dbf142dfcc7abull, 0x6e3569326c784337ull },
+	{ 0xacb92ed9397bf996ull, 0x49c2c37f07965404ull },
+	{ 0xd7e77a8f87daf7fbull, 0xdc33745ec97be906ull },
+	{ 0x86f0ac99b4e8dafdull, 0x69a028bb3ded71a3ull },
+	{ 0xa8acd7c0222311bcull, 0xc40832ea0d68ce0cull },
+	{ 0xd2d80db02aabd62bull, 0xf50a3fa490c30190ull },
+	{ 0x83c7088e1aab65dbull, 0x792667c6da79e0faull },
+	{ 0xa4b8cab1a1563f52ull, 0x577001b891185938ull },
+	{ 0xcde6fd5e09abcf26ull, 0xed4c0226b55e6f86ull },
+	{ 0x80b05e5ac60b6178ull, 0x544f8158315b05b4ull },
+	{ 0xa0dc75f1778e39d6ull, 0x696361ae3db1c721ull },
+	{ 0xc913936dd571c84cull, 0x03bc3a19cd1e38e9ull },
+	{ 0xfb5878494ace3a5full, 0x04ab48a04065c723ull },
+	{ 0x9d174b2dcec0e47bull, 0x62eb0d64283f9c76ull },
+	{ 0xc45d1df942711d9aull, 0x3ba5d0bd324f8394ull },
+	{ 0xf5746577930d6500ull, 0xca8f44ec7ee36479ull },
+	{ 0x9968bf6abbe85f20ull, 0x7e998b13cf4e1ecbull },
+	{ 0xbfc2ef456ae276e8ull, 0x9e3fedd8c321a67eull },
+	{ 0xefb3ab16c59b14a2ull, 0xc5cfe94ef3ea101eull },
+	{ 0x95d04aee3b80ece5ull, 0xbba1f1d158724a12ull },
+	{ 0xbb445da9ca61281full, 0x2a8a6e45ae8edc97ull },
+	{ 0xea1575143cf97226ull, 0xf52d09d71a3293bdull },
+	{ 0x924d692ca61be758ull, 0x593c2626705f9c56ull },
+	{ 0xb6e0c377cfa2e12eull, 0x6f8b2fb00c77836cull },
+	{ 0xe498f455c38b997aull, 0x0b6dfb9c0f956447ull },
+	{ 0x8edf98b59a373fecull, 0x4724bd4189bd5eacull },
+	{ 0xb2977ee300c50fe7ull, 0x58edec91ec2cb657ull },
+	{ 0xdf3d5e9bc0f653e1ull, 0x2f2967b66737e3edull },
+	{ 0x8b865b215899f46cull, 0xbd79e0d20082ee74ull },
+	{ 0xae67f1e9aec07187ull, 0xecd8590680a3aa11ull },
+	{ 0xda01ee641a708de9ull, 0xe80e6f4820cc9495ull },
+	{ 0x884134fe908658b2ull, 0x3109058d147fdcddull },
+	{ 0xaa51823e34a7eedeull, 0xbd4b46f0599fd415ull },
+	{ 0xd4e5e2cdc1d1ea96ull, 0x6c9e18ac7007c91aull },
+	{ 0x850fadc09923329eull, 0x03e2cf6bc604ddb0ull },
+	{ 0xa6539930bf6bff45ull, 0x84db8346b786151cull },
+	{ 0xcfe87f7cef46ff16ull, 0xe612641865679a63ull },
+	{ 0x81f14fae158c5f6eull, 0x4fcb7e8f3f60c07eull },
+	{ 0xa26da3999aef7749ull, 0xe3be5e330f38f09dull },
+	{ 0xcb090c8001ab551cull, 0x5cadf5bfd3072cc5ull },
+	{ 0xfdcb4fa002162a63ull, 0x73d9732fc7c8f7f6ull },
+	{ 0x9e9f11c4014dda7eull, 0x2867e7fddcdd9afaull },
+	{ 0xc646d63501a1511dull, 0xb281e1fd541501b8ull },
+	{ 0xf7d88bc24209a565ull, 0x1f225a7ca91a4226ull },
+	{ 0x9ae757596946075full, 0x3375788de9b06958ull },
+	{ 0xc1a12d2fc3978937ull, 0x0052d6b1641c83aeull },
+	{ 0xf209787bb47d6b84ull, 0xc0678c5dbd23a49aull },
+	{ 0x9745eb4d50ce6332ull, 0xf840b7ba963646e0ull },
+	{ 0xbd176620a501fbffull, 0xb650e5a93bc3d898ull },
+	{ 0xec5d3fa8ce427affull, 0xa3e51f138ab4cebeull },
+	{ 0x93ba47c980e98cdfull, 0xc66f336c36b10137ull },
+	{ 0xb8a8d9bbe123f017ull, 0xb80b0047445d4184ull },
+	{ 0xe6d3102ad96cec1dull, 0xa60dc059157491e5ull },
+	{ 0x9043ea1ac7e41392ull, 0x87c89837ad68db2full },
+	{ 0xb454e4a179dd1877ull, 0x29babe4598c311fbull },
+	{ 0xe16a1dc9d8545e94ull, 0xf4296dd6fef3d67aull },
+	{ 0x8ce2529e2734bb1dull, 0x1899e4a65f58660cull },
+	{ 0xb01ae745b101e9e4ull, 0x5ec05dcff72e7f8full },
+	{ 0xdc21a1171d42645dull, 0x76707543f4fa1f73ull },
+	{ 0x899504ae72497ebaull, 0x6a06494a791c53a8ull },
+	{ 0xabfa45da0edbde69ull, 0x0487db9d17636892ull },
+	{ 0xd6f8d7509292d603ull, 0x45a9d2845d3c42b6ull },
+	{ 0x865b86925b9bc5c2ull, 0x0b8a2392ba45a9b2ull },
+	{ 0xa7f26836f282b732ull, 0x8e6cac7768d7141eull },
+	{ 0xd1ef0244af2364ffull, 0x3207d795430cd926ull },
+	{ 0x8335616aed761f1full, 0x7f44e6bd49e807b8ull },
+	{ 0xa402b9c5a8d3a6e7ull, 0x5f16206c9c6209a6ull },
+	{ 0xcd036837130890a1ull, 0x36dba887c37a8c0full },
+	{ 0x802221226be55a64ull, 0xc2494954da2c9789ull },
+	{ 0xa02aa96b06deb0fdull, 0xf2db9baa10b7bd6cull },
+	{ 0xc83553c5c8965d3dull, 0x6f92829494e5acc7ull },
+	{ 0xfa42a8b73abbf48cull, 0xcb772339ba1f17f9ull },
+	{ 0x9c69a97284b578d7ull, 0xff2a760414536efbull },
+	{ 0xc38413cf25e2d70dull, 0xfef5138519684abaull },
+	{ 0xf46518c2ef5b8cd1ull, 0x7eb258665fc25d69ull },
+	{ 0x98bf2f79d5993802ull, 0xef2f773ffbd97a61ull },
+	{ 0xbeeefb584aff8603ull, 0xaafb550ffacfd8faull },
+	{ 0xeeaaba2e5dbf6784ull, 0x95ba2a53f983cf38ull },
+	{ 0x952ab45cfa97a0b2ull, 0xdd945a747bf26183ull },
+	{ 0xba756174393d88dfull, 0x94f971119aeef9e4ull },
+	{ 0xe912b9d1478ceb17ull, 0x7a37cd5601aab85dull },
+	{ 0x91abb422ccb812eeull, 0xac62e055c10ab33aull },
+	{ 0xb616a12b7fe617aaull, 0x577b986b314d6009ull },
+	{ 0xe39c49765fdf9d94ull, 0xed5a7e85fda0b80bull },
+	{ 0x8e41ade9fbebc27dull, 0x14588f13be847307ull },
+	{ 0xb1d219647ae6b31cull, 0x596eb2d8ae258fc8ull },
+	{ 0xde469fbd99a05fe3ull, 0x6fca5f8ed9aef3bbull },
+	{ 0x8aec23d680043beeull, 0x25de7bb9480d5854ull },
+	{ 0xada72ccc20054ae9ull, 0xaf561aa79a10ae6aull },
+	{ 0xd910f7ff28069da4ull, 0x1b2ba1518094da04ull },
+	{ 0x87aa9aff79042286ull, 0x90fb44d2f05d0842ull },
+	{ 0xa99541bf57452b28ull, 0x353a1607ac744a53ull },
+	{ 0xd3fa922f2d1675f2ull, 0x42889b8997915ce8ull },
+	{ 0x847c9b5d7c2e09b7ull, 0x69956135febada11ull },
+	{ 0xa59bc234db398c25ull, 0x43fab9837e699095ull },
+	{ 0xcf02b2c21207ef2eull, 0x94f967e45e03f4bbull },
+	{ 0x8161afb94b44f57dull, 0x1d1be0eebac278f5ull },
+	{ 0xa1ba1ba79e1632dcull, 0x6462d92a69731732ull },
+	{ 0xca28a291859bbf93ull, 0x7d7b8f7503cfdcfeull },
+	{ 0xfcb2cb35e702af78ull, 0x5cda735244c3d43eull },
+	{ 0x9defbf01b061adabull, 0x3a0888136afa64a7ull },
+	{ 0xc56baec21c7a1916ull, 0x088aaa1845b8fdd0ull },
+	{ 0xf6c69a72a3989f5bull, 0x8aad549e57273d45ull },
+	{ 0x9a3c2087a63f6399ull, 0x36ac54e2f678864bull },
+	{ 0xc0cb28a98fcf3c7full, 0x84576a1bb416a7ddull },
+	{ 0xf0fdf2d3f3c30b9full, 0x656d44a2a11c51d5ull },
+	{ 0x969eb7c47859e743ull, 0x9f644ae5a4b1b325ull },
+	{ 0xbc4665b596706114ull, 0x873d5d9f0dde1feeull },
+	{ 0xeb57ff22fc0c7959ull, 0xa90cb506d155a7eaull },
+	{ 0x9316ff75dd87cbd8ull, 0x09a7f12442d588f2ull },
+	{ 0xb7dcbf5354e9beceull, 0x0c11ed6d538aeb2full },
+	{ 0xe5d3ef282a242e81ull, 0x8f1668c8a86da5faull },
+	{ 0x8fa475791a569d10ull, 0xf96e017d694487bcull },
+	{ 0xb38d92d760ec4455ull, 0x37c981dcc395a9acull },
+	{ 0xe070f78d3927556aull, 0x85bbe253f47b1417ull },
+	{ 0x8c469ab843b89562ull, 0x93956d7478ccec8eull },
+	{ 0xaf58416654a6babbull, 0x387ac8d1970027b2ull },
+	{ 0xdb2e51bfe9d0696aull, 0x06997b05fcc0319eull },
+	{ 0x88fcf317f22241e2ull, 0x441fece3bdf81f03ull },
+	{ 0xab3c2fddeeaad25aull, 0xd527e81cad7626c3ull },
+	{ 0xd60b3bd56a5586f1ull, 0x8a71e223d8d3b074ull },
+	{ 0x85c7056562757456ull, 0xf6872d5667844e49ull },
+	{ 0xa738c6bebb12d16cull, 0xb428f8ac016561dbull },
+	{ 0xd106f86e69d785c7ull, 0xe13336d701beba52ull },
+	{ 0x82a45b450226b39cull, 0xecc0024661173473ull },
+	{ 0xa34d721642b06084ull, 0x27f002d7f95d0190ull },
+	{ 0xcc20ce9bd35c78a5ull, 0x31ec038df7b441f4ull },
+	{ 0xff290242c83396ceull, 0x7e67047175a15271ull },
+	{ 0x9f79a169bd203e41ull, 0x0f0062c6e984d386ull },
+	{ 0xc75809c42c684dd1ull, 0x52c07b78a3e60868ull },
+	{ 0xf92e0c3537826145ull, 0xa7709a56ccdf8a82ull },
+	{ 0x9bbcc7a142b17ccbull, 0x88a66076400bb691ull },
+	{ 0xc2abf989935ddbfeull, 0x6acff893d00ea435ull },
+	{ 0xf356f7ebf83552feull, 0x0583f6b8c4124d43ull },
+	{ 0x98165af37b2153deull, 0xc3727a337a8b704aull },
+	{ 0xbe1bf1b059e9a8d6ull, 0x744f18c0592e4c5cull },
+	{ 0xeda2ee1c7064130cull, 0x1162def06f79df73ull },
+	{ 0x9485d4d1c63e8be7ull, 0x8addcb5645ac2ba8ull },
+	{ 0xb9a74a0637ce2ee1ull, 0x6d953e2bd7173692ull },
+	{ 0xe8111c87c5c1ba99ull, 0xc8fa8db6ccdd0437ull },
+	{ 0x910ab1d4db9914a0ull, 0x1d9c9892400a22a2ull },
+	{ 0xb54d5e4a127f59c8ull, 0x2503beb6d00cab4bull },
+	{ 0xe2a0b5dc971f303aull, 0x2e44ae64840fd61dull },
+	{ 0x8da471a9de737e24ull, 0x5ceaecfed289e5d2ull },
+	{ 0xb10d8e1456105dadull, 0x7425a83e872c5f47ull },
+	{ 0xdd50f1996b947518ull, 0xd12f124e28f77719ull },
+	{ 0x8a5296ffe33cc92full, 0x82bd6b70d99aaa6full },
+	{ 0xace73cbfdc0bfb7bull, 0x636cc64d1001550bull },
+	{ 0xd8210befd30efa5aull, 0x3c47f7e05401aa4eull },
+	{ 0x8714a775e3e95c78ull, 0x65acfaec34810a71ull },
+	{ 0xa8d9d1535ce3b396ull, 0x7f1839a741a14d0dull },
+	{ 0xd31045a8341ca07cull, 0x1ede48111209a050ull },
+	{ 0x83ea2b892091e44dull, 0x934aed0aab460432ull },
+	{ 0xa4e4b66b68b65d60ull, 0xf81da84d5617853full },
+	{ 0xce1de40642e3f4b9ull, 0x36251260ab9d668eull },
+	{ 0x80d2ae83e9ce78f3ull, 0xc1d72b7c6b426019ull },
+	{ 0xa1075a24e4421730ull, 0xb24cf65b8612f81full },
+	{ 0xc94930ae1d529cfcull, 0xdee033f26797b627ull },
+	{ 0xfb9b7cd9a4a7443cull, 0x169840ef017da3b1ull },
+	{ 0x9d412e0806e88aa5ull, 0x8e1f289560ee864eull },
+	{ 0xc491798a08a2ad4eull, 0xf1a6f2bab92a27e2ull },
+	{ 0xf5b5d7ec8acb58a2ull, 0xae10af696774b1dbull },
+	{ 0x9991a6f3d6bf1765ull, 0xacca6da1e0a8ef29ull },
+	{ 0xbff610b0cc6edd3full, 0x17fd090a58d32af3ull },
+	{ 0xeff394dcff8a948eull, 0xddfc4b4cef07f5b0ull },
+	{ 0x95f83d0a1fb69cd9ull, 0x4abdaf101564f98eull },
+	{ 0xbb764c4ca7a4440full, 0x9d6d1ad41abe37f1ull },
+	{ 0xea53df5fd18d5513ull, 0x84c86189216dc5edull },
+	{ 0x92746b9be2f8552cull, 0x32fd3cf5b4e49bb4ull },
+	{ 0xb7118682dbb66a77ull, 0x3fbc8c33221dc2a1ull },
+	{ 0xe4d5e82392a40515ull, 0x0fabaf3feaa5334aull },
+	{ 0x8f05b1163ba6832dull, 0x29cb4d87f2a7400eull },
+	{ 0xb2c71d5bca9023f8ull, 0x743e20e9ef511012ull },
+	{ 0xdf78e4b2bd342cf6ull, 0x914da9246b255416ull },
+	{ 0x8bab8eefb6409c1aull, 0x1ad089b6c2f7548eull },
+	{ 0xae9672aba3d0c320ull, 0xa184ac2473b529b1ull },
+	{ 0xda3c0f568cc4f3e8ull, 0xc9e5d72d90a2741eull },
+	{ 0x8865899617fb1871ull, 0x7e2fa67c7a658892ull },
+	{ 0xaa7eebfb9df9de8dull, 0xddbb901b98feeab7ull },
+	{ 0xd51ea6fa85785631ull, 0x552a74227f3ea565ull },
+	{ 0x8533285c936b35deull, 0xd53a88958f87275full },
+	{ 0xa67ff273b8460356ull, 0x8a892abaf368f137ull },
+	{ 0xd01fef10a657842cull, 0x2d2b7569b0432d85ull },
+	{ 0x8213f56a67f6b29bull, 0x9c3b29620e29fc73ull },
+	{ 0xa298f2c501f45f42ull, 0x8349f3ba91b47b8full },
+	{ 0xcb3f2f7642717713ull, 0x241c70a936219a73ull },
+	{ 0xfe0efb53d30dd4d7ull, 0xed238cd383aa0110ull },
+	{ 0x9ec95d1463e8a506ull, 0xf4363804324a40aaull },
+	{ 0xc67bb4597ce2ce48ull, 0xb143c6053edcd0d5ull },
+	{ 0xf81aa16fdc1b81daull, 0xdd94b7868e94050aull },
+	{ 0x9b10a4e5e9913128ull, 0xca7cf2b4191c8326ull },
+	{ 0xc1d4ce1f63f57d72ull, 0xfd1c2f611f63a3f0ull },
+	{ 0xf24a01a73cf2dccfull, 0xbc633b39673c8cecull },
+	{ 0x976e41088617ca01ull, 0xd5be0503e085d813ull },
+	{ 0xbd49d14aa79dbc82ull, 0x4b2d8644d8a74e18ull },
+	{ 0xec9c459d51852ba2ull, 0xddf8e7d60ed1219eull },
+	{ 0x93e1ab8252f33b45ull, 0xcabb90e5c942b503ull },
+	{ 0xb8da1662e7b00a17ull, 0x3d6a751f3b936243ull },
+	{ 0xe7109bfba19c0c9dull, 0x0cc512670a783ad4ull },
+	{ 0x906a617d450187e2ull, 0x27fb2b80668b24c5ull },
+	{ 0xb484f9dc9641e9daull, 0xb1f9f660802dedf6ull },
+	{ 0xe1a63853bbd26451ull, 0x5e7873f8a0396973ull },
+	{ 0x8d07e33455637eb2ull, 0xdb0b487b6423e1e8ull },
+	{ 0xb049dc016abc5e5full, 0x91ce1a9a3d2cda62ull },
+	{ 0xdc5c5301c56b75f7ull, 0x7641a140cc7810fbull },
+	{ 0x89b9b3e11b6329baull, 0xa9e904c87fcb0a9dull },
+	{ 0xac2820d9623bf429ull, 0x546345fa9fbdcd44ull },
+	{ 0xd732290fbacaf133ull, 0xa97c177947ad4095ull },
+	{ 0x867f59a9d4bed6c0ull, 0x49ed8eabcccc485dull },
+	{ 0xa81f301449ee8c70ull, 0x5c68f256bfff5a74ull },
+	{ 0xd226fc195c6a2f8cull, 0x73832eec6fff3111ull },
+	{ 0x83585d8fd9c25db7ull, 0xc831fd53c5ff7eabull },
+	{ 0xa42e74f3d032f525ull, 0xba3e7ca8b77f5e55ull },
+	{ 0xcd3a1230c43fb26full, 0x28ce1bd2e55f35ebull },
+	{ 0x80444b5e7aa7cf85ull, 0x7980d163cf5b81b3ull },
+	{ 0xa0555e361951c366ull, 0xd7e105bcc332621full },
+	{ 0xc86ab5c39fa63440ull, 0x8dd9472bf3fefaa7ull },
+	{ 0xfa856334878fc150ull, 0xb14f98f6f0feb951ull },
+	{ 0x9c935e00d4b9d8d2ull, 0x6ed1bf9a569f33d3ull },
+	{ 0xc3b8358109e84f07ull, 0x0a862f80ec4700c8ull },
+	{ 0xf4a642e14c6262c8ull, 0xcd27bb612758c0faull },
+	{ 0x98e7e9cccfbd7dbdull, 0x8038d51cb897789cull },
+	{ 0xbf21e44003acdd2cull, 0xe0470a63e6bd56c3ull },
+	{ 0xeeea5d5004981478ull, 0x1858ccfce06cac74ull },
+	{ 0x95527a5202df0ccbull, 0x0f37801e0c43ebc8ull },
+	{ 0xbaa718e68396cffdull, 0xd30560258f54e6baull },
+	{ 0xe950df20247c83fdull, 0x47c6b82ef32a2069ull },
+	{ 0x91d28b7416cdd27eull, 0x4cdc331d57fa5441ull },
+	{ 0xb6472e511c81471dull, 0xe0133fe4adf8e952ull },
+	{ 0xe3d8f9e563a198e5ull, 0x58180fddd97723a6ull },
+	{ 0x8e679c2f5e44ff8full, 0x570f09eaa7ea7648ull },
+};
+
+#endif // SAFEINPUT_POW5_H_
+
+// Clinger's path needs float and double arithmetic done in their own precision
+#if FLT_EVAL_METHOD == 0 || FLT_EVAL_METHOD == 16
+#define SI_CLINGER		1
+#else
+#define SI_CLINGER		0
+#endif
+
+#if defined(__SIZEOF_INT128__)
+__extension__ typedef unsigned __int128 si_u128;
+#endif
+
+typedef struct si_floatFormat {
+	int		mantBits;	// explicit mantissa bits
+	int		bias;		// exponent bias
+	int		infPower;	// biased exponent of infinity
+	int		minPow10;	// below 1e(minPow10) any digits round to zero
+	int		maxPow10;	// above 1e(maxPow10) any digits overflow
+	int		minEven;	// q range where Eisel-Lemire can land exactly
+	int		maxEven;	// on a halfway point between two floats
+} si_floatFormat;
+
+static const si_floatFormat si_binary64 = { 52, 1023, 0x7FF, -342, 308, -4, 23 };
+static const si_floatFormat si_binary32 = { 23, 127, 0xFF, -64, 38, -17, 10 };
+
+// the decimal form of a number, as split out by si_scanReal()
+typedef struct si_decimal {
+	uint64_t	w;			// first 19 significant digits
+	int64_t		q;			// power of ten applied to w
+	bool		many;		// nonzero digits were dropped after the first 19
+	bool		neg;
+	const char	*digits;	// mantissa text, for the slow path
+	const char	*digitsEnd;
+	int64_t		exp10;		// explicit exponent, for the slow path
+} si_decimal;
+
+
+
+/**
+ * si_mul64 - full 64x64 -> 128 bit multiply, returns the high half
+ */
+static alwaysInline uint64_t si_mul64 ( uint64_t a, uint64_t b, uint64_t *lo ) {
+
+#if defined(__SIZEOF_INT128__)
+	si_u128 p = (si_u128)a * b;
+	*lo = (uint64_t)p;
+	return (uint64_t)( p >> 64 );
+#else
+	uint64_t aLo = (uint32_t)a, aHi = a >> 32;
+	uint64_t bLo = (uint32_t)b, bHi = b >> 32;
+	uint64_t ll = aLo * bLo, lh = aLo * bHi, hl = aHi * bLo, hh = aHi * bHi;
+	uint64_t mid = ( ll >> 32 ) + (uint32_t)lh + (uint32_t)hl;
+	*lo = ( mid << 32 ) | (uint32_t)ll;
+	return hh + ( lh >> 32 ) + ( hl >> 32 ) + ( mid >> 32 );
+#endif
+}
+
+
+
+/**
+ * si_roundBinary - round ( m + sticky ) * 2^e2 to the nearest float of format f
+ *
+ * @m:			nonzero mantissa, any alignment
+ * @e2:			binary exponent of m's lowest bit
+ * @sticky:		true if the exact value is slightly above m * 2^e2
+ * @bits:		receives the encoded magnitude
+ *
+ * Mirrors glibc's ERANGE rules: overflow always fails, a subnormal or zero
+ * result fails only when inexact, and tininess is judged after rounding
+ * as if the exponent range were unbounded.
+ *
+ * returns SI_PARSE_OK or SI_PARSE_RANGE
+ */
+static int si_roundBinary ( uint64_t m, int64_t e2, bool sticky, const si_floatFormat *f, uint64_t *bits ) {
+
+	int lz = __builtin_clzll( m );
+	m <<= lz;
+
+	int64_t e = e2 - lz + 63;	// value is in [2^e, 2^(e+1))
+	int64_t emin = 1 - f->bias;
+	int64_t keep = f->mantBits + 1;
+
+	if ( e < emin ) keep -= emin - e;
+
+	uint64_t q, rem, half;
+
+	if ( keep < 0 ) {
+		q = 0; rem = 1; half = 2;	// below half the smallest subnormal
+	}
+	else if ( keep == 0 ) {
+		q = 0; rem = m; half = 1ull << 63;
+	}
+	else {
+		int shift = 64 - (int)keep;
+		q = m >> shift;
+		rem = m & (( 1ull << shift ) - 1 );
+		half = 1ull << ( shift - 1 );
+	}
+
+	bool inexact = rem || sticky;
+	q += ( rem > half || ( rem == half && ( sticky || ( q & 1 ))));
+
+	if ( e >= emin ) {
+		if ( q >> ( f->mantBits + 1 )) {
+			q >>= 1;
+			e++;
+		}
+
+		int64_t biased = e + f->bias;
+		if ( biased >= f->infPower ) return SI_PARSE_RANGE;
+
+		*bits = ( (uint64_t)biased << f->mantBits ) | ( q & (( 1ull << f->mantBits ) - 1 ));
+		return SI_PARSE_OK;
+	}
+
+	// subnormal, zero, or rounded up to the smallest normal ( q == 2^mantBits )
+	if ( inexact ) {
+		bool tiny = true;
+
+		if ( e == emin - 1 ) {
+			int shift = 63 - f->mantBits;
+			uint64_t full = m >> shift;
+			uint64_t r = m & (( 1ull << shift ) - 1 );
+			uint64_t h = 1ull << ( shift - 1 );
+			full += ( r > h || ( r == h && ( sticky || ( full & 1 ))));
+			tiny = !( full >> ( f->mantBits + 1 ));
+		}
+
+		if ( tiny ) return SI_PARSE_RANGE;
+	}
+
+	*bits = q;
+	return SI_PARSE_OK;
+}
+
+
+
+/**
+ * si_eiselLemire - compute w * 10^q for a normal result from the pow5 table
+ *
+ * @w:			nonzero decimal significand
+ * @q:			power of ten, within [f->minPow10, f->maxPow10]
+ * @bits:		receives the encoded magnitude
+ *
+ * Returns:
+ * 		SI_PARSE_OK		- bits holds the correctly rounded result
+ * 		SI_PARSE_RANGE	- the result overflows
+ * 		-1				- undecided ( subnormal or ambiguous ), use the slow path
+ */
+static alwaysInline int si_eiselLemire ( uint64_t w, int64_t q, const si_floatFormat *f, uint64_t *bits ) {
+
+	int lz = __builtin_clzll( w );
+	w <<= lz;
+
+	const uint64_t *pow5 = si_pow5[ q - SI_POW5_MIN ];
+	uint64_t lo;
+	uint64_t hi = si_mul64( w, pow5[0], &lo );
+
+	// the low bits below the mantissa + 3 guard bits are all ones: refine with the next 64 bits
+	uint64_t precisionMask = 0xFFFFFFFFFFFFFFFFull >> ( f->mantBits + 3 );
+	if (( hi & precisionMask ) == precisionMask ) {
+		uint64_t lo2;
+		uint64_t hi2 = si_mul64( w, pow5[1], &lo2 );
+		(void)lo2;
+		lo += hi2;
+		if ( hi2 > lo ) hi++;
+		if ( unlikely( lo == 0xFFFFFFFFFFFFFFFFull && ( q < -27 || q > 55 ))) return -1;
+	}
+
+	int upper = (int)( hi >> 63 );
+	int shift = upper + 64 - f->mantBits - 3;
+	uint64_t mant = hi >> shift;
+	int64_t power2 = ((( 152170 + 65536 ) * q ) >> 16 ) + 63 + upper - lz + f->bias;
+
+	if ( power2 <= 0 ) return -1;
+
+	// a product ending exactly on a halfway point rounds to even, not up
+	if ( lo <= 1 && q >= f->minEven && q <= f->maxEven && ( mant & 3 ) == 1 && ( mant << shift ) == hi )
+		mant &= ~1ull;
+
+	mant += mant & 1;
+	mant >>= 1;
+
+	if ( mant >= ( 2ull << f->mantBits )) {
+		mant = 1ull << f->mantBits;
+		power2++;
+	}
+
+	if ( power2 >= f->infPower ) return SI_PARSE_RANGE;
+
+	*bits = ( (uint64_t)power2 << f->mantBits ) | ( mant & (( 1ull << f->mantBits ) - 1 ));
+	return SI_PARSE_OK;
+}
+
+
+
+/**
+ * si_hpd - high precision decimal for the slow path
+ *
+ * Holds 0.d[0]d[1]...d[nd-1] * 10^dp with up to SI_HPD_DIGITS digits, which
+ * is enough to settle any halfway case of a double. Digits past that are
+ * only remembered through the trunc flag.
+ */
+#define SI_HPD_DIGITS	800
+#define SI_HPD_SHIFT	60	// largest shift that can't overflow the 64-bit accumulator
+
+typedef struct si_hpd {
+	int				nd;		// number of digits
+	int64_t			dp;		// decimal point position
+	bool			trunc;	// nonzero digits were discarded
+	unsigned char	d[ SI_HPD_DIGITS + 20 ];
+} si_hpd;
+
+static alwaysInline void si_hpdTrim ( si_hpd *a ) {
+
+	while ( a->nd > 0 && a->d[ a->nd - 1 ] == 0 ) a->nd--;
+	if ( a->nd == 0 ) a->dp = 0;
+}
+
+// divide by 2^k, k <= SI_HPD_SHIFT
+static void si_hpdShiftRight ( si_hpd *a, unsigned k ) {
+
+	int r = 0, w = 0;
+	uint64_t n = 0;
+
+	for ( ; ( n >> k ) == 0; r++ ) {
+		if ( r >= a->nd ) {
+			if ( n == 0 ) {
+				a->nd = 0;
+				return;
+			}
+			while (( n >> k ) == 0 ) {
+				n *= 10;
+				r++;
+			}
+			break;
+		}
+		n = n * 10 + a->d[r];
+	}
+
+	a->dp -= r - 1;
+
+	uint64_t mask = ( 1ull << k ) - 1;
+
+	for ( ; r < a->nd; r++ ) {
+		a->d[ w++ ] = (unsigned char)( n >> k );
+		n = ( n & mask ) * 10 + a->d[r];
+	}
+
+	while ( n > 0 ) {
+		unsigned char dig = (unsigned char)( n >> k );
+		if ( w < SI_HPD_DIGITS ) a->d[ w++ ] = dig;
+		else if ( dig ) a->trunc = true;
+		n = ( n & mask ) * 10;
+	}
+
+	a->nd = w;
+	si_hpdTrim( a );
+}
+
+// multiply by 2^k, k <= SI_HPD_SHIFT ( 2^60 has 19 digits, so at most 19 new ones )
+static void si_hpdShiftLeft ( si_hpd *a, unsigned k ) {
+
+	int r = a->nd;
+	int w = a->nd + 19;
+	int top = w;
+	uint64_t n = 0;
+
+	while ( r-- > 0 ) {
+		n += (uint64_t)a->d[r] << k;
+		a->d[ --w ] = (unsigned char)( n % 10 );
+		n /= 10;
+	}
+
+	while ( n > 0 ) {
+		a->d[ --w ] = (unsigned char)( n % 10 );
+		n /= 10;
+	}
+
+	int count = top - w;
+	memmove( a->d, a->d + w, (size_t)count );
+	a->dp += count - a->nd;
+
+	if ( count > SI_HPD_DIGITS ) {
+		for ( int i = SI_HPD_DIGITS; i < count; i++ )
+			if ( a->d[i] ) a->trunc = true;
+		count = SI_HPD_DIGITS;
+	}
+
+	a->nd = count;
+	si_hpdTrim( a );
+}
+
+static void si_hpdShift ( si_hpd *a, int k ) {
+
+	for ( ; k > SI_HPD_SHIFT; k -= SI_HPD_SHIFT ) si_hpdShiftLeft( a, SI_HPD_SHIFT );
+	for ( ; k < -SI_HPD_SHIFT; k += SI_HPD_SHIFT ) si_hpdShiftRight( a, SI_HPD_SHIFT );
+
+	if ( k > 0 ) si_hpdShiftLeft( a, (unsigned)k );
+	else if ( k < 0 ) si_hpdShiftRight( a, (unsigned)-k );
+}
+
+
+
+/**
+ * si_slowDecimal - exact conversion of a scanned decimal through si_hpd
+ *
+ * returns SI_PARSE_OK or SI_PARSE_RANGE
+ */
+static cold int si_slowDecimal ( const si_decimal *dec, const si_floatFormat *f, uint64_t *bits ) {
+
+	// powers of two that keep the shifted value within one decimal digit of [0.5, 1)
+	static const unsigned char powtab[] = { 1, 3, 6, 9, 13, 16, 19, 23, 26 };
+
+	si_hpd a;
+	a.nd = 0;
+	a.dp = 0;
+	a.trunc = false;
+
+	bool dot = false;
+
+	for ( const char *p = dec->digits; p < dec->digitsEnd; p++ ) {
+		if ( *p == '.' ) {
+			dot = true;
+			continue;
+		}
+
+		unsigned char d = (unsigned char)( *p - '0' );
+		if ( a.nd == 0 && d == 0 ) {
+			if ( dot ) a.dp--;
+			continue;
+		}
+
+		if ( !dot ) a.dp++;
+		if ( a.nd < SI_HPD_DIGITS ) a.d[ a.nd++ ] = d;
+		else if ( d ) a.trunc = true;
+	}
+
+	si_hpdTrim( &a );
+	a.dp += dec->exp10;
+
+	if ( a.dp > f->maxPow10 + 1 ) return SI_PARSE_RANGE;
+	if ( a.dp < f->minPow10 ) return SI_PARSE_RANGE;	// rounds to zero
+
+	int64_t e2 = 0;
+
+	while ( a.dp > 0 ) {
+		int n = a.dp >= (int64_t)sizeof(powtab) ? 27 : powtab[ a.dp ];
+		si_hpdShift( &a, -n );
+		e2 += n;
+	}
+
+	while ( a.dp < 0 || ( a.dp == 0 && a.d[0] < 5 )) {
+		int n = -a.dp >= (int64_t)sizeof(powtab) ? 27 : powtab[ -a.dp ];
+		si_hpdShift( &a, n );
+		e2 -= n;
+	}
+
+	// value is now in [0.5, 1): pull 64 exact bits into the integer part
+	si_hpdShift( &a, 64 );
+	e2 -= 64;
+
+	uint64_t m = 0;
+	int i = 0;
+	for ( ; i < a.dp && i < a.nd; i++ ) m = m * 10 + a.d[i];
+	for ( ; i < a.dp; i++ ) m *= 10;
+
+	return si_roundBinary( m, e2, a.trunc || a.nd > a.dp, f, bits );
+}
+
+
+
+/**
+ * si_parseHex - hexadecimal float body after "0x": hexdigits [. hexdigits] [p [+|-] digits]
+ *
+ * returns SI_PARSE_OK, SI_PARSE_INVALID or SI_PARSE_RANGE
+ */
+static cold int si_parseHex ( const char *p, const char *end, const si_floatFormat *f, uint64_t *bits ) {
+
+	uint64_t m = 0;
+	int64_t e2 = 0;
+	int sig = 0;
+	bool sticky = false, any = false, dot = false;
+
+	for ( ; p < end; p++ ) {
+		unsigned d;
+		unsigned char c = (unsigned char)*p;
+
+		if ( c == '.' && !dot ) {
+			dot = true;
+			continue;
+		}
+
+		if ( (unsigned)( c - '0' ) < 10 ) d = (unsigned)( c - '0' );
+		else if ( (unsigned)(( c | 0x20 ) - 'a' ) < 6 ) d = (unsigned)(( c | 0x20 ) - 'a' ) + 10;
+		else break;
+
+		any = true;
+		if ( m == 0 && d == 0 ) {
+			if ( dot ) e2 -= 4;
+			continue;
+		}
+
+		if ( sig < 16 ) {
+			m = ( m << 4 ) | d;
+			sig++;
+			if ( dot ) e2 -= 4;
+		}
+		else {
+			sticky |= d != 0;
+			if ( !dot ) e2 += 4;
+		}
+	}
+
+	if ( !any ) return SI_PARSE_INVALID;
+
+	if ( p < end && ( *p | 0x20 ) == 'p' ) {
+		const char *e = p + 1;
+		bool eneg = false;
+		if ( e < end && ( *e == '-' || *e == '+' )) eneg = ( *e++ == '-' );
+
+		if ( e < end && (unsigned char)( *e - '0' ) < 10 ) {
+			int64_t x = 0;
+			for ( ; e < end && (unsigned char)( *e - '0' ) < 10; e++ )
+				if ( x < 100000 ) x = x * 10 + ( *e - '0' );
+			e2 += eneg ? -x : x;
+			p = e;
+		}
+	}
+
+	if ( p != end && *p != '\0' ) return SI_PARSE_INVALID;
+
+	if ( m == 0 ) {
+		*bits = 0;
+		return SI_PARSE_OK;
+	}
+
+	return si_roundBinary( m, e2, sticky, f, bits );
+}
+
+
+
+/**
+ * si_scanReal - split "[ws] [+|-] digits [. digits] [e [+|-] digits]" into a si_decimal
+ *
+ * Hex floats are converted right away through si_parseHex(), in which case
+ * *hex is set and bits holds the result.
+ *
+ * returns SI_PARSE_OK, SI_PARSE_INVALID or SI_PARSE_RANGE
+ */
+static alwaysInline int si_scanReal ( const char *p, size_t len, si_decimal *dec, const si_floatFormat *f, bool *hex, uint64_t *bits ) {
+
+	const char *end = p + len;
+
+	while ( p < end && si_isSpace( (unsigned char)*p )) p++;
+
+	dec->neg = false;
+	if ( p < end && ( *p == '-' || *p == '+' )) dec->neg = ( *p++ == '-' );
+
+	*hex = false;
+	if ( unlikely( end - p >= 2 && p[0] == '0' && ( p[1] | 0x20 ) == 'x' )) {
+		*hex = true;
+		return si_parseHex( p + 2, end, f, bits );
+	}
+
+	uint64_t w = 0;
+	int64_t q = 0;
+	int sig = 0;
+	bool many = false, any = false;
+
+	dec->digits = p;
+
+	for ( ; p < end && (unsigned char)( *p - '0' ) < 10; p++ ) {
+		unsigned d = (unsigned)( *p - '0' );
+		any = true;
+		if ( sig == 0 && d == 0 ) continue;
+		if ( sig < 19 ) {
+			w = w * 10 + d;
+			sig++;
+		}
+		else {
+			q++;
+			many |= d != 0;
+		}
+	}
+
+	if ( p < end && *p == '.' ) {
+		p++;
+		for ( ; p < end && (unsigned char)( *p - '0' ) < 10; p++ ) {
+			unsigned d = (unsigned)( *p - '0' );
+			any = true;
+			if ( sig == 0 && d == 0 ) {
+				q--;
+				continue;
+			}
+			if ( sig < 19 ) {
+				w = w * 10 + d;
+				sig++;
+				q--;
+			}
+			else many |= d != 0;
+		}
+	}
+
+	if ( unlikely( !any )) return SI_PARSE_INVALID;
+
+	dec->digitsEnd = p;
+	dec->exp10 = 0;
+
+	if ( p < end && ( *p | 0x20 ) == 'e' ) {
+		const char *e = p + 1;
+		bool eneg = false;
+		if ( e < end && ( *e == '-' || *e == '+' )) eneg = ( *e++ == '-' );
+
+		if ( e < end && (unsigned char)( *e - '0' ) < 10 ) {
+			int64_t x = 0;
+			for ( ; e < end && (unsigned char)( *e - '0' ) < 10; e++ )
+				if ( x < 100000 ) x = x * 10 + ( *e - '0' );
+			dec->exp10 = eneg ? -x : x;
+			p = e;
+		}
+	}
+
+	if ( unlikely( p != end && *p != '\0' )) return SI_PARSE_INVALID;
+
+	dec->w = w;
+	dec->q = q + dec->exp10;
+	dec->many = many;
+	return SI_PARSE_OK;
+}
+
+
+
+/**
+ * si_decimalToBinary - tiers 2 and 3 for a scanned, nonzero decimal
+ *
+ * returns SI_PARSE_OK or SI_PARSE_RANGE
+ */
+static alwaysInline int si_decimalToBinary ( const si_decimal *dec, const si_floatFormat *f, uint64_t *bits ) {
+
+	if ( dec->q > f->maxPow10 ) return SI_PARSE_RANGE;
+	if ( dec->q < f->minPow10 ) return SI_PARSE_RANGE;	// nonzero digits that round to zero
+
+	int result = si_eiselLemire( dec->w, dec->q, f, bits );
+
+	// with dropped digits the value lies in ( w, w + 1 ) * 10^q: both ends must agree
+	if ( result == SI_PARSE_OK && dec->many ) {
+		uint64_t upper;
+		if ( si_eiselLemire( dec->w + 1, dec->q, f, &upper ) != SI_PARSE_OK || upper != *bits ) result = -1;
+	}
+
+	if ( unlikely( result < 0 )) return si_slowDecimal( dec, f, bits );
+	return result;
+}
+
+
+
+/**
+ * si_parseDouble - strtod()-compatible parse of a span into a finite double
+ *
+ * returns SI_PARSE_OK, SI_PARSE_INVALID or SI_PARSE_RANGE
+ */
+static alwaysInline int si_parseDouble ( const char *p, size_t len, double *out ) {
+
+	static const double pow10[] = {
+		1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+		1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22,
+	};
+
+	si_decimal dec;
+	uint64_t bits = 0;
+	bool hex;
+
+	int result = si_scanReal( p, len, &dec, &si_binary64, &hex, &bits );
+	if ( result ) return result;
+
+	if ( !hex ) {
+		if ( dec.w == 0 ) bits = 0;
+#if SI_CLINGER
+		else if ( !dec.many && dec.w <= ( 1ull << 53 ) && dec.q >= -22 && dec.q <= 22 ) {
+			double d = (double)dec.w;
+			d = dec.q < 0 ? d / pow10[ -dec.q ] : d * pow10[ dec.q ];
+			*out = dec.neg ? -d : d;
+			return SI_PARSE_OK;
+		}
+#endif
+		else if (( result = si_decimalToBinary( &dec, &si_binary64, &bits ))) return result;
+	}
+
+	if ( dec.neg ) bits |= 1ull << 63;
+	memcpy( out, &bits, sizeof(*out) );
+	return SI_PARSE_OK;
+}
+
+
+
+/**
+ * si_parseFloat - strtof()-compatible parse of a span into a finite float
+ *
+ * Rounds straight to binary32, never through a double.
+ *
+ * returns SI_PARSE_OK, SI_PARSE_INVALID or SI_PARSE_RANGE
+ */
+static alwaysInline int si_parseFloat ( const char *p, size_t len, float *out ) {
+
+	static const float pow10[] = { 1e0f, 1e1f, 1e2f, 1e3f, 1e4f, 1e5f, 1e6f, 1e7f, 1e8f, 1e9f, 1e10f };
+
+	si_decimal dec;
+	uint64_t bits = 0;
+	bool hex;
+
+	int result = si_scanReal( p, len, &dec, &si_binary32, &hex, &bits );
+	if ( result ) return result;
+
+	if ( !hex ) {
+		if ( dec.w == 0 ) bits = 0;
+#if SI_CLINGER
+		else if ( !dec.many && dec.w <= ( 1u << 24 ) && dec.q >= -10 && dec.q <= 10 ) {
+			float v = (float)dec.w;
+			v = dec.q < 0 ? v / pow10[ -dec.q ] : v * pow10[ dec.q ];
+			*out = dec.neg ? -v : v;
+			return SI_PARSE_OK;
+		}
+#endif
+		else if (( result = si_decimalToBinary( &dec, &si_binary32, &bits ))) return result;
+	}
+
+	if ( dec.neg ) bits |= 1u << 31;
+
+	uint32_t bits32 = (uint32_t)bits;
+	memcpy( out, &bits32, sizeof(*out) );
+	return SI_PARSE_OK;
+}
+
+
+
+/**
+ * Per-type parse core
+ *
+ * One si_tokX() per type holds the whole validation for that type over a
+ * ( ptr, len ) span, writing through a void pointer. Every entry point -
+ * the looping getters, the status getters, arrays, records and schemas -
+ * goes through an always-inlined driver that takes one of these as a
+ * constant, so each type gets its own specialised loop and any parser
+ * improvement lands everywhere at once.
+ */
+static alwaysInline int si_tokInt ( const char *p, size_t len, void *out ) {
+
+	long long v;
+	int result = si_parseSigned( p, len, INT_MIN, INT_MAX, &v );
+	if ( !result ) *(int *)out = (int)v;
+	return result;
+}
+
+static alwaysInline int si_tokUInt ( const char *p, size_t len, void *out ) {
+
+	unsigned long long v;
+	if ( len && p[0] == '-' ) return SI_PARSE_NEGATIVE;
+	int result = si_parseUnsigned( p, len, ULONG_MAX, &v );
+	if ( !result && v > UINT_MAX ) result = SI_PARSE_RANGE;
+	if ( !result ) *(unsigned int *)out = (unsigned int)v;
+	return result;
+}
+
+static alwaysInline int si_tokLong ( const char *p, size_t len, void *out ) {
+
+	long long v;
+	int result = si_parseSigned( p, len, LONG_MIN, LONG_MAX, &v );
+	if ( !result ) *(long *)out = (long)v;
+	return result;
+}
+
+static alwaysInline int si_tokULong ( const char *p, size_t len, void *out ) {
+
+	unsigned long long v;
+	int result = si_parseUnsigned( p, len, ULONG_MAX, &v );
+	if ( !result ) *(unsigned long *)out = (unsigned long)v;
+	return result;
+}
+
+static alwaysInline int si_tokLongLong ( const char *p, size_t len, void *out ) {
+
+	return si_parseSigned( p, len, LLONG_MIN, LLONG_MAX, (long long *)out );
+}
+
+static alwaysInline int si_tokULongLong ( const char *p, size_t len, void *out ) {
+
+	return si_parseUnsigned( p, len, ULLONG_MAX, (unsigned long long *)out );
+}
+
+static alwaysInline int si_tokFloat ( const char *p, size_t len, void *out ) {
+
+	return si_parseFloat( p, len, (float *)out );
+}
+
+static alwaysInline int si_tokDouble ( const char *p, size_t len, void *out ) {
+
+	return si_parseDouble( p, len, (double *)out );
+}
+
+// si_fieldType of a numeric parse core function, folds to a constant in the drivers
+static alwaysInline si_fieldType si_tokType ( int ( *parse )( const char *, size_t, void * )) {
+
+	if ( parse == si_tokInt ) return SI_FIELD_INT;
+	if ( parse == si_tokUInt ) return SI_FIELD_UINT;
+	if ( parse == si_tokLong ) return SI_FIELD_LONG;
+	if ( parse == si_tokULong ) return SI_FIELD_ULONG;
+	if ( parse == si_tokLongLong ) return SI_FIELD_LONGLONG;
+	if ( parse == si_tokULongLong ) return SI_FIELD_ULONGLONG;
+	if ( parse == si_tokFloat ) return SI_FIELD_FLOAT;
+	return SI_FIELD_DOUBLE;
+}
+
+
+
+/**
+ * si_inBounds - lo <= *value <= hi, compared in the parsed value's own type
+ *
+ * Folds to a pair of compares per parse core function, and away entirely
+ * for the unbounded getters, which pass NULL. Constant bounds from an
+ * inlined bounded getter fold into the compares themselves.
+ */
+static alwaysInline bool si_inBounds ( int ( *parse )( const char *, size_t, void * ), const void *value,
+									   const void *lo, const void *hi ) {
+
+#define si_between( T )	( *(const T *)lo <= *(const T *)value && *(const T *)value <= *(const T *)hi )
+
+	if ( !lo ) return true;
+
+	switch ( si_tokType( parse )) {
+		case SI_FIELD_INT:			return si_between( int );
+		case SI_FIELD_UINT:			return si_between( unsigned int );
+		case SI_FIELD_LONG:			return si_between( long );
+		case SI_FIELD_ULONG:		return si_between( unsigned long );
+		case SI_FIELD_LONGLONG:		return si_between( long long );
+		case SI_FIELD_ULONGLONG:	return si_between( unsigned long long );
+		case SI_FIELD_FLOAT:		return si_between( float );
+		default:					return si_between( double );
+	}
+
+#undef si_between
+}
+
+
+
+/**
+ * si_getValue - shared retry loop for the si_reader_getX() functions
+ *
+ * Always inlined with a constant parse function, like si_readArray().
+ * With lo and hi the value must also lie in [lo, hi], checked on the
+ * parsed value before the loop returns; NULL for the type's own range.
+ *
+ * returns true once a line parsed into out, false on EOF or a too-long line
+ */
+static alwaysInline bool si_getValueIn ( si_reader *r, void *out, int ( *parse )( const char *, size_t, void * ),
+										 const void *lo, const void *hi ) {
+
+	const char *line;
+	size_t len;
+
+	while ( 1 ) {
+
+		if ( si_readLine( r, INPUT_BUFFER_SIZE - 1, &line, &len )) return false;
+
+		int result = parse( line, len, out );
+		if ( !result && unlikely( !si_inBounds( parse, out, lo, hi ))) result = SI_PARSE_RANGE;
+
+		if ( !result ) {
+			si_count( r, parsed[ si_tokType( parse ) ], 1 );
+			return true;
+		}
+
+		si_countReject( r, result );
+		if ( result == SI_PARSE_NEGATIVE ) si_report( r, SI_ERR_INVALID, "Value can not be negative.\n" );
+		else if ( lo && result == SI_PARSE_RANGE ) si_report( r, SI_ERR_OVERFLOW, "Value out of range. Try again.\n" );
+		else si_report( r, si_errorKind( result ), "Invalid input. Try again.\n" );
+	}
+}
+
+static alwaysInline bool si_getValue ( si_reader *r, void *out, int ( *parse )( const char *, size_t, void * )) {
+
+	return si_getValueIn( r, out, parse, NULL, NULL );
+}
+
+
+
+/**
+ * si_readerAlloc - allocate a reader and its block buffer in one chunk
+ *
+ * returns NULL on allocation failure
+ */
+static si_reader *si_readerAlloc ( int fd, FILE *fp ) {
+
+	si_reader *r = malloc( sizeof(*r) + SI_READ_BLOCK );
+	if ( !r ) {
+		si_report( NULL, SI_ERR_NOMEM, "Memory allocation failed.\n" );
+		return NULL;
+	}
+
+	*r = (si_reader){
+		.buf		= (char *)( r + 1 ),
+		.cap		= SI_READ_BLOCK,
+		.fd			= fd,
+		.fp			= fp,
+		.flushOut	= ( fd == STDIN_FILENO ),
+		.lineLimit	= INPUT_BUFFER_SIZE,
+	};
+	return r;
+}
+
+
+
+/**
+ * si_reader_fromFd - create a reader on an open file descriptor
+ *
+ * The fd is not closed by si_reader_free().
+ *
+ * returns NULL on error
+ */
+si_reader *si_reader_fromFd ( int fd ) {
+
+	if ( fd < 0 ) return NULL;
+	return si_readerAlloc( fd, NULL );
+}
+
+
+
+/**
+ * si_reader_fromFile - create a reader on a stdio stream
+ *
+ * Streams backed by a file descriptor are read through the fd, anything
+ * else ( fmemopen, cookie streams ) goes through fread_unlocked().
+ *
+ * NOTE:	the reader takes over the stream. Don't call stdio input
+ * 			functions on it while the reader is in use.
+ *
+ * returns NULL on error
+ */
+si_reader *si_reader_fromFile ( FILE *fp ) {
+
+	if ( !fp ) return NULL;
+
+	int fd = fileno( fp );
+	return si_readerAlloc( fd, fd < 0 ? fp : NULL );
+}
+
+
+
+/**
+ * si_reader_fromMemory - create a reader over an in-memory buffer
+ *
+ * The bytes are not copied and must outlive the reader.
+ *
+ * returns NULL on error
+ */
+si_reader *si_reader_fromMemory ( const void *data, size_t len ) {
+
+	if ( !data && len ) return NULL;
+
+	si_reader *r = malloc( sizeof(*r) );
+	if ( !r ) {
+		si_report( NULL, SI_ERR_NOMEM, "Memory allocation failed.\n" );
+		return NULL;
+	}
+
+	// never written to: memory readers start at EOF and skip compaction
+	*r = (si_reader){
+		.buf		= (char *)data,
+		.cap		= len,
+		.end		= len,
+		.fd			= -1,
+		.eof		= true,
+		.lineLimit	= INPUT_BUFFER_SIZE,
+	};
+	si_count( r, bytes, len );
+	return r;
+}
+
+
+/**
+ * si_mapFd - mmap() all of a regular file read-only for sequential parsing
+ *
+ * returns the mapping, or NULL if fd isn't a non-empty regular file or
+ * mmap() fails
+ */
+static void *si_mapFd ( int fd, size_t *len ) {
+
+	struct stat st;
+
+	if ( fstat( fd, &st ) || !S_ISREG( st.st_mode ) || st.st_size <= 0 ) return NULL;
+	if ( (unsigned long long)st.st_size > SIZE_MAX ) return NULL;
+
+	void *map = mmap( NULL, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0 );
+	if ( map == MAP_FAILED ) return NULL;
+
+	// hints only, failures are harmless
+	madvise( map, (size_t)st.st_size, MADV_SEQUENTIAL );
+#ifdef MADV_HUGEPAGE
+	madvise( map, (size_t)st.st_size, MADV_HUGEPAGE );
+#endif
+
+	*len = (size_t)st.st_size;
+	return map;
+}
+
+
+
+/**
+ * si_mapOffset - the fd's current offset into a mapping of len bytes
+ */
+static size_t si_mapOffset ( int fd, size_t len ) {
+
+	off_t at = lseek( fd, 0, SEEK_CUR );
+	if ( at <= 0 ) return 0;
+	return (size_t)at < len ? (size_t)at : len;
+}
+
+
+
+/**
+ * si_reader_fromMapped - create a reader that parses a file in place
+ *
+ * Regular files are mmap()ed and every getter, view and tokenizer runs
+ * directly over the mapping, starting at the fd's current offset. Pipes,
+ * ttys and anything else that can't be mapped fall back to
+ * si_reader_fromFd(). Once mapped the fd may be closed; the fd fallback
+ * still reads from it, so keep it open until si_reader_free().
+ *
+ * NOTE: 	A file that is truncated while mapped raises SIGBUS on access.
+ *
+ * returns NULL on error
+ */
+si_reader *si_reader_fromMapped ( int fd ) {
+
+	size_t len;
+	void *map = si_mapFd( fd, &len );
+	if ( !map ) return si_reader_fromFd( fd );
+
+	si_reader *r = si_reader_fromMemory( map, len );
+	if ( !r ) {
+		munmap( map, len );
+		return NULL;
+	}
+
+	r->map = map;
+	r->mapLen = len;
+	r->pos = si_mapOffset( fd, len );
+	r->base = 0;
+	r->lineStart = r->pos;
+	return r;
+}
+
+
+
+/**
+ * si_mapStdin - switch the default reader to an mmap() of stdin
+ *
+ * Only works while stdin is redirected from a regular file and nothing has
+ * been read through the default reader yet. Must be called before the
+ * first si_get*() call.
+ *
+ * returns true if stdin is now mapped
+ */
+bool si_mapStdin ( void ) {
+
+	si_reader *r = &si_stdinReader;
+	si_guard( r );
+
+	if ( r->map ) return true;
+	if ( r->end || r->eof ) return false;
+
+	size_t len;
+	void *map = si_mapFd( r->fd, &len );
+	if ( !map ) return false;
+
+	r->map = map;
+	r->mapLen = len;
+	r->buf = map;
+	r->cap = r->end = len;
+	r->pos = r->lineStart = si_mapOffset( r->fd, len );
+	r->eof = true;
+	r->flushOut = false;
+	si_count( r, bytes, len );
+	return true;
+}
+
+
+
+/**
+ * si_reader_free - release a reader created by one of the si_reader_from* calls
+ *
+ * The underlying fd or stream is left open. Passing the default stdin
+ * reader or NULL is a no-op.
+ */
+void si_reader_free ( si_reader *r ) {
+
+	if ( !r || r == &si_stdinReader ) return;
+	if ( r->pendingLen ) si_showPending( r, NULL );
+	if ( r->map ) munmap( r->map, r->mapLen );
+	if ( r->lock ) {
+		pthread_mutex_destroy( r->lock );
+		free( r->lock );
+	}
+	free( r->heapBuf );
+	free( r->fieldBuf );
+	free( r );
+}
+
+
+
+/**
+ * si_reader_setLineLimit - set the line limit used by the string getters
+ *
+ * @limit:		same meaning as INPUT_BUFFER_SIZE ( the default ): si_getString
+ * 				accepts lines shorter than limit. SI_UNBOUNDED, or anything
+ * 				above SI_LINE_MAX, selects the SI_LINE_MAX hard cap.
+ *
+ * Limits above the block size make the buffer grow on demand.
+ *
+ * returns false on a NULL reader or a limit below 2
+ */
+bool si_reader_setLineLimit ( si_reader *r, size_t limit ) {
+
+	if ( !r || limit < 2 ) return false;
+
+	r->lineLimit = limit > SI_LINE_MAX ? SI_LINE_MAX : limit;
+	return true;
+}
+
+
+
+/**
+ * si_stdin - returns the default reader used by the si_get* functions
+ */
+si_reader *si_stdin ( void ) {
+
+	return &si_stdinReader;
+}
+
+
+
+/**
+ * si_reader_eof - true once the reader's source is exhausted and no
+ * 					buffered input is left
+ */
+bool si_reader_eof ( const si_reader *r ) {
+
+	return !r || ( r->eof && r->pos == r->end );
+}
+
+
+
+/**
+ * si_reader_error - returns the errno of the last failed read, 0 if none
+ */
+int si_reader_error ( const si_reader *r ) {
+
+	return r ? r->err : EINVAL;
+}
+
+
+
+/**
+ * si_reader_setErrorHandler - route the reader's error messages to fn
+ *
+ * @fn:			called with ctx, the kind of error and the message text,
+ * 				NULL to go back to writing to stderr
+ *
+ * returns false on a NULL reader
+ */
+bool si_reader_setErrorHandler ( si_reader *r, si_errorHandler fn, void *ctx ) {
+
+	if ( !r ) return false;
+
+	r->onError = fn;
+	r->errorCtx = ctx;
+	return true;
+}
+
+
+
+/**
+ * si_reader_setSilent - drop error messages entirely, only counting them
+ */
+bool si_reader_setSilent ( si_reader *r, bool silent ) {
+
+	if ( !r ) return false;
+
+	r->silent = silent;
+	return true;
+}
+
+
+
+/**
+ * si_isTerminal - true if r reads from a terminal
+ */
+static cold bool si_isTerminal ( const si_reader *r ) {
+
+	int fd = r->fp ? fileno( r->fp ) : r->fd;
+	return fd >= 0 && isatty( fd );
+}
+
+
+
+/**
+ * si_reader_setPrompt - show prompt whenever r is about to wait for a line
+ *
+ * @prompt:		text written to stderr before each blocking read that starts
+ * 				a new line, NULL to go back to no prompt. Not copied, so it
+ * 				must stay valid while it is set.
+ *
+ * The prompt goes out in the same writev() as the retry messages of the
+ * getters ( "Invalid input. Try again." ), after one fflush( stdout ), so a
+ * re-prompt costs a single write and no per-character echo. Lines that are
+ * already buffered, typed ahead of the prompt, are read without showing
+ * it. Prompts are only shown on a terminal and never by non-blocking
+ * readers.
+ *
+ * returns false on a NULL reader, or if r doesn't read from a terminal
+ * 		   ( the prompt is then not set )
+ */
+bool si_reader_setPrompt ( si_reader *r, const char *prompt ) {
+
+	si_guard( r );
+
+	if ( !r ) return false;
+
+	if ( r->pendingLen ) si_showPending( r, NULL );
+
+	if ( prompt && !si_isTerminal( r )) {
+		r->prompt = NULL;
+		return false;
+	}
+
+	r->prompt = prompt;
+	return true;
+}
+
+
+
+/**
+ * si_reader_setErrorRepeatLimit - show at most limit consecutive messages
+ * 								   of the same kind ( 0, the default, for all )
+ *
+ * Suppressed messages are counted in si_errorStats.suppressed and summed up
+ * in a single line once a different kind of error is reported.
+ */
+bool si_reader_setErrorRepeatLimit ( si_reader *r, unsigned limit ) {
+
+	if ( !r ) return false;
+
+	r->repeatLimit = limit;
+	r->repeats = 0;
+	return true;
+}
+
+
+
+/**
+ * si_reader_errorStats - rejected, overflowed and too-long lines so far
+ *
+ * Counts both the retrying getters and the status getters.
+ */
+si_errorStats si_reader_errorStats ( const si_reader *r ) {
+
+	return r ? r->stats : (si_errorStats){ 0, 0, 0, 0 };
+}
+
+
+
+
+/**
+ * si_reader_stats - snapshot of the reader's hot-path counters
+ *
+ * Only counted when the library is built with SI_STATS, otherwise the
+ * snapshot is all zero with enabled == false. Lines are counted once they
+ * are consumed, whichever getter took them; si_reader_getBool() reads
+ * through si_reader_getChar(), so each answer also counts as a char.
+ */
+si_stats si_reader_stats ( const si_reader *r ) {
+
+	si_stats stats = { .enabled = false };
+
+#ifdef SI_STATS
+	if ( r ) {
+		si_guard( (si_reader *)r );
+		stats = r->counters;
+		stats.enabled = true;
+	}
+#else
+	(void)r;
+#endif
+
+	return stats;
+}
+
+
+
+/**
+ * si_reader_resetStats - zero the reader's hot-path counters
+ *
+ * returns false if r is NULL
+ */
+bool si_reader_resetStats ( si_reader *r ) {
+
+	si_guard( r );
+
+	if ( !r ) return false;
+#ifdef SI_STATS
+	r->counters = (si_stats){ .enabled = false };
+#endif
+	return true;
+}
+
+
+
+/**
+ * si_reader_setNonBlocking - switch the reader's fd in or out of O_NONBLOCK
+ *
+ * In non-blocking mode no getter ever waits for input: when no complete
+ * line is buffered they return their EOF value and si_reader_wouldBlock()
+ * turns true. Partial lines are kept in the reader, so it is enough to
+ * poll si_reader_fd() for readability and call again.
+ *
+ * Memory readers never block and accept either mode. Readers on a FILE
+ * without a file descriptor can't be made non-blocking.
+ *
+ * returns false on a NULL reader or if fcntl() fails ( see si_reader_error )
+ */
+bool si_reader_setNonBlocking ( si_reader *r, bool on ) {
+
+	if ( !r || r->fp ) return false;
+
+	if ( r->fd >= 0 ) {
+		int flags = fcntl( r->fd, F_GETFL );
+		if ( flags < 0 || fcntl( r->fd, F_SETFL, on ? flags | O_NONBLOCK : flags & ~O_NONBLOCK ) < 0 ) {
+			r->err = errno;
+			return false;
+		}
+	}
+
+	r->nonBlock = on;
+	return true;
+}
+
+
+
+/**
+ * si_reader_fd - the file descriptor to poll()/epoll/kqueue on, -1 if none
+ */
+int si_reader_fd ( const si_reader *r ) {
+
+	return r && !r->fp ? r->fd : -1;
+}
+
+
+
+/**
+ * si_reader_wouldBlock - true if the last read returned because the
+ * 						  non-blocking source had no complete line ( or token )
+ */
+bool si_reader_wouldBlock ( const si_reader *r ) {
+
+	return r && r->blocked;
+}
+
+
+/**
+ * si_reader_setLocking - make r safe to share between threads
+ *
+ * With locking on, each getter call holds the reader's lock while it reads
+ * and parses, so lines ( and whole batches for the array getters ) are
+ * never interleaved between threads. Retries of the looping getters happen
+ * under the same lock.
+ *
+ * NOTE: 	Switch locking before the reader is shared, not while other
+ * 			threads use it. Views ( si_getStringView, records ) point into
+ * 			the shared buffer and are only safe until another thread reads;
+ * 			use the copying getters on shared readers. The default stdin
+ * 			reader has a static lock and can always be switched.
+ *
+ * returns false on a NULL reader or if the mutex can't be created
+ */
+bool si_reader_setLocking ( si_reader *r, bool on ) {
+
+	if ( !r ) return false;
+
+	if ( r == &si_stdinReader ) {
+		r->lock = on ? &si_stdinLock : NULL;
+		return true;
+	}
+
+	if ( !on ) {
+		if ( r->lock ) {
+			pthread_mutex_destroy( r->lock );
+			free( r->lock );
+			r->lock = NULL;
+		}
+		return true;
+	}
+
+	if ( r->lock ) return true;
+
+	pthread_mutex_t *lock = malloc( sizeof(*lock) );
+	pthread_mutexattr_t attr;
+
+	if ( !lock || pthread_mutexattr_init( &attr )) {
+		free( lock );
+		return false;
+	}
+
+	pthread_mutexattr_settype( &attr, PTHREAD_MUTEX_RECURSIVE );
+	int failed = pthread_mutex_init( lock, &attr );
+	pthread_mutexattr_destroy( &attr );
+
+	if ( failed ) {
+		free( lock );
+		return false;
+	}
+
+	r->lock = lock;
+	return true;
+}
+
+
+
+/**
+ * si_useReader - route the calling thread's si_get*() calls to r
+ *
+ * The lock-free alternative to a shared stdin: give every thread its own
+ * reader ( on its own fd, file or memory ) and the plain si_get*() calls
+ * in that thread use it without any locking. NULL goes back to stdin.
+ *
+ * returns the thread's previous default reader
+ */
+si_reader *si_useReader ( si_reader *r ) {
+
+	si_reader *prev = si_current();
+	si_threadReader = ( r == &si_stdinReader ) ? NULL : r;
+	return prev;
+}
+
+
+
+/**
+ * si_reader_readLine - fetch the next line as a view, without retrying
+ *
+ * @line:		receives the line ( not null-terminated, no newline ),
+ * 				valid until the next read from r
+ *
+ * Lines must be shorter than the reader's line limit. Nothing is printed,
+ * which makes this the building block for event-loop consumers.
+ *
+ * Returns:
+ * 		SI_OK 			- on success
+ * 		SI_TOO_LONG		- the line was discarded ( possibly over several calls )
+ * 		SI_WOULD_BLOCK	- no complete line buffered, poll si_reader_fd() and retry
+ * 		SI_EOF			- on EOF, read error or bad arguments
+ */
+hotApi si_result si_reader_readLine ( si_reader *r, si_string *line ) {
+
+	si_guard( r );
+
+	if ( !r || !line ) return SI_EOF;
+
+	const char *p;
+	size_t len;
+
+	si_result status = si_tryLine( r, r->lineLimit, &p, &len );
+	*line = status ? (si_string){ NULL, 0 } : (si_string){ (char *)p, len };
+	return status;
+}
+
+
+
+/**
+ * si_reader_skipLine - discard input up to and including the next newline
+ *
+ * usage - while ( si_reader_tryGetInt( r, &x ) == SI_INVALID ) si_reader_skipLine( r );
+ *
+ * Resynchronises after garbage without copying or validating it: whole
+ * buffered blocks are scanned and dropped, however long the line is. On a
+ * non-blocking reader that runs dry mid-line the skip is remembered, and
+ * the next read ( or skipLine ) carries on to the end of that line.
+ *
+ * returns the number of bytes skipped, newline included, 0 at EOF
+ */
+size_t si_reader_skipLine ( si_reader *r ) {
+
+	si_guard( r );
+
+	if ( !r ) return 0;
+
+	r->blocked = false;
+	return si_drainStdin( r );
+}
+
+
+
+/**
+ * si_reader_getInt - a safer alternative to scanf for integers
+ *
+ * usage - int x = si_reader_getInt( r );
+ * 
+ * returns INT_MIN on error or EOF
+ */
+hotApi int si_reader_getInt ( si_reader *r ) {
+
+	si_guard( r );
+
+	int value;
+	return si_getValue( r, &value, si_tokInt ) ? value : INT_MIN;
+}
+
+
+
+/**
+ * si_reader_getUInt - a safer alternative to scanf for unsigned integers
+ *
+ * usage - unsigned int x = si_reader_getUInt( r );
+ * 
+ * returns UINT_MAX on error or EOF
+ */
+hotApi unsigned int si_reader_getUInt ( si_reader *r ) {
+
+	si_guard( r );
+
+	unsigned int value;
+	return si_getValue( r, &value, si_tokUInt ) ? value : UINT_MAX;
+}
+
+
+
+/**
+ * si_reader_getFloat - a safer alternative to scanf for floating point numbers
+ *
+ * usage - float x = si_reader_getFloat( r );
+ * 
+ * returns NAN on error or EOF
+ */
+hotApi float si_reader_getFloat ( si_reader *r ) {
+
+	si_guard( r );
+
+	float value;
+	return si_getValue( r, &value, si_tokFloat ) ? value : NAN;
+}
+
+
+
+/**
+ * si_reader_getDouble - a safer alternative to scanf for doubles
+ *
+ * usage - double x = si_reader_getDouble( r );
+ * 
+ * returns NAN on error or EOF
+ */
+hotApi double si_reader_getDouble ( si_reader *r ) {
+
+	si_guard( r );
+
+	double value;
+	return si_getValue( r, &value, si_tokDouble ) ? value : NAN;
+}
+
+
+
+/**
+ * si_reader_getLong - a safer alternative to scanf for longs
+ *
+ * usage - long x = si_reader_getLong( r );
+ * 
+ * returns LONG_MIN on error or EOF
+ */
+hotApi long si_reader_getLong ( si_reader *r ) {
+
+	si_guard( r );
+
+	long value;
+	return si_getValue( r, &value, si_tokLong ) ? value : LONG_MIN;
+}
+
+
+
+/**
+ * si_reader_getULong - a safer alternative to scanf for unsigned longs
+ *
+ * usage - unsigned long x = si_reader_getULong( r );
+ * 
+ * returns ULONG_MAX on error or EOF
+ */
+hotApi unsigned long si_reader_getULong ( si_reader *r ) {
+
+	si_guard( r );
+
+	unsigned long value;
+	return si_getValue( r, &value, si_tokULong ) ? value : ULONG_MAX;
+}
+
+
+
+/**
+ * si_reader_getLongLong - a safer alternative to scanf for long longs
+ *
+ * usage - long long x = si_reader_getLongLong( r );
+ * 
+ * returns LLONG_MIN on error or EOF
+ */
+hotApi long long si_reader_getLongLong ( si_reader *r ) {
+
+	si_guard( r );
+
+	long long value;
+	return si_getValue( r, &value, si_tokLongLong ) ? value : LLONG_MIN;
+}
+
+
+
+/**
+ * si_reader_getULongLong - a safer alternative to scanf for unsigned long longs
+ *
+ * usage - unsigned long long x = si_reader_getULongLong( r );
+ * 
+ * returns ULLONG_MAX on error or EOF
+ */
+hotApi unsigned long long si_reader_getULongLong ( si_reader *r ) {
+
+	si_guard( r );
+
+	unsigned long long value;
+	return si_getValue( r, &value, si_tokULongLong ) ? value : ULLONG_MAX;
+}
+
+
+
+/**
+ * si_reader_getChar - a safer alternative to scanf for chars
+ *
+ * usage - int x = si_reader_getChar( r );
+ *
+ * IMPORTANT: Only accepts one character. " a" and "a " are considered invalid.
+ * 
+ * returns EOF on error or EOF
+ */
+hotApi int si_reader_getChar ( si_reader *r ) {
+
+	si_guard( r );
+
+	char buffer[CHAR_INPUT_BUFFER_SIZE];
+	size_t len = 0;
+
+	while ( 1 ) {
+
+		int result = si_readByte( r, buffer, sizeof(buffer) - 1, &len );
+		buffer[len] = '\0';
+
+		if ( result == EOF ) return EOF;
+		if ( result == 1 ) continue;
+		if ( len <= 1 ) {
+			si_count( r, parsed[SI_FIELD_CHAR], 1 );
+			return len ? (unsigned char)buffer[0] : '\n';
+		}
+		si_count( r, rejected[SI_REJECT_SYNTAX], 1 );
+		si_report( r, SI_ERR_INVALID, "Invalid input. Please enter a single character.\n" );
+
+	}
+}
+
+
+
+/**
+ * Character sets
+ *
+ * si_charset is a 256-bit membership bitmap, compiled once from a pattern
+ * and reused: a membership test is a single bit test. The same set is also
+ * kept transposed by nibble ( row lo-nibble, bit hi-nibble & 7, one table
+ * per hi-nibble half ) so si_charset_span() can classify 16 bytes at a time
+ * with two table shuffles.
+ */
+static alwaysInline void si_charsetAdd ( si_charset *cs, unsigned c ) {
+
+	cs->bits[ c >> 6 ] |= 1ull << ( c & 63 );
+}
+
+
+
+/**
+ * si_charset_compile - build a charset from a bracket-style pattern
+ *
+ * @spec:		members, with "a-z" for ranges, a leading '^' to negate the
+ * 				set and '\\' to take the next character literally. A '-' at
+ * 				either end is literal, as is a lone "^".
+ *
+ * usage - si_charset cs; si_charset_compile( &cs, "A-Za-z0-9_" );
+ *
+ * returns false on NULL arguments, an empty spec or a reversed range
+ */
+bool si_charset_compile ( si_charset *cs, const char *spec ) {
+
+	if ( !cs || !spec || !spec[0] ) return false;
+
+	memset( cs, 0, sizeof(*cs) );
+
+	const unsigned char *p = (const unsigned char *)spec;
+	bool negate = false;
+
+	if ( p[0] == '^' && p[1] ) {
+		negate = true;
+		p++;
+	}
+
+	while ( *p ) {
+		unsigned lo = *p++;
+		if ( lo == '\\' && *p ) lo = *p++;
+
+		unsigned hi = lo;
+		if ( p[0] == '-' && p[1] ) {
+			p++;
+			hi = *p++;
+			if ( hi == '\\' && *p ) hi = *p++;
+			if ( hi < lo ) return false;
+		}
+
+		for ( unsigned c = lo; c <= hi; c++ ) si_charsetAdd( cs, c );
+	}
+
+	if ( negate )
+		for ( int i = 0; i < 4; i++ ) cs->bits[i] = ~cs->bits[i];
+
+	for ( unsigned c = 0; c < 256; c++ )
+		if ( si_charset_has( cs, (unsigned char)c ))
+			cs->nibble[ ( c >> 7 ) * 16 + ( c & 15 ) ] |= (unsigned char)( 1u << (( c >> 4 ) & 7 ));
+
+	return true;
+}
+
+
+
+/**
+ * si_charset_span kernels
+ *
+ * Each kernel classifies whole blocks of 16, 32 or 64 bytes and returns the
+ * offset of the first non-member, or where the full blocks ran out; the
+ * caller finishes the tail one byte at a time. On x86 every ISA level is
+ * compiled in with target attributes and the widest one the CPU supports
+ * is picked on first use, so a build without -march still gets AVX2 or
+ * AVX-512 where the host has it. NEON is baseline on AArch64.
+ */
+typedef size_t ( *si_spanKernel )( const si_charset *cs, const char *p, size_t len );
+
+#if defined(SI_X86)
+static size_t si_spanNone ( const si_charset *cs, const char *p, size_t len ) {
+
+	(void)cs; (void)p; (void)len;
+	return 0;
+}
+
+__attribute__(( target( "ssse3" )))
+static size_t si_spanSsse3 ( const si_charset *cs, const char *p, size_t len ) {
+
+	const __m128i t0 = _mm_loadu_si128( (const __m128i *)cs->nibble );
+	const __m128i t1 = _mm_loadu_si128( (const __m128i *)( cs->nibble + 16 ));
+	const __m128i bitpos = _mm_setr_epi8( 1, 2, 4, 8, 16, 32, 64, -128, 1, 2, 4, 8, 16, 32, 64, -128 );
+	const __m128i low4 = _mm_set1_epi8( 0x0F );
+	const __m128i seven = _mm_set1_epi8( 7 );
+	size_t i = 0;
+
+	for ( ; len - i >= 16; i += 16 ) {
+		__m128i v = _mm_loadu_si128( (const __m128i *)( p + i ));
+		__m128i lo = _mm_and_si128( v, low4 );
+		__m128i hi = _mm_and_si128( _mm_srli_epi16( v, 4 ), low4 );
+		__m128i upper = _mm_cmpgt_epi8( hi, seven );
+		__m128i row = _mm_or_si128( _mm_andnot_si128( upper, _mm_shuffle_epi8( t0, lo )),
+									_mm_and_si128( upper, _mm_shuffle_epi8( t1, lo )));
+		__m128i hit = _mm_and_si128( row, _mm_shuffle_epi8( bitpos, hi ));
+		unsigned miss = (unsigned)_mm_movemask_epi8( _mm_cmpeq_epi8( hit, _mm_setzero_si128() ));
+		if ( miss ) return i + (size_t)__builtin_ctz( miss );
+	}
+
+	return i;
+}
+
+// the same with both 128-bit lanes holding the tables ( vpshufb is per lane )
+__attribute__(( target( "avx2" )))
+static size_t si_spanAvx2 ( const si_charset *cs, const char *p, size_t len ) {
+
+	const __m256i t0 = _mm256_broadcastsi128_si256( _mm_loadu_si128( (const __m128i *)cs->nibble ));
+	const __m256i t1 = _mm256_broadcastsi128_si256( _mm_loadu_si128( (const __m128i *)( cs->nibble + 16 )));
+	const __m256i bitpos = _mm256_broadcastsi128_si256( _mm_setr_epi8( 1, 2, 4, 8, 16, 32, 64, -128, 1, 2, 4, 8, 16, 32, 64, -128 ));
+	const __m256i low4 = _mm256_set1_epi8( 0x0F );
+	const __m256i seven = _mm256_set1_epi8( 7 );
+	size_t i = 0;
+
+	for ( ; len - i >= 32; i += 32 ) {
+		__m256i v = _mm256_loadu_si256( (const __m256i *)( p + i ));
+		__m256i lo = _mm256_and_si256( v, low4 );
+		__m256i hi = _mm256_and_si256( _mm256_srli_epi16( v, 4 ), low4 );
+		__m256i upper = _mm256_cmpgt_epi8( hi, seven );
+		__m256i row = _mm256_blendv_epi8( _mm256_shuffle_epi8( t0, lo ), _mm256_shuffle_epi8( t1, lo ), upper );
+		__m256i hit = _mm256_and_si256( row, _mm256_shuffle_epi8( bitpos, hi ));
+		unsigned miss = (unsigned)_mm256_movemask_epi8( _mm256_cmpeq_epi8( hit, _mm256_setzero_si256() ));
+		if ( miss ) return i + (size_t)__builtin_ctz( miss );
+	}
+
+	return i;
+}
+
+__attribute__(( target( "avx512f,avx512bw" )))
+static size_t si_spanAvx512 ( const si_charset *cs, const char *p, size_t len ) {
+
+	const __m512i t0 = _mm512_broadcast_i32x4( _mm_loadu_si128( (const __m128i *)cs->nibble ));
+	const __m512i t1 = _mm512_broadcast_i32x4( _mm_loadu_si128( (const __m128i *)( cs->nibble + 16 )));
+	const __m512i bitpos = _mm512_broadcast_i32x4( _mm_setr_epi8( 1, 2, 4, 8, 16, 32, 64, -128, 1, 2, 4, 8, 16, 32, 64, -128 ));
+	const __m512i low4 = _mm512_set1_epi8( 0x0F );
+	const __m512i seven = _mm512_set1_epi8( 7 );
+	size_t i = 0;
+
+	for ( ; len - i >= 64; i += 64 ) {
+		__m512i v = _mm512_loadu_si512( (const void *)( p + i ));
+		__m512i lo = _mm512_and_si512( v, low4 );
+		__m512i hi = _mm512_and_si512( _mm512_srli_epi16( v, 4 ), low4 );
+		__mmask64 upper = _mm512_cmpgt_epi8_mask( hi, seven );
+		__m512i row = _mm512_mask_blend_epi8( upper, _mm512_shuffle_epi8( t0, lo ), _mm512_shuffle_epi8( t1, lo ));
+		unsigned long long miss = _mm512_testn_epi8_mask( row, _mm512_shuffle_epi8( bitpos, hi ));
+		if ( miss ) return i + (size_t)__builtin_ctzll( miss );
+	}
+
+	return i;
+}
+
+static size_t si_spanResolve ( const si_charset *cs, const char *p, size_t len );
+
+static si_spanKernel si_spanImpl = si_spanResolve;
+
+// first call: pick the widest kernel this CPU runs, then go straight to it
+static size_t si_spanResolve ( const si_charset *cs, const char *p, size_t len ) {
+
+	si_spanKernel k = si_spanNone;
+
+	__builtin_cpu_init();
+	if ( __builtin_cpu_supports( "avx512f" ) && __builtin_cpu_supports( "avx512bw" )) k = si_spanAvx512;
+	else if ( __builtin_cpu_supports( "avx2" )) k = si_spanAvx2;
+	else if ( __builtin_cpu_supports( "ssse3" )) k = si_spanSsse3;
+
+	__atomic_store_n( &si_spanImpl, k, __ATOMIC_RELAXED );
+	return k( cs, p, len );
+}
+
+static alwaysInline size_t si_spanBlocks ( const si_charset *cs, const char *p, size_t len ) {
+
+	return __atomic_load_n( &si_spanImpl, __ATOMIC_RELAXED )( cs, p, len );
+}
+#elif defined(__aarch64__)
+static alwaysInline size_t si_spanBlocks ( const si_charset *cs, const char *p, size_t len ) {
+
+	static const uint8_t bitTable[16] = { 1, 2, 4, 8, 16, 32, 64, 128, 1, 2, 4, 8, 16, 32, 64, 128 };
+	const uint8x16_t t0 = vld1q_u8( cs->nibble );
+	const uint8x16_t t1 = vld1q_u8( cs->nibble + 16 );
+	const uint8x16_t bitpos = vld1q_u8( bitTable );
+	size_t i = 0;
+
+	for ( ; len - i >= 16; i += 16 ) {
+		uint8x16_t v = vld1q_u8( (const uint8_t *)p + i );
+		uint8x16_t lo = vandq_u8( v, vdupq_n_u8( 0x0F ));
+		uint8x16_t hi = vshrq_n_u8( v, 4 );
+		uint8x16_t row = vbslq_u8( vcgtq_u8( hi, vdupq_n_u8( 7 )), vqtbl1q_u8( t1, lo ), vqtbl1q_u8( t0, lo ));
+		uint8x16_t miss = vceqq_u8( vandq_u8( row, vqtbl1q_u8( bitpos, hi )), vdupq_n_u8( 0 ));
+		uint64_t mask = vget_lane_u64( vreinterpret_u64_u8( vshrn_n_u16( vreinterpretq_u16_u8( miss ), 4 )), 0 );
+		if ( mask ) return i + ( __builtin_ctzll( mask ) >> 2 );
+	}
+
+	return i;
+}
+#else
+static alwaysInline size_t si_spanBlocks ( const si_charset *cs, const char *p, size_t len ) {
+
+	(void)cs; (void)p; (void)len;
+	return 0;
+}
+#endif
+
+
+
+/**
+ * si_charset_span - length of the longest prefix of [p, p + len) made up
+ * 					 only of members of cs ( strspn() for a compiled set )
+ *
+ * A whole span is valid when the result equals len.
+ */
+size_t si_charset_span ( const si_charset *cs, const char *p, size_t len ) {
+
+	if ( !cs || !p ) return 0;
+
+	size_t i = len >= 16 ? si_spanBlocks( cs, p, len ) : 0;
+
+	for ( ; i < len; i++ )
+		if ( !si_charset_has( cs, (unsigned char)p[i] )) break;
+
+	return i;
+}
+
+
+
+/**
+ * UTF-8 validation
+ *
+ * The vector kernels use the lookup method of simdutf / simdjson ( Keiser
+ * and Lemire, "Validating UTF-8 in less than one instruction per byte" ):
+ * three nibble-indexed tables classify every byte together with the one
+ * before it, so a block of 16 needs a handful of shuffles and no branches,
+ * and an all-ASCII block only a movemask. A lead byte's missing or extra
+ * continuations fall out of the same tables, the 3rd and 4th bytes of
+ * long sequences are checked with two saturating subtracts.
+ *
+ * In line mode the kernel also looks for the newline in every block it
+ * validates and stops there, so a line is found and checked in one pass;
+ * bytes from the newline on are cleared to ASCII first, which both hides
+ * the next line and turns a sequence cut off by the newline into an error.
+ * The tables are shared by the SSSE3 and NEON kernels; wider vectors don't
+ * pay off for lines of a few dozen bytes, the common case here.
+ */
+#define SI_U8_TOO_SHORT		0x01	// lead not followed by enough continuations
+#define SI_U8_TOO_LONG		0x02	// continuation without a lead
+#define SI_U8_OVERLONG_3	0x04	// E0 80..9F
+#define SI_U8_TOO_LARGE		0x08	// above U+10FFFF, F4 90.. and up
+#define SI_U8_SURROGATE		0x10	// ED A0..BF
+#define SI_U8_OVERLONG_2	0x20	// C0 / C1
+#define SI_U8_TOO_LARGE_1000	0x40	// F5.. 80..8F
+#define SI_U8_OVERLONG_4	0x40	// F0 80..8F
+#define SI_U8_TWO_CONTS		0x80	// continuation after a continuation
+#define SI_U8_CARRY			( SI_U8_TOO_SHORT | SI_U8_TOO_LONG | SI_U8_TWO_CONTS )
+#define SI_U8_BIG			( SI_U8_CARRY | SI_U8_TOO_LARGE | SI_U8_TOO_LARGE_1000 )
+
+// indexed by the high nibble of the previous byte
+static const uint8_t si_utf8Byte1High[16] __attribute__(( aligned( 16 ), unused )) = {
+	SI_U8_TOO_LONG, SI_U8_TOO_LONG, SI_U8_TOO_LONG, SI_U8_TOO_LONG,
+	SI_U8_TOO_LONG, SI_U8_TOO_LONG, SI_U8_TOO_LONG, SI_U8_TOO_LONG,
+	SI_U8_TWO_CONTS, SI_U8_TWO_CONTS, SI_U8_TWO_CONTS, SI_U8_TWO_CONTS,
+	SI_U8_TOO_SHORT | SI_U8_OVERLONG_2,
+	SI_U8_TOO_SHORT,
+	SI_U8_TOO_SHORT | SI_U8_OVERLONG_3 | SI_U8_SURROGATE,
+	SI_U8_TOO_SHORT | SI_U8_TOO_LARGE | SI_U8_TOO_LARGE_1000 | SI_U8_OVERLONG_4,
+};
+
+// indexed by the low nibble of the previous byte
+static const uint8_t si_utf8Byte1Low[16] __attribute__(( aligned( 16 ), unused )) = {
+	SI_U8_CARRY | SI_U8_OVERLONG_3 | SI_U8_OVERLONG_2 | SI_U8_OVERLONG_4,
+	SI_U8_CARRY | SI_U8_OVERLONG_2,
+	SI_U8_CARRY, SI_U8_CARRY,
+	SI_U8_CARRY | SI_U8_TOO_LARGE,
+	SI_U8_BIG, SI_U8_BIG, SI_U8_BIG,
+	SI_U8_BIG, SI_U8_BIG, SI_U8_BIG, SI_U8_BIG, SI_U8_BIG,
+	SI_U8_BIG | SI_U8_SURROGATE,
+	SI_U8_BIG, SI_U8_BIG,
+};
+
+// indexed by the high nibble of the byte itself
+static const uint8_t si_utf8Byte2High[16] __attribute__(( aligned( 16 ), unused )) = {
+	SI_U8_TOO_SHORT, SI_U8_TOO_SHORT, SI_U8_TOO_SHORT, SI_U8_TOO_SHORT,
+	SI_U8_TOO_SHORT, SI_U8_TOO_SHORT, SI_U8_TOO_SHORT, SI_U8_TOO_SHORT,
+	SI_U8_TOO_LONG | SI_U8_OVERLONG_2 | SI_U8_TWO_CONTS | SI_U8_OVERLONG_3 | SI_U8_TOO_LARGE_1000 | SI_U8_OVERLONG_4,
+	SI_U8_TOO_LONG | SI_U8_OVERLONG_2 | SI_U8_TWO_CONTS | SI_U8_OVERLONG_3 | SI_U8_TOO_LARGE,
+	SI_U8_TOO_LONG | SI_U8_OVERLONG_2 | SI_U8_TWO_CONTS | SI_U8_SURROGATE | SI_U8_TOO_LARGE,
+	SI_U8_TOO_LONG | SI_U8_OVERLONG_2 | SI_U8_TWO_CONTS | SI_U8_SURROGATE | SI_U8_TOO_LARGE,
+	SI_U8_TOO_SHORT, SI_U8_TOO_SHORT, SI_U8_TOO_SHORT, SI_U8_TOO_SHORT,
+};
+
+// a lead this close to the end of a block still owes bytes to the next one
+static const uint8_t si_utf8OpenTail[16] __attribute__(( aligned( 16 ), unused )) = {
+	255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 0xF0 - 1, 0xE0 - 1, 0xC0 - 1,
+};
+
+/**
+ * si_utf8Kernel - validate [p, p + len), in line mode only up to the first '\n'
+ *
+ * @bad:		set if the bytes validated are not well-formed UTF-8
+ *
+ * returns the offset of the newline in line mode, len if there is none
+ * 		   ( *bad is then meaningless, the caller has no line yet )
+ */
+typedef size_t ( *si_utf8Kernel )( const char *p, size_t len, bool lines, bool *bad );
+
+/**
+ * si_utf8Scalar - byte at a time validation, 8 ASCII bytes per step
+ */
+static bool si_utf8Scalar ( const unsigned char *p, size_t len ) {
+
+	size_t i = 0;
+
+	while ( i < len ) {
+
+		uint64_t word;
+		if ( len - i >= 8 && ( memcpy( &word, p + i, 8 ), !( word & 0x8080808080808080ull ))) {
+			i += 8;
+			continue;
+		}
+
+		unsigned c = p[i], more;
+		if ( c < 0x80 ) {
+			i++;
+			continue;
+		}
+		else if ( c >= 0xC2 && c <= 0xDF ) more = 1;
+		else if ( c >= 0xE0 && c <= 0xEF ) more = 2;
+		else if ( c >= 0xF0 && c <= 0xF4 ) more = 3;
+		else return false;
+
+		if ( len - i <= more ) return false;
+
+		unsigned c1 = p[i + 1];
+		if (( c == 0xE0 && c1 < 0xA0 ) || ( c == 0xED && c1 > 0x9F ) ||
+			( c == 0xF0 && c1 < 0x90 ) || ( c == 0xF4 && c1 > 0x8F )) return false;
+
+		for ( unsigned k = 1; k <= more; k++ )
+			if (( p[i + k] & 0xC0 ) != 0x80 ) return false;
+
+		i += more + 1;
+	}
+
+	return true;
+}
+
+static __attribute__(( unused )) size_t si_utf8ScalarLines ( const char *p, size_t len, bool lines, bool *bad ) {
+
+	const char *nl = lines ? memchr( p, '\n', len ) : NULL;
+	size_t n = nl ? (size_t)( nl - p ) : len;
+
+	*bad = !si_utf8Scalar( (const unsigned char *)p, n );
+	return n;
+}
+
+#if defined(SI_X86)
+__attribute__(( target( "ssse3" )))
+static size_t si_utf8Ssse3 ( const char *p, size_t len, bool lines, bool *bad ) {
+
+	const __m128i b1h = _mm_load_si128( (const __m128i *)si_utf8Byte1High );
+	const __m128i b1l = _mm_load_si128( (const __m128i *)si_utf8Byte1Low );
+	const __m128i b2h = _mm_load_si128( (const __m128i *)si_utf8Byte2High );
+	const __m128i tail = _mm_load_si128( (const __m128i *)si_utf8OpenTail );
+	const __m128i low4 = _mm_set1_epi8( 0x0F );
+	const __m128i index = _mm_setr_epi8( 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15 );
+	__m128i prev = _mm_setzero_si128(), open = _mm_setzero_si128(), err = _mm_setzero_si128();
+	size_t i = 0, stop = len;
+	bool wide = false;
+
+	for ( ; i < len; i += 16 ) {
+
+		__m128i v;
+		if ( len - i >= 16 ) v = _mm_loadu_si128( (const __m128i *)( p + i ));
+		else {
+			// zero padding reads as ASCII
+			char last[16] = { 0 };
+			memcpy( last, p + i, len - i );
+			v = _mm_loadu_si128( (const __m128i *)last );
+		}
+
+		unsigned nl = lines ? (unsigned)_mm_movemask_epi8( _mm_cmpeq_epi8( v, _mm_set1_epi8( '\n' ))) : 0;
+		if ( nl ) {
+			stop = i + (size_t)__builtin_ctz( nl );
+			v = _mm_and_si128( v, _mm_cmpgt_epi8( _mm_set1_epi8( (char)__builtin_ctz( nl )), index ));
+		}
+
+		// ASCII blocks take the shortcut until the first that isn't, then a
+		// line of mixed text is checked branch-free to the end, as its
+		// ASCII / non-ASCII pattern would defeat the branch predictor
+		if ( wide || ( wide = _mm_movemask_epi8( v ) != 0 )) {
+			__m128i prev1 = _mm_alignr_epi8( v, prev, 15 );
+			__m128i special = _mm_and_si128( _mm_and_si128(
+				_mm_shuffle_epi8( b1h, _mm_and_si128( _mm_srli_epi16( prev1, 4 ), low4 )),
+				_mm_shuffle_epi8( b1l, _mm_and_si128( prev1, low4 ))),
+				_mm_shuffle_epi8( b2h, _mm_and_si128( _mm_srli_epi16( v, 4 ), low4 )));
+			__m128i third = _mm_subs_epu8( _mm_alignr_epi8( v, prev, 14 ), _mm_set1_epi8( (char)( 0xE0 - 0x80 )));
+			__m128i fourth = _mm_subs_epu8( _mm_alignr_epi8( v, prev, 13 ), _mm_set1_epi8( (char)( 0xF0 - 0x80 )));
+			__m128i must23 = _mm_and_si128( _mm_or_si128( third, fourth ), _mm_set1_epi8( (char)0x80 ));
+			err = _mm_or_si128( err, _mm_xor_si128( must23, special ));
+			open = _mm_subs_epu8( v, tail );
+		}
+		else err = _mm_or_si128( err, open );
+
+		prev = v;
+		if ( nl ) break;
+	}
+
+	err = _mm_or_si128( err, open );
+	*bad = _mm_movemask_epi8( _mm_cmpeq_epi8( err, _mm_setzero_si128() )) != 0xFFFF;
+	return stop;
+}
+
+static size_t si_utf8Resolve ( const char *p, size_t len, bool lines, bool *bad );
+
+static si_utf8Kernel si_utf8Impl = si_utf8Resolve;
+
+// first call: SSSE3 where the CPU has it, the scalar loop otherwise
+static size_t si_utf8Resolve ( const char *p, size_t len, bool lines, bool *bad ) {
+
+	si_utf8Kernel k = si_utf8ScalarLines;
+
+	__builtin_cpu_init();
+	if ( __builtin_cpu_supports( "ssse3" )) k = si_utf8Ssse3;
+
+	__atomic_store_n( &si_utf8Impl, k, __ATOMIC_RELAXED );
+	return k( p, len, lines, bad );
+}
+
+static alwaysInline size_t si_utf8Blocks ( const char *p, size_t len, bool lines, bool *bad ) {
+
+	return __atomic_load_n( &si_utf8Impl, __ATOMIC_RELAXED )( p, len, lines, bad );
+}
+#elif defined(__aarch64__)
+static size_t si_utf8Neon ( const char *p, size_t len, bool lines, bool *bad ) {
+
+	static const uint8_t indexTable[16] = { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15 };
+	const uint8x16_t b1h = vld1q_u8( si_utf8Byte1High );
+	const uint8x16_t b1l = vld1q_u8( si_utf8Byte1Low );
+	const uint8x16_t b2h = vld1q_u8( si_utf8Byte2High );
+	const uint8x16_t tail = vld1q_u8( si_utf8OpenTail );
+	const uint8x16_t low4 = vdupq_n_u8( 0x0F );
+	const uint8x16_t index = vld1q_u8( indexTable );
+	uint8x16_t prev = vdupq_n_u8( 0 ), open = vdupq_n_u8( 0 ), err = vdupq_n_u8( 0 );
+	size_t i = 0, stop = len;
+	bool wide = false;
+
+	for ( ; i < len; i += 16 ) {
+
+		uint8x16_t v;
+		if ( len - i >= 16 ) v = vld1q_u8( (const uint8_t *)p + i );
+		else {
+			uint8_t last[16] = { 0 };
+			memcpy( last, p + i, len - i );
+			v = vld1q_u8( last );
+		}
+
+		uint64_t nl = 0;
+		if ( lines ) {
+			uint8x16_t eq = vceqq_u8( v, vdupq_n_u8( '\n' ));
+			nl = vget_lane_u64( vreinterpret_u64_u8( vshrn_n_u16( vreinterpretq_u16_u8( eq ), 4 )), 0 );
+		}
+		if ( nl ) {
+			unsigned k = (unsigned)__builtin_ctzll( nl ) >> 2;
+			stop = i + k;
+			v = vandq_u8( v, vcltq_u8( index, vdupq_n_u8( (uint8_t)k )));
+		}
+
+		if ( wide || ( wide = vmaxvq_u8( v ) >= 0x80 )) {
+			uint8x16_t prev1 = vextq_u8( prev, v, 15 );
+			uint8x16_t special = vandq_u8( vandq_u8(
+				vqtbl1q_u8( b1h, vshrq_n_u8( prev1, 4 )),
+				vqtbl1q_u8( b1l, vandq_u8( prev1, low4 ))),
+				vqtbl1q_u8( b2h, vshrq_n_u8( v, 4 )));
+			uint8x16_t third = vqsubq_u8( vextq_u8( prev, v, 14 ), vdupq_n_u8( 0xE0 - 0x80 ));
+			uint8x16_t fourth = vqsubq_u8( vextq_u8( prev, v, 13 ), vdupq_n_u8( 0xF0 - 0x80 ));
+			uint8x16_t must23 = vandq_u8( vorrq_u8( third, fourth ), vdupq_n_u8( 0x80 ));
+			err = vorrq_u8( err, veorq_u8( must23, special ));
+			open = vqsubq_u8( v, tail );
+		}
+		else err = vorrq_u8( err, open );
+
+		prev = v;
+		if ( nl ) break;
+	}
+
+	*bad = vmaxvq_u8( vorrq_u8( err, open )) != 0;
+	return stop;
+}
+
+static alwaysInline size_t si_utf8Blocks ( const char *p, size_t len, bool lines, bool *bad ) {
+
+	return si_utf8Neon( p, len, lines, bad );
+}
+#else
+static alwaysInline size_t si_utf8Blocks ( const char *p, size_t len, bool lines, bool *bad ) {
+
+	return si_utf8ScalarLines( p, len, lines, bad );
+}
+#endif
+
+
+
+/**
+ * si_utf8_valid - true if [p, p + len) is well-formed UTF-8
+ *
+ * Rejects overlong forms, surrogates, code points above U+10FFFF and
+ * truncated sequences, as RFC 3629 requires. NUL bytes are valid ( U+0000 ).
+ */
+bool si_utf8_valid ( const char *p, size_t len ) {
+
+	bool bad;
+
+	if ( !p ) return len == 0;
+	si_utf8Blocks( p, len, false, &bad );
+	return !bad;
+}
+
+
+
+/**
+ * si_reader_getCharIn - si_reader_getCharFiltered() with a compiled charset
+ *
+ * usage - int c = si_reader_getCharIn( r, &menu );
+ *
+ * returns EOF on EOF
+ */
+int si_reader_getCharIn ( si_reader *r, const si_charset *cs ) {
+
+	si_guard( r );
+
+	if ( !cs ) {
+		si_report( r, SI_ERR_USAGE, "ERROR: NULL passed to 'cs'.\n" );
+		exit(EXIT_FAILURE);
+	}
+
+	const char *line;
+	size_t len;
+
+	while ( 1 ) {
+
+		int result = si_readLine( r, CHAR_INPUT_BUFFER_SIZE - 1, &line, &len );
+
+		if ( result == EOF ) return EOF;
+		if ( result == 1 ) continue;
+
+		// Ensure input is exactly one character
+		if ( len != 1 ) {
+			si_count( r, rejected[SI_REJECT_SYNTAX], 1 );
+			si_report( r, SI_ERR_INVALID, "Invalid input. Please enter a single character.\n" );
+			continue;
+		}
+
+		if ( si_charset_has( cs, (unsigned char)line[0] )) {
+			si_count( r, parsed[SI_FIELD_CHAR], 1 );
+			return (unsigned char)line[0];
+		}
+
+		si_count( r, rejected[SI_REJECT_CHOICE], 1 );
+		si_report( r, SI_ERR_INVALID, "Invalid input. Character not allowed.\n" );
+	}
+}
+
+
+
+/**
+ * si_reportAllowed - report a character outside the allowed set
+ *
+ * Very long allowed sets are cut short with "..." in the message.
+ */
+static cold void si_reportAllowed ( si_reader *r, const char *allowed ) {
+
+	char msg[256];
+	int n = snprintf( msg, sizeof(msg), "Invalid input. Allowed: %s\n", allowed );
+	if ( n >= (int)sizeof(msg) ) memcpy( msg + sizeof(msg) - 5, "...\n", 5 );
+	si_report( r, SI_ERR_INVALID, msg );
+}
+
+
+
+/**
+ * si_reader_getCharFiltered - a safer alternative to scanf for chars
+ *
+ * usage - int x = si_reader_getCharFiltered( r, "abc" );
+ * 
+ * returns EOF on error or EOF
+ */
+int si_reader_getCharFiltered ( si_reader *r, const char *allowed ) {
+
+	si_guard( r );
+
+	if ( !allowed ){
+		si_report( r, SI_ERR_USAGE, "ERROR: NULL passed to 'allowed'.\n" );
+		exit(EXIT_FAILURE);
+	}
+
+	if ( allowed[0] == '\0' ) {
+		si_report( r, SI_ERR_USAGE, "No allowed characters specified. Exiting.\n" );
+		return 1;
+	}
+
+	char buffer[CHAR_INPUT_BUFFER_SIZE];
+	size_t len = 0;
+
+	while ( 1 ) {
+
+		int result = si_readByte( r, buffer, sizeof(buffer) - 1, &len );
+		buffer[len] = '\0';
+		
+		if ( result == EOF ) return EOF;
+		if ( result == 1 ) continue;
+		
+		// Ensure input is exactly one character
+		if ( len != 1 ) {
+			si_count( r, rejected[SI_REJECT_SYNTAX], 1 );
+			si_report( r, SI_ERR_INVALID, "Invalid input. Please enter a single character.\n" );
+			continue;
+		}
+
+		char c = buffer[0];
+
+		if ( strchr( allowed, c ) != NULL ) {
+			si_count( r, parsed[SI_FIELD_CHAR], 1 );
+			return (unsigned char)c;
+		}
+	
+		si_count( r, rejected[SI_REJECT_CHOICE], 1 );
+		si_reportAllowed( r, allowed );
+		
+	}
+}
+
+
+
+/**
+ * Allocators
+ *
+ * The string getters allocate through the reader's si_allocator, which
+ * defaults to malloc()/free(). si_arena is a bump allocator meant to be
+ * plugged in there: thousands of strings cost a pointer bump each and are
+ * all released by one si_arena_reset().
+ */
+#define SI_ARENA_CHUNK	( 64 * 1024 )
+#define SI_ARENA_ALIGN	16
+
+typedef struct si_arenaChunk {
+	struct si_arenaChunk	*next;
+	size_t					size;	// usable bytes in data
+	size_t					used;
+	unsigned char			data[];
+} si_arenaChunk;
+
+struct si_arena {
+	si_arenaChunk	*head;
+	si_arenaChunk	*current;	// first chunk that may still have room
+	size_t			chunkSize;
+};
+
+
+
+/**
+ * si_alloc - allocate through the reader's allocator
+ */
+static alwaysInline void *si_alloc ( const si_allocator *a, size_t size ) {
+
+	return a->alloc ? a->alloc( a->ctx, size ) : malloc( size );
+}
+
+
+
+/**
+ * si_arenaNewChunk - malloc a chunk with room for at least size aligned bytes
+ */
+static cold si_arenaChunk *si_arenaNewChunk ( size_t chunkSize, size_t size ) {
+
+	if ( size > SIZE_MAX - sizeof(si_arenaChunk) - SI_ARENA_ALIGN ) return NULL;
+
+	size_t want = size + SI_ARENA_ALIGN > chunkSize ? size + SI_ARENA_ALIGN : chunkSize;
+	si_arenaChunk *c = malloc( sizeof(*c) + want );
+	if ( !c ) return NULL;
+
+	c->next = NULL;
+	c->size = want;
+	c->used = 0;
+	return c;
+}
+
+
+
+/**
+ * si_arena_create - create a bump arena that allocates in chunkSize blocks
+ *
+ * @chunkSize:	bytes per chunk, 0 for the 64 KiB default
+ *
+ * NOTE:	an arena is not thread-safe, give each worker its own.
+ *
+ * returns NULL on allocation failure
+ */
+si_arena *si_arena_create ( size_t chunkSize ) {
+
+	si_arena *a = malloc( sizeof(*a) );
+	if ( !a ) return NULL;
+
+	a->chunkSize = chunkSize ? chunkSize : SI_ARENA_CHUNK;
+	a->head = a->current = si_arenaNewChunk( a->chunkSize, 0 );
+	if ( !a->head ) {
+		free( a );
+		return NULL;
+	}
+
+	return a;
+}
+
+
+
+/**
+ * si_arena_alloc - bump-allocate size bytes, aligned to SI_ARENA_ALIGN
+ *
+ * Memory stays valid until the next si_arena_reset() or si_arena_destroy().
+ *
+ * returns NULL on allocation failure
+ */
+void *si_arena_alloc ( si_arena *a, size_t size ) {
+
+	if ( !a ) return NULL;
+
+	si_arenaChunk *c = a->current;
+
+	while ( 1 ) {
+		uintptr_t base = (uintptr_t)c->data;
+		uintptr_t at = ( base + c->used + SI_ARENA_ALIGN - 1 ) & ~(uintptr_t)( SI_ARENA_ALIGN - 1 );
+		size_t offset = (size_t)( at - base );
+
+		if ( offset <= c->size && size <= c->size - offset ) {
+			c->used = offset + size;
+			a->current = c;
+			return c->data + offset;
+		}
+
+		if ( !c->next ) break;
+		c = c->next;
+	}
+
+	c->next = si_arenaNewChunk( a->chunkSize, size );
+	if ( !c->next ) return NULL;
+
+	c = a->current = c->next;
+	uintptr_t base = (uintptr_t)c->data;
+	size_t offset = (size_t)((( base + SI_ARENA_ALIGN - 1 ) & ~(uintptr_t)( SI_ARENA_ALIGN - 1 )) - base );
+	c->used = offset + size;
+	return c->data + offset;
+}
+
+
+
+/**
+ * si_arena_reset - release everything allocated from the arena at once
+ *
+ * The chunks are kept for reuse, so a steady workload stops calling malloc.
+ */
+void si_arena_reset ( si_arena *a ) {
+
+	if ( !a ) return;
+
+	for ( si_arenaChunk *c = a->head; c; c = c->next ) c->used = 0;
+	a->current = a->head;
+}
+
+
+
+/**
+ * si_arena_destroy - free the arena and all of its chunks
+ */
+void si_arena_destroy ( si_arena *a ) {
+
+	if ( !a ) return;
+
+	si_arenaChunk *c = a->head;
+	while ( c ) {
+		si_arenaChunk *next = c->next;
+		free( c );
+		c = next;
+	}
+
+	free( a );
+}
+
+
+
+static void *si_arenaAllocHook ( void *ctx, size_t size ) {
+
+	return si_arena_alloc( ctx, size );
+}
+
+
+
+/**
+ * si_arena_allocator - an si_allocator that allocates from the arena
+ *
+ * Its free hook is NULL: individual strings are never freed, only reset.
+ */
+si_allocator si_arena_allocator ( si_arena *a ) {
+
+	return (si_allocator){ si_arenaAllocHook, NULL, a };
+}
+
+
+
+/**
+ * si_reader_setAllocator - select the allocator used by the reader's string getters
+ *
+ * @a:			allocator to copy, or NULL to go back to malloc()/free().
+ * 				a->free may be NULL when the memory is released in bulk.
+ *
+ * returns false on a NULL reader or an allocator without an alloc hook
+ */
+bool si_reader_setAllocator ( si_reader *r, const si_allocator *a ) {
+
+	if ( !r || ( a && !a->alloc )) return false;
+
+	r->alloc = a ? *a : (si_allocator){ NULL, NULL, NULL };
+	return true;
+}
+
+
+
+/**
+ * si_reader_release - free a string returned by one of the reader's getters
+ *
+ * Goes through the reader's allocator, so it is free() by default and a
+ * no-op for allocators without a free hook.
+ */
+void si_reader_release ( si_reader *r, void *ptr ) {
+
+	if ( !r || !ptr ) return;
+
+	if ( r->alloc.free ) r->alloc.free( r->alloc.ctx, ptr );
+	else if ( !r->alloc.alloc ) free( ptr );
+}
+
+
+
+/**
+ * si_reader_getCString - allocates and returns a line of user input from a reader
+ *
+ * NOTE: 	Caller must free the returned string!!!
+ * 			( si_reader_release() if the reader has a custom allocator )
+ * 
+ *
+ * safe usage example
+ * 
+ *
+ *	char *input = si_reader_getCString( r );
+ *
+ *	if (!input) fputs( "Failed to read input. Try again.\n", stderr );
+ *	else {
+ *		printf("You entered: %s\n", input);
+ *		free(input);
+ *		input = NULL;
+ *	}
+ *
+ * NOTE: 	we use memcpy() because it copies exactly len bytes from the reader's
+ *			buffer before terminating, avoiding overflow and termination issues.
+ * 			the overhead is minimal, memcpy() is well optimized.
+ * 
+ * returns NULL on error or EOF
+ */
+char *si_reader_getCString ( si_reader *r ) {
+
+	si_guard( r );
+
+	if ( !r ) return NULL;
+
+	// one byte less than si_getString, as with the original fixed buffer
+	return si_reader_getCStringMax( r, r->lineLimit - 2 );
+}
+
+
+
+/**
+ * si_reader_getCStringMax - si_reader_getCString() for lines of up to max bytes
+ *
+ * Longer lines are drained and rejected, max is capped at SI_LINE_MAX - 1.
+ * The returned buffer is max + 1 bytes at most.
+ */
+char *si_reader_getCStringMax ( si_reader *r, size_t max ) {
+
+	si_guard( r );
+
+	const char *line;
+	size_t len;
+
+	// read input (return NULL on error/EOF )
+	if ( si_readLine( r, si_maxToLimit( max ), &line, &len )) return NULL;
+
+	// Allocate memory for string( length + 1 for null terminator )
+	char *str = si_alloc( &r->alloc, len+1 );
+	// Check for allocation failure
+	if ( !str ) {
+		si_report( r, SI_ERR_NOMEM, "Memory allocation failed.\n" );
+		return NULL;
+	}
+
+	si_count( r, parsed[SI_FIELD_STRING], 1 );
+	si_count( r, allocs, 1 );
+	si_count( r, allocBytes, len + 1 );
+
+	// copy the line straight out of the reader and terminate it
+	memcpy( str, line, len );
+	str[len] = '\0';
+	return str;
+}
+
+
+
+
+
+
+/**
+ * si_reader_getString - reads a line from a reader into a heap-allocated si_string
+ * 
+ * NOTE: 	Caller is responsible for freeing the returned buffer:
+ * 			free(str.data);
+ * 			( si_reader_release() if the reader has a custom allocator )
+ * 
+ * Safe usage example:
+ * 
+ * 		si_string str = si_reader_getString( r );
+ *
+ *		if (!str.data) return;
+ *		printf("%.*s", (int)str.len, str.data)
+ *		free(str.data);
+ *		str.data = NULL;
+ *
+ * NOTE: 	Uses si_reader_retainString() to copy exactly len bytes from the reader
+ * 			No null terminator is appended-use the length field for safe access.
+ * 
+ * Returns:
+ * 		A si_string with .data == NULL and .len == 0 on error or EOF,
+ * 		otherwise .data points to malloc( len ? len : 1 ) and .len is the byte count.
+ */
+si_string si_reader_getString ( si_reader *r ) {
+
+	si_guard( r );
+
+	// read input ( returns { NULL, 0 } on error/EOF ), then copy it out
+	return si_reader_retainString( r, si_reader_getStringView( r ));
+}
+
+
+
+/**
+ * si_reader_getStringMax - si_reader_getString() for lines of up to max bytes
+ *
+ * Longer lines are drained and rejected, max is capped at SI_LINE_MAX - 1.
+ */
+si_string si_reader_getStringMax ( si_reader *r, size_t max ) {
+
+	si_guard( r );
+
+	return si_reader_retainString( r, si_reader_getStringViewMax( r, max ));
+}
+
+
+
+/**
+ * si_reader_getStringView - reads a line as a view into the reader's buffer
+ *
+ * Zero-copy variant of si_reader_getString(): nothing is allocated and
+ * nothing needs to be freed.
+ *
+ * NOTE: 	The view is only valid until the next read from the same reader,
+ * 			and must not be written through. Use si_retainString() to keep it.
+ *
+ * Safe usage example:
+ *
+ * 		si_string line = si_reader_getStringView( r );
+ *
+ *		if (!line.data) return;
+ *		printf("%.*s", (int)line.len, line.data);
+ *
+ * Returns:
+ * 		A si_string with .data == NULL and .len == 0 on error or EOF,
+ * 		otherwise .data points into the reader and .len is the byte count.
+ */
+hotApi si_string si_reader_getStringView ( si_reader *r ) {
+
+	si_guard( r );
+
+	if ( !r ) return (si_string){ NULL, 0 };
+	return si_reader_getStringViewMax( r, r->lineLimit - 1 );
+}
+
+
+
+/**
+ * si_reader_getStringViewMax - si_reader_getStringView() for lines of up to max bytes
+ *
+ * Longer lines are drained and rejected, max is capped at SI_LINE_MAX - 1.
+ */
+hotApi si_string si_reader_getStringViewMax ( si_reader *r, size_t max ) {
+
+	si_guard( r );
+
+	const char *line;
+	size_t len;
+
+	if ( si_readLine( r, si_maxToLimit( max ), &line, &len )) return (si_string){ NULL, 0 };
+
+	si_count( r, parsed[SI_FIELD_STRING], 1 );
+	return (si_string){ (char *)line, len };
+}
+
+
+
+/**
+ * si_copyString - copy a view into memory from r's allocator ( malloc if r is NULL )
+ */
+static si_string si_copyString ( si_reader *r, si_string view ) {
+
+	static const si_allocator heap = { NULL, NULL, NULL };
+
+	if ( !view.data ) return (si_string){ NULL, 0 };
+
+	// Allocate memory for string data, length is stored in len parameter
+	si_string str;
+	str.data = si_alloc( r ? &r->alloc : &heap, view.len ? view.len : 1 );
+	if ( !str.data ) {
+		si_report( r, SI_ERR_NOMEM, "Memory allocation failed.\n" );
+		return (si_string){ NULL, 0 };
+	}
+
+	if ( r ) {
+		si_count( r, allocs, 1 );
+		si_count( r, allocBytes, view.len ? view.len : 1 );
+	}
+
+	// copy the view to string data
+	memcpy( str.data, view.data, view.len );
+	str.len = view.len;
+	return str;
+}
+
+
+
+/**
+ * si_retainString - copy a view into a heap-allocated si_string
+ *
+ * NOTE: 	Caller is responsible for freeing the returned buffer:
+ * 			free(str.data);
+ *
+ * Returns:
+ * 		A si_string with .data == NULL and .len == 0 if view.data is NULL or
+ * 		allocation fails, otherwise .data points to malloc( len ? len : 1 ).
+ */
+si_string si_retainString ( si_string view ) {
+
+	return si_copyString( NULL, view );
+}
+
+
+
+/**
+ * si_reader_retainString - si_retainString() through the reader's allocator
+ *
+ * Release the result with si_reader_release( r, str.data ).
+ */
+si_string si_reader_retainString ( si_reader *r, si_string view ) {
+
+	if ( !r ) return (si_string){ NULL, 0 };
+	return si_copyString( r, view );
+}
+
+
+
+/**
+ * si_reader_getBool - a safer alternative to scanf for boolean values
+ *
+ * Accepts "y" or "n" (case-insensitive).
+ *
+ * usage - bool x = si_reader_getBool( r );
+ * 
+ * returns false on EOF. Terrible solution but it's the best i could figure out.
+ */
+bool si_reader_getBool ( si_reader *r ) {
+
+	si_guard( r );
+
+	while ( 1 ) {
+		// Read single character, convert to lowercase
+		int c = si_reader_getChar( r );
+
+		if ( c == EOF ) {
+			si_report( r, SI_ERR_EOF, "EOF detected. Returning false by default.\n" );
+			return false;
+		}
+
+		// we avoid using tolower() due to EOF potentially triggering UB
+		if ( c == 'Y' || c == 'y' || c == 'N' || c == 'n' ) {
+			si_count( r, parsed[SI_FIELD_BOOL], 1 );
+			return c == 'Y' || c == 'y';
+		}
+		si_count( r, rejected[SI_REJECT_CHOICE], 1 );
+		si_report( r, SI_ERR_INVALID, "Invalid input. Enter 'y' or 'n'.\n" );
+	}
+}
+
+
+
+/**
+ * Status getters
+ *
+ * si_reader_tryGetX() reads one line like si_reader_getX() but never retries
+ * or prints: the outcome is returned as an si_result and *out is written
+ * only on SI_OK. Bad input costs one line, so batch and streaming consumers
+ * can skip a broken record and move on.
+ *
+ * Returns:
+ * 		SI_OK 			- on success
+ * 		SI_INVALID		- the line is not a valid value of the type
+ * 		SI_OVERFLOW		- the value is out of the type's range
+ * 		SI_TOO_LONG		- the line exceeded the getter's buffer size
+ * 		SI_WOULD_BLOCK	- non-blocking reader without a complete line
+ * 		SI_EOF			- on EOF, read error or NULL arguments
+ */
+static alwaysInline si_result si_statusOf ( int result ) {
+
+	return result == SI_PARSE_OK ? SI_OK : result == SI_PARSE_RANGE ? SI_OVERFLOW : SI_INVALID;
+}
+
+static alwaysInline si_result si_parseStatus ( si_reader *r, int result ) {
+
+	if ( result == SI_PARSE_OK ) return SI_OK;
+	si_countReject( r, result );
+	return si_tally( r, si_statusOf( result ));
+}
+
+/**
+ * si_tryValue - shared body of the numeric si_reader_tryGetX() functions
+ *
+ * Parses into a scratch value first so *out is untouched on failure.
+ * Bounds work as in si_getValueIn(), a value outside them is SI_OVERFLOW.
+ */
+static alwaysInline si_result si_tryValueIn ( si_reader *r, void *out, size_t size,
+											  int ( *parse )( const char *, size_t, void * ), const void *lo, const void *hi ) {
+
+	const char *line;
+	size_t len;
+	union { long long ll; unsigned long long ull; double d; float f; int i; unsigned u; long l; unsigned long ul; } value;
+
+	if ( !r || !out ) return SI_EOF;
+
+	si_result status = si_tryLine( r, INPUT_BUFFER_SIZE - 1, &line, &len );
+	if ( status ) return status;
+
+	int result = parse( line, len, &value );
+	if ( !result && unlikely( !si_inBounds( parse, &value, lo, hi ))) result = SI_PARSE_RANGE;
+
+	status = si_parseStatus( r, result );
+	if ( status ) return status;
+
+	si_count( r, parsed[ si_tokType( parse ) ], 1 );
+	memcpy( out, &value, size );
+	return SI_OK;
+}
+
+static alwaysInline si_result si_tryValue ( si_reader *r, void *out, size_t size,
+											int ( *parse )( const char *, size_t, void * )) {
+
+	return si_tryValueIn( r, out, size, parse, NULL, NULL );
+}
+
+
+
+hotApi si_result si_reader_tryGetInt ( si_reader *r, int *out ) {
+
+	si_guard( r );
+
+	return si_tryValue( r, out, sizeof(*out), si_tokInt );
+}
+
+
+
+hotApi si_result si_reader_tryGetUInt ( si_reader *r, unsigned int *out ) {
+
+	si_guard( r );
+
+	return si_tryValue( r, out, sizeof(*out), si_tokUInt );
+}
+
+
+
+hotApi si_result si_reader_tryGetFloat ( si_reader *r, float *out ) {
+
+	si_guard( r );
+
+	return si_tryValue( r, out, sizeof(*out), si_tokFloat );
+}
+
+
+
+hotApi si_result si_reader_tryGetDouble ( si_reader *r, double *out ) {
+
+	si_guard( r );
+
+	return si_tryValue( r, out, sizeof(*out), si_tokDouble );
+}
+
+
+
+hotApi si_result si_reader_tryGetLong ( si_reader *r, long *out ) {
+
+	si_guard( r );
+
+	return si_tryValue( r, out, sizeof(*out), si_tokLong );
+}
+
+
+
+hotApi si_result si_reader_tryGetULong ( si_reader *r, unsigned long *out ) {
+
+	si_guard( r );
+
+	return si_tryValue( r, out, sizeof(*out), si_tokULong );
+}
+
+
+
+hotApi si_result si_reader_tryGetLongLong ( si_reader *r, long long *out ) {
+
+	si_guard( r );
+
+	return si_tryValue( r, out, sizeof(*out), si_tokLongLong );
+}
+
+
+
+hotApi si_result si_reader_tryGetULongLong ( si_reader *r, unsigned long long *out ) {
+
+	si_guard( r );
+
+	return si_tryValue( r, out, sizeof(*out), si_tokULongLong );
+}
+
+
+
+/**
+ * si_reader_tryGetChar - an empty line reads as '\n', like si_reader_getChar()
+ */
+hotApi si_result si_reader_tryGetChar ( si_reader *r, char *out ) {
+
+	si_guard( r );
+
+	const char *line;
+	size_t len;
+
+	if ( !r || !out ) return SI_EOF;
+
+	si_result status = si_tryLine( r, CHAR_INPUT_BUFFER_SIZE - 1, &line, &len );
+	if ( status ) return status;
+
+	if ( len > 1 ) {
+		si_count( r, rejected[SI_REJECT_SYNTAX], 1 );
+		return si_tally( r, SI_INVALID );
+	}
+
+	si_count( r, parsed[SI_FIELD_CHAR], 1 );
+	*out = len ? line[0] : '\n';
+	return SI_OK;
+}
+
+
+
+/**
+ * si_reader_tryGetBool - accepts "y" or "n" ( case-insensitive )
+ */
+si_result si_reader_tryGetBool ( si_reader *r, bool *out ) {
+
+	si_guard( r );
+
+	char c;
+
+	if ( !out ) return SI_EOF;
+
+	si_result status = si_reader_tryGetChar( r, &c );
+	if ( status ) return status;
+
+	if ( c == 'Y' || c == 'y' ) *out = true;
+	else if ( c == 'N' || c == 'n' ) *out = false;
+	else {
+		si_count( r, rejected[SI_REJECT_CHOICE], 1 );
+		return si_tally( r, SI_INVALID );
+	}
+
+	si_count( r, parsed[SI_FIELD_BOOL], 1 );
+	return SI_OK;
+}
+
+
+/**
+ * si_reader_tryGetLineIn - fetch a line that consists only of members of cs
+ *
+ * @line:		receives a view of the line, valid until the next read from r
+ *
+ * Lines must be shorter than the reader's line limit. The whole line is
+ * validated with si_charset_span().
+ *
+ * returns SI_OK, SI_INVALID if a byte is outside cs, or si_reader_readLine()'s
+ * failure statuses
+ */
+si_result si_reader_tryGetLineIn ( si_reader *r, const si_charset *cs, si_string *line ) {
+
+	si_guard( r );
+
+	if ( !r || !cs || !line ) return SI_EOF;
+
+	si_result status = si_reader_readLine( r, line );
+	if ( status ) return status;
+
+	if ( si_charset_span( cs, line->data, line->len ) != line->len ) {
+		si_count( r, rejected[SI_REJECT_CHOICE], 1 );
+		*line = (si_string){ NULL, 0 };
+		return si_tally( r, SI_INVALID );
+	}
+
+	return SI_OK;
+}
+
+
+
+/**
+ * UTF-8 getters
+ *
+ * The string getters with a Utf8 suffix only return lines that are valid
+ * UTF-8, and si_reader_getCodepoint() is si_reader_getChar() for one
+ * character of up to four bytes. A line that is fully buffered, nearly
+ * all of them, is validated by the same vector pass that finds its
+ * newline ( si_utf8Blocks ), so checking costs no second pass over the
+ * bytes; a line that needed a refill is checked once it is complete.
+ */
+#define SI_CODEPOINT_LIMIT	5	// line limit for one character, as CHAR_INPUT_BUFFER_SIZE is for a byte
+
+/**
+ * si_nextLineUtf8 - si_nextLine() that also checks the line is UTF-8
+ *
+ * Returns:
+ * 		0 - on success
+ * 		1 - on a line that exceeds maxLen ( the rest of it is drained )
+ * 		2 - on a complete line that isn't valid UTF-8 ( it is consumed )
+ *	   -1 - on EOF, or with r->blocked set when no full line is buffered yet
+ */
+static alwaysInline int si_nextLineUtf8 ( si_reader *r, size_t maxLen, const char **line, size_t *outLen ) {
+
+	const char *start = r->buf + r->pos;
+	size_t avail = r->end - r->pos;
+	bool bad;
+	size_t len = si_utf8Blocks( start, avail, true, &bad );
+
+	if ( unlikely( len == avail || r->skipping || len >= maxLen )) {
+		int result = si_nextLineSlow( r, maxLen, line, outLen );
+		if ( result ) return result;
+		return si_utf8_valid( *line, *outLen ) ? 0 : 2;
+	}
+
+	r->blocked = false;
+	si_consumeLine( r, r->pos + len + 1 );
+	*line = start;
+	*outLen = len;
+	return bad ? 2 : 0;
+}
+
+/**
+ * si_readLineUtf8 - si_readLine() that reports and skips lines that aren't UTF-8
+ */
+static alwaysInline int si_readLineUtf8 ( si_reader *r, size_t maxLen, const char **line, size_t *outLen ) {
+
+	if ( unlikely( !r )) return 1;
+
+	while ( 1 ) {
+
+		*outLen = 0;
+
+		int result = si_nextLineUtf8( r, maxLen, line, outLen );
+		if ( result != 2 ) {
+			if ( unlikely( result == 1 )) si_report( r, SI_ERR_TOO_LONG, "Input exceeding buffer size. Try again.\n" );
+			return result;
+		}
+
+		si_count( r, rejected[SI_REJECT_SYNTAX], 1 );
+		si_report( r, SI_ERR_INVALID, "Invalid input. Not valid UTF-8. Try again.\n" );
+	}
+}
+
+/**
+ * si_tryLineUtf8 - si_tryLine() for UTF-8 lines, SI_INVALID if a line isn't
+ */
+static alwaysInline si_result si_tryLineUtf8 ( si_reader *r, size_t maxLen, const char **line, size_t *outLen ) {
+
+	*outLen = 0;
+
+	switch ( si_nextLineUtf8( r, maxLen, line, outLen )) {
+		case 0:		return SI_OK;
+		case 1:		return si_tally( r, SI_TOO_LONG );
+		case 2:		si_count( r, rejected[SI_REJECT_SYNTAX], 1 );
+					return si_tally( r, SI_INVALID );
+		default:	return r->blocked ? SI_WOULD_BLOCK : SI_EOF;
+	}
+}
+
+/**
+ * si_utf8Single - the code point of a line that holds exactly one
+ * 				   valid character, or -1
+ */
+static alwaysInline long si_utf8Single ( const char *line, size_t len ) {
+
+	const unsigned char *p = (const unsigned char *)line;
+
+	if ( len == 1 ) return p[0];
+	if ( len == 2 && p[0] >= 0xC0 && p[0] < 0xE0 ) return ( p[0] & 0x1F ) << 6 | ( p[1] & 0x3F );
+	if ( len == 3 && p[0] >= 0xE0 && p[0] < 0xF0 ) return ( p[0] & 0x0F ) << 12 | ( p[1] & 0x3F ) << 6 | ( p[2] & 0x3F );
+	if ( len == 4 && p[0] >= 0xF0 ) return (long)( p[0] & 0x07 ) << 18 | ( p[1] & 0x3F ) << 12 | ( p[2] & 0x3F ) << 6 | ( p[3] & 0x3F );
+	return -1;
+}
+
+
+
+/**
+ * si_reader_getCodepoint - si_reader_getChar() for one UTF-8 character
+ *
+ * usage - int c = si_reader_getCodepoint( r ); // 'é' is 0xE9
+ *
+ * IMPORTANT: Only accepts one character, of one to four bytes. An empty
+ * 			  line reads as '\n', as with si_reader_getChar().
+ *
+ * returns the code point, or EOF on EOF
+ */
+hotApi int si_reader_getCodepoint ( si_reader *r ) {
+
+	si_guard( r );
+
+	const char *line;
+	size_t len;
+
+	while ( 1 ) {
+
+		int result = si_readLineUtf8( r, SI_CODEPOINT_LIMIT, &line, &len );
+
+		if ( result == EOF ) return EOF;
+		if ( result == 1 ) {
+			if ( !r ) return EOF;
+			continue;
+		}
+
+		long c = len ? si_utf8Single( line, len ) : '\n';
+		if ( c >= 0 ) {
+			si_count( r, parsed[SI_FIELD_CHAR], 1 );
+			return (int)c;
+		}
+
+		si_count( r, rejected[SI_REJECT_SYNTAX], 1 );
+		si_report( r, SI_ERR_INVALID, "Invalid input. Please enter a single character.\n" );
+	}
+}
+
+
+
+/**
+ * si_reader_getStringViewUtf8 - si_reader_getStringView() for UTF-8 lines
+ *
+ * Lines that aren't valid UTF-8 are reported ( "Invalid input. Not valid
+ * UTF-8. Try again." ) and skipped, like unparsable numbers.
+ *
+ * Returns:
+ * 		A si_string with .data == NULL and .len == 0 on error or EOF,
+ * 		otherwise a view valid until the next read from r.
+ */
+hotApi si_string si_reader_getStringViewUtf8 ( si_reader *r ) {
+
+	si_guard( r );
+
+	const char *line;
+	size_t len;
+
+	if ( !r || si_readLineUtf8( r, r->lineLimit, &line, &len )) return (si_string){ NULL, 0 };
+
+	si_count( r, parsed[SI_FIELD_STRING], 1 );
+	return (si_string){ (char *)line, len };
+}
+
+
+
+/**
+ * si_reader_getStringUtf8 - si_reader_getString() for UTF-8 lines
+ *
+ * NOTE: 	Caller is responsible for freeing str.data, as for si_reader_getString().
+ */
+si_string si_reader_getStringUtf8 ( si_reader *r ) {
+
+	si_guard( r );
+
+	return si_reader_retainString( r, si_reader_getStringViewUtf8( r ));
+}
+
+
+
+/**
+ * si_reader_getCStringUtf8 - si_reader_getCString() for UTF-8 lines
+ *
+ * NOTE: 	Caller must free the returned string, as for si_reader_getCString().
+ * 			U+0000 is valid UTF-8, so the line may hold embedded NULs.
+ *
+ * returns NULL on error or EOF
+ */
+char *si_reader_getCStringUtf8 ( si_reader *r ) {
+
+	si_guard( r );
+
+	const char *line;
+	size_t len;
+
+	if ( !r || si_readLineUtf8( r, r->lineLimit - 1, &line, &len )) return NULL;
+
+	char *str = si_alloc( &r->alloc, len + 1 );
+	if ( !str ) {
+		si_report( r, SI_ERR_NOMEM, "Memory allocation failed.\n" );
+		return NULL;
+	}
+
+	si_count( r, parsed[SI_FIELD_STRING], 1 );
+	si_count( r, allocs, 1 );
+	si_count( r, allocBytes, len + 1 );
+
+	memcpy( str, line, len );
+	str[len] = '\0';
+	return str;
+}
+
+
+
+/**
+ * si_reader_tryGetCodepoint - si_reader_tryGetChar() for one UTF-8 character
+ */
+hotApi si_result si_reader_tryGetCodepoint ( si_reader *r, uint32_t *out ) {
+
+	si_guard( r );
+
+	const char *line;
+	size_t len;
+
+	if ( !r || !out ) return SI_EOF;
+
+	si_result status = si_tryLineUtf8( r, SI_CODEPOINT_LIMIT, &line, &len );
+	if ( status ) return status;
+
+	long c = len ? si_utf8Single( line, len ) : '\n';
+	if ( c < 0 ) {
+		si_count( r, rejected[SI_REJECT_SYNTAX], 1 );
+		return si_tally( r, SI_INVALID );
+	}
+
+	si_count( r, parsed[SI_FIELD_CHAR], 1 );
+	*out = (uint32_t)c;
+	return SI_OK;
+}
+
+
+
+/**
+ * si_reader_tryGetLineUtf8 - si_reader_readLine() that only takes UTF-8 lines
+ *
+ * @line:		receives a view of the line, valid until the next read from r
+ *
+ * returns SI_OK, SI_INVALID if the line isn't valid UTF-8 ( it is consumed ),
+ * 		   or si_reader_readLine()'s failure statuses
+ */
+hotApi si_result si_reader_tryGetLineUtf8 ( si_reader *r, si_string *line ) {
+
+	si_guard( r );
+
+	const char *p;
+	size_t len;
+
+	if ( !r || !line ) return SI_EOF;
+
+	si_result status = si_tryLineUtf8( r, r->lineLimit, &p, &len );
+	*line = status ? (si_string){ NULL, 0 } : (si_string){ (char *)p, len };
+	return status;
+}
+
+
+
+/**
+ * Bounded getters
+ *
+ * si_reader_getXRange() and si_reader_tryGetXRange() take only values in
+ * [lo, hi]. The bounds are checked inside the parse loop, on the value
+ * just parsed and in its own type, so there is no post-check or second
+ * round trip: a value outside them is rejected like one outside the type,
+ * with "Value out of range. Try again." and a retry, or SI_OVERFLOW.
+ * In the single-header build the getters are inline, so constant bounds
+ * fold straight into the compares.
+ *
+ * An empty range ( lo > hi, or a NaN bound ) could never be satisfied:
+ * the looping getters report it and exit, the status getters return SI_EOF.
+ */
+static cold void si_emptyRange ( si_reader *r ) {
+
+	if ( r ) si_count( r, rejected[SI_REJECT_USAGE], 1 );
+	si_report( r, SI_ERR_USAGE, "ERROR: empty range, 'lo' > 'hi'. Exiting.\n" );
+	exit(EXIT_FAILURE);
+}
+
+
+
+/**
+ * si_reader_getIntRange - si_reader_getInt() for integers in [lo, hi]
+ *
+ * usage - int x = si_reader_getIntRange( r, 1, 12 );
+ *
+ * returns INT_MIN on error or EOF
+ */
+hotApi int si_reader_getIntRange ( si_reader *r, int lo, int hi ) {
+
+	si_guard( r );
+
+	if ( unlikely( !( lo <= hi ))) si_emptyRange( r );
+
+	int value;
+	return si_getValueIn( r, &value, si_tokInt, &lo, &hi ) ? value : INT_MIN;
+}
+
+
+
+/**
+ * si_reader_getUIntRange - si_reader_getUInt() for unsigned integers in [lo, hi]
+ *
+ * usage - unsigned int x = si_reader_getUIntRange( r, 1, 65535 );
+ *
+ * returns UINT_MAX on error or EOF
+ */
+hotApi unsigned int si_reader_getUIntRange ( si_reader *r, unsigned int lo, unsigned int hi ) {
+
+	si_guard( r );
+
+	if ( unlikely( !( lo <= hi ))) si_emptyRange( r );
+
+	unsigned int value;
+	return si_getValueIn( r, &value, si_tokUInt, &lo, &hi ) ? value : UINT_MAX;
+}
+
+
+
+/**
+ * si_reader_getLongRange - si_reader_getLong() for longs in [lo, hi]
+ *
+ * usage - long x = si_reader_getLongRange( r, -86400, 86400 );
+ *
+ * returns LONG_MIN on error or EOF
+ */
+hotApi long si_reader_getLongRange ( si_reader *r, long lo, long hi ) {
+
+	si_guard( r );
+
+	if ( unlikely( !( lo <= hi ))) si_emptyRange( r );
+
+	long value;
+	return si_getValueIn( r, &value, si_tokLong, &lo, &hi ) ? value : LONG_MIN;
+}
+
+
+
+/**
+ * si_reader_getULongRange - si_reader_getULong() for unsigned longs in [lo, hi]
+ *
+ * usage - unsigned long x = si_reader_getULongRange( r, 1, 4096 );
+ *
+ * returns ULONG_MAX on error or EOF
+ */
+hotApi unsigned long si_reader_getULongRange ( si_reader *r, unsigned long lo, unsigned long hi ) {
+
+	si_guard( r );
+
+	if ( unlikely( !( lo <= hi ))) si_emptyRange( r );
+
+	unsigned long value;
+	return si_getValueIn( r, &value, si_tokULong, &lo, &hi ) ? value : ULONG_MAX;
+}
+
+
+
+/**
+ * si_reader_getLongLongRange - si_reader_getLongLong() for long longs in [lo, hi]
+ *
+ * usage - long long x = si_reader_getLongLongRange( r, 0, LLONG_MAX / 2 );
+ *
+ * returns LLONG_MIN on error or EOF
+ */
+hotApi long long si_reader_getLongLongRange ( si_reader *r, long long lo, long long hi ) {
+
+	si_guard( r );
+
+	if ( unlikely( !( lo <= hi ))) si_emptyRange( r );
+
+	long long value;
+	return si_getValueIn( r, &value, si_tokLongLong, &lo, &hi ) ? value : LLONG_MIN;
+}
+
+
+
+/**
+ * si_reader_getULongLongRange - si_reader_getULongLong() for unsigned long longs in [lo, hi]
+ *
+ * usage - unsigned long long x = si_reader_getULongLongRange( r, 1, 1ull << 40 );
+ *
+ * returns ULLONG_MAX on error or EOF
+ */
+hotApi unsigned long long si_reader_getULongLongRange ( si_reader *r, unsigned long long lo, unsigned long long hi ) {
+
+	si_guard( r );
+
+	if ( unlikely( !( lo <= hi ))) si_emptyRange( r );
+
+	unsigned long long value;
+	return si_getValueIn( r, &value, si_tokULongLong, &lo, &hi ) ? value : ULLONG_MAX;
+}
+
+
+
+/**
+ * si_reader_getFloatRange - si_reader_getFloat() for floating point numbers in [lo, hi]
+ *
+ * usage - float x = si_reader_getFloatRange( r, 0.0f, 1.0f );
+ *
+ * returns NAN on error or EOF
+ */
+hotApi float si_reader_getFloatRange ( si_reader *r, float lo, float hi ) {
+
+	si_guard( r );
+
+	if ( unlikely( !( lo <= hi ))) si_emptyRange( r );
+
+	float value;
+	return si_getValueIn( r, &value, si_tokFloat, &lo, &hi ) ? value : NAN;
+}
+
+
+
+/**
+ * si_reader_getDoubleRange - si_reader_getDouble() for doubles in [lo, hi]
+ *
+ * usage - double x = si_reader_getDoubleRange( r, -90.0, 90.0 );
+ *
+ * returns NAN on error or EOF
+ */
+hotApi double si_reader_getDoubleRange ( si_reader *r, double lo, double hi ) {
+
+	si_guard( r );
+
+	if ( unlikely( !( lo <= hi ))) si_emptyRange( r );
+
+	double value;
+	return si_getValueIn( r, &value, si_tokDouble, &lo, &hi ) ? value : NAN;
+}
+
+
+
+hotApi si_result si_reader_tryGetIntRange ( si_reader *r, int lo, int hi, int *out ) {
+
+	si_guard( r );
+
+	if ( !( lo <= hi )) return SI_EOF;
+	return si_tryValueIn( r, out, sizeof(*out), si_tokInt, &lo, &hi );
+}
+
+
+
+hotApi si_result si_reader_tryGetUIntRange ( si_reader *r, unsigned int lo, unsigned int hi, unsigned int *out ) {
+
+	si_guard( r );
+
+	if ( !( lo <= hi )) return SI_EOF;
+	return si_tryValueIn( r, out, sizeof(*out), si_tokUInt, &lo, &hi );
+}
+
+
+
+hotApi si_result si_reader_tryGetLongRange ( si_reader *r, long lo, long hi, long *out ) {
+
+	si_guard( r );
+
+	if ( !( lo <= hi )) return SI_EOF;
+	return si_tryValueIn( r, out, sizeof(*out), si_tokLong, &lo, &hi );
+}
+
+
+
+hotApi si_result si_reader_tryGetULongRange ( si_reader *r, unsigned long lo, unsigned long hi, unsigned long *out ) {
+
+	si_guard( r );
+
+	if ( !( lo <= hi )) return SI_EOF;
+	return si_tryValueIn( r, out, sizeof(*out), si_tokULong, &lo, &hi );
+}
+
+
+
+hotApi si_result si_reader_tryGetLongLongRange ( si_reader *r, long long lo, long long hi, long long *out ) {
+
+	si_guard( r );
+
+	if ( !( lo <= hi )) return SI_EOF;
+	return si_tryValueIn( r, out, sizeof(*out), si_tokLongLong, &lo, &hi );
+}
+
+
+
+hotApi si_result si_reader_tryGetULongLongRange ( si_reader *r, unsigned long long lo, unsigned long long hi, unsigned long long *out ) {
+
+	si_guard( r );
+
+	if ( !( lo <= hi )) return SI_EOF;
+	return si_tryValueIn( r, out, sizeof(*out), si_tokULongLong, &lo, &hi );
+}
+
+
+
+hotApi si_result si_reader_tryGetFloatRange ( si_reader *r, float lo, float hi, float *out ) {
+
+	si_guard( r );
+
+	if ( !( lo <= hi )) return SI_EOF;
+	return si_tryValueIn( r, out, sizeof(*out), si_tokFloat, &lo, &hi );
+}
+
+
+
+hotApi si_result si_reader_tryGetDoubleRange ( si_reader *r, double lo, double hi, double *out ) {
+
+	si_guard( r );
+
+	if ( !( lo <= hi )) return SI_EOF;
+	return si_tryValueIn( r, out, sizeof(*out), si_tokDouble, &lo, &hi );
+}
+
+
+
+/**
+ * Streaming
+ *
+ * si_reader_forEachLine() hands every remaining line to fn in one call:
+ * the reader is locked once, the lines come straight out of the block
+ * buffer as views ( valid until fn returns ), and there is no per-line
+ * entry, scratch buffer or EOF check on the caller's side. The typed
+ * variants parse each line like si_reader_tryGetLong()/tryGetDouble()
+ * and pass the value; lines that don't parse or are too long are skipped
+ * quietly and counted in si_reader_errorStats().
+ *
+ * fn returns false to stop, leaving the rest of the input unread. fn may
+ * read from the same reader ( the lock is recursive ), which moves the
+ * stream along with it.
+ *
+ * returns SI_EOF once the input is exhausted, SI_OK if fn stopped, or
+ * SI_WOULD_BLOCK when a non-blocking reader runs dry - call again to go on
+ */
+si_result si_reader_forEachLine ( si_reader *r, si_lineFn fn, void *ctx ) {
+
+	si_guard( r );
+
+	const char *line;
+	size_t len;
+
+	if ( !r || !fn ) return SI_EOF;
+
+	while ( 1 ) {
+
+		si_result status = si_tryLine( r, r->lineLimit, &line, &len );
+		if ( unlikely( status == SI_TOO_LONG )) continue;
+		if ( unlikely( status )) return status;
+
+		if ( !fn( ctx, (si_string){ (char *)line, len } )) return SI_OK;
+	}
+}
+
+
+
+si_result si_reader_forEachLong ( si_reader *r, si_longFn fn, void *ctx ) {
+
+	si_guard( r );
+
+	long value;
+
+	if ( !r || !fn ) return SI_EOF;
+
+	while ( 1 ) {
+
+		si_result status = si_tryValue( r, &value, sizeof(value), si_tokLong );
+
+		if ( status == SI_OK ) {
+			if ( !fn( ctx, value )) return SI_OK;
+		}
+		else if ( status == SI_EOF || status == SI_WOULD_BLOCK ) return status;
+	}
+}
+
+
+
+si_result si_reader_forEachDouble ( si_reader *r, si_doubleFn fn, void *ctx ) {
+
+	si_guard( r );
+
+	double value;
+
+	if ( !r || !fn ) return SI_EOF;
+
+	while ( 1 ) {
+
+		si_result status = si_tryValue( r, &value, sizeof(value), si_tokDouble );
+
+		if ( status == SI_OK ) {
+			if ( !fn( ctx, value )) return SI_OK;
+		}
+		else if ( status == SI_EOF || status == SI_WOULD_BLOCK ) return status;
+	}
+}
+
+
+
+/**
+ * si_isSeparator - true for whitespace and the caller's delimiter
+ */
+static alwaysInline bool si_isSeparator ( unsigned char c, char delim ) {
+
+	return si_isSpace( c ) || c == (unsigned char)delim;
+}
+
+
+
+/**
+ * si_skipSeparators - step over separators in the buffered input, counting lines
+ *
+ * returns true if a token starts at r->pos, false if the buffer ran out
+ */
+static alwaysInline bool si_skipSeparators ( si_reader *r, char delim ) {
+
+	while ( r->pos < r->end ) {
+		unsigned char c = (unsigned char)r->buf[ r->pos ];
+		if ( c == '\n' ) si_consumeLine( r, r->pos + 1 );
+		else if ( si_isSeparator( c, delim )) r->pos++;
+		else return true;
+	}
+
+	return false;
+}
+
+
+
+/**
+ * si_nextToken - locate the next separator-delimited token without copying it
+ *
+ * @r:			reader to pull from
+ * @delim:		extra separator besides whitespace ( '\0' for whitespace only )
+ * @maxLen:		tokens of maxLen bytes or more are rejected
+ * @tok:		receives a pointer to the first byte of the token
+ * @outLen:		receives the token length
+ * @where:		receives the token's line and column
+ *
+ * Any run of whitespace ( newlines included ) and delim characters
+ * separates tokens, so empty fields are skipped. The token stays valid
+ * until the next call on the same reader.
+ *
+ * Returns:
+ * 		0 - on success
+ * 		1 - on a token that exceeds maxLen ( consumed )
+ *	   -1 - on EOF
+ */
+static int si_nextToken ( si_reader *r, char delim, size_t maxLen, const char **tok, size_t *outLen, si_position *where ) {
+
+	r->blocked = false;
+
+	while ( !si_skipSeparators( r, delim ))
+		if ( !si_refill( r )) return EOF;
+
+	where->line = r->lines + 1;
+	where->column = r->base + r->pos - r->lineStart + 1;
+
+	size_t len = 0;
+
+	while ( 1 ) {
+		const char *start = r->buf + r->pos;
+		size_t avail = r->end - r->pos;
+
+		while ( len < avail && !si_isSeparator( (unsigned char)start[len], delim )) len++;
+
+		if ( unlikely( len >= maxLen )) {
+			// discard the rest of the token
+			r->pos += len;
+			while ( 1 ) {
+				while ( r->pos < r->end && !si_isSeparator( (unsigned char)r->buf[ r->pos ], delim )) r->pos++;
+				if ( r->pos < r->end || !si_refill( r )) {
+					si_count( r, rejected[SI_REJECT_TOO_LONG], 1 );
+					return 1;
+				}
+			}
+		}
+
+		if ( len < avail ) break;
+		if ( !si_refill( r )) {
+			// a token cut off by a non-blocking read is kept for the next call
+			if ( r->blocked ) return EOF;
+			break;
+		}
+	}
+
+	*tok = r->buf + r->pos;
+	*outLen = len;
+	r->pos += len;
+	return 0;
+}
+
+
+
+/**
+ * si_readArray - shared driver for the si_reader_getXArray() functions
+ *
+ * Always inlined with a constant parse function, so each array getter
+ * ends up with its own loop and a direct ( usually inlined ) parse call.
+ */
+static alwaysInline size_t si_readArray ( si_reader *r, void *out, size_t size, size_t n, char delim, si_position *err,
+										int ( *parse )( const char *, size_t, void * )) {
+
+	si_guard( r );
+
+	if ( err ) *err = (si_position){ 0, 0 };
+	if ( unlikely( !r || ( !out && n ))) return 0;
+
+	char *dst = out;
+	size_t count = 0;
+
+	for ( ; count < n; count++ ) {
+		const char *tok;
+		size_t len;
+		si_position at;
+
+		int result = si_nextToken( r, delim, INPUT_BUFFER_SIZE - 1, &tok, &len, &at );
+		if ( result == EOF ) break;
+
+		if ( !result ) {
+			result = parse( tok, len, dst + count * size );
+			if ( result ) si_countReject( r, result );
+		}
+
+		if ( unlikely( result )) {
+			if ( err ) *err = at;
+			break;
+		}
+	}
+
+	si_count( r, parsed[ si_tokType( parse ) ], count );
+	return count;
+}
+
+
+
+/**
+ * si_reader_getIntArray - read up to n separated ints into out
+ *
+ * usage - size_t got = si_reader_getIntArray( r, row, 16, ',', &err );
+ *
+ * @r:			reader to pull from
+ * @out:		array receiving the values
+ * @n:			capacity of out
+ * @delim:		separator besides whitespace, e.g. ',' ( '\0' for whitespace only )
+ * @err:		optional, receives the position of the first rejected value
+ *
+ * Values may span any number of lines, and runs of separators count as
+ * one. Reading stops after n values, at EOF, or at the first token that
+ * fails the validation si_reader_getInt() applies. That token is consumed
+ * and its position stored in err ( err->line stays 0 if nothing failed ).
+ * Nothing is printed and nothing is retried.
+ *
+ * returns the number of values stored
+ */
+size_t si_reader_getIntArray ( si_reader *r, int *out, size_t n, char delim, si_position *err ) {
+
+	return si_readArray( r, out, sizeof(*out), n, delim, err, si_tokInt );
+}
+
+
+
+/**
+ * si_reader_getUIntArray - si_reader_getIntArray() for unsigned ints
+ */
+size_t si_reader_getUIntArray ( si_reader *r, unsigned int *out, size_t n, char delim, si_position *err ) {
+
+	return si_readArray( r, out, sizeof(*out), n, delim, err, si_tokUInt );
+}
+
+
+
+/**
+ * si_reader_getLongArray - si_reader_getIntArray() for longs
+ */
+size_t si_reader_getLongArray ( si_reader *r, long *out, size_t n, char delim, si_position *err ) {
+
+	return si_readArray( r, out, sizeof(*out), n, delim, err, si_tokLong );
+}
+
+
+
+/**
+ * si_reader_getULongArray - si_reader_getIntArray() for unsigned longs
+ */
+size_t si_reader_getULongArray ( si_reader *r, unsigned long *out, size_t n, char delim, si_position *err ) {
+
+	return si_readArray( r, out, sizeof(*out), n, delim, err, si_tokULong );
+}
+
+
+
+/**
+ * si_reader_getLongLongArray - si_reader_getIntArray() for long longs
+ */
+size_t si_reader_getLongLongArray ( si_reader *r, long long *out, size_t n, char delim, si_position *err ) {
+
+	return si_readArray( r, out, sizeof(*out), n, delim, err, si_tokLongLong );
+}
+
+
+
+/**
+ * si_reader_getULongLongArray - si_reader_getIntArray() for unsigned long longs
+ */
+size_t si_reader_getULongLongArray ( si_reader *r, unsigned long long *out, size_t n, char delim, si_position *err ) {
+
+	return si_readArray( r, out, sizeof(*out), n, delim, err, si_tokULongLong );
+}
+
+
+
+/**
+ * si_reader_getFloatArray - si_reader_getIntArray() for floats
+ */
+size_t si_reader_getFloatArray ( si_reader *r, float *out, size_t n, char delim, si_position *err ) {
+
+	return si_readArray( r, out, sizeof(*out), n, delim, err, si_tokFloat );
+}
+
+
+
+/**
+ * si_reader_getDoubleArray - si_reader_getIntArray() for doubles
+ */
+size_t si_reader_getDoubleArray ( si_reader *r, double *out, size_t n, char delim, si_position *err ) {
+
+	return si_readArray( r, out, sizeof(*out), n, delim, err, si_tokDouble );
+}
+
+
+
+/**
+ * Parallel batch input
+ *
+ * An in-memory or mapped reader's remaining bytes are cut into newline
+ * aligned chunks, one per worker. Every worker runs the array getters'
+ * token loop over its chunk through a private memory reader and collects
+ * values in its own growing array. The arrays are concatenated in input
+ * order afterwards, and error positions are rebased to global line numbers
+ * from the newline counts of the chunks before.
+ *
+ * Tokens never straddle chunks because a chunk always ends after '\n'.
+ * Failing workers lower a shared first-failed index, and workers on later
+ * chunks poll it and give up early; their values would be dropped anyway.
+ */
+#define SI_CHUNK_MIN	( 1024 * 1024 )	// don't start a thread for less
+#define SI_CHUNK_POLL	4096			// tokens between checks of the failed index
+
+typedef struct si_chunk {
+	const char	*data;
+	size_t		len;
+	char		delim;
+	size_t		size;
+	int			( *parse )( const char *, size_t, void * );
+	char		*out;		// values parsed from this chunk
+	size_t		count;
+	size_t		cap;
+	size_t		lines;		// newlines consumed
+	size_t		stop;		// bytes consumed
+	si_position	err;		// chunk-relative, line == 0 if none
+	si_reject	failure;	// why the token at err was rejected
+	bool		nomem;
+	size_t		index;		// position in input order
+	size_t		*failed;	// shared, lowest index with err or nomem
+} si_chunk;
+
+static void *si_chunkWorker ( void *arg ) {
+
+	si_chunk *c = arg;
+	si_reader r = {
+		.buf		= (char *)c->data,
+		.cap		= c->len,
+		.end		= c->len,
+		.fd			= -1,
+		.eof		= true,
+		.lineLimit	= INPUT_BUFFER_SIZE,
+	};
+
+	while ( 1 ) {
+		const char *tok;
+		size_t len;
+		si_position at;
+
+		int result = si_nextToken( &r, c->delim, INPUT_BUFFER_SIZE - 1, &tok, &len, &at );
+		if ( result == EOF ) break;
+
+		if ( unlikely( c->count % SI_CHUNK_POLL == 0 ) && __atomic_load_n( c->failed, __ATOMIC_RELAXED ) < c->index ) break;
+
+		if ( unlikely( c->count == c->cap )) {
+			size_t cap = c->cap ? c->cap * 2 : 1024;
+			char *out = realloc( c->out, cap * c->size );
+			if ( !out ) {
+				c->nomem = true;
+				break;
+			}
+			c->out = out;
+			c->cap = cap;
+		}
+
+		if ( unlikely( result )) c->failure = SI_REJECT_TOO_LONG;
+		else if ( unlikely(( result = c->parse( tok, len, c->out + c->count * c->size )))) c->failure = si_rejectOf( result );
+
+		if ( unlikely( result )) {
+			c->err = at;
+			break;
+		}
+
+		c->count++;
+	}
+
+	if ( c->err.line || c->nomem ) {
+		size_t seen = __atomic_load_n( c->failed, __ATOMIC_RELAXED );
+		while ( c->index < seen && !__atomic_compare_exchange_n( c->failed, &seen, c->index, true, __ATOMIC_RELAXED, __ATOMIC_RELAXED ));
+	}
+
+	c->lines = r.lines;
+	c->stop = r.pos;
+	return NULL;
+}
+
+
+
+/**
+ * si_parallelArray - shared driver for the si_reader_parallelGetXArray() functions
+ */
+static void *si_parallelArray ( si_reader *r, size_t size, char delim, unsigned threads, size_t *count,
+								si_position *err, int ( *parse )( const char *, size_t, void * )) {
+
+	si_guard( r );
+
+	if ( err ) *err = (si_position){ 0, 0 };
+	if ( count ) *count = 0;
+	if ( !r || !count ) return NULL;
+
+	// only fully buffered readers can be split, stream the rest on one chunk
+	if ( !r->eof ) threads = 1;
+	else if ( threads == 0 ) {
+		long cpus = sysconf( _SC_NPROCESSORS_ONLN );
+		threads = cpus > 0 ? (unsigned)cpus : 1;
+	}
+
+	const char *data = r->buf + r->pos;
+	size_t len = r->end - r->pos;
+
+	if ( threads > 1 && len / threads < SI_CHUNK_MIN ) threads = (unsigned)( len / SI_CHUNK_MIN ) + 1;
+
+	si_chunk *chunks = calloc( threads, sizeof(*chunks) );
+	pthread_t *tids = malloc( threads * sizeof(*tids) );
+	if ( !chunks || !tids ) {
+		free( chunks );
+		free( tids );
+		si_report( r, SI_ERR_NOMEM, "Memory allocation failed.\n" );
+		return NULL;
+	}
+
+	// cut at the first newline after each even split point
+	size_t at = 0, failed = SIZE_MAX;
+	unsigned used = 0;
+
+	for ( ; used < threads && at < len; used++ ) {
+		size_t end = len;
+		if ( used + 1 < threads ) {
+			size_t target = at + ( len - at ) / ( threads - used );
+			const char *nl = target < len ? memchr( data + target, '\n', len - target ) : NULL;
+			end = nl ? (size_t)( nl - data ) + 1 : len;
+		}
+
+		chunks[used] = (si_chunk){ .data = data + at, .len = end - at, .delim = delim, .size = size, .parse = parse,
+								   .index = used, .failed = &failed };
+		at = end;
+	}
+
+	if ( used == 0 ) {
+		// nothing buffered ( or a stream ): a single chunk on the reader itself
+		used = 1;
+		chunks[0] = (si_chunk){ .delim = delim, .size = size, .parse = parse, .failed = &failed };
+	}
+
+	unsigned started = 1;
+	for ( ; started < used; started++ )
+		if ( pthread_create( &tids[started], NULL, si_chunkWorker, &chunks[started] )) break;
+
+	if ( r->eof ) si_chunkWorker( &chunks[0] );
+	else {
+		// streaming fallback, parse straight off the reader
+		si_chunk *c = &chunks[0];
+		while ( 1 ) {
+			const char *tok;
+			size_t tlen;
+			si_position pos;
+
+			int result = si_nextToken( r, delim, INPUT_BUFFER_SIZE - 1, &tok, &tlen, &pos );
+			if ( result == EOF ) break;
+
+			if ( c->count == c->cap ) {
+				size_t cap = c->cap ? c->cap * 2 : 1024;
+				char *out = realloc( c->out, cap * size );
+				if ( !out ) {
+					c->nomem = true;
+					break;
+				}
+				c->out = out;
+				c->cap = cap;
+			}
+
+			if ( !result ) {
+				result = parse( tok, tlen, c->out + c->count * size );
+				if ( result ) si_countReject( r, result );
+			}
+
+			if ( result ) {
+				if ( err ) *err = pos;
+				break;
+			}
+			c->count++;
+		}
+	}
+
+	// threads that failed to start are run here instead
+	for ( unsigned i = 1; i < used; i++ ) {
+		if ( i < started ) pthread_join( tids[i], NULL );
+		else si_chunkWorker( &chunks[i] );
+	}
+
+	free( tids );
+
+	// merge in input order, up to the first chunk that failed
+	size_t total = 0;
+	unsigned last = 0;
+	bool nomem = false;
+
+	for ( ; last < used; last++ ) {
+		total += chunks[last].count;
+		nomem |= chunks[last].nomem;
+		if ( chunks[last].err.line || chunks[last].nomem ) break;
+	}
+	if ( last == used ) last--;
+
+	char *result = nomem ? NULL : malloc( total ? total * size : 1 );
+
+	if ( result ) {
+		size_t off = 0;
+		for ( unsigned i = 0; i <= last; i++ ) {
+			if ( chunks[i].count ) memcpy( result + off * size, chunks[i].out, chunks[i].count * size );
+			off += chunks[i].count;
+		}
+		*count = total;
+		si_count( r, parsed[ si_tokType( parse ) ], total );
+	}
+	else si_report( r, SI_ERR_NOMEM, "Memory allocation failed.\n" );
+
+	// rebase the error and the reader's bookkeeping to where parsing stopped
+	if ( r->eof ) {
+		size_t lines = r->lines, consumed = 0;
+		size_t column = r->base + r->pos - r->lineStart;
+
+		for ( unsigned i = 0; i < last; i++ ) {
+			lines += chunks[i].lines;
+			consumed += chunks[i].len;
+		}
+
+		si_chunk *c = &chunks[last];
+		if ( c->err.line ) si_count( r, rejected[ c->failure ], 1 );
+		if ( err && c->err.line ) {
+			err->line = lines + c->err.line;
+			err->column = c->err.column + ( last == 0 && c->err.line == 1 ? column : 0 );
+		}
+
+		si_count( r, lines, lines + c->lines - r->lines );
+		r->pos += consumed + c->stop;
+		r->lines = lines + c->lines;
+		if ( last || c->lines ) {
+			// lineStart of the chunk-local reader, shifted to stream offsets
+			const char *nl = r->buf + r->pos;
+			while ( nl > r->buf && nl[-1] != '\n' ) nl--;
+			r->lineStart = r->base + (size_t)( nl - r->buf );
+		}
+	}
+
+	for ( unsigned i = 0; i < used; i++ ) free( chunks[i].out );
+	free( chunks );
+	return result;
+}
+
+
+
+/**
+ * si_reader_parallelGetLongArray - parse every remaining value of r on
+ * 									several threads
+ *
+ * usage - long *v = si_reader_parallelGetLongArray( r, ',', 0, &n, &err );
+ *
+ * @r:			reader to consume, ideally from si_reader_fromMapped() or
+ * 				si_reader_fromMemory()
+ * @delim:		separator besides whitespace, as for si_reader_getLongArray()
+ * @threads:	worker count, 0 for one per online CPU. Inputs below about
+ * 				1 MiB per worker use fewer threads.
+ * @count:		receives the number of values returned
+ * @err:		optional, receives the global position of the first rejected
+ * 				value ( err->line stays 0 if nothing failed )
+ *
+ * Values are validated like si_reader_getLong(). Parsing stops at the
+ * first bad value in input order, exactly like the serial array getters,
+ * and the reader is left just past it; workers on later chunks notice the
+ * failure within a few thousand values and stop. Readers that still have
+ * input to read from their fd are parsed on the calling thread.
+ *
+ * The workers are started and joined on every call, so for small inputs
+ * the serial si_reader_getLongArray() is cheaper.
+ *
+ * NOTE: 	Caller must free() the returned array.
+ *
+ * returns the values in input order, NULL on allocation failure or bad
+ * arguments
+ */
+long *si_reader_parallelGetLongArray ( si_reader *r, char delim, unsigned threads, size_t *count, si_position *err ) {
+
+	return si_parallelArray( r, sizeof(long), delim, threads, count, err, si_tokLong );
+}
+
+
+
+/**
+ * si_reader_parallelGetXArray - the other element types, see above
+ */
+int *si_reader_parallelGetIntArray ( si_reader *r, char delim, unsigned threads, size_t *count, si_position *err ) {
+
+	return si_parallelArray( r, sizeof(int), delim, threads, count, err, si_tokInt );
+}
+
+unsigned int *si_reader_parallelGetUIntArray ( si_reader *r, char delim, unsigned threads, size_t *count, si_position *err ) {
+
+	return si_parallelArray( r, sizeof(unsigned int), delim, threads, count, err, si_tokUInt );
+}
+
+unsigned long *si_reader_parallelGetULongArray ( si_reader *r, char delim, unsigned threads, size_t *count, si_position *err ) {
+
+	return si_parallelArray( r, sizeof(unsigned long), delim, threads, count, err, si_tokULong );
+}
+
+long long *si_reader_parallelGetLongLongArray ( si_reader *r, char delim, unsigned threads, size_t *count, si_position *err ) {
+
+	return si_parallelArray( r, sizeof(long long), delim, threads, count, err, si_tokLongLong );
+}
+
+unsigned long long *si_reader_parallelGetULongLongArray ( si_reader *r, char delim, unsigned threads, size_t *count, si_position *err ) {
+
+	return si_parallelArray( r, sizeof(unsigned long long), delim, threads, count, err, si_tokULongLong );
+}
+
+float *si_reader_parallelGetFloatArray ( si_reader *r, char delim, unsigned threads, size_t *count, si_position *err ) {
+
+	return si_parallelArray( r, sizeof(float), delim, threads, count, err, si_tokFloat );
+}
+
+double *si_reader_parallelGetDoubleArray ( si_reader *r, char delim, unsigned threads, size_t *count, si_position *err ) {
+
+	return si_parallelArray( r, sizeof(double), delim, threads, count, err, si_tokDouble );
+}
+
+
+
+/**
+ * Records
+ *
+ * si_reader_getRecord() splits one line into delimiter-separated fields,
+ * CSV style. Fields are si_string views into the reader's buffer, found
+ * with the same vectorised byte scan as newlines, and are only copied when
+ * a quoted field contains doubled quotes that must be collapsed. Typed
+ * field parsers reuse the array getters' token parsers.
+ *
+ * Quoted fields can't span lines, and a trailing '\r' is dropped so CRLF
+ * files work unchanged.
+ */
+
+/**
+ * si_unquote - copy a quoted field with doubled quotes collapsed to dst
+ *
+ * returns the unescaped length
+ */
+static cold size_t si_unquote ( char *dst, const char *p, const char *end, char quote ) {
+
+	size_t n = 0;
+
+	while ( p < end ) {
+		dst[n++] = *p;
+		p += ( *p == quote ) ? 2 : 1;
+	}
+
+	return n;
+}
+
+
+
+/**
+ * si_badRecord - reject the current record, leaving it empty
+ */
+static cold si_result si_badRecord ( si_reader *r, si_record *rec ) {
+
+	si_count( r, rejected[SI_REJECT_RECORD], 1 );
+	rec->count = 0;
+	return si_tally( r, SI_INVALID );
+}
+
+
+
+/**
+ * si_reader_getRecord - read one line and split it into fields
+ *
+ * @delim:		field separator, e.g. ',' or '\t'
+ * @quote:		quote character ( usually '"' ), or 0 to disable quoting.
+ * 				A field that starts with it runs to the matching quote,
+ * 				may contain delim, and writes a literal quote as two.
+ * @rec:		receives the fields, valid until the next read from r
+ *
+ * Lines must be shorter than the reader's line limit and hold at most
+ * SI_RECORD_FIELDS fields. An empty line is one empty field.
+ *
+ * Returns:
+ * 		SI_OK 			- on success
+ * 		SI_INVALID		- bad quoting or too many fields ( the line is consumed )
+ * 		SI_TOO_LONG, SI_WOULD_BLOCK, SI_EOF	- as for si_reader_readLine()
+ */
+si_result si_reader_getRecord ( si_reader *r, char delim, char quote, si_record *rec ) {
+
+	si_guard( r );
+
+	if ( !r || !rec ) return SI_EOF;
+
+	rec->count = 0;
+
+	si_string line;
+	si_result status = si_reader_readLine( r, &line );
+	if ( status ) return status;
+
+	rec->line = r->lines;
+
+	const char *p = line.data;
+	const char *end = p + line.len;
+	char *scratch = NULL;
+	size_t used = 0;
+
+	if ( p < end && end[-1] == '\r' ) end--;
+
+	while ( 1 ) {
+		if ( unlikely( rec->count == SI_RECORD_FIELDS )) return si_badRecord( r, rec );
+
+		si_string *field = &rec->field[ rec->count++ ];
+
+		if ( quote && p < end && *p == quote ) {
+			const char *start = ++p;
+			bool escaped = false;
+
+			while ( 1 ) {
+				p = si_scanByte( p, end, quote );
+				if ( unlikely( !p )) return si_badRecord( r, rec );
+				if ( p + 1 < end && p[1] == quote ) {
+					escaped = true;
+					p += 2;
+					continue;
+				}
+				break;
+			}
+
+			if ( escaped ) {
+				// one buffer of line.len bytes holds every unescaped field
+				if ( !scratch ) {
+					if ( r->fieldCap < line.len ) {
+						char *buf = realloc( r->fieldBuf, line.len );
+						if ( !buf ) {
+							si_report( r, SI_ERR_NOMEM, "Memory allocation failed.\n" );
+							return SI_EOF;
+						}
+						r->fieldBuf = buf;
+						r->fieldCap = line.len;
+					}
+					scratch = r->fieldBuf;
+				}
+				size_t n = si_unquote( scratch + used, start, p, quote );
+				*field = (si_string){ scratch + used, n };
+				used += n;
+			}
+			else *field = (si_string){ (char *)start, (size_t)( p - start ) };
+
+			p++;
+			if ( p == end ) return SI_OK;
+			if ( unlikely( *p != delim )) return si_badRecord( r, rec );
+			p++;
+			continue;
+		}
+
+		const char *stop = si_scanByte( p, end, delim );
+		if ( !stop ) {
+			*field = (si_string){ (char *)p, (size_t)( end - p ) };
+			return SI_OK;
+		}
+
+		*field = (si_string){ (char *)p, (size_t)( stop - p ) };
+		p = stop + 1;
+	}
+}
+
+
+
+/**
+ * si_field - the i-th ( 0-based ) field of a record, { NULL, 0 } if missing
+ */
+si_string si_field ( const si_record *rec, size_t i ) {
+
+	if ( !rec || i >= rec->count ) return (si_string){ NULL, 0 };
+	return rec->field[i];
+}
+
+
+
+/**
+ * si_fieldParse - run a token parser over field i
+ */
+static alwaysInline si_result si_fieldParse ( const si_record *rec, size_t i, void *out,
+											  int ( *parse )( const char *, size_t, void * )) {
+
+	if ( !rec || !out || i >= rec->count ) return SI_EOF;
+	return si_statusOf( parse( rec->field[i].data, rec->field[i].len, out ));
+}
+
+
+
+/**
+ * si_fieldInt .. si_fieldDouble - parse field i like the matching getter
+ *
+ * *out is only written on SI_OK.
+ *
+ * returns SI_OK, SI_INVALID, SI_OVERFLOW, or SI_EOF for a missing field
+ */
+si_result si_fieldInt ( const si_record *rec, size_t i, int *out ) {
+
+	return si_fieldParse( rec, i, out, si_tokInt );
+}
+
+si_result si_fieldUInt ( const si_record *rec, size_t i, unsigned int *out ) {
+
+	return si_fieldParse( rec, i, out, si_tokUInt );
+}
+
+si_result si_fieldLong ( const si_record *rec, size_t i, long *out ) {
+
+	return si_fieldParse( rec, i, out, si_tokLong );
+}
+
+si_result si_fieldULong ( const si_record *rec, size_t i, unsigned long *out ) {
+
+	return si_fieldParse( rec, i, out, si_tokULong );
+}
+
+si_result si_fieldLongLong ( const si_record *rec, size_t i, long long *out ) {
+
+	return si_fieldParse( rec, i, out, si_tokLongLong );
+}
+
+si_result si_fieldULongLong ( const si_record *rec, size_t i, unsigned long long *out ) {
+
+	return si_fieldParse( rec, i, out, si_tokULongLong );
+}
+
+si_result si_fieldFloat ( const si_record *rec, size_t i, float *out ) {
+
+	return si_fieldParse( rec, i, out, si_tokFloat );
+}
+
+si_result si_fieldDouble ( const si_record *rec, size_t i, double *out ) {
+
+	return si_fieldParse( rec, i, out, si_tokDouble );
+}
+
+
+
+/**
+ * Schemas
+ *
+ * A schema is a record layout compiled once into a dispatch table of
+ * ( token parser, struct offset ) pairs. si_reader_readStruct() then costs
+ * one si_reader_getRecord() plus one indirect call per field, with no
+ * format string to interpret on every line as with sscanf().
+ */
+typedef int ( *si_tokParser )( const char *p, size_t len, void *out );
+
+struct si_schema {
+	char	delim;
+	char	quote;
+	size_t	count;
+	struct {
+		si_tokParser	parse;		// NULL for skipped fields
+		size_t			offset;
+		bool			copy;		// SI_FIELD_STRING_COPY, retained after parsing
+		si_fieldType	type;
+	} field[];
+};
+
+static int si_tokBool ( const char *p, size_t len, void *out ) {
+
+	if ( len != 1 ) return SI_PARSE_INVALID;
+	if ( p[0] == 'Y' || p[0] == 'y' ) *(bool *)out = true;
+	else if ( p[0] == 'N' || p[0] == 'n' ) *(bool *)out = false;
+	else return SI_PARSE_INVALID;
+	return SI_PARSE_OK;
+}
+
+static int si_tokChar ( const char *p, size_t len, void *out ) {
+
+	if ( len != 1 ) return SI_PARSE_INVALID;
+	*(char *)out = p[0];
+	return SI_PARSE_OK;
+}
+
+static int si_tokString ( const char *p, size_t len, void *out ) {
+
+	*(si_string *)out = (si_string){ (char *)p, len };
+	return SI_PARSE_OK;
+}
+
+static si_tokParser si_fieldParser ( si_fieldType type ) {
+
+	switch ( type ) {
+		case SI_FIELD_INT:			return si_tokInt;
+		case SI_FIELD_UINT:			return si_tokUInt;
+		case SI_FIELD_LONG:			return si_tokLong;
+		case SI_FIELD_ULONG:		return si_tokULong;
+		case SI_FIELD_LONGLONG:		return si_tokLongLong;
+		case SI_FIELD_ULONGLONG:	return si_tokULongLong;
+		case SI_FIELD_FLOAT:		return si_tokFloat;
+		case SI_FIELD_DOUBLE:		return si_tokDouble;
+		case SI_FIELD_BOOL:			return si_tokBool;
+		case SI_FIELD_CHAR:			return si_tokChar;
+		case SI_FIELD_STRING:
+		case SI_FIELD_STRING_COPY:	return si_tokString;
+		default:					return NULL;
+	}
+}
+
+
+
+/**
+ * si_schema_compile - compile field descriptors into a schema
+ *
+ * @fields:		one descriptor per field of the line, in order
+ * @n:			number of descriptors, at most SI_RECORD_FIELDS
+ * @delim:		field separator
+ * @quote:		quote character, or 0, as for si_reader_getRecord()
+ *
+ * NOTE: 	Free the schema with si_schema_free().
+ *
+ * returns NULL on bad arguments, an unknown type or allocation failure
+ */
+si_schema *si_schema_compile ( const si_fieldDesc *fields, size_t n, char delim, char quote ) {
+
+	if ( !fields || !n || n > SI_RECORD_FIELDS ) return NULL;
+
+	si_schema *schema = malloc( sizeof(*schema) + n * sizeof(schema->field[0]) );
+	if ( !schema ) {
+		si_report( NULL, SI_ERR_NOMEM, "Memory allocation failed.\n" );
+		return NULL;
+	}
+
+	schema->delim = delim;
+	schema->quote = quote;
+	schema->count = n;
+
+	for ( size_t i = 0; i < n; i++ ) {
+		schema->field[i].parse = si_fieldParser( fields[i].type );
+		schema->field[i].offset = fields[i].offset;
+		schema->field[i].copy = ( fields[i].type == SI_FIELD_STRING_COPY );
+		schema->field[i].type = fields[i].type;
+
+		if ( !schema->field[i].parse && fields[i].type != SI_FIELD_SKIP ) {
+			free( schema );
+			return NULL;
+		}
+	}
+
+	return schema;
+}
+
+
+
+/**
+ * si_schema_fromSignature - compile a schema from a compact type signature
+ *
+ * @sig:		one letter per field, commas and spaces are ignored:
+ * 				i int, u unsigned int, l long, L unsigned long, q long long,
+ * 				Q unsigned long long, f float, d double, b bool, c char,
+ * 				s si_string view, S si_string copy, - skipped field
+ * @offsets:	offsetof() of the destination of each non-skipped field
+ *
+ * usage - si_schema_fromSignature( "i,d,s", (size_t[]){ offsetof( row, id ),
+ * 			offsetof( row, price ), offsetof( row, name ) }, ',', '"' );
+ *
+ * returns NULL on an unknown letter, too many fields or allocation failure
+ */
+si_schema *si_schema_fromSignature ( const char *sig, const size_t *offsets, char delim, char quote ) {
+
+	if ( !sig || !offsets ) return NULL;
+
+	si_fieldDesc fields[SI_RECORD_FIELDS];
+	size_t n = 0, k = 0;
+
+	for ( ; *sig; sig++ ) {
+		si_fieldType type;
+
+		switch ( *sig ) {
+			case ',': case ' ': case '\t':	continue;
+			case 'i':	type = SI_FIELD_INT;		break;
+			case 'u':	type = SI_FIELD_UINT;		break;
+			case 'l':	type = SI_FIELD_LONG;		break;
+			case 'L':	type = SI_FIELD_ULONG;		break;
+			case 'q':	type = SI_FIELD_LONGLONG;	break;
+			case 'Q':	type = SI_FIELD_ULONGLONG;	break;
+			case 'f':	type = SI_FIELD_FLOAT;		break;
+			case 'd':	type = SI_FIELD_DOUBLE;		break;
+			case 'b':	type = SI_FIELD_BOOL;		break;
+			case 'c':	type = SI_FIELD_CHAR;		break;
+			case 's':	type = SI_FIELD_STRING;		break;
+			case 'S':	type = SI_FIELD_STRING_COPY;	break;
+			case '-':	type = SI_FIELD_SKIP;		break;
+			default:	return NULL;
+		}
+
+		if ( n == SI_RECORD_FIELDS ) return NULL;
+
+		fields[n].type = type;
+		fields[n].offset = ( type == SI_FIELD_SKIP ) ? 0 : offsets[ k++ ];
+		n++;
+	}
+
+	return si_schema_compile( fields, n, delim, quote );
+}
+
+
+
+/**
+ * si_schema_free - release a compiled schema, NULL is a no-op
+ */
+void si_schema_free ( si_schema *schema ) {
+
+	free( schema );
+}
+
+
+
+/**
+ * si_reader_readStruct - read one line and store its fields into out
+ *
+ * @schema:		compiled layout, the line must have exactly schema's fields
+ * @out:		struct the schema's offsets point into
+ * @badField:	if not NULL, receives the 0-based index of the field that
+ * 				failed to parse ( or the field count for a wrong number of
+ * 				fields ), untouched on success
+ *
+ * Fields are validated like the matching si_get*() call. String views are
+ * valid until the next read; SI_FIELD_STRING_COPY fields are copied with
+ * the reader's allocator once the whole line has parsed, and must be
+ * released with si_reader_release().
+ *
+ * NOTE: 	On failure, the fields before the bad one may have been written.
+ *
+ * returns SI_OK, SI_INVALID or SI_OVERFLOW for a bad field, or any other
+ * 		   si_reader_getRecord() status
+ */
+si_result si_reader_readStruct ( si_reader *r, const si_schema *schema, void *out, size_t *badField ) {
+
+	si_guard( r );
+
+	if ( !r || !schema || !out ) return SI_EOF;
+
+	si_record rec;
+	si_result status = si_reader_getRecord( r, schema->delim, schema->quote, &rec );
+	if ( status ) return status;
+
+	if ( rec.count != schema->count ) {
+		si_count( r, rejected[SI_REJECT_RECORD], 1 );
+		if ( badField ) *badField = rec.count;
+		return si_tally( r, SI_INVALID );
+	}
+
+	char *base = out;
+	bool copies = false;
+
+	for ( size_t i = 0; i < schema->count; i++ ) {
+		if ( !schema->field[i].parse ) continue;
+
+		int result = schema->field[i].parse( rec.field[i].data, rec.field[i].len, base + schema->field[i].offset );
+		if ( unlikely( result )) {
+			if ( badField ) *badField = i;
+			return si_parseStatus( r, result );
+		}
+
+		si_count( r, parsed[ schema->field[i].type ], 1 );
+		copies |= schema->field[i].copy;
+	}
+
+	if ( !copies ) return SI_OK;
+
+	for ( size_t i = 0; i < schema->count; i++ ) {
+		if ( !schema->field[i].copy ) continue;
+
+		si_string *dst = (si_string *)( base + schema->field[i].offset );
+		si_string copy = si_reader_retainString( r, *dst );
+		if ( !copy.data ) {
+			// undo the copies made so far
+			while ( i-- )
+				if ( schema->field[i].copy )
+					si_reader_release( r, ((si_string *)( base + schema->field[i].offset ))->data );
+			return SI_EOF;
+		}
+		*dst = copy;
+	}
+
+	return SI_OK;
+}
+
+
+
+/**
+ * si_formLine - store the values of one answer line into fields[*next ...]
+ *
+ * Values are taken one per field, separated by whitespace; a string field
+ * takes the rest of the line, trailing whitespace trimmed. *next moves past
+ * every field stored.
+ *
+ * returns SI_OK, SI_INVALID or SI_OVERFLOW after reporting a bad value or
+ * 		   a line with more values than fields, or SI_EOF if a copy failed
+ */
+static si_result si_formLine ( si_reader *r, const si_promptField *fields, size_t n, size_t *next,
+							   const char *p, const char *end ) {
+
+	size_t first = *next;
+
+	while ( *next < n ) {
+
+		while ( p < end && si_isSpace( (unsigned char)*p )) p++;
+		if ( p == end && *next > first ) return SI_OK;
+
+		const si_promptField *f = &fields[*next];
+		const char *value = p;
+
+		if ( f->type == SI_FIELD_STRING || f->type == SI_FIELD_STRING_COPY ) {
+			while ( end > p && si_isSpace( (unsigned char)end[-1] )) end--;
+			p = end;
+		}
+		else while ( p < end && !si_isSpace( (unsigned char)*p )) p++;
+
+		int result = si_fieldParser( f->type )( value, (size_t)( p - value ), f->out );
+		if ( result ) {
+			// the rest of the line goes, the form carries on from this field
+			si_countReject( r, result );
+			if ( result == SI_PARSE_NEGATIVE ) si_report( r, SI_ERR_INVALID, "Value can not be negative.\n" );
+			else si_report( r, si_errorKind( result ), "Invalid input. Try again.\n" );
+			return si_statusOf( result );
+		}
+
+		if ( f->type == SI_FIELD_STRING_COPY ) {
+			si_string *dst = f->out;
+			if ( !( *dst = si_reader_retainString( r, *dst )).data ) return SI_EOF;
+		}
+
+		si_count( r, parsed[ f->type ], 1 );
+		++*next;
+	}
+
+	while ( p < end && si_isSpace( (unsigned char)*p )) p++;
+	if ( p == end ) return SI_OK;
+
+	// more values than questions: nothing from this line is kept
+	*next = first;
+	si_count( r, rejected[SI_REJECT_RECORD], 1 );
+	si_report( r, SI_ERR_INVALID, "Too many values. Try again.\n" );
+	return SI_INVALID;
+}
+
+
+
+/**
+ * si_reader_promptMany - fill a form, as many fields per round trip as typed
+ *
+ * @fields:		the questions in order, each with the prompt that is shown
+ * 				when its answer is needed and nothing is typed ahead
+ * @n:			number of fields
+ *
+ * Answers are whitespace-separated values taken in field order from as
+ * many lines as it takes, so "Ada 36 1.65" answers name, age and height in
+ * one round trip, and lines typed ahead are used without prompting. A
+ * value that doesn't parse is reported like si_get*() does, the rest of
+ * its line is dropped, and the form goes on from that field, keeping the
+ * answers before it. A line with more values than open fields is dropped
+ * whole. String fields take the rest of their line; views are only valid
+ * until the next read, so SI_FIELD_STRING must be the last field, while
+ * SI_FIELD_STRING_COPY fields are copied as for si_reader_readStruct().
+ *
+ * The labels go through the reader's prompt ( see si_reader_setPrompt ),
+ * so they and the retry messages share one write, on terminals only. The
+ * previous prompt is restored on return.
+ *
+ * NOTE: 	On failure the fields filled so far keep their values, but string
+ * 			copies are released.
+ *
+ * returns SI_OK once every field is filled, SI_EOF on EOF, bad arguments
+ * 		   or allocation failure, SI_WOULD_BLOCK on a non-blocking reader
+ */
+si_result si_reader_promptMany ( si_reader *r, const si_promptField *fields, size_t n ) {
+
+	si_guard( r );
+
+	if ( !r || !fields || !n ) return SI_EOF;
+
+	for ( size_t i = 0; i < n; i++ ) {
+		if ( !fields[i].out || fields[i].type == SI_FIELD_SKIP || !si_fieldParser( fields[i].type )
+			 || ( fields[i].type == SI_FIELD_STRING && i + 1 < n )) {
+			si_count( r, rejected[SI_REJECT_USAGE], 1 );
+			return SI_EOF;
+		}
+	}
+
+	const char *saved = r->prompt;
+	bool terminal = !r->nonBlock && si_isTerminal( r );
+	si_result status = SI_OK;
+	size_t next = 0;
+
+	while ( next < n ) {
+
+		const char *line;
+		size_t len;
+
+		if ( terminal ) r->prompt = fields[next].label;
+
+		int got = si_readLine( r, INPUT_BUFFER_SIZE - 1, &line, &len );
+		if ( got > 0 ) continue;
+		if ( got < 0 ) {
+			status = r->blocked ? SI_WOULD_BLOCK : SI_EOF;
+			break;
+		}
+
+		if ( si_formLine( r, fields, n, &next, line, line + len ) == SI_EOF ) {
+			status = SI_EOF;
+			break;
+		}
+	}
+
+	if ( status ) {
+		for ( size_t i = 0; i < next; i++ )
+			if ( fields[i].type == SI_FIELD_STRING_COPY ) si_reader_release( r, ((si_string *)fields[i].out )->data );
+	}
+
+	if ( r->pendingLen && !saved ) si_showPending( r, NULL );
+	r->prompt = saved;
+	return status;
+}
+
+
+
+/**
+ * Default reader wrappers - the original stdin API
+ *
+ * Each si_getX() is si_reader_getX() on the calling thread's default
+ * reader: si_stdin(), unless si_useReader() picked another one.
+ */
+int si_getInt ( void ) {
+
+	return si_reader_getInt( si_current() );
+}
+
+unsigned int si_getUInt ( void ) {
+
+	return si_reader_getUInt( si_current() );
+}
+
+float si_getFloat ( void ) {
+
+	return si_reader_getFloat( si_current() );
+}
+
+double si_getDouble ( void ) {
+
+	return si_reader_getDouble( si_current() );
+}
+
+long si_getLong ( void ) {
+
+	return si_reader_getLong( si_current() );
+}
+
+unsigned long si_getULong ( void ) {
+
+	return si_reader_getULong( si_current() );
+}
+
+long long si_getLongLong ( void ) {
+
+	return si_reader_getLongLong( si_current() );
+}
+
+unsigned long long si_getULongLong ( void ) {
+
+	return si_reader_getULongLong( si_current() );
+}
+
+int si_getChar ( void ) {
+
+	return si_reader_getChar( si_current() );
+}
+
+int si_getCharFiltered ( const char *allowed ) {
+
+	return si_reader_getCharFiltered( si_current(), allowed );
+}
+
+char *si_getCString ( void ) {
+
+	return si_reader_getCString( si_current() );
+}
+
+char *si_getCStringMax ( size_t max ) {
+
+	return si_reader_getCStringMax( si_current(), max );
+}
+
+si_string si_getString ( void ) {
+
+	return si_reader_getString( si_current() );
+}
+
+si_string si_getStringMax ( size_t max ) {
+
+	return si_reader_getStringMax( si_current(), max );
+}
+
+si_string si_getStringView ( void ) {
+
+	return si_reader_getStringView( si_current() );
+}
+
+si_string si_getStringViewMax ( size_t max ) {
+
+	return si_reader_getStringViewMax( si_current(), max );
+}
+
+bool si_setLineLimit ( size_t limit ) {
+
+	return si_reader_setLineLimit( si_current(), limit );
+}
+
+bool si_setErrorHandler ( si_errorHandler fn, void *ctx ) {
+
+	return si_reader_setErrorHandler( si_current(), fn, ctx );
+}
+
+bool si_setLocking ( bool on ) {
+
+	return si_reader_setLocking( &si_stdinReader, on );
+}
+
+bool si_setSilent ( bool silent ) {
+
+	return si_reader_setSilent( si_current(), silent );
+}
+
+bool si_setAllocator ( const si_allocator *a ) {
+
+	return si_reader_setAllocator( si_current(), a );
+}
+
+void si_release ( void *ptr ) {
+
+	si_reader_release( si_current(), ptr );
+}
+
+bool si_getBool ( void ) {
+
+	return si_reader_getBool( si_current() );
+}
+
+si_result si_tryGetInt ( int *out ) {
+
+	return si_reader_tryGetInt( si_current(), out );
+}
+
+si_result si_tryGetUInt ( unsigned int *out ) {
+
+	return si_reader_tryGetUInt( si_current(), out );
+}
+
+si_result si_tryGetFloat ( float *out ) {
+
+	return si_reader_tryGetFloat( si_current(), out );
+}
+
+si_result si_tryGetDouble ( double *out ) {
+
+	return si_reader_tryGetDouble( si_current(), out );
+}
+
+si_result si_tryGetLong ( long *out ) {
+
+	return si_reader_tryGetLong( si_current(), out );
+}
+
+si_result si_tryGetULong ( unsigned long *out ) {
+
+	return si_reader_tryGetULong( si_current(), out );
+}
+
+si_result si_tryGetLongLong ( long long *out ) {
+
+	return si_reader_tryGetLongLong( si_current(), out );
+}
+
+si_result si_tryGetULongLong ( unsigned long long *out ) {
+
+	return si_reader_tryGetULongLong( si_current(), out );
+}
+
+si_result si_tryGetChar ( char *out ) {
+
+	return si_reader_tryGetChar( si_current(), out );
+}
+
+si_result si_tryGetBool ( bool *out ) {
+
+	return si_reader_tryGetBool( si_current(), out );
+}
+
+si_result si_readStruct ( const si_schema *schema, void *out, size_t *badField ) {
+
+	return si_reader_readStruct( si_current(), schema, out, badField );
+}
+
+si_result si_getRecord ( char delim, char quote, si_record *rec ) {
+
+	return si_reader_getRecord( si_current(), delim, quote, rec );
+}
+
+si_result si_tryGetLineIn ( const si_charset *cs, si_string *line ) {
+
+	return si_reader_tryGetLineIn( si_current(), cs, line );
+}
+
+size_t si_skipLine ( void ) {
+
+	return si_reader_skipLine( si_current() );
+}
+
+int si_getCharIn ( const si_charset *cs ) {
+
+	return si_reader_getCharIn( si_current(), cs );
+}
+
+int si_getIntRange ( int lo, int hi ) {
+
+	return si_reader_getIntRange( si_current(), lo, hi );
+}
+
+unsigned int si_getUIntRange ( unsigned int lo, unsigned int hi ) {
+
+	return si_reader_getUIntRange( si_current(), lo, hi );
+}
+
+long si_getLongRange ( long lo, long hi ) {
+
+	return si_reader_getLongRange( si_current(), lo, hi );
+}
+
+unsigned long si_getULongRange ( unsigned long lo, unsigned long hi ) {
+
+	return si_reader_getULongRange( si_current(), lo, hi );
+}
+
+long long si_getLongLongRange ( long long lo, long long hi ) {
+
+	return si_reader_getLongLongRange( si_current(), lo, hi );
+}
+
+unsigned long long si_getULongLongRange ( unsigned long long lo, unsigned long long hi ) {
+
+	return si_reader_getULongLongRange( si_current(), lo, hi );
+}
+
+float si_getFloatRange ( float lo, float hi ) {
+
+	return si_reader_getFloatRange( si_current(), lo, hi );
+}
+
+double si_getDoubleRange ( double lo, double hi ) {
+
+	return si_reader_getDoubleRange( si_current(), lo, hi );
+}
+
+si_result si_tryGetIntRange ( int lo, int hi, int *out ) {
+
+	return si_reader_tryGetIntRange( si_current(), lo, hi, out );
+}
+
+si_result si_tryGetUIntRange ( unsigned int lo, unsigned int hi, unsigned int *out ) {
+
+	return si_reader_tryGetUIntRange( si_current(), lo, hi, out );
+}
+
+si_result si_tryGetLongRange ( long lo, long hi, long *out ) {
+
+	return si_reader_tryGetLongRange( si_current(), lo, hi, out );
+}
+
+si_result si_tryGetULongRange ( unsigned long lo, unsigned long hi, unsigned long *out ) {
+
+	return si_reader_tryGetULongRange( si_current(), lo, hi, out );
+}
+
+si_result si_tryGetLongLongRange ( long long lo, long long hi, long long *out ) {
+
+	return si_reader_tryGetLongLongRange( si_current(), lo, hi, out );
+}
+
+si_result si_tryGetULongLongRange ( unsigned long long lo, unsigned long long hi, unsigned long long *out ) {
+
+	return si_reader_tryGetULongLongRange( si_current(), lo, hi, out );
+}
+
+si_result si_tryGetFloatRange ( float lo, float hi, float *out ) {
+
+	return si_reader_tryGetFloatRange( si_current(), lo, hi, out );
+}
+
+si_result si_tryGetDoubleRange ( double lo, double hi, double *out ) {
+
+	return si_reader_tryGetDoubleRange( si_current(), lo, hi, out );
+}
+
+si_result si_forEachLine ( si_lineFn fn, void *ctx ) {
+
+	return si_reader_forEachLine( si_current(), fn, ctx );
+}
+
+si_result si_forEachLong ( si_longFn fn, void *ctx ) {
+
+	return si_reader_forEachLong( si_current(), fn, ctx );
+}
+
+si_result si_forEachDouble ( si_doubleFn fn, void *ctx ) {
+
+	return si_reader_forEachDouble( si_current(), fn, ctx );
+}
+
+int si_getCodepoint ( void ) {
+
+	return si_reader_getCodepoint( si_current() );
+}
+
+char *si_getCStringUtf8 ( void ) {
+
+	return si_reader_getCStringUtf8( si_current() );
+}
+
+si_string si_getStringUtf8 ( void ) {
+
+	return si_reader_getStringUtf8( si_current() );
+}
+
+si_string si_getStringViewUtf8 ( void ) {
+
+	return si_reader_getStringViewUtf8( si_current() );
+}
+
+si_result si_tryGetCodepoint ( uint32_t *out ) {
+
+	return si_reader_tryGetCodepoint( si_current(), out );
+}
+
+si_result si_tryGetLineUtf8 ( si_string *line ) {
+
+	return si_reader_tryGetLineUtf8( si_current(), line );
+}
+
+bool si_prompt ( const char *prompt ) {
+
+	return si_reader_setPrompt( si_current(), prompt );
+}
+
+si_result si_promptMany ( const si_promptField *fields, size_t n ) {
+
+	return si_reader_promptMany( si_current(), fields, n );
+}
+
+size_t si_getIntArray ( int *out, size_t n, char delim, si_position *err ) {
+
+	return si_reader_getIntArray( si_current(), out, n, delim, err );
+}
+
+size_t si_getUIntArray ( unsigned int *out, size_t n, char delim, si_position *err ) {
+
+	return si_reader_getUIntArray( si_current(), out, n, delim, err );
+}
+
+size_t si_getLongArray ( long *out, size_t n, char delim, si_position *err ) {
+
+	return si_reader_getLongArray( si_current(), out, n, delim, err );
+}
+
+size_t si_getULongArray ( unsigned long *out, size_t n, char delim, si_position *err ) {
+
+	return si_reader_getULongArray( si_current(), out, n, delim, err );
+}
+
+size_t si_getLongLongArray ( long long *out, size_t n, char delim, si_position *err ) {
+
+	return si_reader_getLongLongArray( si_current(), out, n, delim, err );
+}
+
+size_t si_getULongLongArray ( unsigned long long *out, size_t n, char delim, si_position *err ) {
+
+	return si_reader_getULongLongArray( si_current(), out, n, delim, err );
+}
+
+size_t si_getFloatArray ( float *out, size_t n, char delim, si_position *err ) {
+
+	return si_reader_getFloatArray( si_current(), out, n, delim, err );
+}
+
+size_t si_getDoubleArray ( double *out, size_t n, char delim, si_position *err ) {
+
+	return si_reader_getDoubleArray( si_current(), out, n, delim, err );
+}
+
+
+
+// the single-header build pastes this file into user code, keep these private
+#undef alwaysInline
+#undef cold
+#undef unlikely
+#undef hotApi
+
+#endif // SAFEINPUT_IMPLEMENTATION
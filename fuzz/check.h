@@ -0,0 +1,489 @@
+/**
+ * check.h - differential checks of safeinput against a strto* reference
+ *
+ * Shared by the fuzz target and the differential driver. The reference
+ * is the library's original parsing, kept here verbatim in spirit: copy
+ * the line into a NUL-terminated buffer, call strtol()/strtod()/..., and
+ * accept only if the whole line was consumed without ERANGE. Status codes
+ * follow the try getters: a syntax error, or an "inf"/"nan" spelled out,
+ * is SI_INVALID, and anything strto* flags with ERANGE is SI_OVERFLOW.
+ *
+ * The checks:
+ *
+ * 		checkNumbers	every numeric try getter over the input, line by line
+ * 		checkLines		si_reader_readLine() against a memchr() split
+ * 		checkSpan		si_charset_span() against a scalar si_charset_has() loop
+ * 		checkUtf8		si_utf8_valid() and the UTF-8 getters against a decoder
+ *
+ * Each returns false after printing the first mismatch to stderr.
+ * Float results are compared bit for bit, so -0 and rounding count.
+ * The float reference is glibc's: it flags ERANGE for underflow only
+ * when the subnormal result is inexact.
+ */
+
+#ifndef SAFEINPUT_FUZZ_CHECK_H_
+#define SAFEINPUT_FUZZ_CHECK_H_
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <limits.h>
+#include <errno.h>
+#include <math.h>
+#include <safeinput/safeinput.h>
+
+// === Reference ===
+typedef union value {
+	int					i;
+	unsigned int		u;
+	long				l;
+	unsigned long		ul;
+	long long			ll;
+	unsigned long long	ull;
+	float				f;
+	double				d;
+} value;
+
+static si_result refInt ( const char *s, value *out ) {
+
+	char *end;
+	errno = 0;
+	long v = strtol( s, &end, 10 );
+
+	if ( end == s || *end != '\0' ) return SI_INVALID;
+	if ( errno == ERANGE || v != (int)v ) return SI_OVERFLOW;
+
+	out->i = (int)v;
+	return SI_OK;
+}
+
+static si_result refUInt ( const char *s, value *out ) {
+
+	char *end;
+	errno = 0;
+	unsigned long v = strtoul( s, &end, 10 );
+
+	if ( s[0] == '-' ) return SI_INVALID;	// "Value can not be negative."
+	if ( end == s || *end != '\0' ) return SI_INVALID;
+	if ( errno == ERANGE || v > UINT_MAX ) return SI_OVERFLOW;
+
+	out->u = (unsigned int)v;
+	return SI_OK;
+}
+
+static si_result refLong ( const char *s, value *out ) {
+
+	char *end;
+	errno = 0;
+	long v = strtol( s, &end, 10 );
+
+	if ( end == s || *end != '\0' ) return SI_INVALID;
+	if ( errno == ERANGE ) return SI_OVERFLOW;
+
+	out->l = v;
+	return SI_OK;
+}
+
+static si_result refULong ( const char *s, value *out ) {
+
+	char *end;
+	errno = 0;
+	unsigned long v = strtoul( s, &end, 10 );
+
+	if ( end == s || *end != '\0' ) return SI_INVALID;
+	if ( errno == ERANGE ) return SI_OVERFLOW;
+
+	out->ul = v;
+	return SI_OK;
+}
+
+static si_result refLongLong ( const char *s, value *out ) {
+
+	char *end;
+	errno = 0;
+	long long v = strtoll( s, &end, 10 );
+
+	if ( end == s || *end != '\0' ) return SI_INVALID;
+	if ( errno == ERANGE ) return SI_OVERFLOW;
+
+	out->ll = v;
+	return SI_OK;
+}
+
+static si_result refULongLong ( const char *s, value *out ) {
+
+	char *end;
+	errno = 0;
+	unsigned long long v = strtoull( s, &end, 10 );
+
+	if ( end == s || *end != '\0' ) return SI_INVALID;
+	if ( errno == ERANGE ) return SI_OVERFLOW;
+
+	out->ull = v;
+	return SI_OK;
+}
+
+static si_result refFloat ( const char *s, value *out ) {
+
+	char *end;
+	errno = 0;
+	float v = strtof( s, &end );
+
+	if ( end == s || *end != '\0' ) return SI_INVALID;
+	if ( errno == ERANGE ) return SI_OVERFLOW;
+	if ( !isfinite( v )) return SI_INVALID;	// "inf" or "nan" spelled out
+
+	out->f = v;
+	return SI_OK;
+}
+
+static si_result refDouble ( const char *s, value *out ) {
+
+	char *end;
+	errno = 0;
+	double v = strtod( s, &end );
+
+	if ( end == s || *end != '\0' ) return SI_INVALID;
+	if ( errno == ERANGE ) return SI_OVERFLOW;
+	if ( !isfinite( v )) return SI_INVALID;	// "inf" or "nan" spelled out
+
+	out->d = v;
+	return SI_OK;
+}
+
+// === Library side ===
+static si_result getInt ( si_reader *r, value *out ) { return si_reader_tryGetInt( r, &out->i ); }
+static si_result getUInt ( si_reader *r, value *out ) { return si_reader_tryGetUInt( r, &out->u ); }
+static si_result getLong ( si_reader *r, value *out ) { return si_reader_tryGetLong( r, &out->l ); }
+static si_result getULong ( si_reader *r, value *out ) { return si_reader_tryGetULong( r, &out->ul ); }
+static si_result getLongLong ( si_reader *r, value *out ) { return si_reader_tryGetLongLong( r, &out->ll ); }
+static si_result getULongLong ( si_reader *r, value *out ) { return si_reader_tryGetULongLong( r, &out->ull ); }
+static si_result getFloat ( si_reader *r, value *out ) { return si_reader_tryGetFloat( r, &out->f ); }
+static si_result getDouble ( si_reader *r, value *out ) { return si_reader_tryGetDouble( r, &out->d ); }
+
+typedef enum kind { SIGNED, UNSIGNED, REAL } kind;
+
+typedef struct numType {
+	const char	*name;
+	kind		kind;
+	size_t		size;
+	si_result	( *ref )( const char *s, value *out );
+	si_result	( *get )( si_reader *r, value *out );
+} numType;
+
+static const numType numTypes[] = {
+	{ "Int",		SIGNED,		sizeof(int),				refInt,			getInt },
+	{ "UInt",		UNSIGNED,	sizeof(unsigned int),		refUInt,		getUInt },
+	{ "Long",		SIGNED,		sizeof(long),				refLong,		getLong },
+	{ "ULong",		UNSIGNED,	sizeof(unsigned long),		refULong,		getULong },
+	{ "LongLong",	SIGNED,		sizeof(long long),			refLongLong,	getLongLong },
+	{ "ULongLong",	UNSIGNED,	sizeof(unsigned long long),	refULongLong,	getULongLong },
+	{ "Float",		REAL,		sizeof(float),				refFloat,		getFloat },
+	{ "Double",		REAL,		sizeof(double),				refDouble,		getDouble },
+};
+
+// === Reporting ===
+static const char *statusName ( si_result s ) {
+
+	switch ( s ) {
+		case SI_OK:				return "SI_OK";
+		case SI_EOF:			return "SI_EOF";
+		case SI_TOO_LONG:		return "SI_TOO_LONG";
+		case SI_WOULD_BLOCK:	return "SI_WOULD_BLOCK";
+		case SI_INVALID:		return "SI_INVALID";
+		case SI_OVERFLOW:		return "SI_OVERFLOW";
+	}
+	return "?";
+}
+
+static void printEscaped ( const char *p, size_t len ) {
+
+	fputc( '"', stderr );
+	for ( size_t i = 0; i < len; i++ ) {
+		unsigned char c = (unsigned char)p[i];
+		if ( c == '"' || c == '\\' ) fprintf( stderr, "\\%c", c );
+		else if ( c >= 0x20 && c < 0x7F ) fputc( c, stderr );
+		else fprintf( stderr, "\\x%02x", c );
+	}
+	fputc( '"', stderr );
+}
+
+static void printValue ( const numType *t, si_result s, const value *v ) {
+
+	fputs( statusName( s ), stderr );
+	if ( s != SI_OK ) return;
+
+	if ( t->size == sizeof(float) && t->kind == REAL ) fprintf( stderr, " %a", (double)v->f );
+	else if ( t->kind == REAL ) fprintf( stderr, " %a", v->d );
+	else if ( t->size == sizeof(int) ) fprintf( stderr, t->kind == SIGNED ? " %d" : " %u", v->i );
+	else fprintf( stderr, t->kind == SIGNED ? " %lld" : " %llu", v->ll );
+}
+
+static void mismatch ( const char *what, const char *p, size_t len ) {
+
+	fprintf( stderr, "[!] %s mismatch on ", what );
+	printEscaped( p, len );
+	fputc( '\n', stderr );
+}
+
+// === Checks ===
+
+/**
+ * checkNumbers - run each numeric try getter over data against the reference
+ *
+ * Every '\n'-separated line ( and a final unterminated one ) is one value.
+ * Lines of INPUT_BUFFER_SIZE - 1 bytes or more never fit the getters'
+ * buffer ( the original read loop needed room to see the newline ), so
+ * they must come back as SI_TOO_LONG. The input must end in SI_EOF.
+ */
+static bool checkNumbers ( const char *data, size_t len ) {
+
+	char line[INPUT_BUFFER_SIZE];
+
+	for ( size_t t = 0; t < sizeof(numTypes) / sizeof(numTypes[0]); t++ ) {
+
+		const numType *type = &numTypes[t];
+		si_reader *r = si_reader_fromMemory( data, len );
+		if ( !r ) return true;
+		si_reader_setSilent( r, true );
+
+		const char *p = data, *end = data + len;
+		bool ok = true;
+
+		while ( ok && p < end ) {
+
+			const char *nl = memchr( p, '\n', (size_t)( end - p ));
+			size_t n = ( nl ? nl : end ) - p;
+
+			value want, got;
+			memset( &want, 0, sizeof(want) );
+			memset( &got, 0, sizeof(got) );
+
+			si_result ws = SI_TOO_LONG;
+			if ( n < sizeof(line) - 1 ) {
+				memcpy( line, p, n );
+				line[n] = '\0';
+				ws = type->ref( line, &want );
+			}
+
+			si_result gs = type->get( r, &got );
+
+			if ( gs != ws || ( ws == SI_OK && memcmp( &want, &got, type->size ))) {
+				mismatch( type->name, p, n );
+				fputs( "    strto*:    ", stderr ); printValue( type, ws, &want ); fputc( '\n', stderr );
+				fprintf( stderr, "    tryGet%s: ", type->name ); printValue( type, gs, &got ); fputc( '\n', stderr );
+				ok = false;
+			}
+
+			p += n + ( nl != NULL );
+		}
+
+		value v;
+		si_result last = ok ? type->get( r, &v ) : SI_EOF;
+		if ( last != SI_EOF ) {
+			fprintf( stderr, "[!] %s: %s after the last line, expected SI_EOF\n", type->name, statusName( last ));
+			ok = false;
+		}
+
+		si_reader_free( r );
+		if ( !ok ) return false;
+	}
+
+	return true;
+}
+
+
+
+/**
+ * checkLines - si_reader_readLine() views against a memchr() split of data
+ */
+static bool checkLines ( const char *data, size_t len ) {
+
+	si_reader *r = si_reader_fromMemory( data, len );
+	if ( !r ) return true;
+	si_reader_setLineLimit( r, len + 2 );
+
+	const char *p = data, *end = data + len;
+	bool ok = true;
+
+	while ( ok && p < end ) {
+
+		const char *nl = memchr( p, '\n', (size_t)( end - p ));
+		size_t n = ( nl ? nl : end ) - p;
+
+		si_string got;
+		si_result s = si_reader_readLine( r, &got );
+
+		if ( s != SI_OK || got.len != n || memcmp( got.data, p, n )) {
+			mismatch( "readLine", p, n );
+			fprintf( stderr, "    got %s, %zu bytes at offset %zu\n", statusName( s ), got.len, (size_t)( p - data ));
+			ok = false;
+		}
+
+		p += n + ( nl != NULL );
+	}
+
+	si_string tail;
+	if ( ok && si_reader_readLine( r, &tail ) != SI_EOF ) {
+		fputs( "[!] readLine: no SI_EOF after the last line\n", stderr );
+		ok = false;
+	}
+
+	si_reader_free( r );
+	return ok;
+}
+
+
+
+/**
+ * checkSpan - si_charset_span() against the scalar definition
+ *
+ * Runs a few fixed sets plus one compiled from the start of data, from
+ * every offset into the first 64 bytes so each SIMD width sees all
+ * alignments and tail lengths.
+ */
+static bool checkSpan ( const char *data, size_t len ) {
+
+	static const char *specs[] = { "0-9", "A-Za-z0-9_", "^\n", "^ \t", "\x01-\xff" };
+
+	si_charset sets[sizeof(specs) / sizeof(specs[0]) + 1];
+	size_t count = 0;
+
+	for ( size_t i = 0; i < sizeof(specs) / sizeof(specs[0]); i++ )
+		if ( si_charset_compile( &sets[count], specs[i] )) count++;
+
+	char spec[17];
+	size_t specLen = len < 16 ? len : 16;
+	memcpy( spec, data, specLen );
+	spec[specLen] = '\0';
+	if ( si_charset_compile( &sets[count], spec )) count++;
+
+	for ( size_t s = 0; s < count; s++ ) {
+		for ( size_t off = 0; off < len && off < 64; off++ ) {
+
+			const char *p = data + off;
+			size_t n = len - off, want = 0;
+			while ( want < n && si_charset_has( &sets[s], (unsigned char)p[want] )) want++;
+
+			size_t got = si_charset_span( &sets[s], p, n );
+			if ( got != want ) {
+				mismatch( "si_charset_span", p, n );
+				fprintf( stderr, "    set %zu: scalar %zu, si_charset_span %zu\n", s, want, got );
+				return false;
+			}
+		}
+	}
+
+	return true;
+}
+
+
+
+/**
+ * refUtf8 - decode [p, p + len) by the RFC 3629 definition
+ *
+ * @count:		receives the number of code points, @first the first one
+ *
+ * returns false at the first ill-formed sequence
+ */
+static bool refUtf8 ( const char *p, size_t len, size_t *count, uint32_t *first ) {
+
+	static const uint32_t minimum[5] = { 0, 0, 0x80, 0x800, 0x10000 };
+	const unsigned char *s = (const unsigned char *)p;
+	size_t i = 0;
+
+	*count = 0;
+
+	while ( i < len ) {
+
+		unsigned n = s[i] < 0x80 ? 1 : ( s[i] >> 5 ) == 6 ? 2 : ( s[i] >> 4 ) == 14 ? 3 : ( s[i] >> 3 ) == 30 ? 4 : 0;
+		if ( !n || len - i < n ) return false;
+
+		uint32_t cp = n == 1 ? s[i] : s[i] & ( 0x7Fu >> n );
+		for ( unsigned k = 1; k < n; k++ ) {
+			if (( s[i + k] >> 6 ) != 2 ) return false;
+			cp = cp << 6 | ( s[i + k] & 0x3F );
+		}
+
+		if ( cp < minimum[n] || cp > 0x10FFFF || ( cp >= 0xD800 && cp <= 0xDFFF )) return false;
+
+		if ( !(*count)++ ) *first = cp;
+		i += n;
+	}
+
+	return true;
+}
+
+
+
+/**
+ * checkUtf8 - si_utf8_valid() from every offset into the first 64 bytes,
+ * 			   then si_reader_tryGetLineUtf8() and si_reader_tryGetCodepoint()
+ * 			   over each line, against refUtf8()
+ */
+static bool checkUtf8 ( const char *data, size_t len ) {
+
+	size_t count;
+	uint32_t cp;
+
+	for ( size_t off = 0; off < len && off < 64; off++ ) {
+		bool want = refUtf8( data + off, len - off, &count, &cp );
+		if ( si_utf8_valid( data + off, len - off ) != want ) {
+			mismatch( "si_utf8_valid", data + off, len - off );
+			fprintf( stderr, "    reference says %s\n", want ? "valid" : "invalid" );
+			return false;
+		}
+	}
+
+	si_reader *lines = si_reader_fromMemory( data, len );
+	si_reader *chars = si_reader_fromMemory( data, len );
+	bool ok = lines && chars;
+	if ( ok ) si_reader_setLineLimit( lines, len + 2 );
+
+	const char *p = data, *end = data + len;
+
+	while ( ok && p < end ) {
+
+		const char *nl = memchr( p, '\n', (size_t)( end - p ));
+		size_t n = ( nl ? nl : end ) - p;
+		bool valid = refUtf8( p, n, &count, &cp );
+
+		si_string got;
+		si_result s = si_reader_tryGetLineUtf8( lines, &got );
+		if ( valid ? ( s != SI_OK || got.len != n || memcmp( got.data, p, n )) : s != SI_INVALID ) {
+			mismatch( "tryGetLineUtf8", p, n );
+			fprintf( stderr, "    reference says %s, got %s\n", valid ? "valid" : "invalid", statusName( s ));
+			ok = false;
+		}
+
+		if ( n == 0 ) count = 1, cp = '\n';
+		si_result want = n >= 5 ? SI_TOO_LONG : !valid || count != 1 ? SI_INVALID : SI_OK;
+		uint32_t c = 0;
+		s = si_reader_tryGetCodepoint( chars, &c );
+		if ( ok && ( s != want || ( s == SI_OK && c != cp ))) {
+			mismatch( "tryGetCodepoint", p, n );
+			fprintf( stderr, "    reference %s U+%04X, got %s U+%04X\n", statusName( want ), (unsigned)cp, statusName( s ), (unsigned)c );
+			ok = false;
+		}
+
+		p += n + ( nl != NULL );
+	}
+
+	si_reader_free( lines );
+	si_reader_free( chars );
+	return ok;
+}
+
+
+
+/**
+ * checkInput - every check over one input
+ */
+static bool checkInput ( const char *data, size_t len ) {
+
+	return checkNumbers( data, len ) && checkLines( data, len ) && checkSpan( data, len ) && checkUtf8( data, len );
+}
+
+#endif // SAFEINPUT_FUZZ_CHECK_H_
@@ -0,0 +1,335 @@
+/**
+ * differential.c - the fast parsers and scanners against strto* and scalar code
+ *
+ * Runs the check.h comparisons over a fixed list of edge cases, the
+ * integer limits of every type and their neighbours, doubles printed at
+ * every precision ( halfway points included ), and random inputs built
+ * from number syntax, UTF-8 and noise, alone and joined into multi-line
+ * blocks.
+ *
+ * usage - differential [-n rounds] [-s seed]
+ *
+ * 		-n		random rounds ( default 20000 )
+ * 		-s		seed ( default fixed, so runs are reproducible )
+ *
+ * Exits 1 after the first mismatch, which is printed to stderr.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <limits.h>
+#include <float.h>
+#include <math.h>
+#include "check.h"
+
+static uint64_t rng = 0x9E3779B97F4A7C15ull;
+
+static uint64_t next ( void ) {
+
+	// xorshift64*, deterministic across runs
+	rng ^= rng >> 12;
+	rng ^= rng << 25;
+	rng ^= rng >> 27;
+	return rng * 0x2545F4914F6CDD1Dull;
+}
+
+static size_t inputs;
+
+static bool run ( const char *p, size_t len ) {
+
+	inputs++;
+	return checkInput( p, len );
+}
+
+static bool runString ( const char *s ) {
+
+	return run( s, strlen( s ));
+}
+
+// === Edge cases ===
+static const char *edges[] = {
+	"", "0", "-0", "+0", "00", "-00", "+-1", "-+1", "--1", "++1", "-", "+", " ", "\t",
+	" 12", "\t\v\f\r-12", "12 ", "12\t", "12\r", " 12 ", "1 2", "12x", "x12", "0x10", "1_000",
+	"2147483647", "2147483648", "-2147483648", "-2147483649", "4294967295", "4294967296",
+	"-4294967295", "-4294967296", "9223372036854775807", "9223372036854775808",
+	"-9223372036854775808", "-9223372036854775809", "18446744073709551615",
+	"18446744073709551616", "-18446744073709551615", "-18446744073709551616",
+	"000000000000000000000000000000000000000000000000000000000000000000000000000009",
+	"99999999999999999999999999999999999999999999999999", "99999999999999999999x",
+	"٣",
+	"0.0", "-0.0", "+0.0", ".5", "5.", ".", "-.", "e5", "1e", "1e+", "1e-", "1e5", "1E5",
+	"1e308", "1.7976931348623157e308", "1.7976931348623158e308", "1.7976931348623159e308",
+	"1e309", "-1e309", "1e-307", "2.2250738585072014e-308", "2.2250738585072011e-308",
+	"4.9406564584124654e-324", "2.4703282292062328e-324", "2.4703282292062327e-324",
+	"1e-324", "1e-400", "-1e-400", "1e99999999999999999999", "1e-99999999999999999999",
+	"0e99999999999999999999", "0.000000000000000000000000000000000000000000001e45",
+	"3.4028234663852886e38", "3.4028235677973366e38", "3.4028236e38", "1.1754943508e-38",
+	"1.401298464e-45", "7.006492321624085e-46", "7.006492321624086e-46",
+	"0.1", "0.2", "0.3", "1.0000000000000002", "9007199254740993", "9007199254740992.5",
+	"123456789012345678901234567890", "2.22507385850720113605740979670913197593481954e-308",
+	"inf", "-inf", "INF", "infinity", "nan", "-nan", "NAN", "nan(123)", "infx",
+	"0x1p0", "0x1P-1074", "0x1p-1075", "0x1.fffffffffffffp1023", "0x1p1024", "0x.8p1",
+	"0x", "0x.", "0xp1", "0x1p", "-0x0p0", "0X1.8P+1", "1.5 ", " 1.5", "1,5",
+	// UTF-8: each length at its limits, then overlong, surrogate, too large, cut short
+	"\xC3\xA9", "\xC2\x80", "\xDF\xBF", "\xE0\xA0\x80", "\xEF\xBF\xBF", "\xF0\x90\x80\x80",
+	"\xF4\x8F\xBF\xBF", "\xED\x9F\xBF", "\xEE\x80\x80", "\xF0\x9F\x98\x80", "caf\xC3\xA9 cr\xC3\xA8me",
+	"\xC0\xAF", "\xC1\xBF", "\xE0\x9F\xBF", "\xF0\x8F\xBF\xBF", "\xED\xA0\x80", "\xED\xBF\xBF",
+	"\xF4\x90\x80\x80", "\xF5\x80\x80\x80", "\xF8\x88\x80\x80\x80", "\xFF", "\x80", "\xBF",
+	"\xC3", "\xE2\x82", "\xF0\x9F\x98", "\xC3\xA9\xA9", "a\xC3", "\xE2\x82\xAC\xE2\x82",
+	"0123456789abcd\xC3\xA9", "0123456789abcde\xC3\xA9", "0123456789abc\xF0\x9F\x98\x80x",
+};
+
+// edge cases with an embedded NUL, where strto* stops
+static const struct { const char *p; size_t len; } nulEdges[] = {
+	{ "12\0" "34", 5 }, { "\0", 1 }, { "-\0" "1", 3 }, { "1e\0" "5", 4 },
+};
+
+static bool runEdges ( void ) {
+
+	char block[8192];
+	size_t len = 0;
+
+	for ( size_t i = 0; i < sizeof(nulEdges) / sizeof(nulEdges[0]); i++ )
+		if ( !run( nulEdges[i].p, nulEdges[i].len )) return false;
+
+	for ( size_t i = 0; i < sizeof(edges) / sizeof(edges[0]); i++ ) {
+
+		size_t n = strlen( edges[i] );
+		if ( !run( edges[i], n )) return false;
+
+		memcpy( block + len, edges[i], n );
+		len += n;
+		block[len++] = '\n';
+	}
+
+	// one multi-line input, so values straddle the vector widths
+	return run( block, len ) && run( block, len - 1 );
+}
+
+// === Limits ===
+
+/**
+ * step - add dir ( +1 or -1 ) to a decimal magnitude in place
+ *
+ * returns false if the magnitude was 0 and dir is -1
+ */
+static bool step ( char *digits, int dir ) {
+
+	size_t n = strlen( digits ), i = n;
+
+	if ( dir < 0 && n == 1 && digits[0] == '0' ) return false;
+
+	while ( i-- > 0 ) {
+		if ( dir > 0 && digits[i] < '9' ) { digits[i]++; return true; }
+		if ( dir < 0 && digits[i] > '0' ) { digits[i]--; break; }
+		digits[i] = dir > 0 ? '0' : '9';
+	}
+
+	if ( dir > 0 ) {
+		// carried off the front, 999 + 1
+		memmove( digits + 1, digits, n + 1 );
+		digits[0] = '1';
+	}
+	else if ( digits[0] == '0' && n > 1 ) memmove( digits, digits + 1, n );
+
+	return true;
+}
+
+/**
+ * runLimit - a limit and its neighbours, bare and decorated
+ */
+static bool runLimit ( const char *limit ) {
+
+	static const char *forms[] = { "%s%s", "+%s%s", " %s%s", "\t%s%s", "%s%s ", "%s000%s", "%s%sx" };
+	char digits[64], buf[96];
+
+	const char *sign = limit[0] == '-' ? "-" : "";
+
+	for ( int dir = -1; dir <= 1; dir++ ) {
+
+		snprintf( digits, sizeof(digits), "%s", limit + ( *sign != '\0' ));
+		if ( dir && !step( digits, dir )) continue;
+
+		for ( size_t f = 0; f < sizeof(forms) / sizeof(forms[0]); f++ ) {
+			snprintf( buf, sizeof(buf), forms[f], sign, digits );
+			if ( !runString( buf )) return false;
+		}
+	}
+
+	return true;
+}
+
+static bool runLimits ( void ) {
+
+	static const long long slimits[] = { INT_MIN, INT_MAX, LONG_MIN, LONG_MAX, LLONG_MIN, LLONG_MAX, 0 };
+	static const unsigned long long ulimits[] = { UINT_MAX, ULONG_MAX, ULLONG_MAX, 0 };
+	char buf[64];
+
+	for ( size_t i = 0; i < sizeof(slimits) / sizeof(slimits[0]); i++ ) {
+		snprintf( buf, sizeof(buf), "%lld", slimits[i] );
+		if ( !runLimit( buf )) return false;
+	}
+
+	// unsigned getters negate a leading '-' like strtoul(), so both signs
+	for ( size_t i = 0; i < sizeof(ulimits) / sizeof(ulimits[0]); i++ ) {
+		snprintf( buf, sizeof(buf), "%llu", ulimits[i] );
+		if ( !runLimit( buf )) return false;
+		snprintf( buf, sizeof(buf), "-%llu", ulimits[i] );
+		if ( !runLimit( buf )) return false;
+	}
+
+	return true;
+}
+
+// === Floats ===
+static double randomDouble ( void ) {
+
+	uint64_t bits = next();
+	switch ( next() % 4 ) {
+		case 0:	bits &= 0x800FFFFFFFFFFFFFull; break;					// subnormal
+		case 1:	bits = ( bits & 0x800FFFFFFFFFFFFFull ) | ( 1ull << 62 ); break;	// near 1
+		default: break;
+	}
+
+	double d;
+	memcpy( &d, &bits, sizeof(d) );
+	return isfinite( d ) ? d : 1.0;
+}
+
+static bool runDouble ( double d ) {
+
+	char buf[96];
+
+	for ( int prec = 1; prec <= 25; prec += 1 + (int)( next() % 3 )) {
+		snprintf( buf, sizeof(buf), "%.*g", prec, d );
+		if ( !runString( buf )) return false;
+	}
+
+	snprintf( buf, sizeof(buf), "%a", d );
+	if ( !runString( buf )) return false;
+
+	// halfway to the next double up, exact where long double is wider
+	long double mid = ( (long double)d + (long double)nextafter( d, INFINITY )) / 2;
+	snprintf( buf, sizeof(buf), "%.40Le", mid );
+	if ( !runString( buf )) return false;
+
+	float f = (float)d;
+	if ( !isfinite( f )) return true;
+
+	snprintf( buf, sizeof(buf), "%.9g", (double)f );
+	if ( !runString( buf )) return false;
+	snprintf( buf, sizeof(buf), "%.30e", ( (double)f + (double)nextafterf( f, INFINITY )) / 2 );
+	return runString( buf );
+}
+
+// === Random ===
+static const char alphabet[] = "0123456789000000000+-.eE  \tx0123456789pPinfaINFNAy\r\v\0";
+
+static size_t randomLine ( char *dst, size_t cap ) {
+
+	size_t len = next() % 8 ? next() % 32 : next() % ( INPUT_BUFFER_SIZE + 16 );
+	if ( len > cap ) len = cap;
+
+	for ( size_t i = 0; i < len; i++ ) {
+		uint64_t x = next();
+		if ( x % 32 == 0 ) dst[i] = (char)( x >> 8 );	// any byte but a newline
+		else dst[i] = alphabet[( x >> 8 ) % ( sizeof(alphabet) - 1 )];
+		if ( dst[i] == '\n' ) dst[i] = ' ';
+	}
+
+	return len;
+}
+
+/**
+ * randomUtf8 - mostly well-formed UTF-8 of every length, with the odd
+ * 				byte dropped, doubled or flipped so sequences go bad
+ */
+static size_t randomUtf8 ( char *dst, size_t cap ) {
+
+	static const uint32_t ranges[][2] = {
+		{ 0x20, 0x7E }, { 0x80, 0x7FF }, { 0x800, 0xD7FF }, { 0xE000, 0xFFFF }, { 0x10000, 0x10FFFF },
+	};
+	size_t len = 0, chars = next() % 48;
+
+	for ( size_t i = 0; i < chars && len + 4 <= cap; i++ ) {
+
+		const uint32_t *range = ranges[ next() % 5 ];
+		uint32_t cp = range[0] + (uint32_t)( next() % ( range[1] - range[0] + 1 ));
+		unsigned char *d = (unsigned char *)dst + len;
+
+		if ( cp < 0x80 ) d[0] = (unsigned char)cp, len += 1;
+		else if ( cp < 0x800 ) d[0] = 0xC0 | cp >> 6, d[1] = 0x80 | ( cp & 0x3F ), len += 2;
+		else if ( cp < 0x10000 ) d[0] = 0xE0 | cp >> 12, d[1] = 0x80 | ( cp >> 6 & 0x3F ), d[2] = 0x80 | ( cp & 0x3F ), len += 3;
+		else d[0] = 0xF0 | cp >> 18, d[1] = 0x80 | ( cp >> 12 & 0x3F ), d[2] = 0x80 | ( cp >> 6 & 0x3F ), d[3] = 0x80 | ( cp & 0x3F ), len += 4;
+	}
+
+	switch ( len ? next() % 8 : 7 ) {
+		case 0:	memmove( dst + len / 2, dst + len / 2 + 1, len - len / 2 - 1 ); len--; break;	// drop a byte
+		case 1:	if ( len < cap ) { memmove( dst + len / 3 + 1, dst + len / 3, len - len / 3 ); len++; } break;
+		case 2:	dst[ next() % len ] ^= (char)( 1 << ( next() % 8 )); break;
+		default: break;
+	}
+
+	for ( size_t i = 0; i < len; i++ )
+		if ( dst[i] == '\n' ) dst[i] = ' ';
+	return len;
+}
+
+static bool runRandom ( void ) {
+
+	char block[16384];
+	size_t len = 0, lines = 1 + next() % 32;
+
+	for ( size_t i = 0; i < lines && len + INPUT_BUFFER_SIZE + 32 < sizeof(block); i++ ) {
+
+		size_t n;
+		if ( next() % 4 == 0 ) {
+			// a mutated edge case
+			const char *e = edges[ next() % ( sizeof(edges) / sizeof(edges[0]) ) ];
+			n = strlen( e );
+			memcpy( block + len, e, n );
+			if ( n && next() % 2 ) block[ len + next() % n ] = alphabet[ next() % ( sizeof(alphabet) - 2 ) ];
+		}
+		else if ( next() % 3 == 0 ) n = randomUtf8( block + len, INPUT_BUFFER_SIZE + 16 );
+		else n = randomLine( block + len, INPUT_BUFFER_SIZE + 16 );
+
+		if ( !run( block + len, n )) return false;
+		len += n;
+		block[len++] = '\n';
+	}
+
+	return run( block, len - ( next() & 1 ));
+}
+
+
+
+int main ( int argc, char **argv ) {
+
+	unsigned long rounds = 20000;
+
+	for ( int i = 1; i < argc; i++ ) {
+		if ( !strcmp( argv[i], "-n" ) && i + 1 < argc ) rounds = strtoul( argv[++i], NULL, 10 );
+		else if ( !strcmp( argv[i], "-s" ) && i + 1 < argc ) rng = strtoull( argv[++i], NULL, 10 ) | 1;
+		else {
+			fprintf( stderr, "usage: %s [-n rounds] [-s seed]\n", argv[0] );
+			return 2;
+		}
+	}
+
+	bool ok = runEdges() && runLimits();
+
+	static const double specials[] = { 0.0, -0.0, DBL_MIN, DBL_MAX, FLT_MIN, FLT_MAX, 0.1, 1e23, 5e-324 };
+	for ( size_t i = 0; ok && i < sizeof(specials) / sizeof(specials[0]); i++ ) ok = runDouble( specials[i] );
+
+	for ( unsigned long i = 0; ok && i < rounds; i++ ) ok = runDouble( randomDouble() ) && runRandom();
+
+	if ( !ok ) {
+		fprintf( stderr, "[!] mismatch after %zu inputs\n", inputs );
+		return 1;
+	}
+
+	printf( "[+] %zu inputs, no mismatches\n", inputs );
+	return 0;
+}
@@ -0,0 +1,66 @@
+/**
+ * fuzz_parse.c - libFuzzer / AFL target for the parsers and scanners
+ *
+ * Feeds each input through check.h: every numeric try getter against
+ * strto*, readLine() against memchr() and si_charset_span() against the
+ * scalar loop. A mismatch prints the offending line and aborts, which
+ * both fuzzers record as a crash.
+ *
+ * usage - make fuzz && build/fuzz/fuzz_parse [corpus dir]
+ *
+ * Built with -DSI_FUZZ_MAIN instead of -fsanitize=fuzzer it gets a main()
+ * that runs each file named on the command line ( or stdin ) once, for
+ * AFL ( afl-fuzz -i in -o out -- build/fuzz/fuzz_parse @@ ) and for
+ * replaying crashes with any compiler.
+ */
+
+#include <stdint.h>
+#include <stddef.h>
+#include "check.h"
+
+int LLVMFuzzerTestOneInput ( const uint8_t *data, size_t size );
+
+int LLVMFuzzerTestOneInput ( const uint8_t *data, size_t size ) {
+
+	if ( !checkInput( (const char *)data, size )) abort();
+	return 0;
+}
+
+
+
+#ifdef SI_FUZZ_MAIN
+static int runFile ( FILE *fp ) {
+
+	size_t cap = 4096, len = 0, n;
+	char *buf = malloc( cap );
+	if ( !buf ) return 1;
+
+	while (( n = fread( buf + len, 1, cap - len, fp )) > 0 ) {
+		len += n;
+		if ( len == cap ) {
+			char *grown = realloc( buf, cap *= 2 );
+			if ( !grown ) { free( buf ); return 1; }
+			buf = grown;
+		}
+	}
+
+	LLVMFuzzerTestOneInput( (const uint8_t *)buf, len );
+	free( buf );
+	return 0;
+}
+
+int main ( int argc, char **argv ) {
+
+	if ( argc < 2 ) return runFile( stdin );
+
+	for ( int i = 1; i < argc; i++ ) {
+		FILE *fp = fopen( argv[i], "rb" );
+		if ( !fp ) { perror( argv[i] ); return 1; }
+		int rc = runFile( fp );
+		fclose( fp );
+		if ( rc ) return rc;
+	}
+
+	return 0;
+}
+#endif
@@ -1,48 +1,424 @@
-// safeinput.h - version 1.1.0
-
-#ifndef SAFEINPUT_H_
-#define SAFEINPUT_H_
-
-// === Includes ===
-#include <stdbool.h>
-#include <stddef.h> // for size_t
-
-#ifdef __cplusplus
-extern "C" {
-#endif
-
-// === STRUCTs ===
-typedef struct si_string {
-	char	*data;	// pointer to data
-	size_t	len;	// byte counter
-} si_string;
-
-// === INPUT BUFFER ===
-#define INPUT_BUFFER_SIZE				128
-#define CHAR_INPUT_BUFFER_SIZE			4
-
-// === Input handling ===
-int	si_getInt						( void );
-unsigned int si_getUInt				( void );
-
-float si_getFloat					( void );
-double si_getDouble					( void );
-
-long si_getLong						( void );
-unsigned long si_getULong			( void );
-long long si_getLongLong			( void );
-unsigned long long si_getULongLong	( void );
-
-int si_getChar						( void );
-int si_getCharFiltered				( const char *allowed );
-
-char *si_getCString					( void );
-si_string si_getString				( void );
-
-bool si_getBool						( void );
-
-#ifdef __cplusplus
-}
-#endif
-
-#endif // SAFEINPUT_H_
+// safeinput.h - version 1.1.0
+
+#ifndef SAFEINPUT_H_
+#define SAFEINPUT_H_
+
+// the single-header build ( make single ) compiles the library into the
+// file that defines SAFEINPUT_IMPLEMENTATION, which needs these extensions
+#if defined(SAFEINPUT_IMPLEMENTATION) && !defined(_GNU_SOURCE)
+#define _GNU_SOURCE
+#endif
+
+// === Includes ===
+#include <stdbool.h>
+#include <stddef.h> // for size_t
+#include <stdint.h> // for uint32_t
+#include <stdio.h> // for FILE
+
+// === Exports ===
+// the shared library is built with -fvisibility=hidden, so only SI_API
+// declarations end up in its dynamic symbol table
+#ifndef SI_API
+#if defined(__GNUC__)
+#define SI_API	__attribute__(( visibility( "default" )))
+#else
+#define SI_API
+#endif
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// === STRUCTs ===
+typedef struct si_string {
+	char	*data;	// pointer to data
+	size_t	len;	// byte counter
+} si_string;
+
+// where a batch read stopped ( line == 0 if it didn't fail )
+typedef struct si_position {
+	size_t	line;	// 1-based input line
+	size_t	column;	// 1-based byte column
+} si_position;
+
+// opaque input source, see si_reader_from*()
+typedef struct si_reader si_reader;
+
+// memory source for the string getters ( free may be NULL for bulk release )
+typedef struct si_allocator {
+	void	*(*alloc)( void *ctx, size_t size );
+	void	(*free)( void *ctx, void *ptr );
+	void	*ctx;
+} si_allocator;
+
+// bump allocator, see si_arena_allocator()
+typedef struct si_arena si_arena;
+
+// result of the status-returning calls
+typedef enum si_result {
+	SI_OK = 0,
+	SI_EOF,			// end of input, read error, or bad arguments
+	SI_TOO_LONG,	// line exceeded the limit and was discarded
+	SI_WOULD_BLOCK,	// non-blocking source has no complete line yet
+	SI_INVALID,		// not a valid value of the requested type
+	SI_OVERFLOW,	// valid syntax, but out of the type's range
+} si_result;
+
+// what an error message is about
+typedef enum si_error {
+	SI_ERR_INVALID,		// rejected line
+	SI_ERR_OVERFLOW,	// number out of range
+	SI_ERR_TOO_LONG,	// line exceeded the buffer size
+	SI_ERR_EOF,			// end of input notice
+	SI_ERR_NOMEM,		// allocation failure
+	SI_ERR_USAGE,		// bad arguments
+} si_error;
+
+// receives every message a reader would print to stderr
+typedef void ( *si_errorHandler )( void *ctx, si_error kind, const char *msg );
+
+// callbacks for si_reader_forEach*(), return false to stop early
+typedef bool ( *si_lineFn )( void *ctx, si_string line );
+typedef bool ( *si_longFn )( void *ctx, long value );
+typedef bool ( *si_doubleFn )( void *ctx, double value );
+
+typedef struct si_errorStats {
+	size_t	invalid;	// rejected lines
+	size_t	overflow;	// numbers out of range
+	size_t	tooLong;	// lines over the buffer size
+	size_t	suppressed;	// messages dropped by the repeat limit
+} si_errorStats;
+
+// 256-bit byte class, build with si_charset_compile()
+typedef struct si_charset {
+	unsigned long long	bits[4];	// bit c is set if byte c is a member
+	unsigned char		nibble[32];	// the same set transposed for SIMD scans
+} si_charset;
+
+// one delimited line split into fields, see si_reader_getRecord()
+#define SI_RECORD_FIELDS				64
+
+typedef struct si_record {
+	size_t		line;	// 1-based input line the record came from
+	size_t		count;	// fields in use
+	si_string	field[SI_RECORD_FIELDS];	// views, valid until the next read
+} si_record;
+
+// field types for si_schema_compile()
+typedef enum si_fieldType {
+	SI_FIELD_SKIP = 0,		// field is checked for presence only
+	SI_FIELD_INT,
+	SI_FIELD_UINT,
+	SI_FIELD_LONG,
+	SI_FIELD_ULONG,
+	SI_FIELD_LONGLONG,
+	SI_FIELD_ULONGLONG,
+	SI_FIELD_FLOAT,
+	SI_FIELD_DOUBLE,
+	SI_FIELD_BOOL,			// "y" or "n"
+	SI_FIELD_CHAR,			// exactly one byte
+	SI_FIELD_STRING,		// si_string view, valid until the next read
+	SI_FIELD_STRING_COPY,	// si_string from the reader's allocator
+	SI_FIELD_TYPES			// number of field types
+} si_fieldType;
+
+typedef struct si_fieldDesc {
+	si_fieldType	type;
+	size_t			offset;	// offsetof() the destination member
+} si_fieldDesc;
+
+// one question of a form, see si_reader_promptMany()
+typedef struct si_promptField {
+	const char		*label;	// prompt shown when the answer is needed, NULL for none
+	si_fieldType	type;	// any but SI_FIELD_SKIP
+	void			*out;	// destination of the matching type, si_string for strings
+} si_promptField;
+
+// compiled record layout, see si_schema_compile()
+typedef struct si_schema si_schema;
+
+// why a line or value was turned down, indexes si_stats.rejected
+typedef enum si_reject {
+	SI_REJECT_USAGE,		// NULL buffer or a limit below 1
+	SI_REJECT_TOO_LONG,		// line or token over the limit, drained
+	SI_REJECT_SYNTAX,		// not a value of the type, or more than one character
+	SI_REJECT_RANGE,		// valid syntax, but out of the type's range
+	SI_REJECT_NEGATIVE,		// '-' in front of an unsigned value
+	SI_REJECT_CHOICE,		// character outside the allowed set, or not y/n
+	SI_REJECT_RECORD,		// bad quoting or wrong number of fields
+	SI_REJECTS				// number of reasons
+} si_reject;
+
+// hot-path counters of one reader, see si_reader_stats()
+typedef struct si_stats {
+	bool	enabled;					// false unless the library was built with SI_STATS
+	size_t	bytes;						// bytes taken from the source
+	size_t	refills;					// read() / fread() calls
+	size_t	blocked;					// refills that found no data ( EAGAIN )
+	size_t	lines;						// lines consumed
+	size_t	drained;					// bytes discarded by too-long lines and skipLine
+	size_t	parsed[SI_FIELD_TYPES];		// accepted values by si_fieldType
+	size_t	rejected[SI_REJECTS];		// rejects by si_reject
+	size_t	allocs;						// string getter allocations
+	size_t	allocBytes;
+} si_stats;
+
+// === INPUT BUFFER ===
+#define INPUT_BUFFER_SIZE				128
+#define CHAR_INPUT_BUFFER_SIZE			4
+#define SI_LINE_MAX						( 16u * 1024 * 1024 ) // hard cap for any line
+#define SI_UNBOUNDED					( (size_t)-1 ) // line limit of SI_LINE_MAX
+
+// === Input handling ===
+SI_API int si_getInt						( void );
+SI_API unsigned int si_getUInt				( void );
+
+SI_API float si_getFloat					( void );
+SI_API double si_getDouble					( void );
+
+SI_API long si_getLong						( void );
+SI_API unsigned long si_getULong			( void );
+SI_API long long si_getLongLong				( void );
+SI_API unsigned long long si_getULongLong	( void );
+
+SI_API int si_getChar						( void );
+SI_API int si_getCharFiltered				( const char *allowed );
+SI_API int si_getCharIn							( const si_charset *cs );
+
+SI_API char *si_getCString					( void );
+SI_API si_string si_getString				( void );
+SI_API si_string si_getStringView			( void ); // valid until the next read
+SI_API si_string si_retainString			( si_string view ); // malloc'd copy of a view
+
+SI_API char *si_getCStringMax				( size_t max ); // lines of up to max bytes
+SI_API si_string si_getStringMax			( size_t max );
+SI_API si_string si_getStringViewMax		( size_t max );
+SI_API bool si_setLineLimit					( size_t limit ); // INPUT_BUFFER_SIZE by default
+SI_API bool si_setErrorHandler					( si_errorHandler fn, void *ctx ); // NULL for stderr
+SI_API bool si_setLocking						( bool on ); // line-atomic getters on the shared stdin reader
+SI_API bool si_setSilent						( bool silent );
+SI_API bool si_setAllocator						( const si_allocator *a ); // NULL for malloc/free
+SI_API void si_release							( void *ptr ); // free a string through the allocator
+
+SI_API bool si_getBool						( void );
+
+// === Status input handling ( no sentinels, no retry loop ) ===
+SI_API si_result si_tryGetInt					( int *out );
+SI_API si_result si_tryGetUInt					( unsigned int *out );
+SI_API si_result si_tryGetFloat					( float *out );
+SI_API si_result si_tryGetDouble				( double *out );
+SI_API si_result si_tryGetLong					( long *out );
+SI_API si_result si_tryGetULong					( unsigned long *out );
+SI_API si_result si_tryGetLongLong				( long long *out );
+SI_API si_result si_tryGetULongLong				( unsigned long long *out );
+SI_API si_result si_tryGetChar					( char *out );
+SI_API si_result si_tryGetBool					( bool *out );
+SI_API si_result si_tryGetLineIn				( const si_charset *cs, si_string *line ); // whole-line validator
+SI_API size_t si_skipLine						( void ); // drop the rest of the line, returns bytes skipped
+
+// === Bounded input ( lo <= x <= hi, checked while parsing ) ===
+SI_API int si_getIntRange						( int lo, int hi );
+SI_API unsigned int si_getUIntRange				( unsigned int lo, unsigned int hi );
+SI_API long si_getLongRange						( long lo, long hi );
+SI_API unsigned long si_getULongRange			( unsigned long lo, unsigned long hi );
+SI_API long long si_getLongLongRange			( long long lo, long long hi );
+SI_API unsigned long long si_getULongLongRange	( unsigned long long lo, unsigned long long hi );
+SI_API float si_getFloatRange					( float lo, float hi );
+SI_API double si_getDoubleRange					( double lo, double hi );
+
+SI_API si_result si_tryGetIntRange					( int lo, int hi, int *out ); // SI_OVERFLOW outside [lo, hi]
+SI_API si_result si_tryGetUIntRange					( unsigned int lo, unsigned int hi, unsigned int *out );
+SI_API si_result si_tryGetLongRange					( long lo, long hi, long *out );
+SI_API si_result si_tryGetULongRange				( unsigned long lo, unsigned long hi, unsigned long *out );
+SI_API si_result si_tryGetLongLongRange				( long long lo, long long hi, long long *out );
+SI_API si_result si_tryGetULongLongRange			( unsigned long long lo, unsigned long long hi, unsigned long long *out );
+SI_API si_result si_tryGetFloatRange				( float lo, float hi, float *out );
+SI_API si_result si_tryGetDoubleRange				( double lo, double hi, double *out );
+
+// === Streaming ( one call for the whole input, see si_reader_forEachLine() ) ===
+SI_API si_result si_forEachLine					( si_lineFn fn, void *ctx );
+SI_API si_result si_forEachLong					( si_longFn fn, void *ctx );
+SI_API si_result si_forEachDouble				( si_doubleFn fn, void *ctx );
+
+// === Prompts ( prompt and retry messages in one write, type-ahead kept ) ===
+SI_API bool si_prompt							( const char *prompt ); // shown before each wait for a line, NULL for none
+SI_API si_result si_promptMany					( const si_promptField *fields, size_t n ); // a form, several answers per line
+
+// === UTF-8 ( validated in the pass that finds the newline ) ===
+SI_API int si_getCodepoint						( void ); // one character per line, like si_getChar()
+SI_API char *si_getCStringUtf8					( void );
+SI_API si_string si_getStringUtf8				( void );
+SI_API si_string si_getStringViewUtf8			( void ); // valid until the next read
+SI_API si_result si_tryGetCodepoint				( uint32_t *out );
+SI_API si_result si_tryGetLineUtf8				( si_string *line ); // SI_INVALID for a line that isn't UTF-8
+
+// === Readers ===
+SI_API si_reader *si_reader_fromFile		( FILE *fp );
+SI_API si_reader *si_reader_fromFd			( int fd );
+SI_API si_reader *si_reader_fromMemory		( const void *data, size_t len );
+SI_API si_reader *si_reader_fromMapped			( int fd ); // mmap regular files, else si_reader_fromFd
+SI_API bool si_mapStdin							( void ); // mmap a redirected stdin before the first read
+SI_API void si_reader_free					( si_reader *r );
+
+SI_API si_reader *si_stdin					( void ); // default reader behind si_get*()
+SI_API si_reader *si_useReader					( si_reader *r ); // per-thread default for si_get*(), NULL for stdin
+SI_API bool si_reader_setLocking				( si_reader *r, bool on ); // hold a lock per getter call
+SI_API bool si_reader_eof					( const si_reader *r );
+SI_API int si_reader_error					( const si_reader *r );
+SI_API bool si_reader_setLineLimit			( si_reader *r, size_t limit );
+SI_API bool si_reader_setAllocator				( si_reader *r, const si_allocator *a );
+SI_API void si_reader_release					( si_reader *r, void *ptr );
+SI_API si_string si_reader_retainString			( si_reader *r, si_string view );
+
+SI_API bool si_reader_setErrorHandler			( si_reader *r, si_errorHandler fn, void *ctx );
+SI_API bool si_reader_setSilent					( si_reader *r, bool silent ); // count errors, print nothing
+SI_API bool si_reader_setErrorRepeatLimit		( si_reader *r, unsigned limit ); // 0 for no limit
+SI_API bool si_reader_setPrompt					( si_reader *r, const char *prompt ); // terminals only, not copied
+SI_API si_errorStats si_reader_errorStats		( const si_reader *r );
+SI_API si_stats si_reader_stats					( const si_reader *r ); // zero unless built with SI_STATS
+SI_API bool si_reader_resetStats				( si_reader *r );
+
+SI_API bool si_reader_setNonBlocking			( si_reader *r, bool on ); // sets O_NONBLOCK on the fd
+SI_API int si_reader_fd							( const si_reader *r ); // for poll/epoll, -1 if none
+SI_API bool si_reader_wouldBlock				( const si_reader *r );
+SI_API si_result si_reader_readLine				( si_reader *r, si_string *line ); // view, never retries
+SI_API size_t si_reader_skipLine				( si_reader *r );
+SI_API si_result si_reader_forEachLine			( si_reader *r, si_lineFn fn, void *ctx ); // views, SI_EOF at the end, SI_OK if fn stopped
+SI_API si_result si_reader_forEachLong			( si_reader *r, si_longFn fn, void *ctx ); // lines that don't parse are skipped
+SI_API si_result si_reader_forEachDouble		( si_reader *r, si_doubleFn fn, void *ctx );
+
+// === Character sets ===
+SI_API bool si_charset_compile					( si_charset *cs, const char *spec ); // "A-Za-z0-9_", "^0-9", ...
+SI_API size_t si_charset_span					( const si_charset *cs, const char *p, size_t len ); // SIMD strspn
+SI_API bool si_utf8_valid						( const char *p, size_t len ); // SIMD, RFC 3629
+
+static inline bool si_charset_has		( const si_charset *cs, unsigned char c ) {
+	return ( cs->bits[ c >> 6 ] >> ( c & 63 )) & 1;
+}
+
+// === Arenas ===
+SI_API si_arena *si_arena_create				( size_t chunkSize ); // 0 for 64 KiB chunks
+SI_API void *si_arena_alloc						( si_arena *a, size_t size );
+SI_API void si_arena_reset						( si_arena *a ); // frees everything, keeps chunks
+SI_API void si_arena_destroy					( si_arena *a );
+SI_API si_allocator si_arena_allocator			( si_arena *a );
+
+// === Reader input handling ===
+SI_API int si_reader_getInt				( si_reader *r );
+SI_API unsigned int si_reader_getUInt		( si_reader *r );
+
+SI_API float si_reader_getFloat				( si_reader *r );
+SI_API double si_reader_getDouble			( si_reader *r );
+
+SI_API long si_reader_getLong				( si_reader *r );
+SI_API unsigned long si_reader_getULong		( si_reader *r );
+SI_API long long si_reader_getLongLong		( si_reader *r );
+SI_API unsigned long long si_reader_getULongLong	( si_reader *r );
+
+SI_API int si_reader_getChar				( si_reader *r );
+SI_API int si_reader_getCharFiltered		( si_reader *r, const char *allowed );
+SI_API int si_reader_getCharIn					( si_reader *r, const si_charset *cs );
+
+SI_API char *si_reader_getCString			( si_reader *r );
+SI_API si_string si_reader_getString		( si_reader *r );
+SI_API si_string si_reader_getStringView	( si_reader *r );
+SI_API char *si_reader_getCStringMax		( si_reader *r, size_t max );
+SI_API si_string si_reader_getStringMax		( si_reader *r, size_t max );
+SI_API si_string si_reader_getStringViewMax		( si_reader *r, size_t max );
+
+SI_API bool si_reader_getBool				( si_reader *r );
+
+SI_API si_result si_reader_tryGetInt			( si_reader *r, int *out );
+SI_API si_result si_reader_tryGetUInt			( si_reader *r, unsigned int *out );
+SI_API si_result si_reader_tryGetFloat			( si_reader *r, float *out );
+SI_API si_result si_reader_tryGetDouble			( si_reader *r, double *out );
+SI_API si_result si_reader_tryGetLong			( si_reader *r, long *out );
+SI_API si_result si_reader_tryGetULong			( si_reader *r, unsigned long *out );
+SI_API si_result si_reader_tryGetLongLong		( si_reader *r, long long *out );
+SI_API si_result si_reader_tryGetULongLong		( si_reader *r, unsigned long long *out );
+SI_API si_result si_reader_tryGetChar			( si_reader *r, char *out );
+SI_API si_result si_reader_tryGetBool			( si_reader *r, bool *out );
+SI_API si_result si_reader_tryGetLineIn			( si_reader *r, const si_charset *cs, si_string *line );
+
+SI_API int si_reader_getCodepoint				( si_reader *r );
+SI_API char *si_reader_getCStringUtf8			( si_reader *r );
+SI_API si_string si_reader_getStringUtf8		( si_reader *r );
+SI_API si_string si_reader_getStringViewUtf8	( si_reader *r );
+SI_API si_result si_reader_tryGetCodepoint		( si_reader *r, uint32_t *out );
+SI_API si_result si_reader_tryGetLineUtf8		( si_reader *r, si_string *line );
+
+SI_API int si_reader_getIntRange						( si_reader *r, int lo, int hi );
+SI_API unsigned int si_reader_getUIntRange				( si_reader *r, unsigned int lo, unsigned int hi );
+SI_API long si_reader_getLongRange						( si_reader *r, long lo, long hi );
+SI_API unsigned long si_reader_getULongRange			( si_reader *r, unsigned long lo, unsigned long hi );
+SI_API long long si_reader_getLongLongRange				( si_reader *r, long long lo, long long hi );
+SI_API unsigned long long si_reader_getULongLongRange	( si_reader *r, unsigned long long lo, unsigned long long hi );
+SI_API float si_reader_getFloatRange					( si_reader *r, float lo, float hi );
+SI_API double si_reader_getDoubleRange					( si_reader *r, double lo, double hi );
+
+SI_API si_result si_reader_tryGetIntRange				( si_reader *r, int lo, int hi, int *out );
+SI_API si_result si_reader_tryGetUIntRange				( si_reader *r, unsigned int lo, unsigned int hi, unsigned int *out );
+SI_API si_result si_reader_tryGetLongRange				( si_reader *r, long lo, long hi, long *out );
+SI_API si_result si_reader_tryGetULongRange				( si_reader *r, unsigned long lo, unsigned long hi, unsigned long *out );
+SI_API si_result si_reader_tryGetLongLongRange			( si_reader *r, long long lo, long long hi, long long *out );
+SI_API si_result si_reader_tryGetULongLongRange			( si_reader *r, unsigned long long lo, unsigned long long hi, unsigned long long *out );
+SI_API si_result si_reader_tryGetFloatRange				( si_reader *r, float lo, float hi, float *out );
+SI_API si_result si_reader_tryGetDoubleRange			( si_reader *r, double lo, double hi, double *out );
+
+// === Batch input ===
+SI_API size_t si_getIntArray					( int *out, size_t n, char delim, si_position *err );
+SI_API size_t si_getUIntArray					( unsigned int *out, size_t n, char delim, si_position *err );
+SI_API size_t si_getLongArray					( long *out, size_t n, char delim, si_position *err );
+SI_API size_t si_getULongArray					( unsigned long *out, size_t n, char delim, si_position *err );
+SI_API size_t si_getLongLongArray				( long long *out, size_t n, char delim, si_position *err );
+SI_API size_t si_getULongLongArray				( unsigned long long *out, size_t n, char delim, si_position *err );
+SI_API size_t si_getFloatArray					( float *out, size_t n, char delim, si_position *err );
+SI_API size_t si_getDoubleArray					( double *out, size_t n, char delim, si_position *err );
+
+SI_API size_t si_reader_getIntArray				( si_reader *r, int *out, size_t n, char delim, si_position *err );
+SI_API size_t si_reader_getUIntArray			( si_reader *r, unsigned int *out, size_t n, char delim, si_position *err );
+SI_API size_t si_reader_getLongArray			( si_reader *r, long *out, size_t n, char delim, si_position *err );
+SI_API size_t si_reader_getULongArray			( si_reader *r, unsigned long *out, size_t n, char delim, si_position *err );
+SI_API size_t si_reader_getLongLongArray		( si_reader *r, long long *out, size_t n, char delim, si_position *err );
+SI_API size_t si_reader_getULongLongArray		( si_reader *r, unsigned long long *out, size_t n, char delim, si_position *err );
+SI_API size_t si_reader_getFloatArray			( si_reader *r, float *out, size_t n, char delim, si_position *err );
+SI_API size_t si_reader_getDoubleArray			( si_reader *r, double *out, size_t n, char delim, si_position *err );
+
+// parse all remaining input of a ( mapped ) reader on several threads, free() the result
+SI_API int *si_reader_parallelGetIntArray	( si_reader *r, char delim, unsigned threads, size_t *count, si_position *err );
+SI_API unsigned int *si_reader_parallelGetUIntArray		( si_reader *r, char delim, unsigned threads, size_t *count, si_position *err );
+SI_API long *si_reader_parallelGetLongArray		( si_reader *r, char delim, unsigned threads, size_t *count, si_position *err );
+SI_API unsigned long *si_reader_parallelGetULongArray	( si_reader *r, char delim, unsigned threads, size_t *count, si_position *err );
+SI_API long long *si_reader_parallelGetLongLongArray	( si_reader *r, char delim, unsigned threads, size_t *count, si_position *err );
+SI_API unsigned long long *si_reader_parallelGetULongLongArray	( si_reader *r, char delim, unsigned threads, size_t *count, si_position *err );
+SI_API float *si_reader_parallelGetFloatArray	( si_reader *r, char delim, unsigned threads, size_t *count, si_position *err );
+SI_API double *si_reader_parallelGetDoubleArray		( si_reader *r, char delim, unsigned threads, size_t *count, si_position *err );
+
+// === Records ===
+SI_API si_result si_getRecord						( char delim, char quote, si_record *rec );
+SI_API si_result si_reader_getRecord				( si_reader *r, char delim, char quote, si_record *rec );
+
+SI_API si_string si_field							( const si_record *rec, size_t i ); // 0-based, { NULL, 0 } if missing
+SI_API si_result si_fieldInt						( const si_record *rec, size_t i, int *out );
+SI_API si_result si_fieldUInt						( const si_record *rec, size_t i, unsigned int *out );
+SI_API si_result si_fieldLong						( const si_record *rec, size_t i, long *out );
+SI_API si_result si_fieldULong						( const si_record *rec, size_t i, unsigned long *out );
+SI_API si_result si_fieldLongLong					( const si_record *rec, size_t i, long long *out );
+SI_API si_result si_fieldULongLong					( const si_record *rec, size_t i, unsigned long long *out );
+SI_API si_result si_fieldFloat						( const si_record *rec, size_t i, float *out );
+SI_API si_result si_fieldDouble						( const si_record *rec, size_t i, double *out );
+
+// === Schemas ===
+SI_API si_schema *si_schema_compile					( const si_fieldDesc *fields, size_t n, char delim, char quote );
+SI_API si_schema *si_schema_fromSignature			( const char *sig, const size_t *offsets, char delim, char quote ); // "i,u,d,s,b"
+SI_API void si_schema_free							( si_schema *schema );
+SI_API si_result si_readStruct						( const si_schema *schema, void *out, size_t *badField );
+SI_API si_result si_reader_readStruct				( si_reader *r, const si_schema *schema, void *out, size_t *badField );
+SI_API si_result si_reader_promptMany				( si_reader *r, const si_promptField *fields, size_t n );
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // SAFEINPUT_H_
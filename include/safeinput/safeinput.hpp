@@ -0,0 +1,202 @@
+// safeinput.hpp - version 1.1.0, C++17 wrapper over safeinput.h
+
+#ifndef SAFEINPUT_HPP_
+#define SAFEINPUT_HPP_
+
+#if __cplusplus < 201703L
+#error "safeinput.hpp needs C++17 ( std::optional, std::string_view )"
+#endif
+
+// === Includes ===
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <iterator>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+#include "safeinput.h"
+
+namespace si {
+
+template <class T> inline constexpr bool unsupported = false;
+
+/**
+ * si::tryGet - one value of type T from a reader, picked at compile time
+ *
+ * Numbers, char and bool go to the matching si_reader_tryGetX(), char32_t
+ * to si_reader_tryGetCodepoint(), so a syntax error, overflow or over-long
+ * line consumes that line and comes back as a status without printing.
+ * std::string_view is the line itself, valid until the next read;
+ * std::string copies it.
+ */
+template <class T>
+inline si_result tryGet ( si_reader *r, T &out ) noexcept( !std::is_same_v<T, std::string> ) {
+
+	if constexpr ( std::is_same_v<T, int> ) return si_reader_tryGetInt( r, &out );
+	else if constexpr ( std::is_same_v<T, unsigned int> ) return si_reader_tryGetUInt( r, &out );
+	else if constexpr ( std::is_same_v<T, long> ) return si_reader_tryGetLong( r, &out );
+	else if constexpr ( std::is_same_v<T, unsigned long> ) return si_reader_tryGetULong( r, &out );
+	else if constexpr ( std::is_same_v<T, long long> ) return si_reader_tryGetLongLong( r, &out );
+	else if constexpr ( std::is_same_v<T, unsigned long long> ) return si_reader_tryGetULongLong( r, &out );
+	else if constexpr ( std::is_same_v<T, float> ) return si_reader_tryGetFloat( r, &out );
+	else if constexpr ( std::is_same_v<T, double> ) return si_reader_tryGetDouble( r, &out );
+	else if constexpr ( std::is_same_v<T, char> ) return si_reader_tryGetChar( r, &out );
+	else if constexpr ( std::is_same_v<T, bool> ) return si_reader_tryGetBool( r, &out );
+	else if constexpr ( std::is_same_v<T, char32_t> ) {
+		std::uint32_t c;
+		si_result s = si_reader_tryGetCodepoint( r, &c );
+		if ( s == SI_OK ) out = static_cast<char32_t>( c );
+		return s;
+	}
+	else if constexpr ( std::is_same_v<T, std::string_view> || std::is_same_v<T, std::string> ) {
+		si_string line;
+		si_result s = si_reader_readLine( r, &line );
+		if ( s == SI_OK ) out = T( line.data, line.len );
+		return s;
+	}
+	else static_assert( unsupported<T>, "si::tryGet: no safeinput parser for this type" );
+}
+
+
+
+template <class T> class valueRange;
+
+/**
+ * si::reader - owning handle for an si_reader
+ *
+ * usage - auto r = si::reader::fromFile( fp );
+ * 		   while ( auto v = r.get<int>() ) use( *v );
+ * 		   for ( long v : r.values<long>() ) sum += v;
+ *
+ * Move-only, frees the reader on destruction. si::reader::standard()
+ * borrows the shared stdin reader and never frees it. A failed factory
+ * gives an empty reader that converts to false.
+ */
+class reader {
+public:
+	static reader fromFile ( std::FILE *fp ) noexcept { return reader( si_reader_fromFile( fp )); }
+	static reader fromFd ( int fd ) noexcept { return reader( si_reader_fromFd( fd )); }
+	static reader fromMapped ( int fd ) noexcept { return reader( si_reader_fromMapped( fd )); }
+	static reader fromMemory ( const void *data, std::size_t len ) noexcept { return reader( si_reader_fromMemory( data, len )); }
+	static reader fromMemory ( std::string_view s ) noexcept { return fromMemory( s.data(), s.size() ); }
+	static reader standard () noexcept { return reader( si_stdin(), false ); }
+
+	explicit reader ( si_reader *r, bool owned = true ) noexcept : r_( r ), owned_( owned ) {}
+	reader ( reader &&o ) noexcept : r_( o.r_ ), owned_( o.owned_ ), last_( o.last_ ) { o.r_ = nullptr; }
+	reader &operator= ( reader &&o ) noexcept {
+		if ( this != &o ) {
+			close();
+			r_ = o.r_; owned_ = o.owned_; last_ = o.last_;
+			o.r_ = nullptr;
+		}
+		return *this;
+	}
+	reader ( const reader & ) = delete;
+	reader &operator= ( const reader & ) = delete;
+	~reader () { close(); }
+
+	explicit operator bool () const noexcept { return r_ != nullptr; }
+	si_reader *handle () const noexcept { return r_; }
+
+	// the next value, or nullopt with the reason in status()
+	template <class T>
+	std::optional<T> get () {
+		T v{};
+		if (( last_ = si::tryGet( r_, v )) == SI_OK ) return v;
+		return std::nullopt;
+	}
+
+	template <class T>
+	si_result tryGet ( T &out ) { return last_ = si::tryGet( r_, out ); }
+
+	// every value of type T up to EOF ( or SI_WOULD_BLOCK ), rejected lines skipped
+	template <class T>
+	valueRange<T> values () noexcept;
+
+	si_result status () const noexcept { return last_; }
+	bool eof () const noexcept { return si_reader_eof( r_ ); }
+	std::size_t skipLine () noexcept { return si_reader_skipLine( r_ ); }
+	si_errorStats errorStats () const noexcept { return si_reader_errorStats( r_ ); }
+	bool setSilent ( bool silent ) noexcept { return si_reader_setSilent( r_, silent ); }
+	bool setLineLimit ( std::size_t limit ) noexcept { return si_reader_setLineLimit( r_, limit ); }
+	bool setNonBlocking ( bool on ) noexcept { return si_reader_setNonBlocking( r_, on ); }
+	bool setPrompt ( const char *prompt ) noexcept { return si_reader_setPrompt( r_, prompt ); }
+
+private:
+	void close () noexcept {
+		if ( r_ && owned_ ) si_reader_free( r_ );
+		r_ = nullptr;
+	}
+
+	si_reader	*r_;
+	bool		owned_;
+	si_result	last_ = SI_OK;
+
+	template <class T> friend class valueRange;
+};
+
+
+
+/**
+ * si::valueRange - single-pass range over the values of a reader
+ *
+ * An input range: each increment parses the next line in place, with no
+ * allocation or indirect call per value. Lines that fail to parse are
+ * skipped ( reader::errorStats() counts them ); iteration ends at EOF or,
+ * on a non-blocking reader, at SI_WOULD_BLOCK, which reader::status()
+ * then reports.
+ */
+template <class T>
+class valueRange {
+public:
+	class iterator {
+	public:
+		using iterator_category	= std::input_iterator_tag;
+		using value_type		= T;
+		using difference_type	= std::ptrdiff_t;
+		using pointer			= const T *;
+		using reference			= const T &;
+
+		iterator () noexcept = default;
+		explicit iterator ( reader *r ) : r_( r ) { next(); }
+
+		reference operator* () const noexcept { return value_; }
+		pointer operator-> () const noexcept { return &value_; }
+		iterator &operator++ () { next(); return *this; }
+		iterator operator++ ( int ) { iterator old = *this; next(); return old; }
+
+		friend bool operator== ( const iterator &a, const iterator &b ) noexcept { return a.r_ == b.r_; }
+		friend bool operator!= ( const iterator &a, const iterator &b ) noexcept { return a.r_ != b.r_; }
+
+	private:
+		void next () {
+			while ( 1 ) {
+				si_result s = r_->last_ = si::tryGet( r_->r_, value_ );
+				if ( s == SI_OK ) return;
+				if ( s == SI_EOF || s == SI_WOULD_BLOCK ) break;
+			}
+			r_ = nullptr;
+		}
+
+		reader	*r_ = nullptr;
+		T		value_{};
+	};
+
+	explicit valueRange ( reader &r ) noexcept : r_( &r ) {}
+
+	iterator begin () { return r_->r_ ? iterator( r_ ) : iterator(); }
+	iterator end () const noexcept { return iterator(); }
+
+private:
+	reader	*r_;
+};
+
+template <class T>
+inline valueRange<T> reader::values () noexcept { return valueRange<T>( *this ); }
+
+} // namespace si
+
+#endif // SAFEINPUT_HPP_
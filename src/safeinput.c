@@ -1,585 +1,5982 @@
-/**
- * safeinput.c - version 1.1.0
- *
- * Author:   https://github.com/bustyanimebabesdotcom
- * License:  The Unlicense
- *
- * Safe(r) input handling for C.
- *
- * This library provides a standalone, portable alternative to `scanf`,
- * focusing on input validation and buffer overflow prevention.
- *
- * It is designed for simplicity, robustness, and use in projects
- * where `scanf` and `gets` would otherwise be used by people who
- * unfortunately don't know any better.
- *
- * Main safety features:
- *   - Input length enforcement
- *   - Graceful EOF handling
- *   - Error feedback to stderr
- *   - Non-null-terminated byte-string support
- *
- * Phase 2 completed:
- *   - Implemented si_string (byte-counted, no null terminator)
- *   - Byte-for-byte `getchar()` loop with bounds checking
- *
- * TODO:
- *   - Wrap repeated logic into reusable helpers
- *   - Profile and optimize where sensible
- *
- * Use this in any project, commercial or personal.
- * Attribution is appreciated but not required.
- *
- * For more information, see LICENSE or visit <https://unlicense.org/>
- */
-
-#define _GNU_SOURCE
-
-#define alwaysInline	__attribute__((always_inline)) inline
-#define cold			__attribute__((cold))
-#define unlikely(x)		__builtin_expect(!!(x), 0)
-
-#include <stdio.h>
-#include <string.h>
-#include <stdlib.h>
-#include <limits.h>
-#include <errno.h>
-#include <math.h>
-#include <stdbool.h>
-#include <safeinput/safeinput.h>
-
-/**
- * si_printError - calls fputs into stderr, simple wrapper
- */
-static cold void si_printError ( const char *msg ) {
-
-	fputs( msg, stderr );
-}
-
-
-
-/**
- * si_drainStdin - Drains leftover input from stdin to prevent buffer overflows.
- * Reads until newline or EOF is encountered
- * 
- * called by si_readByte()
- */
-static cold void si_drainStdin ( void ) {
-
-	int c;
-
-	while ( ( c = getchar_unlocked() ) != '\n' && c != EOF )
-		;
-}
-
-
-
-/**
- * si_readByte - read up to maxLen bytes from stdin into buffer, 
- * 					stop at newline or EOF, drain excess input, and report length.
- * 
- * @buf:		buffer to fill with input characters
- * @maxLen:		maximum number of bytes to read into buf
- * @outLen:		pointer to size_t to receive the number of bytes read
- * 
- * Returns:
- * 		0 - on success
- * 		1 - on error ( NULL buf or outLen, or maxLen < 1 )
- *	   -1 - on EOF ( caller should check and handle appropriately )
- */
-static alwaysInline int si_readByte ( char *buf, size_t maxLen, size_t *outLen ) {
-
-	if ( unlikely( !buf || !outLen || maxLen < 1 )) return 1;
-
-	size_t i = 0;
-	int c;
-
-	for ( ; i < maxLen; i++ ) {
-		c = getchar_unlocked();
-		if ( unlikely( c == '\n' || c == EOF )) break;
-		buf[i] = (char)c;
-	}
-
-	*outLen = i;
-
-	if ( unlikely( i == maxLen && c != '\n' && c != EOF )) {
-		si_drainStdin();
-		si_printError( "Input exceeding buffer size. Try again.\n" );
-		return 1;
-	}
-
-	if ( unlikely( c == EOF && i == 0 )) return EOF;
-
-	return 0;
-}
-
-
-
-/**
- * si_getInt - a safer alternative to scanf for integers
- *
- * usage - int x = si_getInt();
- * 
- * returns INT_MIN on error or EOF
- */
-int si_getInt ( void ) {
-
-	char buffer[INPUT_BUFFER_SIZE];
-	char *endptr;
-	long value;
-
-	while ( 1 ) {
-
-		size_t len;
-		if ( si_readByte( buffer, sizeof(buffer) - 1, &len )) return INT_MIN;
-		buffer[len] = '\0';
-
-		errno = 0;
-		value = strtol( buffer, &endptr, 10 );
-		
-		if ( endptr == buffer || *endptr != '\0' || errno == ERANGE || value != (int)value ) {
-			si_printError( "Invalid input. Try again.\n" );
-			continue;
-		}
-
-		return (int)value;
-	}
-}
-
-
-
-/**
- * si_getUInt - a safer alternative to scanf for unsigned integers
- *
- * usage - unsigned int x = si_getUInt();
- * 
- * returns UINT_MAX on error or EOF
- */
-unsigned int si_getUInt ( void ) {
-
-	char buffer[INPUT_BUFFER_SIZE];
-	char *endptr;
-	unsigned long value;
-
-	while ( 1 ) {
-
-		size_t len;
-		if ( si_readByte( buffer, sizeof(buffer) - 1, &len )) return UINT_MAX;
-		buffer[len] = '\0';
-
-		errno = 0;
-		value = strtoul( buffer, &endptr, 10 );
-
-		if ( buffer[0] == '-' ) {
-			si_printError( "Value can not be negative.\n" );
-			continue;
-		}
-
-		if ( endptr == buffer || *endptr != '\0' || errno == ERANGE || value > UINT_MAX ) {
-			si_printError( "Invalid input. Try again.\n" );
-			continue;
-		}
-
-		return (unsigned int)value;
-	}
-}
-
-
-
-/**
- * si_getFloat - a safer alternative to scanf for floating point numbers
- *
- * usage - float x = si_getFloat();
- * 
- * returns NAN on error or EOF
- */
-float si_getFloat ( void ) {
-
-	char buffer[INPUT_BUFFER_SIZE];
-	char *endptr;
-	float value;
-
-	while ( 1 ) {
-
-		size_t len;
-		if ( si_readByte( buffer, sizeof(buffer) - 1, &len )) return NAN;
-		buffer[len] = '\0';
-
-		errno = 0;
-		value = strtof( buffer, &endptr );
-
-		if ( endptr == buffer || *endptr != '\0' || errno == ERANGE || !isfinite( value )) {
-			si_printError( "Invalid input. Try again.\n" );
-			continue;
-		}
-
-		return value;
-	}
-}
-
-
-
-/**
- * si_getDouble - a safer alternative to scanf for doubles
- *
- * usage - double x = si_getDouble();
- * 
- * returns NAN on error or EOF
- */
-double si_getDouble ( void ) {
-
-	char buffer[INPUT_BUFFER_SIZE];
-	char *endptr;
-	double value;
-
-	while ( 1 ) {
-
-		size_t len;
-		if ( si_readByte( buffer, sizeof(buffer) - 1, &len )) return NAN;
-		buffer[len] = '\0';
-
-		errno = 0;
-		value = strtod( buffer, &endptr );
-		
-		if ( endptr == buffer || *endptr != '\0' || errno == ERANGE || !isfinite( value )) {
-			si_printError( "Invalid input. Try again.\n" );
-			continue;
-		}
-
-		return value;
-	}
-}
-
-
-
-/**
- * si_getLong - a safer alternative to scanf for longs
- *
- * usage - long x = si_getLong();
- * 
- * returns LONG_MIN on error or EOF
- */
-long si_getLong ( void ) {
-
-	char buffer[INPUT_BUFFER_SIZE];
-	char *endptr;
-	long value;
-
-	while ( 1 ) {
-
-		size_t len;
-		if ( si_readByte( buffer, sizeof(buffer) - 1, &len )) return LONG_MIN;
-		buffer[len] = '\0';
-
-		errno = 0;
-		value = strtol( buffer, &endptr, 10 );
-		
-		if ( endptr == buffer || *endptr != '\0' || errno == ERANGE) {
-			si_printError( "Invalid input. Try again.\n" );
-			continue;
-		}
-
-		return value;
-	}
-}
-
-
-
-/**
- * si_getULong - a safer alternative to scanf for unsigned longs
- *
- * usage - unsigned long x = si_getULong();
- * 
- * returns ULONG_MAX on error or EOF
- */
-unsigned long si_getULong ( void ) {
-
-	char buffer[INPUT_BUFFER_SIZE];
-	char *endptr;
-	unsigned long value;
-
-	while ( 1 ) {
-
-		size_t len;
-		if ( si_readByte( buffer, sizeof(buffer) - 1, &len )) return ULONG_MAX;
-		buffer[len] = '\0';
-
-		errno = 0;
-		value = strtoul( buffer, &endptr, 10 );
-		
-		if ( endptr == buffer || *endptr != '\0' || errno == ERANGE ) {
-			si_printError( "Invalid input. Try again.\n" );
-			continue;
-		}
-
-		return value;
-	}
-}
-
-
-
-/**
- * si_getLongLong - a safer alternative to scanf for long longs
- *
- * usage - long long x = si_getLongLong();
- * 
- * returns LLONG_MIN on error or EOF
- */
-long long si_getLongLong ( void ) {
-
-	char buffer[INPUT_BUFFER_SIZE];
-	char *endptr;
-	long long value;
-
-	while ( 1 ) {
-
-		size_t len;
-		if ( si_readByte( buffer, sizeof(buffer) - 1, &len )) return LLONG_MIN;
-		buffer[len] = '\0';
-
-		errno = 0;
-		value = strtoll( buffer, &endptr, 10 );
-		
-		if ( endptr == buffer || *endptr != '\0' || errno == ERANGE ) {
-			si_printError( "Invalid input. Try again.\n" );
-			continue;
-		}
-
-		return value;
-	}
-}
-
-
-
-/**
- * si_getULongLong - a safer alternative to scanf for unsigned long longs
- *
- * usage - unsigned long long x = si_getULongLong();
- * 
- * returns ULLONG_MAX on error or EOF
- */
-unsigned long long si_getULongLong ( void ) {
-
-	char buffer[INPUT_BUFFER_SIZE];
-	char *endptr;
-	unsigned long long value;
-
-	while ( 1 ) {
-
-		size_t len;
-		if ( si_readByte( buffer, sizeof(buffer) - 1, &len )) return ULLONG_MAX;
-		buffer[len] = '\0';
-
-		errno = 0;
-		value = strtoull( buffer, &endptr, 10 );
-		
-		if ( endptr == buffer || *endptr != '\0' || errno == ERANGE ) {
-			si_printError( "Invalid input. Try again.\n" );
-			continue;
-		}
-
-		return value;
-	}
-}
-
-
-
-/**
- * si_getChar - a safer alternative to scanf for chars
- *
- * usage - int x = si_getChar();
- *
- * IMPORTANT: Only accepts one character. " a" and "a " are considered invalid.
- * 
- * returns EOF on error or EOF
- */
-int si_getChar ( void ) {
-
-	char buffer[CHAR_INPUT_BUFFER_SIZE];
-	size_t len;
-
-	while ( 1 ) {
-
-		int result = si_readByte( buffer, sizeof(buffer) - 1, &len );
-		buffer[len] = '\0';
-
-		if ( result == EOF ) return EOF;
-		if ( result == 1 ) continue;
-		if ( len == 0 ) return '\n';
-		if ( len == 1 ) return (unsigned char)buffer[0];
-		si_printError( "Invalid input. Please enter a single character.\n" );
-
-	}
-}
-
-
-
-/**
- * si_getCharFiltered - a safer alternative to scanf for chars
- *
- * usage - int x = si_getCharFiltered( "abc" );
- * 
- * returns EOF on error or EOF
- */
-int si_getCharFiltered ( const char *allowed ) {
-
-	if ( !allowed ){
-		si_printError( "ERROR: NULL passed to 'allowed'.\n" );
-		exit(EXIT_FAILURE);
-	}
-
-	if ( allowed[0] == '\0' ) {
-		si_printError( "No allowed characters specified. Exiting.\n" );
-		return 1;
-	}
-
-	char buffer[CHAR_INPUT_BUFFER_SIZE];
-	size_t len;
-
-	while ( 1 ) {
-
-		int result = si_readByte( buffer, sizeof(buffer) - 1, &len );
-		buffer[len] = '\0';
-		
-		if ( result == EOF ) return EOF;
-		if ( result == 1 ) continue;
-		
-		// Ensure input is exactly one character
-		if ( len != 1 ) {
-			si_printError( "Invalid input. Please enter a single character.\n" );
-			continue;
-		}
-
-		char c = buffer[0];
-
-		if ( strchr( allowed, c ) != NULL ) return (unsigned char)c;
-	
-		fprintf( stderr, "Invalid input. Allowed: %s\n", allowed );
-		
-	}
-}
-
-
-
-/**
- * si_getCString - allocates and returns a line of user input from stdin
- *
- * NOTE: 	Caller must free the returned string!!!
- * 
- *
- * safe usage example
- * 
- *
- *	char *input = si_getCString();
- *
- *	if (!input) fputs( "Failed to read input. Try again.\n", stderr );
- *	else {
- *		printf("You entered: %s\n", input);
- *		free(input);
- *		input = NULL;
- *	}
- *
- * NOTE: 	we use memcpy() because it copies exactly len + 1 bytes from buffer, 
- *			avoiding overflow and termination issues.
- * 			the overhead is minimal, memcpy() is well optimized.
- * 
- * returns NULL on error or EOF
- */
-char *si_getCString ( void ) {
-
-	char buffer[INPUT_BUFFER_SIZE];
-	size_t len;
-
-	// read input (return NULL on error/EOF )
-	if ( si_readByte( buffer, sizeof(buffer)-1, &len )) return NULL;
-
-	// add null-terminator for C string
-	buffer[len] = '\0';
-
-	// Allocate memory for string( length + 1 for null terminator )
-	char *str = malloc( len+1 );
-	// Check for allocation failure
-	if ( !str ) {
-		si_printError( "Memory allocation failed.\n" );
-		return NULL;
-	}
-
-	// copy buffer to allocated string
-	memcpy( str, buffer, len+1 );
-	return str;
-}
-
-
-
-/**
- * si_getString - reads a line from stdin into a heap-allocated si_string
- * 
- * NOTE: 	Caller is responsible for freeing the returned buffer:
- * 			free(str.data);
- * 
- * Safe usage example:
- * 
- * 		si_string str = si_getString();
- *
- *		if (!str.data) return;
- *		printf("%.*s", (int)str.len, str.data)
- *		free(str.data);
- *		str.data = NULL;
- *
- * NOTE: 	Uses memcpy() to copy exactly len bytes from internal buffer
- * 			No null terminator is appended-use the length field for safe access.
- * 
- * Returns:
- * 		A si_string with .data == NULL and .len == 0 on error or EOF,
- * 		otherwise .data points to malloc( len ? len : 1 ) and .len is the byte count.
- */
-si_string si_getString ( void ) {
-
-	char buffer[INPUT_BUFFER_SIZE];
-	size_t len;
-
-	// read input ( return NULL on error/EOF )
-	if ( si_readByte( buffer, sizeof(buffer), &len )) return (si_string){ NULL, 0 };
-
-	// Allocate memory for string data, length is stored in len parameter
-	si_string str;
-	str.data = malloc( len ? len : 1 );
-	if ( !str.data ) {
-		si_printError( "Memory allocation failed.\n" );
-		return (si_string){ NULL, 0 };
-	}
-
-	// copy buffer to string data
-	memcpy( str.data, buffer, len );
-	str.len = len;
-	return str;
-}
-
-
-
-/**
- * si_getBool - a safer alternative to scanf for boolean values
- *
- * Accepts "y" or "n" (case-insensitive).
- *
- * usage - bool x = si_getBool();
- * 
- * returns false on EOF. Terrible solution but it's the best i could figure out.
- */
-bool si_getBool ( void ) {
-
-	while ( 1 ) {
-		// Read single character, convert to lowercase
-		int c = si_getChar();
-
-		if ( c == EOF ) {
-			si_printError( "EOF detected. Returning false by default.\n" );
-			return false;
-		}
-
-		// we avoid using tolower() due to EOF potentially triggering UB
-		if ( c == 'Y' || c == 'y' ) return true;
-		if ( c == 'N' || c == 'n' ) return false;
-		si_printError( "Invalid input. Enter 'y' or 'n'.\n" );
-	}
-}
+/**
+ * safeinput.c - version 1.1.0
+ *
+ * Author:   https://github.com/bustyanimebabesdotcom
+ * License:  The Unlicense
+ *
+ * Safe(r) input handling for C.
+ *
+ * This library provides a standalone, portable alternative to `scanf`,
+ * focusing on input validation and buffer overflow prevention.
+ *
+ * It is designed for simplicity, robustness, and use in projects
+ * where `scanf` and `gets` would otherwise be used by people who
+ * unfortunately don't know any better.
+ *
+ * Main safety features:
+ *   - Input length enforcement
+ *   - Graceful EOF handling
+ *   - Error feedback to stderr
+ *   - Non-null-terminated byte-string support
+ *
+ * Phase 2 completed:
+ *   - Implemented si_string (byte-counted, no null terminator)
+ *   - Byte-for-byte `getchar()` loop with bounds checking
+ *
+ * Phase 3:
+ *   - Block-buffered reads from the fd with SIMD newline scanning
+ *   - Span-based SWAR integer parsing ( no strto*, no errno )
+ *   - Correctly rounded float parsing ( Clinger, Eisel-Lemire, big decimal )
+ *   - One per-type parse core shared by every getter family
+ *
+ * TODO:
+ *   - Profile and optimize where sensible
+ *
+ * Use this in any project, commercial or personal.
+ * Attribution is appreciated but not required.
+ *
+ * For more information, see LICENSE or visit <https://unlicense.org/>
+ */
+
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE
+#endif
+
+#define alwaysInline	__attribute__((always_inline)) inline
+#define cold			__attribute__((cold))
+#define unlikely(x)		__builtin_expect(!!(x), 0)
+
+// hot getters, offered to the caller's inliner by the single-header build
+#if !defined(SAFEINPUT_IMPLEMENTATION)
+#define hotApi
+#elif defined(SAFEINPUT_INLINE)
+#define hotApi			SAFEINPUT_INLINE
+#else
+#define hotApi			inline
+#endif
+
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+#include <limits.h>
+#include <errno.h>
+#include <math.h>
+#include <float.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/uio.h>
+#include <sys/ioctl.h>
+#include <pthread.h>
+#include <safeinput/safeinput.h>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>	// every ISA level, for the target() kernels below
+#define SI_X86			1
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+
+/**
+ * si_reader - block-buffered line source
+ *
+ * Input is pulled from the fd in SI_READ_BLOCK sized chunks and lines are
+ * located with a vectorised newline scan instead of one getchar per byte.
+ * Unread bytes are compacted to the front of the block before a refill, so
+ * a line is always contiguous in memory.
+ *
+ * Memory readers point buf straight at the caller's bytes and start out
+ * at EOF, so they are never compacted or written to. Mapped readers are
+ * memory readers over an mmap() of a regular file, unmapped on free.
+ *
+ * A line longer than the block makes the buffer grow geometrically into
+ * a heap allocation owned by the reader, never past SI_LINE_MAX bytes.
+ *
+ * With locking enabled every public getter holds the reader's recursive
+ * mutex for the whole call ( si_guard ), so each line or batch is read
+ * and parsed atomically: one lock per call rather than one per byte.
+ *
+ * In non-blocking mode a read that would block sets `blocked` instead of
+ * `eof`. A partial line simply stays buffered until the rest arrives, and
+ * a too-long line that is only partly drained sets `skipping` so the next
+ * call carries on discarding it.
+ *
+ * NOTE:	the default reader owns fd 0 directly. Mixing these getters
+ * 			with stdio reads on stdin (fgets, scanf, ...) is not supported,
+ * 			as bytes read ahead by either side are invisible to the other.
+ */
+#define SI_READ_BLOCK	( 64 * 1024 )
+#define SI_PENDING_MAX	256		// retry messages held for the next prompt
+
+struct si_reader {
+	char	*buf;		// block buffer ( or caller memory )
+	size_t	cap;		// size of buf
+	size_t	pos;		// first unread byte
+	size_t	end;		// one past the last valid byte
+	int		fd;			// source file descriptor, -1 if none
+	FILE	*fp;		// stdio source for streams without an fd
+	int		err;		// errno of the last failed read, 0 if none
+	bool	eof;		// source is exhausted ( sticky, like stdio )
+	bool	flushOut;	// flush stdout before blocking ( reading a terminal's stdin )
+	bool	nonBlock;	// fd is O_NONBLOCK, getters return instead of waiting
+	bool	blocked;	// the last refill hit EAGAIN ( reset by every line fetch )
+	bool	skipping;	// still draining a too-long line
+	size_t	base;		// stream offset of buf[0]
+	size_t	lines;		// newlines consumed so far
+	size_t	lineStart;	// stream offset of the current line
+	size_t	lineLimit;	// string getter limit, same meaning as INPUT_BUFFER_SIZE
+	char	*heapBuf;	// grown buffer owned by the reader, NULL if none
+	void	*map;		// mmap()ed file behind buf, NULL if none
+	size_t	mapLen;
+	char	*fieldBuf;	// unescaped quoted fields of the current record
+	size_t	fieldCap;
+	si_allocator alloc;	// string getter allocator, all NULL for malloc/free
+	si_errorHandler onError;	// error sink, NULL for stderr
+	void	*errorCtx;
+	bool	silent;		// count errors but don't report them
+	const char *prompt;	// written before blocking at a line start, NULL for none
+	char	pending[SI_PENDING_MAX];	// messages waiting to go out with the prompt
+	size_t	pendingLen;
+	unsigned repeatLimit;	// consecutive same-kind messages shown, 0 for all
+	unsigned repeats;	// length of the current run of lastKind messages
+	si_error lastKind;
+	si_errorStats stats;
+	pthread_mutex_t *lock;	// held by the getters if set, NULL for lock-free use
+#ifdef SI_STATS
+	si_stats counters;	// hot-path counters, see si_count()
+#endif
+};
+
+static char si_stdinBlock[SI_READ_BLOCK];
+static pthread_mutex_t si_stdinLock = PTHREAD_RECURSIVE_MUTEX_INITIALIZER_NP;
+static si_reader si_stdinReader = {
+	.buf		= si_stdinBlock,
+	.cap		= SI_READ_BLOCK,
+	.fd			= STDIN_FILENO,
+	.flushOut	= true,
+	.lineLimit	= INPUT_BUFFER_SIZE,
+};
+
+
+
+/**
+ * si_guard - hold r's lock ( if it has one ) until the enclosing scope ends
+ *
+ * Uses the cleanup attribute, so every return path unlocks. The mutex is
+ * recursive because getters call each other ( getString -> getStringView ).
+ */
+static alwaysInline si_reader *si_lock ( si_reader *r ) {
+
+	if ( unlikely( r && r->lock )) pthread_mutex_lock( r->lock );
+	return r;
+}
+
+static alwaysInline void si_unlock ( si_reader **r ) {
+
+	if ( unlikely( *r && (*r)->lock )) pthread_mutex_unlock( (*r)->lock );
+}
+
+#define si_guard( r )	si_reader *si_held __attribute__(( cleanup( si_unlock ), unused )) = si_lock( r )
+
+// the default reader of the calling thread, see si_useReader(), initial-exec
+// so the shared library reads it off the thread pointer, not via __tls_get_addr
+static __thread si_reader *si_threadReader __attribute__(( tls_model( "initial-exec" )));
+
+static alwaysInline si_reader *si_current ( void ) {
+
+	return si_threadReader ? si_threadReader : &si_stdinReader;
+}
+
+
+
+/**
+ * si_writeAll - writev() all of iov to fd, carrying on after short writes
+ *
+ * Prompts and messages are best effort, so a failed write is dropped.
+ */
+static cold void si_writeAll ( int fd, struct iovec *iov, int count ) {
+
+	while ( count > 0 ) {
+
+		ssize_t n = writev( fd, iov, count );
+		if ( n < 0 ) {
+			if ( errno == EINTR ) continue;
+			return;
+		}
+
+		for ( ; count > 0 && (size_t)n >= iov->iov_len; iov++, count-- ) n -= (ssize_t)iov->iov_len;
+		if ( count > 0 ) {
+			iov->iov_base = (char *)iov->iov_base + n;
+			iov->iov_len -= (size_t)n;
+		}
+	}
+}
+
+
+
+/**
+ * si_showPending - write the held messages, then msg, in a single writev()
+ *
+ * @msg:		the prompt or a message that can't wait, NULL for none
+ */
+static cold void si_showPending ( si_reader *r, const char *msg ) {
+
+	struct iovec iov[2] = {
+		{ r->pending, r->pendingLen },
+		{ (char *)msg, msg ? strlen( msg ) : 0 },
+	};
+
+	r->pendingLen = 0;
+	if ( iov[0].iov_len || iov[1].iov_len ) si_writeAll( STDERR_FILENO, iov, 2 );
+}
+
+
+
+/**
+ * si_emit - hand a message to the reader's error handler, or to stderr
+ *
+ * While a prompt is set, a retry message is held back if the getter's next
+ * step is the blocking read that shows the prompt ( no further line is
+ * buffered ), so message and prompt cost one write. Anything else goes out
+ * at once, behind whatever is already held.
+ */
+static cold void si_emit ( si_reader *r, si_error kind, const char *msg ) {
+
+	if ( r && r->onError ) {
+		r->onError( r->errorCtx, kind, msg );
+		return;
+	}
+
+	if ( !r || !r->prompt ) {
+		fputs( msg, stderr );
+		return;
+	}
+
+	size_t len = strlen( msg );
+	bool retry = ( kind == SI_ERR_INVALID || kind == SI_ERR_OVERFLOW );
+
+	if ( retry && !r->eof && !r->nonBlock && r->pendingLen + len <= sizeof(r->pending)
+		 && !memchr( r->buf + r->pos, '\n', r->end - r->pos )) {
+		memcpy( r->pending + r->pendingLen, msg, len );
+		r->pendingLen += len;
+	}
+	else si_showPending( r, msg );
+}
+
+
+
+/**
+ * si_report - count an error against the reader and report it
+ *
+ * With a repeat limit set, a run of same-kind messages is cut off after
+ * repeatLimit of them and the rest are only counted. The run is summed up
+ * in one line as soon as a different kind of error shows up, so a flood
+ * of garbage costs one write instead of one per line.
+ *
+ * r may be NULL for errors that don't belong to a reader.
+ */
+static cold void si_report ( si_reader *r, si_error kind, const char *msg ) {
+
+	if ( !r ) {
+		si_emit( r, kind, msg );
+		return;
+	}
+
+	if ( kind == SI_ERR_INVALID ) r->stats.invalid++;
+	else if ( kind == SI_ERR_OVERFLOW ) r->stats.overflow++;
+	else if ( kind == SI_ERR_TOO_LONG ) r->stats.tooLong++;
+
+	if ( r->silent ) return;
+
+	if ( r->repeatLimit ) {
+		if ( r->repeats && kind == r->lastKind ) {
+			if ( r->repeats++ >= r->repeatLimit ) {
+				r->stats.suppressed++;
+				return;
+			}
+		}
+		else {
+			if ( r->repeats > r->repeatLimit ) {
+				char summary[64];
+				snprintf( summary, sizeof(summary), "Last message repeated %u more time%s.\n",
+						  r->repeats - r->repeatLimit, r->repeats - r->repeatLimit == 1 ? "" : "s" );
+				si_emit( r, r->lastKind, summary );
+			}
+			r->lastKind = kind;
+			r->repeats = 1;
+		}
+	}
+
+	si_emit( r, kind, msg );
+}
+
+
+
+/**
+ * Hot-path counters
+ *
+ * Built with -DSI_STATS ( make STATS=1 ), every reader counts bytes,
+ * refills, lines, values parsed, rejects and string allocations, so a slow
+ * consumer can tell a slow source from bad data or parser cost. Without
+ * it si_count() compiles to nothing and the reader carries no counters.
+ */
+#ifdef SI_STATS
+#define si_count( r, field, n )	(( r )->counters.field += ( n ))
+#else
+#define si_count( r, field, n )	((void)( r ))
+#endif
+
+#define si_countReject( r, result )	si_count( r, rejected[ si_rejectOf( result ) ], 1 )
+
+
+
+/**
+ * si_scanByte - find the first byte c in [p, end)
+ *
+ * Short lines and fields are the common case, so the first few
+ * blocks are checked inline with SSE2/NEON compares. Both are baseline
+ * on x86-64 and AArch64, so this needs no -march. Anything longer is
+ * handed to memchr(), which glibc already picks per CPU ( ifunc ) for wide scans.
+ *
+ * returns a pointer to the byte, or NULL if there is none
+ */
+static alwaysInline const char *si_scanByte ( const char *p, const char *end, char c ) {
+
+	const char *inlineEnd = ( end - p > 64 ) ? p + 64 : end;
+
+#if defined(__SSE2__)
+	const __m128i needle = _mm_set1_epi8( c );
+
+	for ( ; inlineEnd - p >= 16; p += 16 ) {
+		unsigned mask = (unsigned)_mm_movemask_epi8( _mm_cmpeq_epi8( _mm_loadu_si128( (const __m128i *)p ), needle ));
+		if ( mask ) return p + __builtin_ctz( mask );
+	}
+#elif defined(__ARM_NEON)
+	const uint8x16_t needle = vdupq_n_u8( (uint8_t)c );
+
+	for ( ; inlineEnd - p >= 16; p += 16 ) {
+		uint8x16_t eq = vceqq_u8( vld1q_u8( (const uint8_t *)p ), needle );
+		uint64_t mask = vget_lane_u64( vreinterpret_u64_u8( vshrn_n_u16( vreinterpretq_u16_u8( eq ), 4 )), 0 );
+		if ( mask ) return p + ( __builtin_ctzll( mask ) >> 2 );
+	}
+#endif
+
+	(void)inlineEnd;
+	if ( p >= end ) return NULL;
+	return memchr( p, c, (size_t)( end - p ));
+}
+
+
+
+static alwaysInline const char *si_scanNewline ( const char *p, const char *end ) {
+
+	return si_scanByte( p, end, '\n' );
+}
+
+
+
+/**
+ * si_growBuffer - double the reader's buffer, up to SI_LINE_MAX bytes
+ *
+ * Only called with the unread bytes already compacted to offset 0.
+ *
+ * returns false if the buffer is at the cap or allocation fails
+ */
+static cold bool si_growBuffer ( si_reader *r ) {
+
+	if ( r->cap >= SI_LINE_MAX ) return false;
+
+	size_t cap = r->cap > SI_LINE_MAX / 2 ? SI_LINE_MAX : r->cap * 2;
+	char *buf = realloc( r->heapBuf, cap );
+	if ( !buf ) return false;
+
+	if ( !r->heapBuf ) memcpy( buf, r->buf, r->end );
+
+	r->heapBuf = r->buf = buf;
+	r->cap = cap;
+	return true;
+}
+
+
+
+/**
+ * si_typedAhead - true if r's fd already holds input, so a read won't wait
+ *
+ * A terminal in canonical mode hands out one line per read(), so answers
+ * typed ahead arrive one refill at a time; without this check each of
+ * them would be prompted for after the fact.
+ */
+static cold bool si_typedAhead ( const si_reader *r ) {
+
+	int n = 0;
+	return r->fd >= 0 && ioctl( r->fd, FIONREAD, &n ) == 0 && n > 0;
+}
+
+
+
+/**
+ * si_refill - compact unread bytes to the front of the block and read more
+ *
+ * Flushes stdout first so prompts without a trailing newline are visible
+ * before we block, matching what stdio does for a line-buffered stdin.
+ * A reader with a prompt then writes it, together with any held error
+ * messages, in one writev() ( see si_reader_setPrompt ).
+ *
+ * returns the number of bytes added, 0 on EOF, read error, when the read
+ * would block ( r->blocked ), or when the buffer is full and can't grow
+ * ( r->eof stays false in the last two cases )
+ */
+static cold size_t si_refill ( si_reader *r ) {
+
+	if ( r->eof ) return 0;
+
+	if ( r->pos ) {
+		memmove( r->buf, r->buf + r->pos, r->end - r->pos );
+		r->base += r->pos;
+		r->end -= r->pos;
+		r->pos = 0;
+	}
+
+	if ( r->end == r->cap && !si_growBuffer( r )) return 0;
+
+	if ( !r->nonBlock ) {
+		if ( r->flushOut || r->prompt ) fflush( stdout );
+		// held messages always, the prompt only if this read starts a line and will wait
+		if ( unlikely( r->prompt || r->pendingLen ))
+			si_showPending( r, r->prompt && !r->end && !r->skipping && !si_typedAhead( r ) ? r->prompt : NULL );
+	}
+
+	ssize_t n;
+
+	if ( r->fp ) {
+		n = (ssize_t)fread_unlocked( r->buf + r->end, 1, r->cap - r->end, r->fp );
+		if ( n == 0 && ferror_unlocked( r->fp )) n = -1;
+	}
+	else {
+		do n = read( r->fd, r->buf + r->end, r->cap - r->end );
+		while ( n < 0 && errno == EINTR );
+	}
+
+	si_count( r, refills, 1 );
+
+	if ( n < 0 && ( errno == EAGAIN || errno == EWOULDBLOCK )) {
+		si_count( r, blocked, 1 );
+		r->blocked = true;
+		return 0;
+	}
+
+	if ( n <= 0 ) {
+		if ( n < 0 ) r->err = errno;
+		r->eof = true;
+		return 0;
+	}
+
+	si_count( r, bytes, (size_t)n );
+	r->end += (size_t)n;
+	return (size_t)n;
+}
+
+
+
+/**
+ * si_consumeLine - mark everything up to buffer offset next as read,
+ * 					where buf[next - 1] is a newline
+ */
+static alwaysInline void si_consumeLine ( si_reader *r, size_t next ) {
+
+	si_count( r, lines, 1 );
+	r->pos = next;
+	r->lines++;
+	r->lineStart = r->base + next;
+}
+
+
+
+/**
+ * si_drainStdin - Drains leftover input from stdin to prevent buffer overflows.
+ * Discards buffered blocks until newline or EOF is encountered
+ * 
+ * Each block is searched with si_scanNewline() and dropped whole, and as
+ * nothing is left unread the refill after it has nothing to compact.
+ *
+ * called by si_nextLine() and si_reader_skipLine(). If a non-blocking read
+ * runs dry first, r->skipping is left set and the next call resumes the drain.
+ *
+ * returns the number of bytes discarded, newline included
+ */
+static cold size_t si_drainStdin ( si_reader *r ) {
+
+	size_t skipped = 0;
+
+	r->skipping = false;
+
+	while ( 1 ) {
+		const char *nl = si_scanNewline( r->buf + r->pos, r->buf + r->end );
+		if ( nl ) {
+			size_t next = (size_t)( nl - r->buf ) + 1;
+			skipped += next - r->pos;
+			si_count( r, drained, next - r->pos );
+			si_consumeLine( r, next );
+			return skipped;
+		}
+
+		skipped += r->end - r->pos;
+		si_count( r, drained, r->end - r->pos );
+		r->pos = r->end;
+		if ( !si_refill( r )) {
+			r->skipping = r->blocked;
+			return skipped;
+		}
+	}
+}
+
+
+
+/**
+ * si_nextLineSlow - si_nextLine() for everything but a whole buffered line
+ *
+ * Refills, partial lines, drains and the final unterminated line, kept
+ * out of line so the fast path stays small enough to inline anywhere.
+ */
+static cold int si_nextLineSlow ( si_reader *r, size_t maxLen, const char **line, size_t *outLen ) {
+
+	size_t scanned = 0;
+
+	r->blocked = false;
+
+	if ( unlikely( r->skipping )) {
+		si_drainStdin( r );
+		if ( r->skipping ) return EOF;
+	}
+
+	while ( 1 ) {
+		const char *start = r->buf + r->pos;
+		const char *nl = si_scanNewline( start + scanned, r->buf + r->end );
+
+		if ( nl ) {
+			size_t len = (size_t)( nl - start );
+			si_consumeLine( r, r->pos + len + 1 );
+			if ( unlikely( len >= maxLen )) {
+				si_count( r, drained, len + 1 );
+				si_count( r, rejected[SI_REJECT_TOO_LONG], 1 );
+				return 1;
+			}
+			*line = start;
+			*outLen = len;
+			return 0;
+		}
+
+		scanned = r->end - r->pos;
+
+		if ( unlikely( scanned >= maxLen )) {
+			si_drainStdin( r );
+			si_count( r, rejected[SI_REJECT_TOO_LONG], 1 );
+			return 1;
+		}
+
+		if ( unlikely( !si_refill( r ))) {
+			// partial line, keep it buffered until the rest arrives
+			if ( r->blocked ) return EOF;
+			if ( unlikely( !r->eof )) {
+				// no room left to buffer the line
+				si_drainStdin( r );
+				si_count( r, rejected[SI_REJECT_TOO_LONG], 1 );
+				return 1;
+			}
+			if ( scanned == 0 ) return EOF;
+			// last line without a trailing newline
+			si_count( r, lines, 1 );
+			*line = r->buf + r->pos;
+			*outLen = scanned;
+			r->pos = r->end;
+			return 0;
+		}
+	}
+}
+
+
+
+/**
+ * si_nextLine - locate the next line in the reader without copying it
+ *
+ * @r:			reader to pull from
+ * @maxLen:		line length limit, lines of maxLen bytes or more are rejected
+ * @line:		receives a pointer to the first byte of the line
+ * @outLen:		receives the line length, excluding the newline
+ *
+ * The returned line stays valid until the next call on the same reader.
+ * The common case, a whole line of fewer than maxLen bytes already in the
+ * buffer, is one scan and a few stores; anything else is si_nextLineSlow().
+ *
+ * Returns:
+ * 		0 - on success
+ * 		1 - on a line that exceeds maxLen ( the rest of it is drained )
+ *	   -1 - on EOF, or with r->blocked set when no full line is buffered yet
+ */
+static alwaysInline int si_nextLine ( si_reader *r, size_t maxLen, const char **line, size_t *outLen ) {
+
+	const char *start = r->buf + r->pos;
+	const char *nl = si_scanNewline( start, r->buf + r->end );
+
+	if ( unlikely( !nl || r->skipping || (size_t)( nl - start ) >= maxLen ))
+		return si_nextLineSlow( r, maxLen, line, outLen );
+
+	size_t len = (size_t)( nl - start );
+	r->blocked = false;
+	si_consumeLine( r, r->pos + len + 1 );
+	*line = start;
+	*outLen = len;
+	return 0;
+}
+
+
+
+/**
+ * si_readLine - fetch the next line from a reader without copying it
+ *
+ * @r:			reader to pull from
+ * @maxLen:		line length limit, same meaning as for si_readByte()
+ * @line:		receives a pointer into the reader's buffer
+ * @outLen:		receives the line length
+ *
+ * The line is not null-terminated and stays valid until the next read.
+ *
+ * Returns:
+ * 		0 - on success
+ * 		1 - on error ( NULL r, line or outLen, maxLen < 1, or line too long )
+ *	   -1 - on EOF
+ */
+static alwaysInline int si_readLine ( si_reader *r, size_t maxLen, const char **line, size_t *outLen ) {
+
+	if ( unlikely( !r || !line || !outLen || maxLen < 1 )) {
+		if ( r ) si_count( r, rejected[SI_REJECT_USAGE], 1 );
+		return 1;
+	}
+
+	*outLen = 0;
+
+	int result = si_nextLine( r, maxLen, line, outLen );
+
+	if ( unlikely( result == 1 )) {
+		si_report( r, SI_ERR_TOO_LONG, "Input exceeding buffer size. Try again.\n" );
+		return 1;
+	}
+
+	return result;
+}
+
+
+
+/**
+ * si_tally - count a failed status getter in the reader's error stats
+ */
+static alwaysInline si_result si_tally ( si_reader *r, si_result status ) {
+
+	if ( status == SI_INVALID ) r->stats.invalid++;
+	else if ( status == SI_OVERFLOW ) r->stats.overflow++;
+	else if ( status == SI_TOO_LONG ) r->stats.tooLong++;
+	return status;
+}
+
+
+
+/**
+ * si_tryLine - si_nextLine() with the result mapped to an si_result
+ *
+ * Never prints, so the status getters can fail quietly.
+ */
+static alwaysInline si_result si_tryLine ( si_reader *r, size_t maxLen, const char **line, size_t *outLen ) {
+
+	*outLen = 0;
+
+	switch ( si_nextLine( r, maxLen, line, outLen )) {
+		case 0:		return SI_OK;
+		case 1:		return si_tally( r, SI_TOO_LONG );
+		default:	return r->blocked ? SI_WOULD_BLOCK : SI_EOF;
+	}
+}
+
+
+
+/**
+ * si_maxToLimit - convert a "longest accepted line" into a si_readLine() limit
+ */
+static alwaysInline size_t si_maxToLimit ( size_t max ) {
+
+	return max >= SI_LINE_MAX ? SI_LINE_MAX : max + 1;
+}
+
+
+
+/**
+ * si_readByte - read up to maxLen bytes from a reader into buffer, 
+ * 					stop at newline or EOF, drain excess input, and report length.
+ * 
+ * @r:			reader to pull from
+ * @buf:		buffer to fill with input characters
+ * @maxLen:		maximum number of bytes to read into buf
+ * @outLen:		pointer to size_t to receive the number of bytes read
+ * 
+ * Returns:
+ * 		0 - on success
+ * 		1 - on error ( NULL r, buf or outLen, or maxLen < 1 )
+ *	   -1 - on EOF ( caller should check and handle appropriately )
+ */
+static alwaysInline int si_readByte ( si_reader *r, char *buf, size_t maxLen, size_t *outLen ) {
+
+	if ( unlikely( !buf )) return 1;
+
+	const char *line;
+	int result = si_readLine( r, maxLen, &line, outLen );
+	if ( result ) return result;
+
+	memcpy( buf, line, *outLen );
+	return 0;
+}
+
+
+
+/**
+ * Integer parsing
+ *
+ * The integer getters parse the line in place as a (ptr, len) span. The
+ * accepted syntax is exactly what strtol()/strtoul() accept in base 10 with
+ * the "C" locale, followed by nothing but the end of the line:
+ *
+ * 		[whitespace] [+|-] digits
+ *
+ * Like the strto* calls, an embedded '\0' ends the number. Digits are
+ * converted eight at a time with SWAR arithmetic, without touching errno.
+ */
+enum {
+	SI_PARSE_OK = 0,
+	SI_PARSE_INVALID,	// no digits, or trailing garbage
+	SI_PARSE_RANGE,		// syntactically fine but out of range
+	SI_PARSE_NEGATIVE,	// '-' in front of an unsigned value
+};
+
+static alwaysInline si_error si_errorKind ( int result ) {
+
+	return result == SI_PARSE_RANGE ? SI_ERR_OVERFLOW : SI_ERR_INVALID;
+}
+
+static alwaysInline si_reject si_rejectOf ( int result ) {
+
+	return result == SI_PARSE_RANGE ? SI_REJECT_RANGE : result == SI_PARSE_NEGATIVE ? SI_REJECT_NEGATIVE : SI_REJECT_SYNTAX;
+}
+
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+#define si_load64le(p)	__builtin_bswap64( si_load64( p ))
+#else
+#define si_load64le(p)	si_load64( p )
+#endif
+
+static alwaysInline uint64_t si_load64 ( const char *p ) {
+
+	uint64_t v;
+	memcpy( &v, p, sizeof(v) );
+	return v;
+}
+
+
+
+/**
+ * si_isEightDigits - true if all eight bytes of a little-endian word are '0'..'9'
+ */
+static alwaysInline bool si_isEightDigits ( uint64_t v ) {
+
+	return ((( v & 0xF0F0F0F0F0F0F0F0ull ) | ((( v + 0x0606060606060606ull ) & 0xF0F0F0F0F0F0F0F0ull ) >> 4 ))
+			== 0x3333333333333333ull );
+}
+
+
+
+/**
+ * si_eightDigits - convert eight ASCII digits ( little-endian word ) to their value
+ */
+static alwaysInline uint32_t si_eightDigits ( uint64_t v ) {
+
+	v -= 0x3030303030303030ull;
+	v = ( v * 10 ) + ( v >> 8 );
+	v = ((( v & 0x000000FF000000FFull ) * ( 100 + ( 1000000ull << 32 ))) +
+		((( v >> 16 ) & 0x000000FF000000FFull ) * ( 1 + ( 10000ull << 32 )))) >> 32;
+	return (uint32_t)v;
+}
+
+
+
+/**
+ * si_isSpace - isspace() for the "C" locale, without the table lookup
+ */
+static alwaysInline bool si_isSpace ( unsigned char c ) {
+
+	return c == ' ' || ( c >= '\t' && c <= '\r' );
+}
+
+
+
+/**
+ * si_parseMagnitude - parse "[ws] [+|-] digits" from a span into an unsigned magnitude
+ *
+ * @p, @len:	the span, not null-terminated
+ * @neg:		receives true if a '-' sign was present
+ * @out:		receives the magnitude ( only meaningful on SI_PARSE_OK )
+ *
+ * returns SI_PARSE_OK, SI_PARSE_INVALID or SI_PARSE_RANGE ( above ULLONG_MAX )
+ */
+static alwaysInline int si_parseMagnitude ( const char *p, size_t len, bool *neg, unsigned long long *out ) {
+
+	const char *end = p + len;
+
+	while ( p < end && si_isSpace( (unsigned char)*p )) p++;
+
+	*neg = false;
+	if ( p < end && ( *p == '-' || *p == '+' )) *neg = ( *p++ == '-' );
+
+	const char *digits = p;
+	while ( p < end && *p == '0' ) p++;
+
+	// up to 19 significant digits always fit, 8 at a time first
+	const char *sig = p;
+	uint64_t value = 0;
+
+	while ( end - p >= 8 && p - sig <= 11 ) {
+		uint64_t word = si_load64le( p );
+		if ( !si_isEightDigits( word )) break;
+		value = value * 100000000ull + si_eightDigits( word );
+		p += 8;
+	}
+
+	bool range = false;
+
+	for ( ; p < end && (unsigned char)( *p - '0' ) < 10; p++ ) {
+		unsigned d = (unsigned)( *p - '0' );
+		if ( p - sig < 19 ) value = value * 10 + d;
+		else if ( unlikely( __builtin_mul_overflow( value, 10, &value ) ||
+							__builtin_add_overflow( value, d, &value ))) range = true;
+	}
+
+	if ( unlikely( p == digits )) return SI_PARSE_INVALID;
+	if ( unlikely( p != end && *p != '\0' )) return SI_PARSE_INVALID;
+	if ( unlikely( range )) return SI_PARSE_RANGE;
+
+	*out = value;
+	return SI_PARSE_OK;
+}
+
+
+
+/**
+ * si_parseSigned - strtoll()-style parse of a span, checked against [min, max]
+ *
+ * returns SI_PARSE_OK, SI_PARSE_INVALID or SI_PARSE_RANGE
+ */
+static alwaysInline int si_parseSigned ( const char *p, size_t len, long long min, long long max, long long *out ) {
+
+	bool neg;
+	unsigned long long mag;
+
+	int result = si_parseMagnitude( p, len, &neg, &mag );
+	if ( result ) return result;
+
+	if ( neg ) {
+		if ( mag > (unsigned long long)-( min + 1 ) + 1 ) return SI_PARSE_RANGE;
+		*out = mag ? -(long long)( mag - 1 ) - 1 : 0;
+	}
+	else {
+		if ( mag > (unsigned long long)max ) return SI_PARSE_RANGE;
+		*out = (long long)mag;
+	}
+
+	return SI_PARSE_OK;
+}
+
+
+
+/**
+ * si_parseUnsigned - strtoull()-style parse of a span, checked against max
+ *
+ * As with strtoul(), a leading '-' negates the magnitude in unsigned
+ * arithmetic rather than being rejected.
+ *
+ * returns SI_PARSE_OK, SI_PARSE_INVALID or SI_PARSE_RANGE
+ */
+static alwaysInline int si_parseUnsigned ( const char *p, size_t len, unsigned long long max, unsigned long long *out ) {
+
+	bool neg;
+	unsigned long long mag;
+
+	int result = si_parseMagnitude( p, len, &neg, &mag );
+	if ( result ) return result;
+
+	if ( mag > max ) return SI_PARSE_RANGE;
+
+	*out = neg ? ( 0 - mag ) & max : mag;
+	return SI_PARSE_OK;
+}
+
+
+
+/**
+ * Floating point parsing
+ *
+ * si_getFloat/si_getDouble parse the span themselves instead of calling
+ * strtof()/strtod(). The accepted syntax matches the strto* calls in the
+ * "C" locale ( decimal and hexadecimal forms ), and results are correctly
+ * rounded to nearest-even. There are three tiers:
+ *
+ * 		1. Clinger's fast path, when the digits and the power of ten are
+ * 		   both exactly representable and one multiply or divide is exact.
+ * 		2. Eisel-Lemire, a 128-bit multiply against a table of powers of
+ * 		   five, which settles nearly every remaining normal result.
+ * 		3. A big-decimal fallback that shifts the digits in base 10 until
+ * 		   64 exact bits and a sticky bit are known.
+ *
+ * Anything strtod() would report as non-finite or ERANGE is rejected with
+ * SI_PARSE_RANGE, including glibc's rule of flagging subnormal results
+ * only when they are inexact.
+ */
+#include "safeinput_pow5.h"
+
+// Clinger's path needs float and double arithmetic done in their own precision
+#if FLT_EVAL_METHOD == 0 || FLT_EVAL_METHOD == 16
+#define SI_CLINGER		1
+#else
+#define SI_CLINGER		0
+#endif
+
+#if defined(__SIZEOF_INT128__)
+__extension__ typedef unsigned __int128 si_u128;
+#endif
+
+typedef struct si_floatFormat {
+	int		mantBits;	// explicit mantissa bits
+	int		bias;		// exponent bias
+	int		infPower;	// biased exponent of infinity
+	int		minPow10;	// below 1e(minPow10) any digits round to zero
+	int		maxPow10;	// above 1e(maxPow10) any digits overflow
+	int		minEven;	// q range where Eisel-Lemire can land exactly
+	int		maxEven;	// on a halfway point between two floats
+} si_floatFormat;
+
+static const si_floatFormat si_binary64 = { 52, 1023, 0x7FF, -342, 308, -4, 23 };
+static const si_floatFormat si_binary32 = { 23, 127, 0xFF, -64, 38, -17, 10 };
+
+// the decimal form of a number, as split out by si_scanReal()
+typedef struct si_decimal {
+	uint64_t	w;			// first 19 significant digits
+	int64_t		q;			// power of ten applied to w
+	bool		many;		// nonzero digits were dropped after the first 19
+	bool		neg;
+	const char	*digits;	// mantissa text, for the slow path
+	const char	*digitsEnd;
+	int64_t		exp10;		// explicit exponent, for the slow path
+} si_decimal;
+
+
+
+/**
+ * si_mul64 - full 64x64 -> 128 bit multiply, returns the high half
+ */
+static alwaysInline uint64_t si_mul64 ( uint64_t a, uint64_t b, uint64_t *lo ) {
+
+#if defined(__SIZEOF_INT128__)
+	si_u128 p = (si_u128)a * b;
+	*lo = (uint64_t)p;
+	return (uint64_t)( p >> 64 );
+#else
+	uint64_t aLo = (uint32_t)a, aHi = a >> 32;
+	uint64_t bLo = (uint32_t)b, bHi = b >> 32;
+	uint64_t ll = aLo * bLo, lh = aLo * bHi, hl = aHi * bLo, hh = aHi * bHi;
+	uint64_t mid = ( ll >> 32 ) + (uint32_t)lh + (uint32_t)hl;
+	*lo = ( mid << 32 ) | (uint32_t)ll;
+	return hh + ( lh >> 32 ) + ( hl >> 32 ) + ( mid >> 32 );
+#endif
+}
+
+
+
+/**
+ * si_roundBinary - round ( m + sticky ) * 2^e2 to the nearest float of format f
+ *
+ * @m:			nonzero mantissa, any alignment
+ * @e2:			binary exponent of m's lowest bit
+ * @sticky:		true if the exact value is slightly above m * 2^e2
+ * @bits:		receives the encoded magnitude
+ *
+ * Mirrors glibc's ERANGE rules: overflow always fails, a subnormal or zero
+ * result fails only when inexact, and tininess is judged after rounding
+ * as if the exponent range were unbounded.
+ *
+ * returns SI_PARSE_OK or SI_PARSE_RANGE
+ */
+static int si_roundBinary ( uint64_t m, int64_t e2, bool sticky, const si_floatFormat *f, uint64_t *bits ) {
+
+	int lz = __builtin_clzll( m );
+	m <<= lz;
+
+	int64_t e = e2 - lz + 63;	// value is in [2^e, 2^(e+1))
+	int64_t emin = 1 - f->bias;
+	int64_t keep = f->mantBits + 1;
+
+	if ( e < emin ) keep -= emin - e;
+
+	uint64_t q, rem, half;
+
+	if ( keep < 0 ) {
+		q = 0; rem = 1; half = 2;	// below half the smallest subnormal
+	}
+	else if ( keep == 0 ) {
+		q = 0; rem = m; half = 1ull << 63;
+	}
+	else {
+		int shift = 64 - (int)keep;
+		q = m >> shift;
+		rem = m & (( 1ull << shift ) - 1 );
+		half = 1ull << ( shift - 1 );
+	}
+
+	bool inexact = rem || sticky;
+	q += ( rem > half || ( rem == half && ( sticky || ( q & 1 ))));
+
+	if ( e >= emin ) {
+		if ( q >> ( f->mantBits + 1 )) {
+			q >>= 1;
+			e++;
+		}
+
+		int64_t biased = e + f->bias;
+		if ( biased >= f->infPower ) return SI_PARSE_RANGE;
+
+		*bits = ( (uint64_t)biased << f->mantBits ) | ( q & (( 1ull << f->mantBits ) - 1 ));
+		return SI_PARSE_OK;
+	}
+
+	// subnormal, zero, or rounded up to the smallest normal ( q == 2^mantBits )
+	if ( inexact ) {
+		bool tiny = true;
+
+		if ( e == emin - 1 ) {
+			int shift = 63 - f->mantBits;
+			uint64_t full = m >> shift;
+			uint64_t r = m & (( 1ull << shift ) - 1 );
+			uint64_t h = 1ull << ( shift - 1 );
+			full += ( r > h || ( r == h && ( sticky || ( full & 1 ))));
+			tiny = !( full >> ( f->mantBits + 1 ));
+		}
+
+		if ( tiny ) return SI_PARSE_RANGE;
+	}
+
+	*bits = q;
+	return SI_PARSE_OK;
+}
+
+
+
+/**
+ * si_eiselLemire - compute w * 10^q for a normal result from the pow5 table
+ *
+ * @w:			nonzero decimal significand
+ * @q:			power of ten, within [f->minPow10, f->maxPow10]
+ * @bits:		receives the encoded magnitude
+ *
+ * Returns:
+ * 		SI_PARSE_OK		- bits holds the correctly rounded result
+ * 		SI_PARSE_RANGE	- the result overflows
+ * 		-1				- undecided ( subnormal or ambiguous ), use the slow path
+ */
+static alwaysInline int si_eiselLemire ( uint64_t w, int64_t q, const si_floatFormat *f, uint64_t *bits ) {
+
+	int lz = __builtin_clzll( w );
+	w <<= lz;
+
+	const uint64_t *pow5 = si_pow5[ q - SI_POW5_MIN ];
+	uint64_t lo;
+	uint64_t hi = si_mul64( w, pow5[0], &lo );
+
+	// the low bits below the mantissa + 3 guard bits are all ones: refine with the next 64 bits
+	uint64_t precisionMask = 0xFFFFFFFFFFFFFFFFull >> ( f->mantBits + 3 );
+	if (( hi & precisionMask ) == precisionMask ) {
+		uint64_t lo2;
+		uint64_t hi2 = si_mul64( w, pow5[1], &lo2 );
+		(void)lo2;
+		lo += hi2;
+		if ( hi2 > lo ) hi++;
+		if ( unlikely( lo == 0xFFFFFFFFFFFFFFFFull && ( q < -27 || q > 55 ))) return -1;
+	}
+
+	int upper = (int)( hi >> 63 );
+	int shift = upper + 64 - f->mantBits - 3;
+	uint64_t mant = hi >> shift;
+	int64_t power2 = ((( 152170 + 65536 ) * q ) >> 16 ) + 63 + upper - lz + f->bias;
+
+	if ( power2 <= 0 ) return -1;
+
+	// a product ending exactly on a halfway point rounds to even, not up
+	if ( lo <= 1 && q >= f->minEven && q <= f->maxEven && ( mant & 3 ) == 1 && ( mant << shift ) == hi )
+		mant &= ~1ull;
+
+	mant += mant & 1;
+	mant >>= 1;
+
+	if ( mant >= ( 2ull << f->mantBits )) {
+		mant = 1ull << f->mantBits;
+		power2++;
+	}
+
+	if ( power2 >= f->infPower ) return SI_PARSE_RANGE;
+
+	*bits = ( (uint64_t)power2 << f->mantBits ) | ( mant & (( 1ull << f->mantBits ) - 1 ));
+	return SI_PARSE_OK;
+}
+
+
+
+/**
+ * si_hpd - high precision decimal for the slow path
+ *
+ * Holds 0.d[0]d[1]...d[nd-1] * 10^dp with up to SI_HPD_DIGITS digits, which
+ * is enough to settle any halfway case of a double. Digits past that are
+ * only remembered through the trunc flag.
+ */
+#define SI_HPD_DIGITS	800
+#define SI_HPD_SHIFT	60	// largest shift that can't overflow the 64-bit accumulator
+
+typedef struct si_hpd {
+	int				nd;		// number of digits
+	int64_t			dp;		// decimal point position
+	bool			trunc;	// nonzero digits were discarded
+	unsigned char	d[ SI_HPD_DIGITS + 20 ];
+} si_hpd;
+
+static alwaysInline void si_hpdTrim ( si_hpd *a ) {
+
+	while ( a->nd > 0 && a->d[ a->nd - 1 ] == 0 ) a->nd--;
+	if ( a->nd == 0 ) a->dp = 0;
+}
+
+// divide by 2^k, k <= SI_HPD_SHIFT
+static void si_hpdShiftRight ( si_hpd *a, unsigned k ) {
+
+	int r = 0, w = 0;
+	uint64_t n = 0;
+
+	for ( ; ( n >> k ) == 0; r++ ) {
+		if ( r >= a->nd ) {
+			if ( n == 0 ) {
+				a->nd = 0;
+				return;
+			}
+			while (( n >> k ) == 0 ) {
+				n *= 10;
+				r++;
+			}
+			break;
+		}
+		n = n * 10 + a->d[r];
+	}
+
+	a->dp -= r - 1;
+
+	uint64_t mask = ( 1ull << k ) - 1;
+
+	for ( ; r < a->nd; r++ ) {
+		a->d[ w++ ] = (unsigned char)( n >> k );
+		n = ( n & mask ) * 10 + a->d[r];
+	}
+
+	while ( n > 0 ) {
+		unsigned char dig = (unsigned char)( n >> k );
+		if ( w < SI_HPD_DIGITS ) a->d[ w++ ] = dig;
+		else if ( dig ) a->trunc = true;
+		n = ( n & mask ) * 10;
+	}
+
+	a->nd = w;
+	si_hpdTrim( a );
+}
+
+// multiply by 2^k, k <= SI_HPD_SHIFT ( 2^60 has 19 digits, so at most 19 new ones )
+static void si_hpdShiftLeft ( si_hpd *a, unsigned k ) {
+
+	int r = a->nd;
+	int w = a->nd + 19;
+	int top = w;
+	uint64_t n = 0;
+
+	while ( r-- > 0 ) {
+		n += (uint64_t)a->d[r] << k;
+		a->d[ --w ] = (unsigned char)( n % 10 );
+		n /= 10;
+	}
+
+	while ( n > 0 ) {
+		a->d[ --w ] = (unsigned char)( n % 10 );
+		n /= 10;
+	}
+
+	int count = top - w;
+	memmove( a->d, a->d + w, (size_t)count );
+	a->dp += count - a->nd;
+
+	if ( count > SI_HPD_DIGITS ) {
+		for ( int i = SI_HPD_DIGITS; i < count; i++ )
+			if ( a->d[i] ) a->trunc = true;
+		count = SI_HPD_DIGITS;
+	}
+
+	a->nd = count;
+	si_hpdTrim( a );
+}
+
+static void si_hpdShift ( si_hpd *a, int k ) {
+
+	for ( ; k > SI_HPD_SHIFT; k -= SI_HPD_SHIFT ) si_hpdShiftLeft( a, SI_HPD_SHIFT );
+	for ( ; k < -SI_HPD_SHIFT; k += SI_HPD_SHIFT ) si_hpdShiftRight( a, SI_HPD_SHIFT );
+
+	if ( k > 0 ) si_hpdShiftLeft( a, (unsigned)k );
+	else if ( k < 0 ) si_hpdShiftRight( a, (unsigned)-k );
+}
+
+
+
+/**
+ * si_slowDecimal - exact conversion of a scanned decimal through si_hpd
+ *
+ * returns SI_PARSE_OK or SI_PARSE_RANGE
+ */
+static cold int si_slowDecimal ( const si_decimal *dec, const si_floatFormat *f, uint64_t *bits ) {
+
+	// powers of two that keep the shifted value within one decimal digit of [0.5, 1)
+	static const unsigned char powtab[] = { 1, 3, 6, 9, 13, 16, 19, 23, 26 };
+
+	si_hpd a;
+	a.nd = 0;
+	a.dp = 0;
+	a.trunc = false;
+
+	bool dot = false;
+
+	for ( const char *p = dec->digits; p < dec->digitsEnd; p++ ) {
+		if ( *p == '.' ) {
+			dot = true;
+			continue;
+		}
+
+		unsigned char d = (unsigned char)( *p - '0' );
+		if ( a.nd == 0 && d == 0 ) {
+			if ( dot ) a.dp--;
+			continue;
+		}
+
+		if ( !dot ) a.dp++;
+		if ( a.nd < SI_HPD_DIGITS ) a.d[ a.nd++ ] = d;
+		else if ( d ) a.trunc = true;
+	}
+
+	si_hpdTrim( &a );
+	a.dp += dec->exp10;
+
+	if ( a.dp > f->maxPow10 + 1 ) return SI_PARSE_RANGE;
+	if ( a.dp < f->minPow10 ) return SI_PARSE_RANGE;	// rounds to zero
+
+	int64_t e2 = 0;
+
+	while ( a.dp > 0 ) {
+		int n = a.dp >= (int64_t)sizeof(powtab) ? 27 : powtab[ a.dp ];
+		si_hpdShift( &a, -n );
+		e2 += n;
+	}
+
+	while ( a.dp < 0 || ( a.dp == 0 && a.d[0] < 5 )) {
+		int n = -a.dp >= (int64_t)sizeof(powtab) ? 27 : powtab[ -a.dp ];
+		si_hpdShift( &a, n );
+		e2 -= n;
+	}
+
+	// value is now in [0.5, 1): pull 64 exact bits into the integer part
+	si_hpdShift( &a, 64 );
+	e2 -= 64;
+
+	uint64_t m = 0;
+	int i = 0;
+	for ( ; i < a.dp && i < a.nd; i++ ) m = m * 10 + a.d[i];
+	for ( ; i < a.dp; i++ ) m *= 10;
+
+	return si_roundBinary( m, e2, a.trunc || a.nd > a.dp, f, bits );
+}
+
+
+
+/**
+ * si_parseHex - hexadecimal float body after "0x": hexdigits [. hexdigits] [p [+|-] digits]
+ *
+ * returns SI_PARSE_OK, SI_PARSE_INVALID or SI_PARSE_RANGE
+ */
+static cold int si_parseHex ( const char *p, const char *end, const si_floatFormat *f, uint64_t *bits ) {
+
+	uint64_t m = 0;
+	int64_t e2 = 0;
+	int sig = 0;
+	bool sticky = false, any = false, dot = false;
+
+	for ( ; p < end; p++ ) {
+		unsigned d;
+		unsigned char c = (unsigned char)*p;
+
+		if ( c == '.' && !dot ) {
+			dot = true;
+			continue;
+		}
+
+		if ( (unsigned)( c - '0' ) < 10 ) d = (unsigned)( c - '0' );
+		else if ( (unsigned)(( c | 0x20 ) - 'a' ) < 6 ) d = (unsigned)(( c | 0x20 ) - 'a' ) + 10;
+		else break;
+
+		any = true;
+		if ( m == 0 && d == 0 ) {
+			if ( dot ) e2 -= 4;
+			continue;
+		}
+
+		if ( sig < 16 ) {
+			m = ( m << 4 ) | d;
+			sig++;
+			if ( dot ) e2 -= 4;
+		}
+		else {
+			sticky |= d != 0;
+			if ( !dot ) e2 += 4;
+		}
+	}
+
+	if ( !any ) return SI_PARSE_INVALID;
+
+	if ( p < end && ( *p | 0x20 ) == 'p' ) {
+		const char *e = p + 1;
+		bool eneg = false;
+		if ( e < end && ( *e == '-' || *e == '+' )) eneg = ( *e++ == '-' );
+
+		if ( e < end && (unsigned char)( *e - '0' ) < 10 ) {
+			int64_t x = 0;
+			for ( ; e < end && (unsigned char)( *e - '0' ) < 10; e++ )
+				if ( x < 100000 ) x = x * 10 + ( *e - '0' );
+			e2 += eneg ? -x : x;
+			p = e;
+		}
+	}
+
+	if ( p != end && *p != '\0' ) return SI_PARSE_INVALID;
+
+	if ( m == 0 ) {
+		*bits = 0;
+		return SI_PARSE_OK;
+	}
+
+	return si_roundBinary( m, e2, sticky, f, bits );
+}
+
+
+
+/**
+ * si_scanReal - split "[ws] [+|-] digits [. digits] [e [+|-] digits]" into a si_decimal
+ *
+ * Hex floats are converted right away through si_parseHex(), in which case
+ * *hex is set and bits holds the result.
+ *
+ * returns SI_PARSE_OK, SI_PARSE_INVALID or SI_PARSE_RANGE
+ */
+static alwaysInline int si_scanReal ( const char *p, size_t len, si_decimal *dec, const si_floatFormat *f, bool *hex, uint64_t *bits ) {
+
+	const char *end = p + len;
+
+	while ( p < end && si_isSpace( (unsigned char)*p )) p++;
+
+	dec->neg = false;
+	if ( p < end && ( *p == '-' || *p == '+' )) dec->neg = ( *p++ == '-' );
+
+	*hex = false;
+	if ( unlikely( end - p >= 2 && p[0] == '0' && ( p[1] | 0x20 ) == 'x' )) {
+		*hex = true;
+		return si_parseHex( p + 2, end, f, bits );
+	}
+
+	uint64_t w = 0;
+	int64_t q = 0;
+	int sig = 0;
+	bool many = false, any = false;
+
+	dec->digits = p;
+
+	for ( ; p < end && (unsigned char)( *p - '0' ) < 10; p++ ) {
+		unsigned d = (unsigned)( *p - '0' );
+		any = true;
+		if ( sig == 0 && d == 0 ) continue;
+		if ( sig < 19 ) {
+			w = w * 10 + d;
+			sig++;
+		}
+		else {
+			q++;
+			many |= d != 0;
+		}
+	}
+
+	if ( p < end && *p == '.' ) {
+		p++;
+		for ( ; p < end && (unsigned char)( *p - '0' ) < 10; p++ ) {
+			unsigned d = (unsigned)( *p - '0' );
+			any = true;
+			if ( sig == 0 && d == 0 ) {
+				q--;
+				continue;
+			}
+			if ( sig < 19 ) {
+				w = w * 10 + d;
+				sig++;
+				q--;
+			}
+			else many |= d != 0;
+		}
+	}
+
+	if ( unlikely( !any )) return SI_PARSE_INVALID;
+
+	dec->digitsEnd = p;
+	dec->exp10 = 0;
+
+	if ( p < end && ( *p | 0x20 ) == 'e' ) {
+		const char *e = p + 1;
+		bool eneg = false;
+		if ( e < end && ( *e == '-' || *e == '+' )) eneg = ( *e++ == '-' );
+
+		if ( e < end && (unsigned char)( *e - '0' ) < 10 ) {
+			int64_t x = 0;
+			for ( ; e < end && (unsigned char)( *e - '0' ) < 10; e++ )
+				if ( x < 100000 ) x = x * 10 + ( *e - '0' );
+			dec->exp10 = eneg ? -x : x;
+			p = e;
+		}
+	}
+
+	if ( unlikely( p != end && *p != '\0' )) return SI_PARSE_INVALID;
+
+	dec->w = w;
+	dec->q = q + dec->exp10;
+	dec->many = many;
+	return SI_PARSE_OK;
+}
+
+
+
+/**
+ * si_decimalToBinary - tiers 2 and 3 for a scanned, nonzero decimal
+ *
+ * returns SI_PARSE_OK or SI_PARSE_RANGE
+ */
+static alwaysInline int si_decimalToBinary ( const si_decimal *dec, const si_floatFormat *f, uint64_t *bits ) {
+
+	if ( dec->q > f->maxPow10 ) return SI_PARSE_RANGE;
+	if ( dec->q < f->minPow10 ) return SI_PARSE_RANGE;	// nonzero digits that round to zero
+
+	int result = si_eiselLemire( dec->w, dec->q, f, bits );
+
+	// with dropped digits the value lies in ( w, w + 1 ) * 10^q: both ends must agree
+	if ( result == SI_PARSE_OK && dec->many ) {
+		uint64_t upper;
+		if ( si_eiselLemire( dec->w + 1, dec->q, f, &upper ) != SI_PARSE_OK || upper != *bits ) result = -1;
+	}
+
+	if ( unlikely( result < 0 )) return si_slowDecimal( dec, f, bits );
+	return result;
+}
+
+
+
+/**
+ * si_parseDouble - strtod()-compatible parse of a span into a finite double
+ *
+ * returns SI_PARSE_OK, SI_PARSE_INVALID or SI_PARSE_RANGE
+ */
+static alwaysInline int si_parseDouble ( const char *p, size_t len, double *out ) {
+
+	static const double pow10[] = {
+		1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+		1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22,
+	};
+
+	si_decimal dec;
+	uint64_t bits = 0;
+	bool hex;
+
+	int result = si_scanReal( p, len, &dec, &si_binary64, &hex, &bits );
+	if ( result ) return result;
+
+	if ( !hex ) {
+		if ( dec.w == 0 ) bits = 0;
+#if SI_CLINGER
+		else if ( !dec.many && dec.w <= ( 1ull << 53 ) && dec.q >= -22 && dec.q <= 22 ) {
+			double d = (double)dec.w;
+			d = dec.q < 0 ? d / pow10[ -dec.q ] : d * pow10[ dec.q ];
+			*out = dec.neg ? -d : d;
+			return SI_PARSE_OK;
+		}
+#endif
+		else if (( result = si_decimalToBinary( &dec, &si_binary64, &bits ))) return result;
+	}
+
+	if ( dec.neg ) bits |= 1ull << 63;
+	memcpy( out, &bits, sizeof(*out) );
+	return SI_PARSE_OK;
+}
+
+
+
+/**
+ * si_parseFloat - strtof()-compatible parse of a span into a finite float
+ *
+ * Rounds straight to binary32, never through a double.
+ *
+ * returns SI_PARSE_OK, SI_PARSE_INVALID or SI_PARSE_RANGE
+ */
+static alwaysInline int si_parseFloat ( const char *p, size_t len, float *out ) {
+
+	static const float pow10[] = { 1e0f, 1e1f, 1e2f, 1e3f, 1e4f, 1e5f, 1e6f, 1e7f, 1e8f, 1e9f, 1e10f };
+
+	si_decimal dec;
+	uint64_t bits = 0;
+	bool hex;
+
+	int result = si_scanReal( p, len, &dec, &si_binary32, &hex, &bits );
+	if ( result ) return result;
+
+	if ( !hex ) {
+		if ( dec.w == 0 ) bits = 0;
+#if SI_CLINGER
+		else if ( !dec.many && dec.w <= ( 1u << 24 ) && dec.q >= -10 && dec.q <= 10 ) {
+			float v = (float)dec.w;
+			v = dec.q < 0 ? v / pow10[ -dec.q ] : v * pow10[ dec.q ];
+			*out = dec.neg ? -v : v;
+			return SI_PARSE_OK;
+		}
+#endif
+		else if (( result = si_decimalToBinary( &dec, &si_binary32, &bits ))) return result;
+	}
+
+	if ( dec.neg ) bits |= 1u << 31;
+
+	uint32_t bits32 = (uint32_t)bits;
+	memcpy( out, &bits32, sizeof(*out) );
+	return SI_PARSE_OK;
+}
+
+
+
+/**
+ * Per-type parse core
+ *
+ * One si_tokX() per type holds the whole validation for that type over a
+ * ( ptr, len ) span, writing through a void pointer. Every entry point -
+ * the looping getters, the status getters, arrays, records and schemas -
+ * goes through an always-inlined driver that takes one of these as a
+ * constant, so each type gets its own specialised loop and any parser
+ * improvement lands everywhere at once.
+ */
+static alwaysInline int si_tokInt ( const char *p, size_t len, void *out ) {
+
+	long long v;
+	int result = si_parseSigned( p, len, INT_MIN, INT_MAX, &v );
+	if ( !result ) *(int *)out = (int)v;
+	return result;
+}
+
+static alwaysInline int si_tokUInt ( const char *p, size_t len, void *out ) {
+
+	unsigned long long v;
+	if ( len && p[0] == '-' ) return SI_PARSE_NEGATIVE;
+	int result = si_parseUnsigned( p, len, ULONG_MAX, &v );
+	if ( !result && v > UINT_MAX ) result = SI_PARSE_RANGE;
+	if ( !result ) *(unsigned int *)out = (unsigned int)v;
+	return result;
+}
+
+static alwaysInline int si_tokLong ( const char *p, size_t len, void *out ) {
+
+	long long v;
+	int result = si_parseSigned( p, len, LONG_MIN, LONG_MAX, &v );
+	if ( !result ) *(long *)out = (long)v;
+	return result;
+}
+
+static alwaysInline int si_tokULong ( const char *p, size_t len, void *out ) {
+
+	unsigned long long v;
+	int result = si_parseUnsigned( p, len, ULONG_MAX, &v );
+	if ( !result ) *(unsigned long *)out = (unsigned long)v;
+	return result;
+}
+
+static alwaysInline int si_tokLongLong ( const char *p, size_t len, void *out ) {
+
+	return si_parseSigned( p, len, LLONG_MIN, LLONG_MAX, (long long *)out );
+}
+
+static alwaysInline int si_tokULongLong ( const char *p, size_t len, void *out ) {
+
+	return si_parseUnsigned( p, len, ULLONG_MAX, (unsigned long long *)out );
+}
+
+static alwaysInline int si_tokFloat ( const char *p, size_t len, void *out ) {
+
+	return si_parseFloat( p, len, (float *)out );
+}
+
+static alwaysInline int si_tokDouble ( const char *p, size_t len, void *out ) {
+
+	return si_parseDouble( p, len, (double *)out );
+}
+
+// si_fieldType of a numeric parse core function, folds to a constant in the drivers
+static alwaysInline si_fieldType si_tokType ( int ( *parse )( const char *, size_t, void * )) {
+
+	if ( parse == si_tokInt ) return SI_FIELD_INT;
+	if ( parse == si_tokUInt ) return SI_FIELD_UINT;
+	if ( parse == si_tokLong ) return SI_FIELD_LONG;
+	if ( parse == si_tokULong ) return SI_FIELD_ULONG;
+	if ( parse == si_tokLongLong ) return SI_FIELD_LONGLONG;
+	if ( parse == si_tokULongLong ) return SI_FIELD_ULONGLONG;
+	if ( parse == si_tokFloat ) return SI_FIELD_FLOAT;
+	return SI_FIELD_DOUBLE;
+}
+
+
+
+/**
+ * si_inBounds - lo <= *value <= hi, compared in the parsed value's own type
+ *
+ * Folds to a pair of compares per parse core function, and away entirely
+ * for the unbounded getters, which pass NULL. Constant bounds from an
+ * inlined bounded getter fold into the compares themselves.
+ */
+static alwaysInline bool si_inBounds ( int ( *parse )( const char *, size_t, void * ), const void *value,
+									   const void *lo, const void *hi ) {
+
+#define si_between( T )	( *(const T *)lo <= *(const T *)value && *(const T *)value <= *(const T *)hi )
+
+	if ( !lo ) return true;
+
+	switch ( si_tokType( parse )) {
+		case SI_FIELD_INT:			return si_between( int );
+		case SI_FIELD_UINT:			return si_between( unsigned int );
+		case SI_FIELD_LONG:			return si_between( long );
+		case SI_FIELD_ULONG:		return si_between( unsigned long );
+		case SI_FIELD_LONGLONG:		return si_between( long long );
+		case SI_FIELD_ULONGLONG:	return si_between( unsigned long long );
+		case SI_FIELD_FLOAT:		return si_between( float );
+		default:					return si_between( double );
+	}
+
+#undef si_between
+}
+
+
+
+/**
+ * si_getValue - shared retry loop for the si_reader_getX() functions
+ *
+ * Always inlined with a constant parse function, like si_readArray().
+ * With lo and hi the value must also lie in [lo, hi], checked on the
+ * parsed value before the loop returns; NULL for the type's own range.
+ *
+ * returns true once a line parsed into out, false on EOF or a too-long line
+ */
+static alwaysInline bool si_getValueIn ( si_reader *r, void *out, int ( *parse )( const char *, size_t, void * ),
+										 const void *lo, const void *hi ) {
+
+	const char *line;
+	size_t len;
+
+	while ( 1 ) {
+
+		if ( si_readLine( r, INPUT_BUFFER_SIZE - 1, &line, &len )) return false;
+
+		int result = parse( line, len, out );
+		if ( !result && unlikely( !si_inBounds( parse, out, lo, hi ))) result = SI_PARSE_RANGE;
+
+		if ( !result ) {
+			si_count( r, parsed[ si_tokType( parse ) ], 1 );
+			return true;
+		}
+
+		si_countReject( r, result );
+		if ( result == SI_PARSE_NEGATIVE ) si_report( r, SI_ERR_INVALID, "Value can not be negative.\n" );
+		else if ( lo && result == SI_PARSE_RANGE ) si_report( r, SI_ERR_OVERFLOW, "Value out of range. Try again.\n" );
+		else si_report( r, si_errorKind( result ), "Invalid input. Try again.\n" );
+	}
+}
+
+static alwaysInline bool si_getValue ( si_reader *r, void *out, int ( *parse )( const char *, size_t, void * )) {
+
+	return si_getValueIn( r, out, parse, NULL, NULL );
+}
+
+
+
+/**
+ * si_readerAlloc - allocate a reader and its block buffer in one chunk
+ *
+ * returns NULL on allocation failure
+ */
+static si_reader *si_readerAlloc ( int fd, FILE *fp ) {
+
+	si_reader *r = malloc( sizeof(*r) + SI_READ_BLOCK );
+	if ( !r ) {
+		si_report( NULL, SI_ERR_NOMEM, "Memory allocation failed.\n" );
+		return NULL;
+	}
+
+	*r = (si_reader){
+		.buf		= (char *)( r + 1 ),
+		.cap		= SI_READ_BLOCK,
+		.fd			= fd,
+		.fp			= fp,
+		.flushOut	= ( fd == STDIN_FILENO ),
+		.lineLimit	= INPUT_BUFFER_SIZE,
+	};
+	return r;
+}
+
+
+
+/**
+ * si_reader_fromFd - create a reader on an open file descriptor
+ *
+ * The fd is not closed by si_reader_free().
+ *
+ * returns NULL on error
+ */
+si_reader *si_reader_fromFd ( int fd ) {
+
+	if ( fd < 0 ) return NULL;
+	return si_readerAlloc( fd, NULL );
+}
+
+
+
+/**
+ * si_reader_fromFile - create a reader on a stdio stream
+ *
+ * Streams backed by a file descriptor are read through the fd, anything
+ * else ( fmemopen, cookie streams ) goes through fread_unlocked().
+ *
+ * NOTE:	the reader takes over the stream. Don't call stdio input
+ * 			functions on it while the reader is in use.
+ *
+ * returns NULL on error
+ */
+si_reader *si_reader_fromFile ( FILE *fp ) {
+
+	if ( !fp ) return NULL;
+
+	int fd = fileno( fp );
+	return si_readerAlloc( fd, fd < 0 ? fp : NULL );
+}
+
+
+
+/**
+ * si_reader_fromMemory - create a reader over an in-memory buffer
+ *
+ * The bytes are not copied and must outlive the reader.
+ *
+ * returns NULL on error
+ */
+si_reader *si_reader_fromMemory ( const void *data, size_t len ) {
+
+	if ( !data && len ) return NULL;
+
+	si_reader *r = malloc( sizeof(*r) );
+	if ( !r ) {
+		si_report( NULL, SI_ERR_NOMEM, "Memory allocation failed.\n" );
+		return NULL;
+	}
+
+	// never written to: memory readers start at EOF and skip compaction
+	*r = (si_reader){
+		.buf		= (char *)data,
+		.cap		= len,
+		.end		= len,
+		.fd			= -1,
+		.eof		= true,
+		.lineLimit	= INPUT_BUFFER_SIZE,
+	};
+	si_count( r, bytes, len );
+	return r;
+}
+
+
+/**
+ * si_mapFd - mmap() all of a regular file read-only for sequential parsing
+ *
+ * returns the mapping, or NULL if fd isn't a non-empty regular file or
+ * mmap() fails
+ */
+static void *si_mapFd ( int fd, size_t *len ) {
+
+	struct stat st;
+
+	if ( fstat( fd, &st ) || !S_ISREG( st.st_mode ) || st.st_size <= 0 ) return NULL;
+	if ( (unsigned long long)st.st_size > SIZE_MAX ) return NULL;
+
+	void *map = mmap( NULL, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0 );
+	if ( map == MAP_FAILED ) return NULL;
+
+	// hints only, failures are harmless
+	madvise( map, (size_t)st.st_size, MADV_SEQUENTIAL );
+#ifdef MADV_HUGEPAGE
+	madvise( map, (size_t)st.st_size, MADV_HUGEPAGE );
+#endif
+
+	*len = (size_t)st.st_size;
+	return map;
+}
+
+
+
+/**
+ * si_mapOffset - the fd's current offset into a mapping of len bytes
+ */
+static size_t si_mapOffset ( int fd, size_t len ) {
+
+	off_t at = lseek( fd, 0, SEEK_CUR );
+	if ( at <= 0 ) return 0;
+	return (size_t)at < len ? (size_t)at : len;
+}
+
+
+
+/**
+ * si_reader_fromMapped - create a reader that parses a file in place
+ *
+ * Regular files are mmap()ed and every getter, view and tokenizer runs
+ * directly over the mapping, starting at the fd's current offset. Pipes,
+ * ttys and anything else that can't be mapped fall back to
+ * si_reader_fromFd(). Once mapped the fd may be closed; the fd fallback
+ * still reads from it, so keep it open until si_reader_free().
+ *
+ * NOTE: 	A file that is truncated while mapped raises SIGBUS on access.
+ *
+ * returns NULL on error
+ */
+si_reader *si_reader_fromMapped ( int fd ) {
+
+	size_t len;
+	void *map = si_mapFd( fd, &len );
+	if ( !map ) return si_reader_fromFd( fd );
+
+	si_reader *r = si_reader_fromMemory( map, len );
+	if ( !r ) {
+		munmap( map, len );
+		return NULL;
+	}
+
+	r->map = map;
+	r->mapLen = len;
+	r->pos = si_mapOffset( fd, len );
+	r->base = 0;
+	r->lineStart = r->pos;
+	return r;
+}
+
+
+
+/**
+ * si_mapStdin - switch the default reader to an mmap() of stdin
+ *
+ * Only works while stdin is redirected from a regular file and nothing has
+ * been read through the default reader yet. Must be called before the
+ * first si_get*() call.
+ *
+ * returns true if stdin is now mapped
+ */
+bool si_mapStdin ( void ) {
+
+	si_reader *r = &si_stdinReader;
+	si_guard( r );
+
+	if ( r->map ) return true;
+	if ( r->end || r->eof ) return false;
+
+	size_t len;
+	void *map = si_mapFd( r->fd, &len );
+	if ( !map ) return false;
+
+	r->map = map;
+	r->mapLen = len;
+	r->buf = map;
+	r->cap = r->end = len;
+	r->pos = r->lineStart = si_mapOffset( r->fd, len );
+	r->eof = true;
+	r->flushOut = false;
+	si_count( r, bytes, len );
+	return true;
+}
+
+
+
+/**
+ * si_reader_free - release a reader created by one of the si_reader_from* calls
+ *
+ * The underlying fd or stream is left open. Passing the default stdin
+ * reader or NULL is a no-op.
+ */
+void si_reader_free ( si_reader *r ) {
+
+	if ( !r || r == &si_stdinReader ) return;
+	if ( r->pendingLen ) si_showPending( r, NULL );
+	if ( r->map ) munmap( r->map, r->mapLen );
+	if ( r->lock ) {
+		pthread_mutex_destroy( r->lock );
+		free( r->lock );
+	}
+	free( r->heapBuf );
+	free( r->fieldBuf );
+	free( r );
+}
+
+
+
+/**
+ * si_reader_setLineLimit - set the line limit used by the string getters
+ *
+ * @limit:		same meaning as INPUT_BUFFER_SIZE ( the default ): si_getString
+ * 				accepts lines shorter than limit. SI_UNBOUNDED, or anything
+ * 				above SI_LINE_MAX, selects the SI_LINE_MAX hard cap.
+ *
+ * Limits above the block size make the buffer grow on demand.
+ *
+ * returns false on a NULL reader or a limit below 2
+ */
+bool si_reader_setLineLimit ( si_reader *r, size_t limit ) {
+
+	if ( !r || limit < 2 ) return false;
+
+	r->lineLimit = limit > SI_LINE_MAX ? SI_LINE_MAX : limit;
+	return true;
+}
+
+
+
+/**
+ * si_stdin - returns the default reader used by the si_get* functions
+ */
+si_reader *si_stdin ( void ) {
+
+	return &si_stdinReader;
+}
+
+
+
+/**
+ * si_reader_eof - true once the reader's source is exhausted and no
+ * 					buffered input is left
+ */
+bool si_reader_eof ( const si_reader *r ) {
+
+	return !r || ( r->eof && r->pos == r->end );
+}
+
+
+
+/**
+ * si_reader_error - returns the errno of the last failed read, 0 if none
+ */
+int si_reader_error ( const si_reader *r ) {
+
+	return r ? r->err : EINVAL;
+}
+
+
+
+/**
+ * si_reader_setErrorHandler - route the reader's error messages to fn
+ *
+ * @fn:			called with ctx, the kind of error and the message text,
+ * 				NULL to go back to writing to stderr
+ *
+ * returns false on a NULL reader
+ */
+bool si_reader_setErrorHandler ( si_reader *r, si_errorHandler fn, void *ctx ) {
+
+	if ( !r ) return false;
+
+	r->onError = fn;
+	r->errorCtx = ctx;
+	return true;
+}
+
+
+
+/**
+ * si_reader_setSilent - drop error messages entirely, only counting them
+ */
+bool si_reader_setSilent ( si_reader *r, bool silent ) {
+
+	if ( !r ) return false;
+
+	r->silent = silent;
+	return true;
+}
+
+
+
+/**
+ * si_isTerminal - true if r reads from a terminal
+ */
+static cold bool si_isTerminal ( const si_reader *r ) {
+
+	int fd = r->fp ? fileno( r->fp ) : r->fd;
+	return fd >= 0 && isatty( fd );
+}
+
+
+
+/**
+ * si_reader_setPrompt - show prompt whenever r is about to wait for a line
+ *
+ * @prompt:		text written to stderr before each blocking read that starts
+ * 				a new line, NULL to go back to no prompt. Not copied, so it
+ * 				must stay valid while it is set.
+ *
+ * The prompt goes out in the same writev() as the retry messages of the
+ * getters ( "Invalid input. Try again." ), after one fflush( stdout ), so a
+ * re-prompt costs a single write and no per-character echo. Lines that are
+ * already buffered, typed ahead of the prompt, are read without showing
+ * it. Prompts are only shown on a terminal and never by non-blocking
+ * readers.
+ *
+ * returns false on a NULL reader, or if r doesn't read from a terminal
+ * 		   ( the prompt is then not set )
+ */
+bool si_reader_setPrompt ( si_reader *r, const char *prompt ) {
+
+	si_guard( r );
+
+	if ( !r ) return false;
+
+	if ( r->pendingLen ) si_showPending( r, NULL );
+
+	if ( prompt && !si_isTerminal( r )) {
+		r->prompt = NULL;
+		return false;
+	}
+
+	r->prompt = prompt;
+	return true;
+}
+
+
+
+/**
+ * si_reader_setErrorRepeatLimit - show at most limit consecutive messages
+ * 								   of the same kind ( 0, the default, for all )
+ *
+ * Suppressed messages are counted in si_errorStats.suppressed and summed up
+ * in a single line once a different kind of error is reported.
+ */
+bool si_reader_setErrorRepeatLimit ( si_reader *r, unsigned limit ) {
+
+	if ( !r ) return false;
+
+	r->repeatLimit = limit;
+	r->repeats = 0;
+	return true;
+}
+
+
+
+/**
+ * si_reader_errorStats - rejected, overflowed and too-long lines so far
+ *
+ * Counts both the retrying getters and the status getters.
+ */
+si_errorStats si_reader_errorStats ( const si_reader *r ) {
+
+	return r ? r->stats : (si_errorStats){ 0, 0, 0, 0 };
+}
+
+
+
+
+/**
+ * si_reader_stats - snapshot of the reader's hot-path counters
+ *
+ * Only counted when the library is built with SI_STATS, otherwise the
+ * snapshot is all zero with enabled == false. Lines are counted once they
+ * are consumed, whichever getter took them; si_reader_getBool() reads
+ * through si_reader_getChar(), so each answer also counts as a char.
+ */
+si_stats si_reader_stats ( const si_reader *r ) {
+
+	si_stats stats = { .enabled = false };
+
+#ifdef SI_STATS
+	if ( r ) {
+		si_guard( (si_reader *)r );
+		stats = r->counters;
+		stats.enabled = true;
+	}
+#else
+	(void)r;
+#endif
+
+	return stats;
+}
+
+
+
+/**
+ * si_reader_resetStats - zero the reader's hot-path counters
+ *
+ * returns false if r is NULL
+ */
+bool si_reader_resetStats ( si_reader *r ) {
+
+	si_guard( r );
+
+	if ( !r ) return false;
+#ifdef SI_STATS
+	r->counters = (si_stats){ .enabled = false };
+#endif
+	return true;
+}
+
+
+
+/**
+ * si_reader_setNonBlocking - switch the reader's fd in or out of O_NONBLOCK
+ *
+ * In non-blocking mode no getter ever waits for input: when no complete
+ * line is buffered they return their EOF value and si_reader_wouldBlock()
+ * turns true. Partial lines are kept in the reader, so it is enough to
+ * poll si_reader_fd() for readability and call again.
+ *
+ * Memory readers never block and accept either mode. Readers on a FILE
+ * without a file descriptor can't be made non-blocking.
+ *
+ * returns false on a NULL reader or if fcntl() fails ( see si_reader_error )
+ */
+bool si_reader_setNonBlocking ( si_reader *r, bool on ) {
+
+	if ( !r || r->fp ) return false;
+
+	if ( r->fd >= 0 ) {
+		int flags = fcntl( r->fd, F_GETFL );
+		if ( flags < 0 || fcntl( r->fd, F_SETFL, on ? flags | O_NONBLOCK : flags & ~O_NONBLOCK ) < 0 ) {
+			r->err = errno;
+			return false;
+		}
+	}
+
+	r->nonBlock = on;
+	return true;
+}
+
+
+
+/**
+ * si_reader_fd - the file descriptor to poll()/epoll/kqueue on, -1 if none
+ */
+int si_reader_fd ( const si_reader *r ) {
+
+	return r && !r->fp ? r->fd : -1;
+}
+
+
+
+/**
+ * si_reader_wouldBlock - true if the last read returned because the
+ * 						  non-blocking source had no complete line ( or token )
+ */
+bool si_reader_wouldBlock ( const si_reader *r ) {
+
+	return r && r->blocked;
+}
+
+
+/**
+ * si_reader_setLocking - make r safe to share between threads
+ *
+ * With locking on, each getter call holds the reader's lock while it reads
+ * and parses, so lines ( and whole batches for the array getters ) are
+ * never interleaved between threads. Retries of the looping getters happen
+ * under the same lock.
+ *
+ * NOTE: 	Switch locking before the reader is shared, not while other
+ * 			threads use it. Views ( si_getStringView, records ) point into
+ * 			the shared buffer and are only safe until another thread reads;
+ * 			use the copying getters on shared readers. The default stdin
+ * 			reader has a static lock and can always be switched.
+ *
+ * returns false on a NULL reader or if the mutex can't be created
+ */
+bool si_reader_setLocking ( si_reader *r, bool on ) {
+
+	if ( !r ) return false;
+
+	if ( r == &si_stdinReader ) {
+		r->lock = on ? &si_stdinLock : NULL;
+		return true;
+	}
+
+	if ( !on ) {
+		if ( r->lock ) {
+			pthread_mutex_destroy( r->lock );
+			free( r->lock );
+			r->lock = NULL;
+		}
+		return true;
+	}
+
+	if ( r->lock ) return true;
+
+	pthread_mutex_t *lock = malloc( sizeof(*lock) );
+	pthread_mutexattr_t attr;
+
+	if ( !lock || pthread_mutexattr_init( &attr )) {
+		free( lock );
+		return false;
+	}
+
+	pthread_mutexattr_settype( &attr, PTHREAD_MUTEX_RECURSIVE );
+	int failed = pthread_mutex_init( lock, &attr );
+	pthread_mutexattr_destroy( &attr );
+
+	if ( failed ) {
+		free( lock );
+		return false;
+	}
+
+	r->lock = lock;
+	return true;
+}
+
+
+
+/**
+ * si_useReader - route the calling thread's si_get*() calls to r
+ *
+ * The lock-free alternative to a shared stdin: give every thread its own
+ * reader ( on its own fd, file or memory ) and the plain si_get*() calls
+ * in that thread use it without any locking. NULL goes back to stdin.
+ *
+ * returns the thread's previous default reader
+ */
+si_reader *si_useReader ( si_reader *r ) {
+
+	si_reader *prev = si_current();
+	si_threadReader = ( r == &si_stdinReader ) ? NULL : r;
+	return prev;
+}
+
+
+
+/**
+ * si_reader_readLine - fetch the next line as a view, without retrying
+ *
+ * @line:		receives the line ( not null-terminated, no newline ),
+ * 				valid until the next read from r
+ *
+ * Lines must be shorter than the reader's line limit. Nothing is printed,
+ * which makes this the building block for event-loop consumers.
+ *
+ * Returns:
+ * 		SI_OK 			- on success
+ * 		SI_TOO_LONG		- the line was discarded ( possibly over several calls )
+ * 		SI_WOULD_BLOCK	- no complete line buffered, poll si_reader_fd() and retry
+ * 		SI_EOF			- on EOF, read error or bad arguments
+ */
+hotApi si_result si_reader_readLine ( si_reader *r, si_string *line ) {
+
+	si_guard( r );
+
+	if ( !r || !line ) return SI_EOF;
+
+	const char *p;
+	size_t len;
+
+	si_result status = si_tryLine( r, r->lineLimit, &p, &len );
+	*line = status ? (si_string){ NULL, 0 } : (si_string){ (char *)p, len };
+	return status;
+}
+
+
+
+/**
+ * si_reader_skipLine - discard input up to and including the next newline
+ *
+ * usage - while ( si_reader_tryGetInt( r, &x ) == SI_INVALID ) si_reader_skipLine( r );
+ *
+ * Resynchronises after garbage without copying or validating it: whole
+ * buffered blocks are scanned and dropped, however long the line is. On a
+ * non-blocking reader that runs dry mid-line the skip is remembered, and
+ * the next read ( or skipLine ) carries on to the end of that line.
+ *
+ * returns the number of bytes skipped, newline included, 0 at EOF
+ */
+size_t si_reader_skipLine ( si_reader *r ) {
+
+	si_guard( r );
+
+	if ( !r ) return 0;
+
+	r->blocked = false;
+	return si_drainStdin( r );
+}
+
+
+
+/**
+ * si_reader_getInt - a safer alternative to scanf for integers
+ *
+ * usage - int x = si_reader_getInt( r );
+ * 
+ * returns INT_MIN on error or EOF
+ */
+hotApi int si_reader_getInt ( si_reader *r ) {
+
+	si_guard( r );
+
+	int value;
+	return si_getValue( r, &value, si_tokInt ) ? value : INT_MIN;
+}
+
+
+
+/**
+ * si_reader_getUInt - a safer alternative to scanf for unsigned integers
+ *
+ * usage - unsigned int x = si_reader_getUInt( r );
+ * 
+ * returns UINT_MAX on error or EOF
+ */
+hotApi unsigned int si_reader_getUInt ( si_reader *r ) {
+
+	si_guard( r );
+
+	unsigned int value;
+	return si_getValue( r, &value, si_tokUInt ) ? value : UINT_MAX;
+}
+
+
+
+/**
+ * si_reader_getFloat - a safer alternative to scanf for floating point numbers
+ *
+ * usage - float x = si_reader_getFloat( r );
+ * 
+ * returns NAN on error or EOF
+ */
+hotApi float si_reader_getFloat ( si_reader *r ) {
+
+	si_guard( r );
+
+	float value;
+	return si_getValue( r, &value, si_tokFloat ) ? value : NAN;
+}
+
+
+
+/**
+ * si_reader_getDouble - a safer alternative to scanf for doubles
+ *
+ * usage - double x = si_reader_getDouble( r );
+ * 
+ * returns NAN on error or EOF
+ */
+hotApi double si_reader_getDouble ( si_reader *r ) {
+
+	si_guard( r );
+
+	double value;
+	return si_getValue( r, &value, si_tokDouble ) ? value : NAN;
+}
+
+
+
+/**
+ * si_reader_getLong - a safer alternative to scanf for longs
+ *
+ * usage - long x = si_reader_getLong( r );
+ * 
+ * returns LONG_MIN on error or EOF
+ */
+hotApi long si_reader_getLong ( si_reader *r ) {
+
+	si_guard( r );
+
+	long value;
+	return si_getValue( r, &value, si_tokLong ) ? value : LONG_MIN;
+}
+
+
+
+/**
+ * si_reader_getULong - a safer alternative to scanf for unsigned longs
+ *
+ * usage - unsigned long x = si_reader_getULong( r );
+ * 
+ * returns ULONG_MAX on error or EOF
+ */
+hotApi unsigned long si_reader_getULong ( si_reader *r ) {
+
+	si_guard( r );
+
+	unsigned long value;
+	return si_getValue( r, &value, si_tokULong ) ? value : ULONG_MAX;
+}
+
+
+
+/**
+ * si_reader_getLongLong - a safer alternative to scanf for long longs
+ *
+ * usage - long long x = si_reader_getLongLong( r );
+ * 
+ * returns LLONG_MIN on error or EOF
+ */
+hotApi long long si_reader_getLongLong ( si_reader *r ) {
+
+	si_guard( r );
+
+	long long value;
+	return si_getValue( r, &value, si_tokLongLong ) ? value : LLONG_MIN;
+}
+
+
+
+/**
+ * si_reader_getULongLong - a safer alternative to scanf for unsigned long longs
+ *
+ * usage - unsigned long long x = si_reader_getULongLong( r );
+ * 
+ * returns ULLONG_MAX on error or EOF
+ */
+hotApi unsigned long long si_reader_getULongLong ( si_reader *r ) {
+
+	si_guard( r );
+
+	unsigned long long value;
+	return si_getValue( r, &value, si_tokULongLong ) ? value : ULLONG_MAX;
+}
+
+
+
+/**
+ * si_reader_getChar - a safer alternative to scanf for chars
+ *
+ * usage - int x = si_reader_getChar( r );
+ *
+ * IMPORTANT: Only accepts one character. " a" and "a " are considered invalid.
+ * 
+ * returns EOF on error or EOF
+ */
+hotApi int si_reader_getChar ( si_reader *r ) {
+
+	si_guard( r );
+
+	char buffer[CHAR_INPUT_BUFFER_SIZE];
+	size_t len = 0;
+
+	while ( 1 ) {
+
+		int result = si_readByte( r, buffer, sizeof(buffer) - 1, &len );
+		buffer[len] = '\0';
+
+		if ( result == EOF ) return EOF;
+		if ( result == 1 ) continue;
+		if ( len <= 1 ) {
+			si_count( r, parsed[SI_FIELD_CHAR], 1 );
+			return len ? (unsigned char)buffer[0] : '\n';
+		}
+		si_count( r, rejected[SI_REJECT_SYNTAX], 1 );
+		si_report( r, SI_ERR_INVALID, "Invalid input. Please enter a single character.\n" );
+
+	}
+}
+
+
+
+/**
+ * Character sets
+ *
+ * si_charset is a 256-bit membership bitmap, compiled once from a pattern
+ * and reused: a membership test is a single bit test. The same set is also
+ * kept transposed by nibble ( row lo-nibble, bit hi-nibble & 7, one table
+ * per hi-nibble half ) so si_charset_span() can classify 16 bytes at a time
+ * with two table shuffles.
+ */
+static alwaysInline void si_charsetAdd ( si_charset *cs, unsigned c ) {
+
+	cs->bits[ c >> 6 ] |= 1ull << ( c & 63 );
+}
+
+
+
+/**
+ * si_charset_compile - build a charset from a bracket-style pattern
+ *
+ * @spec:		members, with "a-z" for ranges, a leading '^' to negate the
+ * 				set and '\\' to take the next character literally. A '-' at
+ * 				either end is literal, as is a lone "^".
+ *
+ * usage - si_charset cs; si_charset_compile( &cs, "A-Za-z0-9_" );
+ *
+ * returns false on NULL arguments, an empty spec or a reversed range
+ */
+bool si_charset_compile ( si_charset *cs, const char *spec ) {
+
+	if ( !cs || !spec || !spec[0] ) return false;
+
+	memset( cs, 0, sizeof(*cs) );
+
+	const unsigned char *p = (const unsigned char *)spec;
+	bool negate = false;
+
+	if ( p[0] == '^' && p[1] ) {
+		negate = true;
+		p++;
+	}
+
+	while ( *p ) {
+		unsigned lo = *p++;
+		if ( lo == '\\' && *p ) lo = *p++;
+
+		unsigned hi = lo;
+		if ( p[0] == '-' && p[1] ) {
+			p++;
+			hi = *p++;
+			if ( hi == '\\' && *p ) hi = *p++;
+			if ( hi < lo ) return false;
+		}
+
+		for ( unsigned c = lo; c <= hi; c++ ) si_charsetAdd( cs, c );
+	}
+
+	if ( negate )
+		for ( int i = 0; i < 4; i++ ) cs->bits[i] = ~cs->bits[i];
+
+	for ( unsigned c = 0; c < 256; c++ )
+		if ( si_charset_has( cs, (unsigned char)c ))
+			cs->nibble[ ( c >> 7 ) * 16 + ( c & 15 ) ] |= (unsigned char)( 1u << (( c >> 4 ) & 7 ));
+
+	return true;
+}
+
+
+
+/**
+ * si_charset_span kernels
+ *
+ * Each kernel classifies whole blocks of 16, 32 or 64 bytes and returns the
+ * offset of the first non-member, or where the full blocks ran out; the
+ * caller finishes the tail one byte at a time. On x86 every ISA level is
+ * compiled in with target attributes and the widest one the CPU supports
+ * is picked on first use, so a build without -march still gets AVX2 or
+ * AVX-512 where the host has it. NEON is baseline on AArch64.
+ */
+typedef size_t ( *si_spanKernel )( const si_charset *cs, const char *p, size_t len );
+
+#if defined(SI_X86)
+static size_t si_spanNone ( const si_charset *cs, const char *p, size_t len ) {
+
+	(void)cs; (void)p; (void)len;
+	return 0;
+}
+
+__attribute__(( target( "ssse3" )))
+static size_t si_spanSsse3 ( const si_charset *cs, const char *p, size_t len ) {
+
+	const __m128i t0 = _mm_loadu_si128( (const __m128i *)cs->nibble );
+	const __m128i t1 = _mm_loadu_si128( (const __m128i *)( cs->nibble + 16 ));
+	const __m128i bitpos = _mm_setr_epi8( 1, 2, 4, 8, 16, 32, 64, -128, 1, 2, 4, 8, 16, 32, 64, -128 );
+	const __m128i low4 = _mm_set1_epi8( 0x0F );
+	const __m128i seven = _mm_set1_epi8( 7 );
+	size_t i = 0;
+
+	for ( ; len - i >= 16; i += 16 ) {
+		__m128i v = _mm_loadu_si128( (const __m128i *)( p + i ));
+		__m128i lo = _mm_and_si128( v, low4 );
+		__m128i hi = _mm_and_si128( _mm_srli_epi16( v, 4 ), low4 );
+		__m128i upper = _mm_cmpgt_epi8( hi, seven );
+		__m128i row = _mm_or_si128( _mm_andnot_si128( upper, _mm_shuffle_epi8( t0, lo )),
+									_mm_and_si128( upper, _mm_shuffle_epi8( t1, lo )));
+		__m128i hit = _mm_and_si128( row, _mm_shuffle_epi8( bitpos, hi ));
+		unsigned miss = (unsigned)_mm_movemask_epi8( _mm_cmpeq_epi8( hit, _mm_setzero_si128() ));
+		if ( miss ) return i + (size_t)__builtin_ctz( miss );
+	}
+
+	return i;
+}
+
+// the same with both 128-bit lanes holding the tables ( vpshufb is per lane )
+__attribute__(( target( "avx2" )))
+static size_t si_spanAvx2 ( const si_charset *cs, const char *p, size_t len ) {
+
+	const __m256i t0 = _mm256_broadcastsi128_si256( _mm_loadu_si128( (const __m128i *)cs->nibble ));
+	const __m256i t1 = _mm256_broadcastsi128_si256( _mm_loadu_si128( (const __m128i *)( cs->nibble + 16 )));
+	const __m256i bitpos = _mm256_broadcastsi128_si256( _mm_setr_epi8( 1, 2, 4, 8, 16, 32, 64, -128, 1, 2, 4, 8, 16, 32, 64, -128 ));
+	const __m256i low4 = _mm256_set1_epi8( 0x0F );
+	const __m256i seven = _mm256_set1_epi8( 7 );
+	size_t i = 0;
+
+	for ( ; len - i >= 32; i += 32 ) {
+		__m256i v = _mm256_loadu_si256( (const __m256i *)( p + i ));
+		__m256i lo = _mm256_and_si256( v, low4 );
+		__m256i hi = _mm256_and_si256( _mm256_srli_epi16( v, 4 ), low4 );
+		__m256i upper = _mm256_cmpgt_epi8( hi, seven );
+		__m256i row = _mm256_blendv_epi8( _mm256_shuffle_epi8( t0, lo ), _mm256_shuffle_epi8( t1, lo ), upper );
+		__m256i hit = _mm256_and_si256( row, _mm256_shuffle_epi8( bitpos, hi ));
+		unsigned miss = (unsigned)_mm256_movemask_epi8( _mm256_cmpeq_epi8( hit, _mm256_setzero_si256() ));
+		if ( miss ) return i + (size_t)__builtin_ctz( miss );
+	}
+
+	return i;
+}
+
+__attribute__(( target( "avx512f,avx512bw" )))
+static size_t si_spanAvx512 ( const si_charset *cs, const char *p, size_t len ) {
+
+	const __m512i t0 = _mm512_broadcast_i32x4( _mm_loadu_si128( (const __m128i *)cs->nibble ));
+	const __m512i t1 = _mm512_broadcast_i32x4( _mm_loadu_si128( (const __m128i *)( cs->nibble + 16 )));
+	const __m512i bitpos = _mm512_broadcast_i32x4( _mm_setr_epi8( 1, 2, 4, 8, 16, 32, 64, -128, 1, 2, 4, 8, 16, 32, 64, -128 ));
+	const __m512i low4 = _mm512_set1_epi8( 0x0F );
+	const __m512i seven = _mm512_set1_epi8( 7 );
+	size_t i = 0;
+
+	for ( ; len - i >= 64; i += 64 ) {
+		__m512i v = _mm512_loadu_si512( (const void *)( p + i ));
+		__m512i lo = _mm512_and_si512( v, low4 );
+		__m512i hi = _mm512_and_si512( _mm512_srli_epi16( v, 4 ), low4 );
+		__mmask64 upper = _mm512_cmpgt_epi8_mask( hi, seven );
+		__m512i row = _mm512_mask_blend_epi8( upper, _mm512_shuffle_epi8( t0, lo ), _mm512_shuffle_epi8( t1, lo ));
+		unsigned long long miss = _mm512_testn_epi8_mask( row, _mm512_shuffle_epi8( bitpos, hi ));
+		if ( miss ) return i + (size_t)__builtin_ctzll( miss );
+	}
+
+	return i;
+}
+
+static size_t si_spanResolve ( const si_charset *cs, const char *p, size_t len );
+
+static si_spanKernel si_spanImpl = si_spanResolve;
+
+// first call: pick the widest kernel this CPU runs, then go straight to it
+static size_t si_spanResolve ( const si_charset *cs, const char *p, size_t len ) {
+
+	si_spanKernel k = si_spanNone;
+
+	__builtin_cpu_init();
+	if ( __builtin_cpu_supports( "avx512f" ) && __builtin_cpu_supports( "avx512bw" )) k = si_spanAvx512;
+	else if ( __builtin_cpu_supports( "avx2" )) k = si_spanAvx2;
+	else if ( __builtin_cpu_supports( "ssse3" )) k = si_spanSsse3;
+
+	__atomic_store_n( &si_spanImpl, k, __ATOMIC_RELAXED );
+	return k( cs, p, len );
+}
+
+static alwaysInline size_t si_spanBlocks ( const si_charset *cs, const char *p, size_t len ) {
+
+	return __atomic_load_n( &si_spanImpl, __ATOMIC_RELAXED )( cs, p, len );
+}
+#elif defined(__aarch64__)
+static alwaysInline size_t si_spanBlocks ( const si_charset *cs, const char *p, size_t len ) {
+
+	static const uint8_t bitTable[16] = { 1, 2, 4, 8, 16, 32, 64, 128, 1, 2, 4, 8, 16, 32, 64, 128 };
+	const uint8x16_t t0 = vld1q_u8( cs->nibble );
+	const uint8x16_t t1 = vld1q_u8( cs->nibble + 16 );
+	const uint8x16_t bitpos = vld1q_u8( bitTable );
+	size_t i = 0;
+
+	for ( ; len - i >= 16; i += 16 ) {
+		uint8x16_t v = vld1q_u8( (const uint8_t *)p + i );
+		uint8x16_t lo = vandq_u8( v, vdupq_n_u8( 0x0F ));
+		uint8x16_t hi = vshrq_n_u8( v, 4 );
+		uint8x16_t row = vbslq_u8( vcgtq_u8( hi, vdupq_n_u8( 7 )), vqtbl1q_u8( t1, lo ), vqtbl1q_u8( t0, lo ));
+		uint8x16_t miss = vceqq_u8( vandq_u8( row, vqtbl1q_u8( bitpos, hi )), vdupq_n_u8( 0 ));
+		uint64_t mask = vget_lane_u64( vreinterpret_u64_u8( vshrn_n_u16( vreinterpretq_u16_u8( miss ), 4 )), 0 );
+		if ( mask ) return i + ( __builtin_ctzll( mask ) >> 2 );
+	}
+
+	return i;
+}
+#else
+static alwaysInline size_t si_spanBlocks ( const si_charset *cs, const char *p, size_t len ) {
+
+	(void)cs; (void)p; (void)len;
+	return 0;
+}
+#endif
+
+
+
+/**
+ * si_charset_span - length of the longest prefix of [p, p + len) made up
+ * 					 only of members of cs ( strspn() for a compiled set )
+ *
+ * A whole span is valid when the result equals len.
+ */
+size_t si_charset_span ( const si_charset *cs, const char *p, size_t len ) {
+
+	if ( !cs || !p ) return 0;
+
+	size_t i = len >= 16 ? si_spanBlocks( cs, p, len ) : 0;
+
+	for ( ; i < len; i++ )
+		if ( !si_charset_has( cs, (unsigned char)p[i] )) break;
+
+	return i;
+}
+
+
+
+/**
+ * UTF-8 validation
+ *
+ * The vector kernels use the lookup method of simdutf / simdjson ( Keiser
+ * and Lemire, "Validating UTF-8 in less than one instruction per byte" ):
+ * three nibble-indexed tables classify every byte together with the one
+ * before it, so a block of 16 needs a handful of shuffles and no branches,
+ * and an all-ASCII block only a movemask. A lead byte's missing or extra
+ * continuations fall out of the same tables, the 3rd and 4th bytes of
+ * long sequences are checked with two saturating subtracts.
+ *
+ * In line mode the kernel also looks for the newline in every block it
+ * validates and stops there, so a line is found and checked in one pass;
+ * bytes from the newline on are cleared to ASCII first, which both hides
+ * the next line and turns a sequence cut off by the newline into an error.
+ * The tables are shared by the SSSE3 and NEON kernels; wider vectors don't
+ * pay off for lines of a few dozen bytes, the common case here.
+ */
+#define SI_U8_TOO_SHORT		0x01	// lead not followed by enough continuations
+#define SI_U8_TOO_LONG		0x02	// continuation without a lead
+#define SI_U8_OVERLONG_3	0x04	// E0 80..9F
+#define SI_U8_TOO_LARGE		0x08	// above U+10FFFF, F4 90.. and up
+#define SI_U8_SURROGATE		0x10	// ED A0..BF
+#define SI_U8_OVERLONG_2	0x20	// C0 / C1
+#define SI_U8_TOO_LARGE_1000	0x40	// F5.. 80..8F
+#define SI_U8_OVERLONG_4	0x40	// F0 80..8F
+#define SI_U8_TWO_CONTS		0x80	// continuation after a continuation
+#define SI_U8_CARRY			( SI_U8_TOO_SHORT | SI_U8_TOO_LONG | SI_U8_TWO_CONTS )
+#define SI_U8_BIG			( SI_U8_CARRY | SI_U8_TOO_LARGE | SI_U8_TOO_LARGE_1000 )
+
+// indexed by the high nibble of the previous byte
+static const uint8_t si_utf8Byte1High[16] __attribute__(( aligned( 16 ), unused )) = {
+	SI_U8_TOO_LONG, SI_U8_TOO_LONG, SI_U8_TOO_LONG, SI_U8_TOO_LONG,
+	SI_U8_TOO_LONG, SI_U8_TOO_LONG, SI_U8_TOO_LONG, SI_U8_TOO_LONG,
+	SI_U8_TWO_CONTS, SI_U8_TWO_CONTS, SI_U8_TWO_CONTS, SI_U8_TWO_CONTS,
+	SI_U8_TOO_SHORT | SI_U8_OVERLONG_2,
+	SI_U8_TOO_SHORT,
+	SI_U8_TOO_SHORT | SI_U8_OVERLONG_3 | SI_U8_SURROGATE,
+	SI_U8_TOO_SHORT | SI_U8_TOO_LARGE | SI_U8_TOO_LARGE_1000 | SI_U8_OVERLONG_4,
+};
+
+// indexed by the low nibble of the previous byte
+static const uint8_t si_utf8Byte1Low[16] __attribute__(( aligned( 16 ), unused )) = {
+	SI_U8_CARRY | SI_U8_OVERLONG_3 | SI_U8_OVERLONG_2 | SI_U8_OVERLONG_4,
+	SI_U8_CARRY | SI_U8_OVERLONG_2,
+	SI_U8_CARRY, SI_U8_CARRY,
+	SI_U8_CARRY | SI_U8_TOO_LARGE,
+	SI_U8_BIG, SI_U8_BIG, SI_U8_BIG,
+	SI_U8_BIG, SI_U8_BIG, SI_U8_BIG, SI_U8_BIG, SI_U8_BIG,
+	SI_U8_BIG | SI_U8_SURROGATE,
+	SI_U8_BIG, SI_U8_BIG,
+};
+
+// indexed by the high nibble of the byte itself
+static const uint8_t si_utf8Byte2High[16] __attribute__(( aligned( 16 ), unused )) = {
+	SI_U8_TOO_SHORT, SI_U8_TOO_SHORT, SI_U8_TOO_SHORT, SI_U8_TOO_SHORT,
+	SI_U8_TOO_SHORT, SI_U8_TOO_SHORT, SI_U8_TOO_SHORT, SI_U8_TOO_SHORT,
+	SI_U8_TOO_LONG | SI_U8_OVERLONG_2 | SI_U8_TWO_CONTS | SI_U8_OVERLONG_3 | SI_U8_TOO_LARGE_1000 | SI_U8_OVERLONG_4,
+	SI_U8_TOO_LONG | SI_U8_OVERLONG_2 | SI_U8_TWO_CONTS | SI_U8_OVERLONG_3 | SI_U8_TOO_LARGE,
+	SI_U8_TOO_LONG | SI_U8_OVERLONG_2 | SI_U8_TWO_CONTS | SI_U8_SURROGATE | SI_U8_TOO_LARGE,
+	SI_U8_TOO_LONG | SI_U8_OVERLONG_2 | SI_U8_TWO_CONTS | SI_U8_SURROGATE | SI_U8_TOO_LARGE,
+	SI_U8_TOO_SHORT, SI_U8_TOO_SHORT, SI_U8_TOO_SHORT, SI_U8_TOO_SHORT,
+};
+
+// a lead this close to the end of a block still owes bytes to the next one
+static const uint8_t si_utf8OpenTail[16] __attribute__(( aligned( 16 ), unused )) = {
+	255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 0xF0 - 1, 0xE0 - 1, 0xC0 - 1,
+};
+
+/**
+ * si_utf8Kernel - validate [p, p + len), in line mode only up to the first '\n'
+ *
+ * @bad:		set if the bytes validated are not well-formed UTF-8
+ *
+ * returns the offset of the newline in line mode, len if there is none
+ * 		   ( *bad is then meaningless, the caller has no line yet )
+ */
+typedef size_t ( *si_utf8Kernel )( const char *p, size_t len, bool lines, bool *bad );
+
+/**
+ * si_utf8Scalar - byte at a time validation, 8 ASCII bytes per step
+ */
+static bool si_utf8Scalar ( const unsigned char *p, size_t len ) {
+
+	size_t i = 0;
+
+	while ( i < len ) {
+
+		uint64_t word;
+		if ( len - i >= 8 && ( memcpy( &word, p + i, 8 ), !( word & 0x8080808080808080ull ))) {
+			i += 8;
+			continue;
+		}
+
+		unsigned c = p[i], more;
+		if ( c < 0x80 ) {
+			i++;
+			continue;
+		}
+		else if ( c >= 0xC2 && c <= 0xDF ) more = 1;
+		else if ( c >= 0xE0 && c <= 0xEF ) more = 2;
+		else if ( c >= 0xF0 && c <= 0xF4 ) more = 3;
+		else return false;
+
+		if ( len - i <= more ) return false;
+
+		unsigned c1 = p[i + 1];
+		if (( c == 0xE0 && c1 < 0xA0 ) || ( c == 0xED && c1 > 0x9F ) ||
+			( c == 0xF0 && c1 < 0x90 ) || ( c == 0xF4 && c1 > 0x8F )) return false;
+
+		for ( unsigned k = 1; k <= more; k++ )
+			if (( p[i + k] & 0xC0 ) != 0x80 ) return false;
+
+		i += more + 1;
+	}
+
+	return true;
+}
+
+static __attribute__(( unused )) size_t si_utf8ScalarLines ( const char *p, size_t len, bool lines, bool *bad ) {
+
+	const char *nl = lines ? memchr( p, '\n', len ) : NULL;
+	size_t n = nl ? (size_t)( nl - p ) : len;
+
+	*bad = !si_utf8Scalar( (const unsigned char *)p, n );
+	return n;
+}
+
+#if defined(SI_X86)
+__attribute__(( target( "ssse3" )))
+static size_t si_utf8Ssse3 ( const char *p, size_t len, bool lines, bool *bad ) {
+
+	const __m128i b1h = _mm_load_si128( (const __m128i *)si_utf8Byte1High );
+	const __m128i b1l = _mm_load_si128( (const __m128i *)si_utf8Byte1Low );
+	const __m128i b2h = _mm_load_si128( (const __m128i *)si_utf8Byte2High );
+	const __m128i tail = _mm_load_si128( (const __m128i *)si_utf8OpenTail );
+	const __m128i low4 = _mm_set1_epi8( 0x0F );
+	const __m128i index = _mm_setr_epi8( 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15 );
+	__m128i prev = _mm_setzero_si128(), open = _mm_setzero_si128(), err = _mm_setzero_si128();
+	size_t i = 0, stop = len;
+	bool wide = false;
+
+	for ( ; i < len; i += 16 ) {
+
+		__m128i v;
+		if ( len - i >= 16 ) v = _mm_loadu_si128( (const __m128i *)( p + i ));
+		else {
+			// zero padding reads as ASCII
+			char last[16] = { 0 };
+			memcpy( last, p + i, len - i );
+			v = _mm_loadu_si128( (const __m128i *)last );
+		}
+
+		unsigned nl = lines ? (unsigned)_mm_movemask_epi8( _mm_cmpeq_epi8( v, _mm_set1_epi8( '\n' ))) : 0;
+		if ( nl ) {
+			stop = i + (size_t)__builtin_ctz( nl );
+			v = _mm_and_si128( v, _mm_cmpgt_epi8( _mm_set1_epi8( (char)__builtin_ctz( nl )), index ));
+		}
+
+		// ASCII blocks take the shortcut until the first that isn't, then a
+		// line of mixed text is checked branch-free to the end, as its
+		// ASCII / non-ASCII pattern would defeat the branch predictor
+		if ( wide || ( wide = _mm_movemask_epi8( v ) != 0 )) {
+			__m128i prev1 = _mm_alignr_epi8( v, prev, 15 );
+			__m128i special = _mm_and_si128( _mm_and_si128(
+				_mm_shuffle_epi8( b1h, _mm_and_si128( _mm_srli_epi16( prev1, 4 ), low4 )),
+				_mm_shuffle_epi8( b1l, _mm_and_si128( prev1, low4 ))),
+				_mm_shuffle_epi8( b2h, _mm_and_si128( _mm_srli_epi16( v, 4 ), low4 )));
+			__m128i third = _mm_subs_epu8( _mm_alignr_epi8( v, prev, 14 ), _mm_set1_epi8( (char)( 0xE0 - 0x80 )));
+			__m128i fourth = _mm_subs_epu8( _mm_alignr_epi8( v, prev, 13 ), _mm_set1_epi8( (char)( 0xF0 - 0x80 )));
+			__m128i must23 = _mm_and_si128( _mm_or_si128( third, fourth ), _mm_set1_epi8( (char)0x80 ));
+			err = _mm_or_si128( err, _mm_xor_si128( must23, special ));
+			open = _mm_subs_epu8( v, tail );
+		}
+		else err = _mm_or_si128( err, open );
+
+		prev = v;
+		if ( nl ) break;
+	}
+
+	err = _mm_or_si128( err, open );
+	*bad = _mm_movemask_epi8( _mm_cmpeq_epi8( err, _mm_setzero_si128() )) != 0xFFFF;
+	return stop;
+}
+
+static size_t si_utf8Resolve ( const char *p, size_t len, bool lines, bool *bad );
+
+static si_utf8Kernel si_utf8Impl = si_utf8Resolve;
+
+// first call: SSSE3 where the CPU has it, the scalar loop otherwise
+static size_t si_utf8Resolve ( const char *p, size_t len, bool lines, bool *bad ) {
+
+	si_utf8Kernel k = si_utf8ScalarLines;
+
+	__builtin_cpu_init();
+	if ( __builtin_cpu_supports( "ssse3" )) k = si_utf8Ssse3;
+
+	__atomic_store_n( &si_utf8Impl, k, __ATOMIC_RELAXED );
+	return k( p, len, lines, bad );
+}
+
+static alwaysInline size_t si_utf8Blocks ( const char *p, size_t len, bool lines, bool *bad ) {
+
+	return __atomic_load_n( &si_utf8Impl, __ATOMIC_RELAXED )( p, len, lines, bad );
+}
+#elif defined(__aarch64__)
+static size_t si_utf8Neon ( const char *p, size_t len, bool lines, bool *bad ) {
+
+	static const uint8_t indexTable[16] = { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15 };
+	const uint8x16_t b1h = vld1q_u8( si_utf8Byte1High );
+	const uint8x16_t b1l = vld1q_u8( si_utf8Byte1Low );
+	const uint8x16_t b2h = vld1q_u8( si_utf8Byte2High );
+	const uint8x16_t tail = vld1q_u8( si_utf8OpenTail );
+	const uint8x16_t low4 = vdupq_n_u8( 0x0F );
+	const uint8x16_t index = vld1q_u8( indexTable );
+	uint8x16_t prev = vdupq_n_u8( 0 ), open = vdupq_n_u8( 0 ), err = vdupq_n_u8( 0 );
+	size_t i = 0, stop = len;
+	bool wide = false;
+
+	for ( ; i < len; i += 16 ) {
+
+		uint8x16_t v;
+		if ( len - i >= 16 ) v = vld1q_u8( (const uint8_t *)p + i );
+		else {
+			uint8_t last[16] = { 0 };
+			memcpy( last, p + i, len - i );
+			v = vld1q_u8( last );
+		}
+
+		uint64_t nl = 0;
+		if ( lines ) {
+			uint8x16_t eq = vceqq_u8( v, vdupq_n_u8( '\n' ));
+			nl = vget_lane_u64( vreinterpret_u64_u8( vshrn_n_u16( vreinterpretq_u16_u8( eq ), 4 )), 0 );
+		}
+		if ( nl ) {
+			unsigned k = (unsigned)__builtin_ctzll( nl ) >> 2;
+			stop = i + k;
+			v = vandq_u8( v, vcltq_u8( index, vdupq_n_u8( (uint8_t)k )));
+		}
+
+		if ( wide || ( wide = vmaxvq_u8( v ) >= 0x80 )) {
+			uint8x16_t prev1 = vextq_u8( prev, v, 15 );
+			uint8x16_t special = vandq_u8( vandq_u8(
+				vqtbl1q_u8( b1h, vshrq_n_u8( prev1, 4 )),
+				vqtbl1q_u8( b1l, vandq_u8( prev1, low4 ))),
+				vqtbl1q_u8( b2h, vshrq_n_u8( v, 4 )));
+			uint8x16_t third = vqsubq_u8( vextq_u8( prev, v, 14 ), vdupq_n_u8( 0xE0 - 0x80 ));
+			uint8x16_t fourth = vqsubq_u8( vextq_u8( prev, v, 13 ), vdupq_n_u8( 0xF0 - 0x80 ));
+			uint8x16_t must23 = vandq_u8( vorrq_u8( third, fourth ), vdupq_n_u8( 0x80 ));
+			err = vorrq_u8( err, veorq_u8( must23, special ));
+			open = vqsubq_u8( v, tail );
+		}
+		else err = vorrq_u8( err, open );
+
+		prev = v;
+		if ( nl ) break;
+	}
+
+	*bad = vmaxvq_u8( vorrq_u8( err, open )) != 0;
+	return stop;
+}
+
+static alwaysInline size_t si_utf8Blocks ( const char *p, size_t len, bool lines, bool *bad ) {
+
+	return si_utf8Neon( p, len, lines, bad );
+}
+#else
+static alwaysInline size_t si_utf8Blocks ( const char *p, size_t len, bool lines, bool *bad ) {
+
+	return si_utf8ScalarLines( p, len, lines, bad );
+}
+#endif
+
+
+
+/**
+ * si_utf8_valid - true if [p, p + len) is well-formed UTF-8
+ *
+ * Rejects overlong forms, surrogates, code points above U+10FFFF and
+ * truncated sequences, as RFC 3629 requires. NUL bytes are valid ( U+0000 ).
+ */
+bool si_utf8_valid ( const char *p, size_t len ) {
+
+	bool bad;
+
+	if ( !p ) return len == 0;
+	si_utf8Blocks( p, len, false, &bad );
+	return !bad;
+}
+
+
+
+/**
+ * si_reader_getCharIn - si_reader_getCharFiltered() with a compiled charset
+ *
+ * usage - int c = si_reader_getCharIn( r, &menu );
+ *
+ * returns EOF on EOF
+ */
+int si_reader_getCharIn ( si_reader *r, const si_charset *cs ) {
+
+	si_guard( r );
+
+	if ( !cs ) {
+		si_report( r, SI_ERR_USAGE, "ERROR: NULL passed to 'cs'.\n" );
+		exit(EXIT_FAILURE);
+	}
+
+	const char *line;
+	size_t len;
+
+	while ( 1 ) {
+
+		int result = si_readLine( r, CHAR_INPUT_BUFFER_SIZE - 1, &line, &len );
+
+		if ( result == EOF ) return EOF;
+		if ( result == 1 ) continue;
+
+		// Ensure input is exactly one character
+		if ( len != 1 ) {
+			si_count( r, rejected[SI_REJECT_SYNTAX], 1 );
+			si_report( r, SI_ERR_INVALID, "Invalid input. Please enter a single character.\n" );
+			continue;
+		}
+
+		if ( si_charset_has( cs, (unsigned char)line[0] )) {
+			si_count( r, parsed[SI_FIELD_CHAR], 1 );
+			return (unsigned char)line[0];
+		}
+
+		si_count( r, rejected[SI_REJECT_CHOICE], 1 );
+		si_report( r, SI_ERR_INVALID, "Invalid input. Character not allowed.\n" );
+	}
+}
+
+
+
+/**
+ * si_reportAllowed - report a character outside the allowed set
+ *
+ * Very long allowed sets are cut short with "..." in the message.
+ */
+static cold void si_reportAllowed ( si_reader *r, const char *allowed ) {
+
+	char msg[256];
+	int n = snprintf( msg, sizeof(msg), "Invalid input. Allowed: %s\n", allowed );
+	if ( n >= (int)sizeof(msg) ) memcpy( msg + sizeof(msg) - 5, "...\n", 5 );
+	si_report( r, SI_ERR_INVALID, msg );
+}
+
+
+
+/**
+ * si_reader_getCharFiltered - a safer alternative to scanf for chars
+ *
+ * usage - int x = si_reader_getCharFiltered( r, "abc" );
+ * 
+ * returns EOF on error or EOF
+ */
+int si_reader_getCharFiltered ( si_reader *r, const char *allowed ) {
+
+	si_guard( r );
+
+	if ( !allowed ){
+		si_report( r, SI_ERR_USAGE, "ERROR: NULL passed to 'allowed'.\n" );
+		exit(EXIT_FAILURE);
+	}
+
+	if ( allowed[0] == '\0' ) {
+		si_report( r, SI_ERR_USAGE, "No allowed characters specified. Exiting.\n" );
+		return 1;
+	}
+
+	char buffer[CHAR_INPUT_BUFFER_SIZE];
+	size_t len = 0;
+
+	while ( 1 ) {
+
+		int result = si_readByte( r, buffer, sizeof(buffer) - 1, &len );
+		buffer[len] = '\0';
+		
+		if ( result == EOF ) return EOF;
+		if ( result == 1 ) continue;
+		
+		// Ensure input is exactly one character
+		if ( len != 1 ) {
+			si_count( r, rejected[SI_REJECT_SYNTAX], 1 );
+			si_report( r, SI_ERR_INVALID, "Invalid input. Please enter a single character.\n" );
+			continue;
+		}
+
+		char c = buffer[0];
+
+		if ( strchr( allowed, c ) != NULL ) {
+			si_count( r, parsed[SI_FIELD_CHAR], 1 );
+			return (unsigned char)c;
+		}
+	
+		si_count( r, rejected[SI_REJECT_CHOICE], 1 );
+		si_reportAllowed( r, allowed );
+		
+	}
+}
+
+
+
+/**
+ * Allocators
+ *
+ * The string getters allocate through the reader's si_allocator, which
+ * defaults to malloc()/free(). si_arena is a bump allocator meant to be
+ * plugged in there: thousands of strings cost a pointer bump each and are
+ * all released by one si_arena_reset().
+ */
+#define SI_ARENA_CHUNK	( 64 * 1024 )
+#define SI_ARENA_ALIGN	16
+
+typedef struct si_arenaChunk {
+	struct si_arenaChunk	*next;
+	size_t					size;	// usable bytes in data
+	size_t					used;
+	unsigned char			data[];
+} si_arenaChunk;
+
+struct si_arena {
+	si_arenaChunk	*head;
+	si_arenaChunk	*current;	// first chunk that may still have room
+	size_t			chunkSize;
+};
+
+
+
+/**
+ * si_alloc - allocate through the reader's allocator
+ */
+static alwaysInline void *si_alloc ( const si_allocator *a, size_t size ) {
+
+	return a->alloc ? a->alloc( a->ctx, size ) : malloc( size );
+}
+
+
+
+/**
+ * si_arenaNewChunk - malloc a chunk with room for at least size aligned bytes
+ */
+static cold si_arenaChunk *si_arenaNewChunk ( size_t chunkSize, size_t size ) {
+
+	if ( size > SIZE_MAX - sizeof(si_arenaChunk) - SI_ARENA_ALIGN ) return NULL;
+
+	size_t want = size + SI_ARENA_ALIGN > chunkSize ? size + SI_ARENA_ALIGN : chunkSize;
+	si_arenaChunk *c = malloc( sizeof(*c) + want );
+	if ( !c ) return NULL;
+
+	c->next = NULL;
+	c->size = want;
+	c->used = 0;
+	return c;
+}
+
+
+
+/**
+ * si_arena_create - create a bump arena that allocates in chunkSize blocks
+ *
+ * @chunkSize:	bytes per chunk, 0 for the 64 KiB default
+ *
+ * NOTE:	an arena is not thread-safe, give each worker its own.
+ *
+ * returns NULL on allocation failure
+ */
+si_arena *si_arena_create ( size_t chunkSize ) {
+
+	si_arena *a = malloc( sizeof(*a) );
+	if ( !a ) return NULL;
+
+	a->chunkSize = chunkSize ? chunkSize : SI_ARENA_CHUNK;
+	a->head = a->current = si_arenaNewChunk( a->chunkSize, 0 );
+	if ( !a->head ) {
+		free( a );
+		return NULL;
+	}
+
+	return a;
+}
+
+
+
+/**
+ * si_arena_alloc - bump-allocate size bytes, aligned to SI_ARENA_ALIGN
+ *
+ * Memory stays valid until the next si_arena_reset() or si_arena_destroy().
+ *
+ * returns NULL on allocation failure
+ */
+void *si_arena_alloc ( si_arena *a, size_t size ) {
+
+	if ( !a ) return NULL;
+
+	si_arenaChunk *c = a->current;
+
+	while ( 1 ) {
+		uintptr_t base = (uintptr_t)c->data;
+		uintptr_t at = ( base + c->used + SI_ARENA_ALIGN - 1 ) & ~(uintptr_t)( SI_ARENA_ALIGN - 1 );
+		size_t offset = (size_t)( at - base );
+
+		if ( offset <= c->size && size <= c->size - offset ) {
+			c->used = offset + size;
+			a->current = c;
+			return c->data + offset;
+		}
+
+		if ( !c->next ) break;
+		c = c->next;
+	}
+
+	c->next = si_arenaNewChunk( a->chunkSize, size );
+	if ( !c->next ) return NULL;
+
+	c = a->current = c->next;
+	uintptr_t base = (uintptr_t)c->data;
+	size_t offset = (size_t)((( base + SI_ARENA_ALIGN - 1 ) & ~(uintptr_t)( SI_ARENA_ALIGN - 1 )) - base );
+	c->used = offset + size;
+	return c->data + offset;
+}
+
+
+
+/**
+ * si_arena_reset - release everything allocated from the arena at once
+ *
+ * The chunks are kept for reuse, so a steady workload stops calling malloc.
+ */
+void si_arena_reset ( si_arena *a ) {
+
+	if ( !a ) return;
+
+	for ( si_arenaChunk *c = a->head; c; c = c->next ) c->used = 0;
+	a->current = a->head;
+}
+
+
+
+/**
+ * si_arena_destroy - free the arena and all of its chunks
+ */
+void si_arena_destroy ( si_arena *a ) {
+
+	if ( !a ) return;
+
+	si_arenaChunk *c = a->head;
+	while ( c ) {
+		si_arenaChunk *next = c->next;
+		free( c );
+		c = next;
+	}
+
+	free( a );
+}
+
+
+
+static void *si_arenaAllocHook ( void *ctx, size_t size ) {
+
+	return si_arena_alloc( ctx, size );
+}
+
+
+
+/**
+ * si_arena_allocator - an si_allocator that allocates from the arena
+ *
+ * Its free hook is NULL: individual strings are never freed, only reset.
+ */
+si_allocator si_arena_allocator ( si_arena *a ) {
+
+	return (si_allocator){ si_arenaAllocHook, NULL, a };
+}
+
+
+
+/**
+ * si_reader_setAllocator - select the allocator used by the reader's string getters
+ *
+ * @a:			allocator to copy, or NULL to go back to malloc()/free().
+ * 				a->free may be NULL when the memory is released in bulk.
+ *
+ * returns false on a NULL reader or an allocator without an alloc hook
+ */
+bool si_reader_setAllocator ( si_reader *r, const si_allocator *a ) {
+
+	if ( !r || ( a && !a->alloc )) return false;
+
+	r->alloc = a ? *a : (si_allocator){ NULL, NULL, NULL };
+	return true;
+}
+
+
+
+/**
+ * si_reader_release - free a string returned by one of the reader's getters
+ *
+ * Goes through the reader's allocator, so it is free() by default and a
+ * no-op for allocators without a free hook.
+ */
+void si_reader_release ( si_reader *r, void *ptr ) {
+
+	if ( !r || !ptr ) return;
+
+	if ( r->alloc.free ) r->alloc.free( r->alloc.ctx, ptr );
+	else if ( !r->alloc.alloc ) free( ptr );
+}
+
+
+
+/**
+ * si_reader_getCString - allocates and returns a line of user input from a reader
+ *
+ * NOTE: 	Caller must free the returned string!!!
+ * 			( si_reader_release() if the reader has a custom allocator )
+ * 
+ *
+ * safe usage example
+ * 
+ *
+ *	char *input = si_reader_getCString( r );
+ *
+ *	if (!input) fputs( "Failed to read input. Try again.\n", stderr );
+ *	else {
+ *		printf("You entered: %s\n", input);
+ *		free(input);
+ *		input = NULL;
+ *	}
+ *
+ * NOTE: 	we use memcpy() because it copies exactly len bytes from the reader's
+ *			buffer before terminating, avoiding overflow and termination issues.
+ * 			the overhead is minimal, memcpy() is well optimized.
+ * 
+ * returns NULL on error or EOF
+ */
+char *si_reader_getCString ( si_reader *r ) {
+
+	si_guard( r );
+
+	if ( !r ) return NULL;
+
+	// one byte less than si_getString, as with the original fixed buffer
+	return si_reader_getCStringMax( r, r->lineLimit - 2 );
+}
+
+
+
+/**
+ * si_reader_getCStringMax - si_reader_getCString() for lines of up to max bytes
+ *
+ * Longer lines are drained and rejected, max is capped at SI_LINE_MAX - 1.
+ * The returned buffer is max + 1 bytes at most.
+ */
+char *si_reader_getCStringMax ( si_reader *r, size_t max ) {
+
+	si_guard( r );
+
+	const char *line;
+	size_t len;
+
+	// read input (return NULL on error/EOF )
+	if ( si_readLine( r, si_maxToLimit( max ), &line, &len )) return NULL;
+
+	// Allocate memory for string( length + 1 for null terminator )
+	char *str = si_alloc( &r->alloc, len+1 );
+	// Check for allocation failure
+	if ( !str ) {
+		si_report( r, SI_ERR_NOMEM, "Memory allocation failed.\n" );
+		return NULL;
+	}
+
+	si_count( r, parsed[SI_FIELD_STRING], 1 );
+	si_count( r, allocs, 1 );
+	si_count( r, allocBytes, len + 1 );
+
+	// copy the line straight out of the reader and terminate it
+	memcpy( str, line, len );
+	str[len] = '\0';
+	return str;
+}
+
+
+
+
+
+
+/**
+ * si_reader_getString - reads a line from a reader into a heap-allocated si_string
+ * 
+ * NOTE: 	Caller is responsible for freeing the returned buffer:
+ * 			free(str.data);
+ * 			( si_reader_release() if the reader has a custom allocator )
+ * 
+ * Safe usage example:
+ * 
+ * 		si_string str = si_reader_getString( r );
+ *
+ *		if (!str.data) return;
+ *		printf("%.*s", (int)str.len, str.data)
+ *		free(str.data);
+ *		str.data = NULL;
+ *
+ * NOTE: 	Uses si_reader_retainString() to copy exactly len bytes from the reader
+ * 			No null terminator is appended-use the length field for safe access.
+ * 
+ * Returns:
+ * 		A si_string with .data == NULL and .len == 0 on error or EOF,
+ * 		otherwise .data points to malloc( len ? len : 1 ) and .len is the byte count.
+ */
+si_string si_reader_getString ( si_reader *r ) {
+
+	si_guard( r );
+
+	// read input ( returns { NULL, 0 } on error/EOF ), then copy it out
+	return si_reader_retainString( r, si_reader_getStringView( r ));
+}
+
+
+
+/**
+ * si_reader_getStringMax - si_reader_getString() for lines of up to max bytes
+ *
+ * Longer lines are drained and rejected, max is capped at SI_LINE_MAX - 1.
+ */
+si_string si_reader_getStringMax ( si_reader *r, size_t max ) {
+
+	si_guard( r );
+
+	return si_reader_retainString( r, si_reader_getStringViewMax( r, max ));
+}
+
+
+
+/**
+ * si_reader_getStringView - reads a line as a view into the reader's buffer
+ *
+ * Zero-copy variant of si_reader_getString(): nothing is allocated and
+ * nothing needs to be freed.
+ *
+ * NOTE: 	The view is only valid until the next read from the same reader,
+ * 			and must not be written through. Use si_retainString() to keep it.
+ *
+ * Safe usage example:
+ *
+ * 		si_string line = si_reader_getStringView( r );
+ *
+ *		if (!line.data) return;
+ *		printf("%.*s", (int)line.len, line.data);
+ *
+ * Returns:
+ * 		A si_string with .data == NULL and .len == 0 on error or EOF,
+ * 		otherwise .data points into the reader and .len is the byte count.
+ */
+hotApi si_string si_reader_getStringView ( si_reader *r ) {
+
+	si_guard( r );
+
+	if ( !r ) return (si_string){ NULL, 0 };
+	return si_reader_getStringViewMax( r, r->lineLimit - 1 );
+}
+
+
+
+/**
+ * si_reader_getStringViewMax - si_reader_getStringView() for lines of up to max bytes
+ *
+ * Longer lines are drained and rejected, max is capped at SI_LINE_MAX - 1.
+ */
+hotApi si_string si_reader_getStringViewMax ( si_reader *r, size_t max ) {
+
+	si_guard( r );
+
+	const char *line;
+	size_t len;
+
+	if ( si_readLine( r, si_maxToLimit( max ), &line, &len )) return (si_string){ NULL, 0 };
+
+	si_count( r, parsed[SI_FIELD_STRING], 1 );
+	return (si_string){ (char *)line, len };
+}
+
+
+
+/**
+ * si_copyString - copy a view into memory from r's allocator ( malloc if r is NULL )
+ */
+static si_string si_copyString ( si_reader *r, si_string view ) {
+
+	static const si_allocator heap = { NULL, NULL, NULL };
+
+	if ( !view.data ) return (si_string){ NULL, 0 };
+
+	// Allocate memory for string data, length is stored in len parameter
+	si_string str;
+	str.data = si_alloc( r ? &r->alloc : &heap, view.len ? view.len : 1 );
+	if ( !str.data ) {
+		si_report( r, SI_ERR_NOMEM, "Memory allocation failed.\n" );
+		return (si_string){ NULL, 0 };
+	}
+
+	if ( r ) {
+		si_count( r, allocs, 1 );
+		si_count( r, allocBytes, view.len ? view.len : 1 );
+	}
+
+	// copy the view to string data
+	memcpy( str.data, view.data, view.len );
+	str.len = view.len;
+	return str;
+}
+
+
+
+/**
+ * si_retainString - copy a view into a heap-allocated si_string
+ *
+ * NOTE: 	Caller is responsible for freeing the returned buffer:
+ * 			free(str.data);
+ *
+ * Returns:
+ * 		A si_string with .data == NULL and .len == 0 if view.data is NULL or
+ * 		allocation fails, otherwise .data points to malloc( len ? len : 1 ).
+ */
+si_string si_retainString ( si_string view ) {
+
+	return si_copyString( NULL, view );
+}
+
+
+
+/**
+ * si_reader_retainString - si_retainString() through the reader's allocator
+ *
+ * Release the result with si_reader_release( r, str.data ).
+ */
+si_string si_reader_retainString ( si_reader *r, si_string view ) {
+
+	if ( !r ) return (si_string){ NULL, 0 };
+	return si_copyString( r, view );
+}
+
+
+
+/**
+ * si_reader_getBool - a safer alternative to scanf for boolean values
+ *
+ * Accepts "y" or "n" (case-insensitive).
+ *
+ * usage - bool x = si_reader_getBool( r );
+ * 
+ * returns false on EOF. Terrible solution but it's the best i could figure out.
+ */
+bool si_reader_getBool ( si_reader *r ) {
+
+	si_guard( r );
+
+	while ( 1 ) {
+		// Read single character, convert to lowercase
+		int c = si_reader_getChar( r );
+
+		if ( c == EOF ) {
+			si_report( r, SI_ERR_EOF, "EOF detected. Returning false by default.\n" );
+			return false;
+		}
+
+		// we avoid using tolower() due to EOF potentially triggering UB
+		if ( c == 'Y' || c == 'y' || c == 'N' || c == 'n' ) {
+			si_count( r, parsed[SI_FIELD_BOOL], 1 );
+			return c == 'Y' || c == 'y';
+		}
+		si_count( r, rejected[SI_REJECT_CHOICE], 1 );
+		si_report( r, SI_ERR_INVALID, "Invalid input. Enter 'y' or 'n'.\n" );
+	}
+}
+
+
+
+/**
+ * Status getters
+ *
+ * si_reader_tryGetX() reads one line like si_reader_getX() but never retries
+ * or prints: the outcome is returned as an si_result and *out is written
+ * only on SI_OK. Bad input costs one line, so batch and streaming consumers
+ * can skip a broken record and move on.
+ *
+ * Returns:
+ * 		SI_OK 			- on success
+ * 		SI_INVALID		- the line is not a valid value of the type
+ * 		SI_OVERFLOW		- the value is out of the type's range
+ * 		SI_TOO_LONG		- the line exceeded the getter's buffer size
+ * 		SI_WOULD_BLOCK	- non-blocking reader without a complete line
+ * 		SI_EOF			- on EOF, read error or NULL arguments
+ */
+static alwaysInline si_result si_statusOf ( int result ) {
+
+	return result == SI_PARSE_OK ? SI_OK : result == SI_PARSE_RANGE ? SI_OVERFLOW : SI_INVALID;
+}
+
+static alwaysInline si_result si_parseStatus ( si_reader *r, int result ) {
+
+	if ( result == SI_PARSE_OK ) return SI_OK;
+	si_countReject( r, result );
+	return si_tally( r, si_statusOf( result ));
+}
+
+/**
+ * si_tryValue - shared body of the numeric si_reader_tryGetX() functions
+ *
+ * Parses into a scratch value first so *out is untouched on failure.
+ * Bounds work as in si_getValueIn(), a value outside them is SI_OVERFLOW.
+ */
+static alwaysInline si_result si_tryValueIn ( si_reader *r, void *out, size_t size,
+											  int ( *parse )( const char *, size_t, void * ), const void *lo, const void *hi ) {
+
+	const char *line;
+	size_t len;
+	union { long long ll; unsigned long long ull; double d; float f; int i; unsigned u; long l; unsigned long ul; } value;
+
+	if ( !r || !out ) return SI_EOF;
+
+	si_result status = si_tryLine( r, INPUT_BUFFER_SIZE - 1, &line, &len );
+	if ( status ) return status;
+
+	int result = parse( line, len, &value );
+	if ( !result && unlikely( !si_inBounds( parse, &value, lo, hi ))) result = SI_PARSE_RANGE;
+
+	status = si_parseStatus( r, result );
+	if ( status ) return status;
+
+	si_count( r, parsed[ si_tokType( parse ) ], 1 );
+	memcpy( out, &value, size );
+	return SI_OK;
+}
+
+static alwaysInline si_result si_tryValue ( si_reader *r, void *out, size_t size,
+											int ( *parse )( const char *, size_t, void * )) {
+
+	return si_tryValueIn( r, out, size, parse, NULL, NULL );
+}
+
+
+
+hotApi si_result si_reader_tryGetInt ( si_reader *r, int *out ) {
+
+	si_guard( r );
+
+	return si_tryValue( r, out, sizeof(*out), si_tokInt );
+}
+
+
+
+hotApi si_result si_reader_tryGetUInt ( si_reader *r, unsigned int *out ) {
+
+	si_guard( r );
+
+	return si_tryValue( r, out, sizeof(*out), si_tokUInt );
+}
+
+
+
+hotApi si_result si_reader_tryGetFloat ( si_reader *r, float *out ) {
+
+	si_guard( r );
+
+	return si_tryValue( r, out, sizeof(*out), si_tokFloat );
+}
+
+
+
+hotApi si_result si_reader_tryGetDouble ( si_reader *r, double *out ) {
+
+	si_guard( r );
+
+	return si_tryValue( r, out, sizeof(*out), si_tokDouble );
+}
+
+
+
+hotApi si_result si_reader_tryGetLong ( si_reader *r, long *out ) {
+
+	si_guard( r );
+
+	return si_tryValue( r, out, sizeof(*out), si_tokLong );
+}
+
+
+
+hotApi si_result si_reader_tryGetULong ( si_reader *r, unsigned long *out ) {
+
+	si_guard( r );
+
+	return si_tryValue( r, out, sizeof(*out), si_tokULong );
+}
+
+
+
+hotApi si_result si_reader_tryGetLongLong ( si_reader *r, long long *out ) {
+
+	si_guard( r );
+
+	return si_tryValue( r, out, sizeof(*out), si_tokLongLong );
+}
+
+
+
+hotApi si_result si_reader_tryGetULongLong ( si_reader *r, unsigned long long *out ) {
+
+	si_guard( r );
+
+	return si_tryValue( r, out, sizeof(*out), si_tokULongLong );
+}
+
+
+
+/**
+ * si_reader_tryGetChar - an empty line reads as '\n', like si_reader_getChar()
+ */
+hotApi si_result si_reader_tryGetChar ( si_reader *r, char *out ) {
+
+	si_guard( r );
+
+	const char *line;
+	size_t len;
+
+	if ( !r || !out ) return SI_EOF;
+
+	si_result status = si_tryLine( r, CHAR_INPUT_BUFFER_SIZE - 1, &line, &len );
+	if ( status ) return status;
+
+	if ( len > 1 ) {
+		si_count( r, rejected[SI_REJECT_SYNTAX], 1 );
+		return si_tally( r, SI_INVALID );
+	}
+
+	si_count( r, parsed[SI_FIELD_CHAR], 1 );
+	*out = len ? line[0] : '\n';
+	return SI_OK;
+}
+
+
+
+/**
+ * si_reader_tryGetBool - accepts "y" or "n" ( case-insensitive )
+ */
+si_result si_reader_tryGetBool ( si_reader *r, bool *out ) {
+
+	si_guard( r );
+
+	char c;
+
+	if ( !out ) return SI_EOF;
+
+	si_result status = si_reader_tryGetChar( r, &c );
+	if ( status ) return status;
+
+	if ( c == 'Y' || c == 'y' ) *out = true;
+	else if ( c == 'N' || c == 'n' ) *out = false;
+	else {
+		si_count( r, rejected[SI_REJECT_CHOICE], 1 );
+		return si_tally( r, SI_INVALID );
+	}
+
+	si_count( r, parsed[SI_FIELD_BOOL], 1 );
+	return SI_OK;
+}
+
+
+/**
+ * si_reader_tryGetLineIn - fetch a line that consists only of members of cs
+ *
+ * @line:		receives a view of the line, valid until the next read from r
+ *
+ * Lines must be shorter than the reader's line limit. The whole line is
+ * validated with si_charset_span().
+ *
+ * returns SI_OK, SI_INVALID if a byte is outside cs, or si_reader_readLine()'s
+ * failure statuses
+ */
+si_result si_reader_tryGetLineIn ( si_reader *r, const si_charset *cs, si_string *line ) {
+
+	si_guard( r );
+
+	if ( !r || !cs || !line ) return SI_EOF;
+
+	si_result status = si_reader_readLine( r, line );
+	if ( status ) return status;
+
+	if ( si_charset_span( cs, line->data, line->len ) != line->len ) {
+		si_count( r, rejected[SI_REJECT_CHOICE], 1 );
+		*line = (si_string){ NULL, 0 };
+		return si_tally( r, SI_INVALID );
+	}
+
+	return SI_OK;
+}
+
+
+
+/**
+ * UTF-8 getters
+ *
+ * The string getters with a Utf8 suffix only return lines that are valid
+ * UTF-8, and si_reader_getCodepoint() is si_reader_getChar() for one
+ * character of up to four bytes. A line that is fully buffered, nearly
+ * all of them, is validated by the same vector pass that finds its
+ * newline ( si_utf8Blocks ), so checking costs no second pass over the
+ * bytes; a line that needed a refill is checked once it is complete.
+ */
+#define SI_CODEPOINT_LIMIT	5	// line limit for one character, as CHAR_INPUT_BUFFER_SIZE is for a byte
+
+/**
+ * si_nextLineUtf8 - si_nextLine() that also checks the line is UTF-8
+ *
+ * Returns:
+ * 		0 - on success
+ * 		1 - on a line that exceeds maxLen ( the rest of it is drained )
+ * 		2 - on a complete line that isn't valid UTF-8 ( it is consumed )
+ *	   -1 - on EOF, or with r->blocked set when no full line is buffered yet
+ */
+static alwaysInline int si_nextLineUtf8 ( si_reader *r, size_t maxLen, const char **line, size_t *outLen ) {
+
+	const char *start = r->buf + r->pos;
+	size_t avail = r->end - r->pos;
+	bool bad;
+	size_t len = si_utf8Blocks( start, avail, true, &bad );
+
+	if ( unlikely( len == avail || r->skipping || len >= maxLen )) {
+		int result = si_nextLineSlow( r, maxLen, line, outLen );
+		if ( result ) return result;
+		return si_utf8_valid( *line, *outLen ) ? 0 : 2;
+	}
+
+	r->blocked = false;
+	si_consumeLine( r, r->pos + len + 1 );
+	*line = start;
+	*outLen = len;
+	return bad ? 2 : 0;
+}
+
+/**
+ * si_readLineUtf8 - si_readLine() that reports and skips lines that aren't UTF-8
+ */
+static alwaysInline int si_readLineUtf8 ( si_reader *r, size_t maxLen, const char **line, size_t *outLen ) {
+
+	if ( unlikely( !r )) return 1;
+
+	while ( 1 ) {
+
+		*outLen = 0;
+
+		int result = si_nextLineUtf8( r, maxLen, line, outLen );
+		if ( result != 2 ) {
+			if ( unlikely( result == 1 )) si_report( r, SI_ERR_TOO_LONG, "Input exceeding buffer size. Try again.\n" );
+			return result;
+		}
+
+		si_count( r, rejected[SI_REJECT_SYNTAX], 1 );
+		si_report( r, SI_ERR_INVALID, "Invalid input. Not valid UTF-8. Try again.\n" );
+	}
+}
+
+/**
+ * si_tryLineUtf8 - si_tryLine() for UTF-8 lines, SI_INVALID if a line isn't
+ */
+static alwaysInline si_result si_tryLineUtf8 ( si_reader *r, size_t maxLen, const char **line, size_t *outLen ) {
+
+	*outLen = 0;
+
+	switch ( si_nextLineUtf8( r, maxLen, line, outLen )) {
+		case 0:		return SI_OK;
+		case 1:		return si_tally( r, SI_TOO_LONG );
+		case 2:		si_count( r, rejected[SI_REJECT_SYNTAX], 1 );
+					return si_tally( r, SI_INVALID );
+		default:	return r->blocked ? SI_WOULD_BLOCK : SI_EOF;
+	}
+}
+
+/**
+ * si_utf8Single - the code point of a line that holds exactly one
+ * 				   valid character, or -1
+ */
+static alwaysInline long si_utf8Single ( const char *line, size_t len ) {
+
+	const unsigned char *p = (const unsigned char *)line;
+
+	if ( len == 1 ) return p[0];
+	if ( len == 2 && p[0] >= 0xC0 && p[0] < 0xE0 ) return ( p[0] & 0x1F ) << 6 | ( p[1] & 0x3F );
+	if ( len == 3 && p[0] >= 0xE0 && p[0] < 0xF0 ) return ( p[0] & 0x0F ) << 12 | ( p[1] & 0x3F ) << 6 | ( p[2] & 0x3F );
+	if ( len == 4 && p[0] >= 0xF0 ) return (long)( p[0] & 0x07 ) << 18 | ( p[1] & 0x3F ) << 12 | ( p[2] & 0x3F ) << 6 | ( p[3] & 0x3F );
+	return -1;
+}
+
+
+
+/**
+ * si_reader_getCodepoint - si_reader_getChar() for one UTF-8 character
+ *
+ * usage - int c = si_reader_getCodepoint( r ); // 'é' is 0xE9
+ *
+ * IMPORTANT: Only accepts one character, of one to four bytes. An empty
+ * 			  line reads as '\n', as with si_reader_getChar().
+ *
+ * returns the code point, or EOF on EOF
+ */
+hotApi int si_reader_getCodepoint ( si_reader *r ) {
+
+	si_guard( r );
+
+	const char *line;
+	size_t len;
+
+	while ( 1 ) {
+
+		int result = si_readLineUtf8( r, SI_CODEPOINT_LIMIT, &line, &len );
+
+		if ( result == EOF ) return EOF;
+		if ( result == 1 ) {
+			if ( !r ) return EOF;
+			continue;
+		}
+
+		long c = len ? si_utf8Single( line, len ) : '\n';
+		if ( c >= 0 ) {
+			si_count( r, parsed[SI_FIELD_CHAR], 1 );
+			return (int)c;
+		}
+
+		si_count( r, rejected[SI_REJECT_SYNTAX], 1 );
+		si_report( r, SI_ERR_INVALID, "Invalid input. Please enter a single character.\n" );
+	}
+}
+
+
+
+/**
+ * si_reader_getStringViewUtf8 - si_reader_getStringView() for UTF-8 lines
+ *
+ * Lines that aren't valid UTF-8 are reported ( "Invalid input. Not valid
+ * UTF-8. Try again." ) and skipped, like unparsable numbers.
+ *
+ * Returns:
+ * 		A si_string with .data == NULL and .len == 0 on error or EOF,
+ * 		otherwise a view valid until the next read from r.
+ */
+hotApi si_string si_reader_getStringViewUtf8 ( si_reader *r ) {
+
+	si_guard( r );
+
+	const char *line;
+	size_t len;
+
+	if ( !r || si_readLineUtf8( r, r->lineLimit, &line, &len )) return (si_string){ NULL, 0 };
+
+	si_count( r, parsed[SI_FIELD_STRING], 1 );
+	return (si_string){ (char *)line, len };
+}
+
+
+
+/**
+ * si_reader_getStringUtf8 - si_reader_getString() for UTF-8 lines
+ *
+ * NOTE: 	Caller is responsible for freeing str.data, as for si_reader_getString().
+ */
+si_string si_reader_getStringUtf8 ( si_reader *r ) {
+
+	si_guard( r );
+
+	return si_reader_retainString( r, si_reader_getStringViewUtf8( r ));
+}
+
+
+
+/**
+ * si_reader_getCStringUtf8 - si_reader_getCString() for UTF-8 lines
+ *
+ * NOTE: 	Caller must free the returned string, as for si_reader_getCString().
+ * 			U+0000 is valid UTF-8, so the line may hold embedded NULs.
+ *
+ * returns NULL on error or EOF
+ */
+char *si_reader_getCStringUtf8 ( si_reader *r ) {
+
+	si_guard( r );
+
+	const char *line;
+	size_t len;
+
+	if ( !r || si_readLineUtf8( r, r->lineLimit - 1, &line, &len )) return NULL;
+
+	char *str = si_alloc( &r->alloc, len + 1 );
+	if ( !str ) {
+		si_report( r, SI_ERR_NOMEM, "Memory allocation failed.\n" );
+		return NULL;
+	}
+
+	si_count( r, parsed[SI_FIELD_STRING], 1 );
+	si_count( r, allocs, 1 );
+	si_count( r, allocBytes, len + 1 );
+
+	memcpy( str, line, len );
+	str[len] = '\0';
+	return str;
+}
+
+
+
+/**
+ * si_reader_tryGetCodepoint - si_reader_tryGetChar() for one UTF-8 character
+ */
+hotApi si_result si_reader_tryGetCodepoint ( si_reader *r, uint32_t *out ) {
+
+	si_guard( r );
+
+	const char *line;
+	size_t len;
+
+	if ( !r || !out ) return SI_EOF;
+
+	si_result status = si_tryLineUtf8( r, SI_CODEPOINT_LIMIT, &line, &len );
+	if ( status ) return status;
+
+	long c = len ? si_utf8Single( line, len ) : '\n';
+	if ( c < 0 ) {
+		si_count( r, rejected[SI_REJECT_SYNTAX], 1 );
+		return si_tally( r, SI_INVALID );
+	}
+
+	si_count( r, parsed[SI_FIELD_CHAR], 1 );
+	*out = (uint32_t)c;
+	return SI_OK;
+}
+
+
+
+/**
+ * si_reader_tryGetLineUtf8 - si_reader_readLine() that only takes UTF-8 lines
+ *
+ * @line:		receives a view of the line, valid until the next read from r
+ *
+ * returns SI_OK, SI_INVALID if the line isn't valid UTF-8 ( it is consumed ),
+ * 		   or si_reader_readLine()'s failure statuses
+ */
+hotApi si_result si_reader_tryGetLineUtf8 ( si_reader *r, si_string *line ) {
+
+	si_guard( r );
+
+	const char *p;
+	size_t len;
+
+	if ( !r || !line ) return SI_EOF;
+
+	si_result status = si_tryLineUtf8( r, r->lineLimit, &p, &len );
+	*line = status ? (si_string){ NULL, 0 } : (si_string){ (char *)p, len };
+	return status;
+}
+
+
+
+/**
+ * Bounded getters
+ *
+ * si_reader_getXRange() and si_reader_tryGetXRange() take only values in
+ * [lo, hi]. The bounds are checked inside the parse loop, on the value
+ * just parsed and in its own type, so there is no post-check or second
+ * round trip: a value outside them is rejected like one outside the type,
+ * with "Value out of range. Try again." and a retry, or SI_OVERFLOW.
+ * In the single-header build the getters are inline, so constant bounds
+ * fold straight into the compares.
+ *
+ * An empty range ( lo > hi, or a NaN bound ) could never be satisfied:
+ * the looping getters report it and exit, the status getters return SI_EOF.
+ */
+static cold void si_emptyRange ( si_reader *r ) {
+
+	if ( r ) si_count( r, rejected[SI_REJECT_USAGE], 1 );
+	si_report( r, SI_ERR_USAGE, "ERROR: empty range, 'lo' > 'hi'. Exiting.\n" );
+	exit(EXIT_FAILURE);
+}
+
+
+
+/**
+ * si_reader_getIntRange - si_reader_getInt() for integers in [lo, hi]
+ *
+ * usage - int x = si_reader_getIntRange( r, 1, 12 );
+ *
+ * returns INT_MIN on error or EOF
+ */
+hotApi int si_reader_getIntRange ( si_reader *r, int lo, int hi ) {
+
+	si_guard( r );
+
+	if ( unlikely( !( lo <= hi ))) si_emptyRange( r );
+
+	int value;
+	return si_getValueIn( r, &value, si_tokInt, &lo, &hi ) ? value : INT_MIN;
+}
+
+
+
+/**
+ * si_reader_getUIntRange - si_reader_getUInt() for unsigned integers in [lo, hi]
+ *
+ * usage - unsigned int x = si_reader_getUIntRange( r, 1, 65535 );
+ *
+ * returns UINT_MAX on error or EOF
+ */
+hotApi unsigned int si_reader_getUIntRange ( si_reader *r, unsigned int lo, unsigned int hi ) {
+
+	si_guard( r );
+
+	if ( unlikely( !( lo <= hi ))) si_emptyRange( r );
+
+	unsigned int value;
+	return si_getValueIn( r, &value, si_tokUInt, &lo, &hi ) ? value : UINT_MAX;
+}
+
+
+
+/**
+ * si_reader_getLongRange - si_reader_getLong() for longs in [lo, hi]
+ *
+ * usage - long x = si_reader_getLongRange( r, -86400, 86400 );
+ *
+ * returns LONG_MIN on error or EOF
+ */
+hotApi long si_reader_getLongRange ( si_reader *r, long lo, long hi ) {
+
+	si_guard( r );
+
+	if ( unlikely( !( lo <= hi ))) si_emptyRange( r );
+
+	long value;
+	return si_getValueIn( r, &value, si_tokLong, &lo, &hi ) ? value : LONG_MIN;
+}
+
+
+
+/**
+ * si_reader_getULongRange - si_reader_getULong() for unsigned longs in [lo, hi]
+ *
+ * usage - unsigned long x = si_reader_getULongRange( r, 1, 4096 );
+ *
+ * returns ULONG_MAX on error or EOF
+ */
+hotApi unsigned long si_reader_getULongRange ( si_reader *r, unsigned long lo, unsigned long hi ) {
+
+	si_guard( r );
+
+	if ( unlikely( !( lo <= hi ))) si_emptyRange( r );
+
+	unsigned long value;
+	return si_getValueIn( r, &value, si_tokULong, &lo, &hi ) ? value : ULONG_MAX;
+}
+
+
+
+/**
+ * si_reader_getLongLongRange - si_reader_getLongLong() for long longs in [lo, hi]
+ *
+ * usage - long long x = si_reader_getLongLongRange( r, 0, LLONG_MAX / 2 );
+ *
+ * returns LLONG_MIN on error or EOF
+ */
+hotApi long long si_reader_getLongLongRange ( si_reader *r, long long lo, long long hi ) {
+
+	si_guard( r );
+
+	if ( unlikely( !( lo <= hi ))) si_emptyRange( r );
+
+	long long value;
+	return si_getValueIn( r, &value, si_tokLongLong, &lo, &hi ) ? value : LLONG_MIN;
+}
+
+
+
+/**
+ * si_reader_getULongLongRange - si_reader_getULongLong() for unsigned long longs in [lo, hi]
+ *
+ * usage - unsigned long long x = si_reader_getULongLongRange( r, 1, 1ull << 40 );
+ *
+ * returns ULLONG_MAX on error or EOF
+ */
+hotApi unsigned long long si_reader_getULongLongRange ( si_reader *r, unsigned long long lo, unsigned long long hi ) {
+
+	si_guard( r );
+
+	if ( unlikely( !( lo <= hi ))) si_emptyRange( r );
+
+	unsigned long long value;
+	return si_getValueIn( r, &value, si_tokULongLong, &lo, &hi ) ? value : ULLONG_MAX;
+}
+
+
+
+/**
+ * si_reader_getFloatRange - si_reader_getFloat() for floating point numbers in [lo, hi]
+ *
+ * usage - float x = si_reader_getFloatRange( r, 0.0f, 1.0f );
+ *
+ * returns NAN on error or EOF
+ */
+hotApi float si_reader_getFloatRange ( si_reader *r, float lo, float hi ) {
+
+	si_guard( r );
+
+	if ( unlikely( !( lo <= hi ))) si_emptyRange( r );
+
+	float value;
+	return si_getValueIn( r, &value, si_tokFloat, &lo, &hi ) ? value : NAN;
+}
+
+
+
+/**
+ * si_reader_getDoubleRange - si_reader_getDouble() for doubles in [lo, hi]
+ *
+ * usage - double x = si_reader_getDoubleRange( r, -90.0, 90.0 );
+ *
+ * returns NAN on error or EOF
+ */
+hotApi double si_reader_getDoubleRange ( si_reader *r, double lo, double hi ) {
+
+	si_guard( r );
+
+	if ( unlikely( !( lo <= hi ))) si_emptyRange( r );
+
+	double value;
+	return si_getValueIn( r, &value, si_tokDouble, &lo, &hi ) ? value : NAN;
+}
+
+
+
+hotApi si_result si_reader_tryGetIntRange ( si_reader *r, int lo, int hi, int *out ) {
+
+	si_guard( r );
+
+	if ( !( lo <= hi )) return SI_EOF;
+	return si_tryValueIn( r, out, sizeof(*out), si_tokInt, &lo, &hi );
+}
+
+
+
+hotApi si_result si_reader_tryGetUIntRange ( si_reader *r, unsigned int lo, unsigned int hi, unsigned int *out ) {
+
+	si_guard( r );
+
+	if ( !( lo <= hi )) return SI_EOF;
+	return si_tryValueIn( r, out, sizeof(*out), si_tokUInt, &lo, &hi );
+}
+
+
+
+hotApi si_result si_reader_tryGetLongRange ( si_reader *r, long lo, long hi, long *out ) {
+
+	si_guard( r );
+
+	if ( !( lo <= hi )) return SI_EOF;
+	return si_tryValueIn( r, out, sizeof(*out), si_tokLong, &lo, &hi );
+}
+
+
+
+hotApi si_result si_reader_tryGetULongRange ( si_reader *r, unsigned long lo, unsigned long hi, unsigned long *out ) {
+
+	si_guard( r );
+
+	if ( !( lo <= hi )) return SI_EOF;
+	return si_tryValueIn( r, out, sizeof(*out), si_tokULong, &lo, &hi );
+}
+
+
+
+hotApi si_result si_reader_tryGetLongLongRange ( si_reader *r, long long lo, long long hi, long long *out ) {
+
+	si_guard( r );
+
+	if ( !( lo <= hi )) return SI_EOF;
+	return si_tryValueIn( r, out, sizeof(*out), si_tokLongLong, &lo, &hi );
+}
+
+
+
+hotApi si_result si_reader_tryGetULongLongRange ( si_reader *r, unsigned long long lo, unsigned long long hi, unsigned long long *out ) {
+
+	si_guard( r );
+
+	if ( !( lo <= hi )) return SI_EOF;
+	return si_tryValueIn( r, out, sizeof(*out), si_tokULongLong, &lo, &hi );
+}
+
+
+
+hotApi si_result si_reader_tryGetFloatRange ( si_reader *r, float lo, float hi, float *out ) {
+
+	si_guard( r );
+
+	if ( !( lo <= hi )) return SI_EOF;
+	return si_tryValueIn( r, out, sizeof(*out), si_tokFloat, &lo, &hi );
+}
+
+
+
+hotApi si_result si_reader_tryGetDoubleRange ( si_reader *r, double lo, double hi, double *out ) {
+
+	si_guard( r );
+
+	if ( !( lo <= hi )) return SI_EOF;
+	return si_tryValueIn( r, out, sizeof(*out), si_tokDouble, &lo, &hi );
+}
+
+
+
+/**
+ * Streaming
+ *
+ * si_reader_forEachLine() hands every remaining line to fn in one call:
+ * the reader is locked once, the lines come straight out of the block
+ * buffer as views ( valid until fn returns ), and there is no per-line
+ * entry, scratch buffer or EOF check on the caller's side. The typed
+ * variants parse each line like si_reader_tryGetLong()/tryGetDouble()
+ * and pass the value; lines that don't parse or are too long are skipped
+ * quietly and counted in si_reader_errorStats().
+ *
+ * fn returns false to stop, leaving the rest of the input unread. fn may
+ * read from the same reader ( the lock is recursive ), which moves the
+ * stream along with it.
+ *
+ * returns SI_EOF once the input is exhausted, SI_OK if fn stopped, or
+ * SI_WOULD_BLOCK when a non-blocking reader runs dry - call again to go on
+ */
+si_result si_reader_forEachLine ( si_reader *r, si_lineFn fn, void *ctx ) {
+
+	si_guard( r );
+
+	const char *line;
+	size_t len;
+
+	if ( !r || !fn ) return SI_EOF;
+
+	while ( 1 ) {
+
+		si_result status = si_tryLine( r, r->lineLimit, &line, &len );
+		if ( unlikely( status == SI_TOO_LONG )) continue;
+		if ( unlikely( status )) return status;
+
+		if ( !fn( ctx, (si_string){ (char *)line, len } )) return SI_OK;
+	}
+}
+
+
+
+si_result si_reader_forEachLong ( si_reader *r, si_longFn fn, void *ctx ) {
+
+	si_guard( r );
+
+	long value;
+
+	if ( !r || !fn ) return SI_EOF;
+
+	while ( 1 ) {
+
+		si_result status = si_tryValue( r, &value, sizeof(value), si_tokLong );
+
+		if ( status == SI_OK ) {
+			if ( !fn( ctx, value )) return SI_OK;
+		}
+		else if ( status == SI_EOF || status == SI_WOULD_BLOCK ) return status;
+	}
+}
+
+
+
+si_result si_reader_forEachDouble ( si_reader *r, si_doubleFn fn, void *ctx ) {
+
+	si_guard( r );
+
+	double value;
+
+	if ( !r || !fn ) return SI_EOF;
+
+	while ( 1 ) {
+
+		si_result status = si_tryValue( r, &value, sizeof(value), si_tokDouble );
+
+		if ( status == SI_OK ) {
+			if ( !fn( ctx, value )) return SI_OK;
+		}
+		else if ( status == SI_EOF || status == SI_WOULD_BLOCK ) return status;
+	}
+}
+
+
+
+/**
+ * si_isSeparator - true for whitespace and the caller's delimiter
+ */
+static alwaysInline bool si_isSeparator ( unsigned char c, char delim ) {
+
+	return si_isSpace( c ) || c == (unsigned char)delim;
+}
+
+
+
+/**
+ * si_skipSeparators - step over separators in the buffered input, counting lines
+ *
+ * returns true if a token starts at r->pos, false if the buffer ran out
+ */
+static alwaysInline bool si_skipSeparators ( si_reader *r, char delim ) {
+
+	while ( r->pos < r->end ) {
+		unsigned char c = (unsigned char)r->buf[ r->pos ];
+		if ( c == '\n' ) si_consumeLine( r, r->pos + 1 );
+		else if ( si_isSeparator( c, delim )) r->pos++;
+		else return true;
+	}
+
+	return false;
+}
+
+
+
+/**
+ * si_nextToken - locate the next separator-delimited token without copying it
+ *
+ * @r:			reader to pull from
+ * @delim:		extra separator besides whitespace ( '\0' for whitespace only )
+ * @maxLen:		tokens of maxLen bytes or more are rejected
+ * @tok:		receives a pointer to the first byte of the token
+ * @outLen:		receives the token length
+ * @where:		receives the token's line and column
+ *
+ * Any run of whitespace ( newlines included ) and delim characters
+ * separates tokens, so empty fields are skipped. The token stays valid
+ * until the next call on the same reader.
+ *
+ * Returns:
+ * 		0 - on success
+ * 		1 - on a token that exceeds maxLen ( consumed )
+ *	   -1 - on EOF
+ */
+static int si_nextToken ( si_reader *r, char delim, size_t maxLen, const char **tok, size_t *outLen, si_position *where ) {
+
+	r->blocked = false;
+
+	while ( !si_skipSeparators( r, delim ))
+		if ( !si_refill( r )) return EOF;
+
+	where->line = r->lines + 1;
+	where->column = r->base + r->pos - r->lineStart + 1;
+
+	size_t len = 0;
+
+	while ( 1 ) {
+		const char *start = r->buf + r->pos;
+		size_t avail = r->end - r->pos;
+
+		while ( len < avail && !si_isSeparator( (unsigned char)start[len], delim )) len++;
+
+		if ( unlikely( len >= maxLen )) {
+			// discard the rest of the token
+			r->pos += len;
+			while ( 1 ) {
+				while ( r->pos < r->end && !si_isSeparator( (unsigned char)r->buf[ r->pos ], delim )) r->pos++;
+				if ( r->pos < r->end || !si_refill( r )) {
+					si_count( r, rejected[SI_REJECT_TOO_LONG], 1 );
+					return 1;
+				}
+			}
+		}
+
+		if ( len < avail ) break;
+		if ( !si_refill( r )) {
+			// a token cut off by a non-blocking read is kept for the next call
+			if ( r->blocked ) return EOF;
+			break;
+		}
+	}
+
+	*tok = r->buf + r->pos;
+	*outLen = len;
+	r->pos += len;
+	return 0;
+}
+
+
+
+/**
+ * si_readArray - shared driver for the si_reader_getXArray() functions
+ *
+ * Always inlined with a constant parse function, so each array getter
+ * ends up with its own loop and a direct ( usually inlined ) parse call.
+ */
+static alwaysInline size_t si_readArray ( si_reader *r, void *out, size_t size, size_t n, char delim, si_position *err,
+										int ( *parse )( const char *, size_t, void * )) {
+
+	si_guard( r );
+
+	if ( err ) *err = (si_position){ 0, 0 };
+	if ( unlikely( !r || ( !out && n ))) return 0;
+
+	char *dst = out;
+	size_t count = 0;
+
+	for ( ; count < n; count++ ) {
+		const char *tok;
+		size_t len;
+		si_position at;
+
+		int result = si_nextToken( r, delim, INPUT_BUFFER_SIZE - 1, &tok, &len, &at );
+		if ( result == EOF ) break;
+
+		if ( !result ) {
+			result = parse( tok, len, dst + count * size );
+			if ( result ) si_countReject( r, result );
+		}
+
+		if ( unlikely( result )) {
+			if ( err ) *err = at;
+			break;
+		}
+	}
+
+	si_count( r, parsed[ si_tokType( parse ) ], count );
+	return count;
+}
+
+
+
+/**
+ * si_reader_getIntArray - read up to n separated ints into out
+ *
+ * usage - size_t got = si_reader_getIntArray( r, row, 16, ',', &err );
+ *
+ * @r:			reader to pull from
+ * @out:		array receiving the values
+ * @n:			capacity of out
+ * @delim:		separator besides whitespace, e.g. ',' ( '\0' for whitespace only )
+ * @err:		optional, receives the position of the first rejected value
+ *
+ * Values may span any number of lines, and runs of separators count as
+ * one. Reading stops after n values, at EOF, or at the first token that
+ * fails the validation si_reader_getInt() applies. That token is consumed
+ * and its position stored in err ( err->line stays 0 if nothing failed ).
+ * Nothing is printed and nothing is retried.
+ *
+ * returns the number of values stored
+ */
+size_t si_reader_getIntArray ( si_reader *r, int *out, size_t n, char delim, si_position *err ) {
+
+	return si_readArray( r, out, sizeof(*out), n, delim, err, si_tokInt );
+}
+
+
+
+/**
+ * si_reader_getUIntArray - si_reader_getIntArray() for unsigned ints
+ */
+size_t si_reader_getUIntArray ( si_reader *r, unsigned int *out, size_t n, char delim, si_position *err ) {
+
+	return si_readArray( r, out, sizeof(*out), n, delim, err, si_tokUInt );
+}
+
+
+
+/**
+ * si_reader_getLongArray - si_reader_getIntArray() for longs
+ */
+size_t si_reader_getLongArray ( si_reader *r, long *out, size_t n, char delim, si_position *err ) {
+
+	return si_readArray( r, out, sizeof(*out), n, delim, err, si_tokLong );
+}
+
+
+
+/**
+ * si_reader_getULongArray - si_reader_getIntArray() for unsigned longs
+ */
+size_t si_reader_getULongArray ( si_reader *r, unsigned long *out, size_t n, char delim, si_position *err ) {
+
+	return si_readArray( r, out, sizeof(*out), n, delim, err, si_tokULong );
+}
+
+
+
+/**
+ * si_reader_getLongLongArray - si_reader_getIntArray() for long longs
+ */
+size_t si_reader_getLongLongArray ( si_reader *r, long long *out, size_t n, char delim, si_position *err ) {
+
+	return si_readArray( r, out, sizeof(*out), n, delim, err, si_tokLongLong );
+}
+
+
+
+/**
+ * si_reader_getULongLongArray - si_reader_getIntArray() for unsigned long longs
+ */
+size_t si_reader_getULongLongArray ( si_reader *r, unsigned long long *out, size_t n, char delim, si_position *err ) {
+
+	return si_readArray( r, out, sizeof(*out), n, delim, err, si_tokULongLong );
+}
+
+
+
+/**
+ * si_reader_getFloatArray - si_reader_getIntArray() for floats
+ */
+size_t si_reader_getFloatArray ( si_reader *r, float *out, size_t n, char delim, si_position *err ) {
+
+	return si_readArray( r, out, sizeof(*out), n, delim, err, si_tokFloat );
+}
+
+
+
+/**
+ * si_reader_getDoubleArray - si_reader_getIntArray() for doubles
+ */
+size_t si_reader_getDoubleArray ( si_reader *r, double *out, size_t n, char delim, si_position *err ) {
+
+	return si_readArray( r, out, sizeof(*out), n, delim, err, si_tokDouble );
+}
+
+
+
+/**
+ * Parallel batch input
+ *
+ * An in-memory or mapped reader's remaining bytes are cut into newline
+ * aligned chunks, one per worker. Every worker runs the array getters'
+ * token loop over its chunk through a private memory reader and collects
+ * values in its own growing array. The arrays are concatenated in input
+ * order afterwards, and error positions are rebased to global line numbers
+ * from the newline counts of the chunks before.
+ *
+ * Tokens never straddle chunks because a chunk always ends after '\n'.
+ * Failing workers lower a shared first-failed index, and workers on later
+ * chunks poll it and give up early; their values would be dropped anyway.
+ */
+#define SI_CHUNK_MIN	( 1024 * 1024 )	// don't start a thread for less
+#define SI_CHUNK_POLL	4096			// tokens between checks of the failed index
+
+typedef struct si_chunk {
+	const char	*data;
+	size_t		len;
+	char		delim;
+	size_t		size;
+	int			( *parse )( const char *, size_t, void * );
+	char		*out;		// values parsed from this chunk
+	size_t		count;
+	size_t		cap;
+	size_t		lines;		// newlines consumed
+	size_t		stop;		// bytes consumed
+	si_position	err;		// chunk-relative, line == 0 if none
+	si_reject	failure;	// why the token at err was rejected
+	bool		nomem;
+	size_t		index;		// position in input order
+	size_t		*failed;	// shared, lowest index with err or nomem
+} si_chunk;
+
+static void *si_chunkWorker ( void *arg ) {
+
+	si_chunk *c = arg;
+	si_reader r = {
+		.buf		= (char *)c->data,
+		.cap		= c->len,
+		.end		= c->len,
+		.fd			= -1,
+		.eof		= true,
+		.lineLimit	= INPUT_BUFFER_SIZE,
+	};
+
+	while ( 1 ) {
+		const char *tok;
+		size_t len;
+		si_position at;
+
+		int result = si_nextToken( &r, c->delim, INPUT_BUFFER_SIZE - 1, &tok, &len, &at );
+		if ( result == EOF ) break;
+
+		if ( unlikely( c->count % SI_CHUNK_POLL == 0 ) && __atomic_load_n( c->failed, __ATOMIC_RELAXED ) < c->index ) break;
+
+		if ( unlikely( c->count == c->cap )) {
+			size_t cap = c->cap ? c->cap * 2 : 1024;
+			char *out = realloc( c->out, cap * c->size );
+			if ( !out ) {
+				c->nomem = true;
+				break;
+			}
+			c->out = out;
+			c->cap = cap;
+		}
+
+		if ( unlikely( result )) c->failure = SI_REJECT_TOO_LONG;
+		else if ( unlikely(( result = c->parse( tok, len, c->out + c->count * c->size )))) c->failure = si_rejectOf( result );
+
+		if ( unlikely( result )) {
+			c->err = at;
+			break;
+		}
+
+		c->count++;
+	}
+
+	if ( c->err.line || c->nomem ) {
+		size_t seen = __atomic_load_n( c->failed, __ATOMIC_RELAXED );
+		while ( c->index < seen && !__atomic_compare_exchange_n( c->failed, &seen, c->index, true, __ATOMIC_RELAXED, __ATOMIC_RELAXED ));
+	}
+
+	c->lines = r.lines;
+	c->stop = r.pos;
+	return NULL;
+}
+
+
+
+/**
+ * si_parallelArray - shared driver for the si_reader_parallelGetXArray() functions
+ */
+static void *si_parallelArray ( si_reader *r, size_t size, char delim, unsigned threads, size_t *count,
+								si_position *err, int ( *parse )( const char *, size_t, void * )) {
+
+	si_guard( r );
+
+	if ( err ) *err = (si_position){ 0, 0 };
+	if ( count ) *count = 0;
+	if ( !r || !count ) return NULL;
+
+	// only fully buffered readers can be split, stream the rest on one chunk
+	if ( !r->eof ) threads = 1;
+	else if ( threads == 0 ) {
+		long cpus = sysconf( _SC_NPROCESSORS_ONLN );
+		threads = cpus > 0 ? (unsigned)cpus : 1;
+	}
+
+	const char *data = r->buf + r->pos;
+	size_t len = r->end - r->pos;
+
+	if ( threads > 1 && len / threads < SI_CHUNK_MIN ) threads = (unsigned)( len / SI_CHUNK_MIN ) + 1;
+
+	si_chunk *chunks = calloc( threads, sizeof(*chunks) );
+	pthread_t *tids = malloc( threads * sizeof(*tids) );
+	if ( !chunks || !tids ) {
+		free( chunks );
+		free( tids );
+		si_report( r, SI_ERR_NOMEM, "Memory allocation failed.\n" );
+		return NULL;
+	}
+
+	// cut at the first newline after each even split point
+	size_t at = 0, failed = SIZE_MAX;
+	unsigned used = 0;
+
+	for ( ; used < threads && at < len; used++ ) {
+		size_t end = len;
+		if ( used + 1 < threads ) {
+			size_t target = at + ( len - at ) / ( threads - used );
+			const char *nl = target < len ? memchr( data + target, '\n', len - target ) : NULL;
+			end = nl ? (size_t)( nl - data ) + 1 : len;
+		}
+
+		chunks[used] = (si_chunk){ .data = data + at, .len = end - at, .delim = delim, .size = size, .parse = parse,
+								   .index = used, .failed = &failed };
+		at = end;
+	}
+
+	if ( used == 0 ) {
+		// nothing buffered ( or a stream ): a single chunk on the reader itself
+		used = 1;
+		chunks[0] = (si_chunk){ .delim = delim, .size = size, .parse = parse, .failed = &failed };
+	}
+
+	unsigned started = 1;
+	for ( ; started < used; started++ )
+		if ( pthread_create( &tids[started], NULL, si_chunkWorker, &chunks[started] )) break;
+
+	if ( r->eof ) si_chunkWorker( &chunks[0] );
+	else {
+		// streaming fallback, parse straight off the reader
+		si_chunk *c = &chunks[0];
+		while ( 1 ) {
+			const char *tok;
+			size_t tlen;
+			si_position pos;
+
+			int result = si_nextToken( r, delim, INPUT_BUFFER_SIZE - 1, &tok, &tlen, &pos );
+			if ( result == EOF ) break;
+
+			if ( c->count == c->cap ) {
+				size_t cap = c->cap ? c->cap * 2 : 1024;
+				char *out = realloc( c->out, cap * size );
+				if ( !out ) {
+					c->nomem = true;
+					break;
+				}
+				c->out = out;
+				c->cap = cap;
+			}
+
+			if ( !result ) {
+				result = parse( tok, tlen, c->out + c->count * size );
+				if ( result ) si_countReject( r, result );
+			}
+
+			if ( result ) {
+				if ( err ) *err = pos;
+				break;
+			}
+			c->count++;
+		}
+	}
+
+	// threads that failed to start are run here instead
+	for ( unsigned i = 1; i < used; i++ ) {
+		if ( i < started ) pthread_join( tids[i], NULL );
+		else si_chunkWorker( &chunks[i] );
+	}
+
+	free( tids );
+
+	// merge in input order, up to the first chunk that failed
+	size_t total = 0;
+	unsigned last = 0;
+	bool nomem = false;
+
+	for ( ; last < used; last++ ) {
+		total += chunks[last].count;
+		nomem |= chunks[last].nomem;
+		if ( chunks[last].err.line || chunks[last].nomem ) break;
+	}
+	if ( last == used ) last--;
+
+	char *result = nomem ? NULL : malloc( total ? total * size : 1 );
+
+	if ( result ) {
+		size_t off = 0;
+		for ( unsigned i = 0; i <= last; i++ ) {
+			if ( chunks[i].count ) memcpy( result + off * size, chunks[i].out, chunks[i].count * size );
+			off += chunks[i].count;
+		}
+		*count = total;
+		si_count( r, parsed[ si_tokType( parse ) ], total );
+	}
+	else si_report( r, SI_ERR_NOMEM, "Memory allocation failed.\n" );
+
+	// rebase the error and the reader's bookkeeping to where parsing stopped
+	if ( r->eof ) {
+		size_t lines = r->lines, consumed = 0;
+		size_t column = r->base + r->pos - r->lineStart;
+
+		for ( unsigned i = 0; i < last; i++ ) {
+			lines += chunks[i].lines;
+			consumed += chunks[i].len;
+		}
+
+		si_chunk *c = &chunks[last];
+		if ( c->err.line ) si_count( r, rejected[ c->failure ], 1 );
+		if ( err && c->err.line ) {
+			err->line = lines + c->err.line;
+			err->column = c->err.column + ( last == 0 && c->err.line == 1 ? column : 0 );
+		}
+
+		si_count( r, lines, lines + c->lines - r->lines );
+		r->pos += consumed + c->stop;
+		r->lines = lines + c->lines;
+		if ( last || c->lines ) {
+			// lineStart of the chunk-local reader, shifted to stream offsets
+			const char *nl = r->buf + r->pos;
+			while ( nl > r->buf && nl[-1] != '\n' ) nl--;
+			r->lineStart = r->base + (size_t)( nl - r->buf );
+		}
+	}
+
+	for ( unsigned i = 0; i < used; i++ ) free( chunks[i].out );
+	free( chunks );
+	return result;
+}
+
+
+
+/**
+ * si_reader_parallelGetLongArray - parse every remaining value of r on
+ * 									several threads
+ *
+ * usage - long *v = si_reader_parallelGetLongArray( r, ',', 0, &n, &err );
+ *
+ * @r:			reader to consume, ideally from si_reader_fromMapped() or
+ * 				si_reader_fromMemory()
+ * @delim:		separator besides whitespace, as for si_reader_getLongArray()
+ * @threads:	worker count, 0 for one per online CPU. Inputs below about
+ * 				1 MiB per worker use fewer threads.
+ * @count:		receives the number of values returned
+ * @err:		optional, receives the global position of the first rejected
+ * 				value ( err->line stays 0 if nothing failed )
+ *
+ * Values are validated like si_reader_getLong(). Parsing stops at the
+ * first bad value in input order, exactly like the serial array getters,
+ * and the reader is left just past it; workers on later chunks notice the
+ * failure within a few thousand values and stop. Readers that still have
+ * input to read from their fd are parsed on the calling thread.
+ *
+ * The workers are started and joined on every call, so for small inputs
+ * the serial si_reader_getLongArray() is cheaper.
+ *
+ * NOTE: 	Caller must free() the returned array.
+ *
+ * returns the values in input order, NULL on allocation failure or bad
+ * arguments
+ */
+long *si_reader_parallelGetLongArray ( si_reader *r, char delim, unsigned threads, size_t *count, si_position *err ) {
+
+	return si_parallelArray( r, sizeof(long), delim, threads, count, err, si_tokLong );
+}
+
+
+
+/**
+ * si_reader_parallelGetXArray - the other element types, see above
+ */
+int *si_reader_parallelGetIntArray ( si_reader *r, char delim, unsigned threads, size_t *count, si_position *err ) {
+
+	return si_parallelArray( r, sizeof(int), delim, threads, count, err, si_tokInt );
+}
+
+unsigned int *si_reader_parallelGetUIntArray ( si_reader *r, char delim, unsigned threads, size_t *count, si_position *err ) {
+
+	return si_parallelArray( r, sizeof(unsigned int), delim, threads, count, err, si_tokUInt );
+}
+
+unsigned long *si_reader_parallelGetULongArray ( si_reader *r, char delim, unsigned threads, size_t *count, si_position *err ) {
+
+	return si_parallelArray( r, sizeof(unsigned long), delim, threads, count, err, si_tokULong );
+}
+
+long long *si_reader_parallelGetLongLongArray ( si_reader *r, char delim, unsigned threads, size_t *count, si_position *err ) {
+
+	return si_parallelArray( r, sizeof(long long), delim, threads, count, err, si_tokLongLong );
+}
+
+unsigned long long *si_reader_parallelGetULongLongArray ( si_reader *r, char delim, unsigned threads, size_t *count, si_position *err ) {
+
+	return si_parallelArray( r, sizeof(unsigned long long), delim, threads, count, err, si_tokULongLong );
+}
+
+float *si_reader_parallelGetFloatArray ( si_reader *r, char delim, unsigned threads, size_t *count, si_position *err ) {
+
+	return si_parallelArray( r, sizeof(float), delim, threads, count, err, si_tokFloat );
+}
+
+double *si_reader_parallelGetDoubleArray ( si_reader *r, char delim, unsigned threads, size_t *count, si_position *err ) {
+
+	return si_parallelArray( r, sizeof(double), delim, threads, count, err, si_tokDouble );
+}
+
+
+
+/**
+ * Records
+ *
+ * si_reader_getRecord() splits one line into delimiter-separated fields,
+ * CSV style. Fields are si_string views into the reader's buffer, found
+ * with the same vectorised byte scan as newlines, and are only copied when
+ * a quoted field contains doubled quotes that must be collapsed. Typed
+ * field parsers reuse the array getters' token parsers.
+ *
+ * Quoted fields can't span lines, and a trailing '\r' is dropped so CRLF
+ * files work unchanged.
+ */
+
+/**
+ * si_unquote - copy a quoted field with doubled quotes collapsed to dst
+ *
+ * returns the unescaped length
+ */
+static cold size_t si_unquote ( char *dst, const char *p, const char *end, char quote ) {
+
+	size_t n = 0;
+
+	while ( p < end ) {
+		dst[n++] = *p;
+		p += ( *p == quote ) ? 2 : 1;
+	}
+
+	return n;
+}
+
+
+
+/**
+ * si_badRecord - reject the current record, leaving it empty
+ */
+static cold si_result si_badRecord ( si_reader *r, si_record *rec ) {
+
+	si_count( r, rejected[SI_REJECT_RECORD], 1 );
+	rec->count = 0;
+	return si_tally( r, SI_INVALID );
+}
+
+
+
+/**
+ * si_reader_getRecord - read one line and split it into fields
+ *
+ * @delim:		field separator, e.g. ',' or '\t'
+ * @quote:		quote character ( usually '"' ), or 0 to disable quoting.
+ * 				A field that starts with it runs to the matching quote,
+ * 				may contain delim, and writes a literal quote as two.
+ * @rec:		receives the fields, valid until the next read from r
+ *
+ * Lines must be shorter than the reader's line limit and hold at most
+ * SI_RECORD_FIELDS fields. An empty line is one empty field.
+ *
+ * Returns:
+ * 		SI_OK 			- on success
+ * 		SI_INVALID		- bad quoting or too many fields ( the line is consumed )
+ * 		SI_TOO_LONG, SI_WOULD_BLOCK, SI_EOF	- as for si_reader_readLine()
+ */
+si_result si_reader_getRecord ( si_reader *r, char delim, char quote, si_record *rec ) {
+
+	si_guard( r );
+
+	if ( !r || !rec ) return SI_EOF;
+
+	rec->count = 0;
+
+	si_string line;
+	si_result status = si_reader_readLine( r, &line );
+	if ( status ) return status;
+
+	rec->line = r->lines;
+
+	const char *p = line.data;
+	const char *end = p + line.len;
+	char *scratch = NULL;
+	size_t used = 0;
+
+	if ( p < end && end[-1] == '\r' ) end--;
+
+	while ( 1 ) {
+		if ( unlikely( rec->count == SI_RECORD_FIELDS )) return si_badRecord( r, rec );
+
+		si_string *field = &rec->field[ rec->count++ ];
+
+		if ( quote && p < end && *p == quote ) {
+			const char *start = ++p;
+			bool escaped = false;
+
+			while ( 1 ) {
+				p = si_scanByte( p, end, quote );
+				if ( unlikely( !p )) return si_badRecord( r, rec );
+				if ( p + 1 < end && p[1] == quote ) {
+					escaped = true;
+					p += 2;
+					continue;
+				}
+				break;
+			}
+
+			if ( escaped ) {
+				// one buffer of line.len bytes holds every unescaped field
+				if ( !scratch ) {
+					if ( r->fieldCap < line.len ) {
+						char *buf = realloc( r->fieldBuf, line.len );
+						if ( !buf ) {
+							si_report( r, SI_ERR_NOMEM, "Memory allocation failed.\n" );
+							return SI_EOF;
+						}
+						r->fieldBuf = buf;
+						r->fieldCap = line.len;
+					}
+					scratch = r->fieldBuf;
+				}
+				size_t n = si_unquote( scratch + used, start, p, quote );
+				*field = (si_string){ scratch + used, n };
+				used += n;
+			}
+			else *field = (si_string){ (char *)start, (size_t)( p - start ) };
+
+			p++;
+			if ( p == end ) return SI_OK;
+			if ( unlikely( *p != delim )) return si_badRecord( r, rec );
+			p++;
+			continue;
+		}
+
+		const char *stop = si_scanByte( p, end, delim );
+		if ( !stop ) {
+			*field = (si_string){ (char *)p, (size_t)( end - p ) };
+			return SI_OK;
+		}
+
+		*field = (si_string){ (char *)p, (size_t)( stop - p ) };
+		p = stop + 1;
+	}
+}
+
+
+
+/**
+ * si_field - the i-th ( 0-based ) field of a record, { NULL, 0 } if missing
+ */
+si_string si_field ( const si_record *rec, size_t i ) {
+
+	if ( !rec || i >= rec->count ) return (si_string){ NULL, 0 };
+	return rec->field[i];
+}
+
+
+
+/**
+ * si_fieldParse - run a token parser over field i
+ */
+static alwaysInline si_result si_fieldParse ( const si_record *rec, size_t i, void *out,
+											  int ( *parse )( const char *, size_t, void * )) {
+
+	if ( !rec || !out || i >= rec->count ) return SI_EOF;
+	return si_statusOf( parse( rec->field[i].data, rec->field[i].len, out ));
+}
+
+
+
+/**
+ * si_fieldInt .. si_fieldDouble - parse field i like the matching getter
+ *
+ * *out is only written on SI_OK.
+ *
+ * returns SI_OK, SI_INVALID, SI_OVERFLOW, or SI_EOF for a missing field
+ */
+si_result si_fieldInt ( const si_record *rec, size_t i, int *out ) {
+
+	return si_fieldParse( rec, i, out, si_tokInt );
+}
+
+si_result si_fieldUInt ( const si_record *rec, size_t i, unsigned int *out ) {
+
+	return si_fieldParse( rec, i, out, si_tokUInt );
+}
+
+si_result si_fieldLong ( const si_record *rec, size_t i, long *out ) {
+
+	return si_fieldParse( rec, i, out, si_tokLong );
+}
+
+si_result si_fieldULong ( const si_record *rec, size_t i, unsigned long *out ) {
+
+	return si_fieldParse( rec, i, out, si_tokULong );
+}
+
+si_result si_fieldLongLong ( const si_record *rec, size_t i, long long *out ) {
+
+	return si_fieldParse( rec, i, out, si_tokLongLong );
+}
+
+si_result si_fieldULongLong ( const si_record *rec, size_t i, unsigned long long *out ) {
+
+	return si_fieldParse( rec, i, out, si_tokULongLong );
+}
+
+si_result si_fieldFloat ( const si_record *rec, size_t i, float *out ) {
+
+	return si_fieldParse( rec, i, out, si_tokFloat );
+}
+
+si_result si_fieldDouble ( const si_record *rec, size_t i, double *out ) {
+
+	return si_fieldParse( rec, i, out, si_tokDouble );
+}
+
+
+
+/**
+ * Schemas
+ *
+ * A schema is a record layout compiled once into a dispatch table of
+ * ( token parser, struct offset ) pairs. si_reader_readStruct() then costs
+ * one si_reader_getRecord() plus one indirect call per field, with no
+ * format string to interpret on every line as with sscanf().
+ */
+typedef int ( *si_tokParser )( const char *p, size_t len, void *out );
+
+struct si_schema {
+	char	delim;
+	char	quote;
+	size_t	count;
+	struct {
+		si_tokParser	parse;		// NULL for skipped fields
+		size_t			offset;
+		bool			copy;		// SI_FIELD_STRING_COPY, retained after parsing
+		si_fieldType	type;
+	} field[];
+};
+
+static int si_tokBool ( const char *p, size_t len, void *out ) {
+
+	if ( len != 1 ) return SI_PARSE_INVALID;
+	if ( p[0] == 'Y' || p[0] == 'y' ) *(bool *)out = true;
+	else if ( p[0] == 'N' || p[0] == 'n' ) *(bool *)out = false;
+	else return SI_PARSE_INVALID;
+	return SI_PARSE_OK;
+}
+
+static int si_tokChar ( const char *p, size_t len, void *out ) {
+
+	if ( len != 1 ) return SI_PARSE_INVALID;
+	*(char *)out = p[0];
+	return SI_PARSE_OK;
+}
+
+static int si_tokString ( const char *p, size_t len, void *out ) {
+
+	*(si_string *)out = (si_string){ (char *)p, len };
+	return SI_PARSE_OK;
+}
+
+static si_tokParser si_fieldParser ( si_fieldType type ) {
+
+	switch ( type ) {
+		case SI_FIELD_INT:			return si_tokInt;
+		case SI_FIELD_UINT:			return si_tokUInt;
+		case SI_FIELD_LONG:			return si_tokLong;
+		case SI_FIELD_ULONG:		return si_tokULong;
+		case SI_FIELD_LONGLONG:		return si_tokLongLong;
+		case SI_FIELD_ULONGLONG:	return si_tokULongLong;
+		case SI_FIELD_FLOAT:		return si_tokFloat;
+		case SI_FIELD_DOUBLE:		return si_tokDouble;
+		case SI_FIELD_BOOL:			return si_tokBool;
+		case SI_FIELD_CHAR:			return si_tokChar;
+		case SI_FIELD_STRING:
+		case SI_FIELD_STRING_COPY:	return si_tokString;
+		default:					return NULL;
+	}
+}
+
+
+
+/**
+ * si_schema_compile - compile field descriptors into a schema
+ *
+ * @fields:		one descriptor per field of the line, in order
+ * @n:			number of descriptors, at most SI_RECORD_FIELDS
+ * @delim:		field separator
+ * @quote:		quote character, or 0, as for si_reader_getRecord()
+ *
+ * NOTE: 	Free the schema with si_schema_free().
+ *
+ * returns NULL on bad arguments, an unknown type or allocation failure
+ */
+si_schema *si_schema_compile ( const si_fieldDesc *fields, size_t n, char delim, char quote ) {
+
+	if ( !fields || !n || n > SI_RECORD_FIELDS ) return NULL;
+
+	si_schema *schema = malloc( sizeof(*schema) + n * sizeof(schema->field[0]) );
+	if ( !schema ) {
+		si_report( NULL, SI_ERR_NOMEM, "Memory allocation failed.\n" );
+		return NULL;
+	}
+
+	schema->delim = delim;
+	schema->quote = quote;
+	schema->count = n;
+
+	for ( size_t i = 0; i < n; i++ ) {
+		schema->field[i].parse = si_fieldParser( fields[i].type );
+		schema->field[i].offset = fields[i].offset;
+		schema->field[i].copy = ( fields[i].type == SI_FIELD_STRING_COPY );
+		schema->field[i].type = fields[i].type;
+
+		if ( !schema->field[i].parse && fields[i].type != SI_FIELD_SKIP ) {
+			free( schema );
+			return NULL;
+		}
+	}
+
+	return schema;
+}
+
+
+
+/**
+ * si_schema_fromSignature - compile a schema from a compact type signature
+ *
+ * @sig:		one letter per field, commas and spaces are ignored:
+ * 				i int, u unsigned int, l long, L unsigned long, q long long,
+ * 				Q unsigned long long, f float, d double, b bool, c char,
+ * 				s si_string view, S si_string copy, - skipped field
+ * @offsets:	offsetof() of the destination of each non-skipped field
+ *
+ * usage - si_schema_fromSignature( "i,d,s", (size_t[]){ offsetof( row, id ),
+ * 			offsetof( row, price ), offsetof( row, name ) }, ',', '"' );
+ *
+ * returns NULL on an unknown letter, too many fields or allocation failure
+ */
+si_schema *si_schema_fromSignature ( const char *sig, const size_t *offsets, char delim, char quote ) {
+
+	if ( !sig || !offsets ) return NULL;
+
+	si_fieldDesc fields[SI_RECORD_FIELDS];
+	size_t n = 0, k = 0;
+
+	for ( ; *sig; sig++ ) {
+		si_fieldType type;
+
+		switch ( *sig ) {
+			case ',': case ' ': case '\t':	continue;
+			case 'i':	type = SI_FIELD_INT;		break;
+			case 'u':	type = SI_FIELD_UINT;		break;
+			case 'l':	type = SI_FIELD_LONG;		break;
+			case 'L':	type = SI_FIELD_ULONG;		break;
+			case 'q':	type = SI_FIELD_LONGLONG;	break;
+			case 'Q':	type = SI_FIELD_ULONGLONG;	break;
+			case 'f':	type = SI_FIELD_FLOAT;		break;
+			case 'd':	type = SI_FIELD_DOUBLE;		break;
+			case 'b':	type = SI_FIELD_BOOL;		break;
+			case 'c':	type = SI_FIELD_CHAR;		break;
+			case 's':	type = SI_FIELD_STRING;		break;
+			case 'S':	type = SI_FIELD_STRING_COPY;	break;
+			case '-':	type = SI_FIELD_SKIP;		break;
+			default:	return NULL;
+		}
+
+		if ( n == SI_RECORD_FIELDS ) return NULL;
+
+		fields[n].type = type;
+		fields[n].offset = ( type == SI_FIELD_SKIP ) ? 0 : offsets[ k++ ];
+		n++;
+	}
+
+	return si_schema_compile( fields, n, delim, quote );
+}
+
+
+
+/**
+ * si_schema_free - release a compiled schema, NULL is a no-op
+ */
+void si_schema_free ( si_schema *schema ) {
+
+	free( schema );
+}
+
+
+
+/**
+ * si_reader_readStruct - read one line and store its fields into out
+ *
+ * @schema:		compiled layout, the line must have exactly schema's fields
+ * @out:		struct the schema's offsets point into
+ * @badField:	if not NULL, receives the 0-based index of the field that
+ * 				failed to parse ( or the field count for a wrong number of
+ * 				fields ), untouched on success
+ *
+ * Fields are validated like the matching si_get*() call. String views are
+ * valid until the next read; SI_FIELD_STRING_COPY fields are copied with
+ * the reader's allocator once the whole line has parsed, and must be
+ * released with si_reader_release().
+ *
+ * NOTE: 	On failure, the fields before the bad one may have been written.
+ *
+ * returns SI_OK, SI_INVALID or SI_OVERFLOW for a bad field, or any other
+ * 		   si_reader_getRecord() status
+ */
+si_result si_reader_readStruct ( si_reader *r, const si_schema *schema, void *out, size_t *badField ) {
+
+	si_guard( r );
+
+	if ( !r || !schema || !out ) return SI_EOF;
+
+	si_record rec;
+	si_result status = si_reader_getRecord( r, schema->delim, schema->quote, &rec );
+	if ( status ) return status;
+
+	if ( rec.count != schema->count ) {
+		si_count( r, rejected[SI_REJECT_RECORD], 1 );
+		if ( badField ) *badField = rec.count;
+		return si_tally( r, SI_INVALID );
+	}
+
+	char *base = out;
+	bool copies = false;
+
+	for ( size_t i = 0; i < schema->count; i++ ) {
+		if ( !schema->field[i].parse ) continue;
+
+		int result = schema->field[i].parse( rec.field[i].data, rec.field[i].len, base + schema->field[i].offset );
+		if ( unlikely( result )) {
+			if ( badField ) *badField = i;
+			return si_parseStatus( r, result );
+		}
+
+		si_count( r, parsed[ schema->field[i].type ], 1 );
+		copies |= schema->field[i].copy;
+	}
+
+	if ( !copies ) return SI_OK;
+
+	for ( size_t i = 0; i < schema->count; i++ ) {
+		if ( !schema->field[i].copy ) continue;
+
+		si_string *dst = (si_string *)( base + schema->field[i].offset );
+		si_string copy = si_reader_retainString( r, *dst );
+		if ( !copy.data ) {
+			// undo the copies made so far
+			while ( i-- )
+				if ( schema->field[i].copy )
+					si_reader_release( r, ((si_string *)( base + schema->field[i].offset ))->data );
+			return SI_EOF;
+		}
+		*dst = copy;
+	}
+
+	return SI_OK;
+}
+
+
+
+/**
+ * si_formLine - store the values of one answer line into fields[*next ...]
+ *
+ * Values are taken one per field, separated by whitespace; a string field
+ * takes the rest of the line, trailing whitespace trimmed. *next moves past
+ * every field stored.
+ *
+ * returns SI_OK, SI_INVALID or SI_OVERFLOW after reporting a bad value or
+ * 		   a line with more values than fields, or SI_EOF if a copy failed
+ */
+static si_result si_formLine ( si_reader *r, const si_promptField *fields, size_t n, size_t *next,
+							   const char *p, const char *end ) {
+
+	size_t first = *next;
+
+	while ( *next < n ) {
+
+		while ( p < end && si_isSpace( (unsigned char)*p )) p++;
+		if ( p == end && *next > first ) return SI_OK;
+
+		const si_promptField *f = &fields[*next];
+		const char *value = p;
+
+		if ( f->type == SI_FIELD_STRING || f->type == SI_FIELD_STRING_COPY ) {
+			while ( end > p && si_isSpace( (unsigned char)end[-1] )) end--;
+			p = end;
+		}
+		else while ( p < end && !si_isSpace( (unsigned char)*p )) p++;
+
+		int result = si_fieldParser( f->type )( value, (size_t)( p - value ), f->out );
+		if ( result ) {
+			// the rest of the line goes, the form carries on from this field
+			si_countReject( r, result );
+			if ( result == SI_PARSE_NEGATIVE ) si_report( r, SI_ERR_INVALID, "Value can not be negative.\n" );
+			else si_report( r, si_errorKind( result ), "Invalid input. Try again.\n" );
+			return si_statusOf( result );
+		}
+
+		if ( f->type == SI_FIELD_STRING_COPY ) {
+			si_string *dst = f->out;
+			if ( !( *dst = si_reader_retainString( r, *dst )).data ) return SI_EOF;
+		}
+
+		si_count( r, parsed[ f->type ], 1 );
+		++*next;
+	}
+
+	while ( p < end && si_isSpace( (unsigned char)*p )) p++;
+	if ( p == end ) return SI_OK;
+
+	// more values than questions: nothing from this line is kept
+	*next = first;
+	si_count( r, rejected[SI_REJECT_RECORD], 1 );
+	si_report( r, SI_ERR_INVALID, "Too many values. Try again.\n" );
+	return SI_INVALID;
+}
+
+
+
+/**
+ * si_reader_promptMany - fill a form, as many fields per round trip as typed
+ *
+ * @fields:		the questions in order, each with the prompt that is shown
+ * 				when its answer is needed and nothing is typed ahead
+ * @n:			number of fields
+ *
+ * Answers are whitespace-separated values taken in field order from as
+ * many lines as it takes, so "Ada 36 1.65" answers name, age and height in
+ * one round trip, and lines typed ahead are used without prompting. A
+ * value that doesn't parse is reported like si_get*() does, the rest of
+ * its line is dropped, and the form goes on from that field, keeping the
+ * answers before it. A line with more values than open fields is dropped
+ * whole. String fields take the rest of their line; views are only valid
+ * until the next read, so SI_FIELD_STRING must be the last field, while
+ * SI_FIELD_STRING_COPY fields are copied as for si_reader_readStruct().
+ *
+ * The labels go through the reader's prompt ( see si_reader_setPrompt ),
+ * so they and the retry messages share one write, on terminals only. The
+ * previous prompt is restored on return.
+ *
+ * NOTE: 	On failure the fields filled so far keep their values, but string
+ * 			copies are released.
+ *
+ * returns SI_OK once every field is filled, SI_EOF on EOF, bad arguments
+ * 		   or allocation failure, SI_WOULD_BLOCK on a non-blocking reader
+ */
+si_result si_reader_promptMany ( si_reader *r, const si_promptField *fields, size_t n ) {
+
+	si_guard( r );
+
+	if ( !r || !fields || !n ) return SI_EOF;
+
+	for ( size_t i = 0; i < n; i++ ) {
+		if ( !fields[i].out || fields[i].type == SI_FIELD_SKIP || !si_fieldParser( fields[i].type )
+			 || ( fields[i].type == SI_FIELD_STRING && i + 1 < n )) {
+			si_count( r, rejected[SI_REJECT_USAGE], 1 );
+			return SI_EOF;
+		}
+	}
+
+	const char *saved = r->prompt;
+	bool terminal = !r->nonBlock && si_isTerminal( r );
+	si_result status = SI_OK;
+	size_t next = 0;
+
+	while ( next < n ) {
+
+		const char *line;
+		size_t len;
+
+		if ( terminal ) r->prompt = fields[next].label;
+
+		int got = si_readLine( r, INPUT_BUFFER_SIZE - 1, &line, &len );
+		if ( got > 0 ) continue;
+		if ( got < 0 ) {
+			status = r->blocked ? SI_WOULD_BLOCK : SI_EOF;
+			break;
+		}
+
+		if ( si_formLine( r, fields, n, &next, line, line + len ) == SI_EOF ) {
+			status = SI_EOF;
+			break;
+		}
+	}
+
+	if ( status ) {
+		for ( size_t i = 0; i < next; i++ )
+			if ( fields[i].type == SI_FIELD_STRING_COPY ) si_reader_release( r, ((si_string *)fields[i].out )->data );
+	}
+
+	if ( r->pendingLen && !saved ) si_showPending( r, NULL );
+	r->prompt = saved;
+	return status;
+}
+
+
+
+/**
+ * Default reader wrappers - the original stdin API
+ *
+ * Each si_getX() is si_reader_getX() on the calling thread's default
+ * reader: si_stdin(), unless si_useReader() picked another one.
+ */
+int si_getInt ( void ) {
+
+	return si_reader_getInt( si_current() );
+}
+
+unsigned int si_getUInt ( void ) {
+
+	return si_reader_getUInt( si_current() );
+}
+
+float si_getFloat ( void ) {
+
+	return si_reader_getFloat( si_current() );
+}
+
+double si_getDouble ( void ) {
+
+	return si_reader_getDouble( si_current() );
+}
+
+long si_getLong ( void ) {
+
+	return si_reader_getLong( si_current() );
+}
+
+unsigned long si_getULong ( void ) {
+
+	return si_reader_getULong( si_current() );
+}
+
+long long si_getLongLong ( void ) {
+
+	return si_reader_getLongLong( si_current() );
+}
+
+unsigned long long si_getULongLong ( void ) {
+
+	return si_reader_getULongLong( si_current() );
+}
+
+int si_getChar ( void ) {
+
+	return si_reader_getChar( si_current() );
+}
+
+int si_getCharFiltered ( const char *allowed ) {
+
+	return si_reader_getCharFiltered( si_current(), allowed );
+}
+
+char *si_getCString ( void ) {
+
+	return si_reader_getCString( si_current() );
+}
+
+char *si_getCStringMax ( size_t max ) {
+
+	return si_reader_getCStringMax( si_current(), max );
+}
+
+si_string si_getString ( void ) {
+
+	return si_reader_getString( si_current() );
+}
+
+si_string si_getStringMax ( size_t max ) {
+
+	return si_reader_getStringMax( si_current(), max );
+}
+
+si_string si_getStringView ( void ) {
+
+	return si_reader_getStringView( si_current() );
+}
+
+si_string si_getStringViewMax ( size_t max ) {
+
+	return si_reader_getStringViewMax( si_current(), max );
+}
+
+bool si_setLineLimit ( size_t limit ) {
+
+	return si_reader_setLineLimit( si_current(), limit );
+}
+
+bool si_setErrorHandler ( si_errorHandler fn, void *ctx ) {
+
+	return si_reader_setErrorHandler( si_current(), fn, ctx );
+}
+
+bool si_setLocking ( bool on ) {
+
+	return si_reader_setLocking( &si_stdinReader, on );
+}
+
+bool si_setSilent ( bool silent ) {
+
+	return si_reader_setSilent( si_current(), silent );
+}
+
+bool si_setAllocator ( const si_allocator *a ) {
+
+	return si_reader_setAllocator( si_current(), a );
+}
+
+void si_release ( void *ptr ) {
+
+	si_reader_release( si_current(), ptr );
+}
+
+bool si_getBool ( void ) {
+
+	return si_reader_getBool( si_current() );
+}
+
+si_result si_tryGetInt ( int *out ) {
+
+	return si_reader_tryGetInt( si_current(), out );
+}
+
+si_result si_tryGetUInt ( unsigned int *out ) {
+
+	return si_reader_tryGetUInt( si_current(), out );
+}
+
+si_result si_tryGetFloat ( float *out ) {
+
+	return si_reader_tryGetFloat( si_current(), out );
+}
+
+si_result si_tryGetDouble ( double *out ) {
+
+	return si_reader_tryGetDouble( si_current(), out );
+}
+
+si_result si_tryGetLong ( long *out ) {
+
+	return si_reader_tryGetLong( si_current(), out );
+}
+
+si_result si_tryGetULong ( unsigned long *out ) {
+
+	return si_reader_tryGetULong( si_current(), out );
+}
+
+si_result si_tryGetLongLong ( long long *out ) {
+
+	return si_reader_tryGetLongLong( si_current(), out );
+}
+
+si_result si_tryGetULongLong ( unsigned long long *out ) {
+
+	return si_reader_tryGetULongLong( si_current(), out );
+}
+
+si_result si_tryGetChar ( char *out ) {
+
+	return si_reader_tryGetChar( si_current(), out );
+}
+
+si_result si_tryGetBool ( bool *out ) {
+
+	return si_reader_tryGetBool( si_current(), out );
+}
+
+si_result si_readStruct ( const si_schema *schema, void *out, size_t *badField ) {
+
+	return si_reader_readStruct( si_current(), schema, out, badField );
+}
+
+si_result si_getRecord ( char delim, char quote, si_record *rec ) {
+
+	return si_reader_getRecord( si_current(), delim, quote, rec );
+}
+
+si_result si_tryGetLineIn ( const si_charset *cs, si_string *line ) {
+
+	return si_reader_tryGetLineIn( si_current(), cs, line );
+}
+
+size_t si_skipLine ( void ) {
+
+	return si_reader_skipLine( si_current() );
+}
+
+int si_getCharIn ( const si_charset *cs ) {
+
+	return si_reader_getCharIn( si_current(), cs );
+}
+
+int si_getIntRange ( int lo, int hi ) {
+
+	return si_reader_getIntRange( si_current(), lo, hi );
+}
+
+unsigned int si_getUIntRange ( unsigned int lo, unsigned int hi ) {
+
+	return si_reader_getUIntRange( si_current(), lo, hi );
+}
+
+long si_getLongRange ( long lo, long hi ) {
+
+	return si_reader_getLongRange( si_current(), lo, hi );
+}
+
+unsigned long si_getULongRange ( unsigned long lo, unsigned long hi ) {
+
+	return si_reader_getULongRange( si_current(), lo, hi );
+}
+
+long long si_getLongLongRange ( long long lo, long long hi ) {
+
+	return si_reader_getLongLongRange( si_current(), lo, hi );
+}
+
+unsigned long long si_getULongLongRange ( unsigned long long lo, unsigned long long hi ) {
+
+	return si_reader_getULongLongRange( si_current(), lo, hi );
+}
+
+float si_getFloatRange ( float lo, float hi ) {
+
+	return si_reader_getFloatRange( si_current(), lo, hi );
+}
+
+double si_getDoubleRange ( double lo, double hi ) {
+
+	return si_reader_getDoubleRange( si_current(), lo, hi );
+}
+
+si_result si_tryGetIntRange ( int lo, int hi, int *out ) {
+
+	return si_reader_tryGetIntRange( si_current(), lo, hi, out );
+}
+
+si_result si_tryGetUIntRange ( unsigned int lo, unsigned int hi, unsigned int *out ) {
+
+	return si_reader_tryGetUIntRange( si_current(), lo, hi, out );
+}
+
+si_result si_tryGetLongRange ( long lo, long hi, long *out ) {
+
+	return si_reader_tryGetLongRange( si_current(), lo, hi, out );
+}
+
+si_result si_tryGetULongRange ( unsigned long lo, unsigned long hi, unsigned long *out ) {
+
+	return si_reader_tryGetULongRange( si_current(), lo, hi, out );
+}
+
+si_result si_tryGetLongLongRange ( long long lo, long long hi, long long *out ) {
+
+	return si_reader_tryGetLongLongRange( si_current(), lo, hi, out );
+}
+
+si_result si_tryGetULongLongRange ( unsigned long long lo, unsigned long long hi, unsigned long long *out ) {
+
+	return si_reader_tryGetULongLongRange( si_current(), lo, hi, out );
+}
+
+si_result si_tryGetFloatRange ( float lo, float hi, float *out ) {
+
+	return si_reader_tryGetFloatRange( si_current(), lo, hi, out );
+}
+
+si_result si_tryGetDoubleRange ( double lo, double hi, double *out ) {
+
+	return si_reader_tryGetDoubleRange( si_current(), lo, hi, out );
+}
+
+si_result si_forEachLine ( si_lineFn fn, void *ctx ) {
+
+	return si_reader_forEachLine( si_current(), fn, ctx );
+}
+
+si_result si_forEachLong ( si_longFn fn, void *ctx ) {
+
+	return si_reader_forEachLong( si_current(), fn, ctx );
+}
+
+si_result si_forEachDouble ( si_doubleFn fn, void *ctx ) {
+
+	return si_reader_forEachDouble( si_current(), fn, ctx );
+}
+
+int si_getCodepoint ( void ) {
+
+	return si_reader_getCodepoint( si_current() );
+}
+
+char *si_getCStringUtf8 ( void ) {
+
+	return si_reader_getCStringUtf8( si_current() );
+}
+
+si_string si_getStringUtf8 ( void ) {
+
+	return si_reader_getStringUtf8( si_current() );
+}
+
+si_string si_getStringViewUtf8 ( void ) {
+
+	return si_reader_getStringViewUtf8( si_current() );
+}
+
+si_result si_tryGetCodepoint ( uint32_t *out ) {
+
+	return si_reader_tryGetCodepoint( si_current(), out );
+}
+
+si_result si_tryGetLineUtf8 ( si_string *line ) {
+
+	return si_reader_tryGetLineUtf8( si_current(), line );
+}
+
+bool si_prompt ( const char *prompt ) {
+
+	return si_reader_setPrompt( si_current(), prompt );
+}
+
+si_result si_promptMany ( const si_promptField *fields, size_t n ) {
+
+	return si_reader_promptMany( si_current(), fields, n );
+}
+
+size_t si_getIntArray ( int *out, size_t n, char delim, si_position *err ) {
+
+	return si_reader_getIntArray( si_current(), out, n, delim, err );
+}
+
+size_t si_getUIntArray ( unsigned int *out, size_t n, char delim, si_position *err ) {
+
+	return si_reader_getUIntArray( si_current(), out, n, delim, err );
+}
+
+size_t si_getLongArray ( long *out, size_t n, char delim, si_position *err ) {
+
+	return si_reader_getLongArray( si_current(), out, n, delim, err );
+}
+
+size_t si_getULongArray ( unsigned long *out, size_t n, char delim, si_position *err ) {
+
+	return si_reader_getULongArray( si_current(), out, n, delim, err );
+}
+
+size_t si_getLongLongArray ( long long *out, size_t n, char delim, si_position *err ) {
+
+	return si_reader_getLongLongArray( si_current(), out, n, delim, err );
+}
+
+size_t si_getULongLongArray ( unsigned long long *out, size_t n, char delim, si_position *err ) {
+
+	return si_reader_getULongLongArray( si_current(), out, n, delim, err );
+}
+
+size_t si_getFloatArray ( float *out, size_t n, char delim, si_position *err ) {
+
+	return si_reader_getFloatArray( si_current(), out, n, delim, err );
+}
+
+size_t si_getDoubleArray ( double *out, size_t n, char delim, si_position *err ) {
+
+	return si_reader_getDoubleArray( si_current(), out, n, delim, err );
+}
+
+
+
+// the single-header build pastes this file into user code, keep these private
+#undef alwaysInline
+#undef cold
+#undef unlikely
+#undef hotApi